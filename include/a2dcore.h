@@ -16,6 +16,7 @@
 #include "ad/a2disotropic.h"
 #include "ad/a2dmatdet.h"
 #include "ad/a2dmatinv.h"
+#include "ad/a2dmatpolar.h"
 #include "ad/a2dmatsum.h"
 #include "ad/a2dmattovec.h"
 #include "ad/a2dmattrace.h"
@@ -26,9 +27,15 @@
 #include "ad/a2dsymmatmulttrace.h"
 #include "ad/a2dsymrk.h"
 #include "ad/a2dsymsum.h"
+#include "ad/a2dtensorbasis.h"
+#include "ad/a2dvecaggregate.h"
 #include "ad/a2dveccross.h"
 #include "ad/a2dvecnorm.h"
 #include "ad/a2dvecouter.h"
 #include "ad/a2dvecsum.h"
 
+// Precompiled cores, see a2dkernels.h
+
+#include "a2dkernels.h"
+
 #endif  //  A2D_CORE_H
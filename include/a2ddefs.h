@@ -42,13 +42,18 @@ enum class ADorder { ZERO, FIRST, SECOND };
 /**
  * @brief The class of object
  */
-enum class ADObjType { SCALAR, VECTOR, MATRIX, SYMMAT };
+enum class ADObjType { SCALAR, VECTOR, MATRIX, SYMMAT, SKEWMAT, DIAGMAT };
 
 /**
  * @brief Is the matrix normal (not transposed) or transposed
  */
 enum class MatOp { NORMAL, TRANSPOSE };
 
+/**
+ * @brief The storage order of the entries of a matrix
+ */
+enum class MatLayout { ROW_MAJOR, COLUMN_MAJOR };
+
 /**
  * @brief The symmetry type of the matrix
  */
@@ -99,8 +104,11 @@ A2D_FUNCTION double fmt(A2D_complex_t<T> val) {
 
 A2D_FUNCTION inline double fmt(double val) { return val; }
 
-A2D_FUNCTION inline double absfunc(A2D_complex_t<double> a) {
-  if (a.real() >= 0.0) {
+A2D_FUNCTION inline double fmt(float val) { return val; }
+
+template <typename T>
+A2D_FUNCTION T absfunc(A2D_complex_t<T> a) {
+  if (a.real() >= T(0.0)) {
     return a.real();
   } else {
     return -a.real();
@@ -115,15 +123,29 @@ A2D_FUNCTION inline double absfunc(double a) {
   }
 }
 
+A2D_FUNCTION inline float absfunc(float a) {
+  if (a >= 0.0f) {
+    return a;
+  } else {
+    return -a;
+  }
+}
+
 A2D_FUNCTION inline double RealPart(double a) { return a; }
 
-A2D_FUNCTION inline double RealPart(A2D_complex_t<double> a) {
+A2D_FUNCTION inline float RealPart(float a) { return a; }
+
+template <typename T>
+A2D_FUNCTION T RealPart(A2D_complex_t<T> a) {
   return a.real();
 }
 
 A2D_FUNCTION inline double ImagPart(double a) { return 0.0; }
 
-A2D_FUNCTION inline double ImagPart(A2D_complex_t<double> a) {
+A2D_FUNCTION inline float ImagPart(float a) { return 0.0f; }
+
+template <typename T>
+A2D_FUNCTION T ImagPart(A2D_complex_t<T> a) {
   return a.imag();
 }
 
@@ -195,6 +217,33 @@ template <class T>
 struct get_object_numeric_type
     : __get_object_numeric_type<typename remove_const_and_refs<T>::type> {};
 
+/*
+  Get the type used to accumulate sums of products in the reductions
+
+  By default sums are accumulated in the numeric type itself. When
+  A2D_MIXED_PRECISION is defined, float and complex<float> data are
+  accumulated in double and complex<double> inside the matrix products,
+  matrix-vector products, rank-k updates, dot products and traces, and the
+  result is rounded to float once. The definition must be the same in all
+  translation units of a program.
+*/
+template <class T>
+struct accumulate_type {
+  using type = T;
+};
+
+#ifdef A2D_MIXED_PRECISION
+template <>
+struct accumulate_type<float> {
+  using type = double;
+};
+
+template <>
+struct accumulate_type<A2D_complex_t<float>> {
+  using type = A2D_complex_t<double>;
+};
+#endif  // A2D_MIXED_PRECISION
+
 /*
   Get the type of object
 */
@@ -208,11 +257,21 @@ struct __get_a2d_object_type<double> {
   static constexpr ADObjType value = ADObjType::SCALAR;
 };
 
+template <>
+struct __get_a2d_object_type<float> {
+  static constexpr ADObjType value = ADObjType::SCALAR;
+};
+
 template <>
 struct __get_a2d_object_type<A2D_complex_t<double>> {
   static constexpr ADObjType value = ADObjType::SCALAR;
 };
 
+template <>
+struct __get_a2d_object_type<A2D_complex_t<float>> {
+  static constexpr ADObjType value = ADObjType::SCALAR;
+};
+
 template <class T>
 struct get_a2d_object_type
     : __get_a2d_object_type<typename std::remove_reference<T>::type> {};
@@ -328,6 +387,99 @@ A2D_FUNCTION T acos(T val) {
 #endif
 }
 
+template <typename T, std::enable_if_t<is_scalar_type<T>::value, bool> = true>
+A2D_FUNCTION T tanh(T val) {
+#ifndef __CUDACC__
+  return std::tanh(val);
+#else
+  return cuda::std::tanh(val);
+#endif
+}
+
+/*
+  The standard library does not provide erf, log1p, expm1, atan2 and hypot
+  for complex arguments. For complex types these are linearized about the
+  real part, f(x + i*h) = f(x) + i*h*f'(x), which is all that the
+  complex-step method requires.
+*/
+template <typename T, std::enable_if_t<is_scalar_type<T>::value, bool> = true>
+A2D_FUNCTION T erf(T val) {
+  if constexpr (is_complex<T>::value) {
+    using R = typename T::value_type;
+    const R two_over_sqrt_pi = 1.1283791670955126;
+    R x = val.real();
+    return T(erf(x), two_over_sqrt_pi * exp(-x * x) * val.imag());
+  } else {
+#ifndef __CUDACC__
+    return std::erf(val);
+#else
+    return cuda::std::erf(val);
+#endif
+  }
+}
+
+template <typename T, std::enable_if_t<is_scalar_type<T>::value, bool> = true>
+A2D_FUNCTION T log1p(T val) {
+  if constexpr (is_complex<T>::value) {
+    using R = typename T::value_type;
+    R x = val.real();
+    return T(log1p(x), val.imag() / (1.0 + x));
+  } else {
+#ifndef __CUDACC__
+    return std::log1p(val);
+#else
+    return cuda::std::log1p(val);
+#endif
+  }
+}
+
+template <typename T, std::enable_if_t<is_scalar_type<T>::value, bool> = true>
+A2D_FUNCTION T expm1(T val) {
+  if constexpr (is_complex<T>::value) {
+    using R = typename T::value_type;
+    R x = val.real();
+    return T(expm1(x), exp(x) * val.imag());
+  } else {
+#ifndef __CUDACC__
+    return std::expm1(val);
+#else
+    return cuda::std::expm1(val);
+#endif
+  }
+}
+
+template <typename T, std::enable_if_t<is_scalar_type<T>::value, bool> = true>
+A2D_FUNCTION T atan2(T y, T x) {
+  if constexpr (is_complex<T>::value) {
+    using R = typename T::value_type;
+    R yr = y.real(), xr = x.real();
+    return T(atan2(yr, xr),
+             (xr * y.imag() - yr * x.imag()) / (xr * xr + yr * yr));
+  } else {
+#ifndef __CUDACC__
+    return std::atan2(y, x);
+#else
+    return cuda::std::atan2(y, x);
+#endif
+  }
+}
+
+template <typename T, std::enable_if_t<is_scalar_type<T>::value, bool> = true>
+A2D_FUNCTION T hypot(T x, T y) {
+  if constexpr (is_complex<T>::value) {
+    using R = typename T::value_type;
+    R xr = x.real(), yr = y.real();
+    R r = hypot(xr, yr);
+    return T(r, (xr * x.imag() + yr * y.imag()) / r);
+  } else {
+#ifndef __CUDACC__
+    return std::hypot(x, y);
+#else
+    return cuda::std::hypot(x, y);
+#endif
+  }
+}
+
 template <class ForwardIt, class T>
 A2D_FUNCTION void fill(ForwardIt first, ForwardIt last, const T& value) {
 #ifdef __CUDACC__
@@ -337,7 +489,7 @@ A2D_FUNCTION void fill(ForwardIt first, ForwardIt last, const T& value) {
 #endif
 }
 
-A2D_FUNCTION int A2D_rand() {
+A2D_FUNCTION inline int A2D_rand() {
 #ifdef __CUDACC__
   return 123456;
 #else
@@ -345,6 +497,65 @@ A2D_FUNCTION int A2D_rand() {
 #endif
 }
 
+/*
+  Counter-based random number generator
+
+  The value drawn for a counter is a pure function of the key and the counter,
+  computed with the SplitMix64 mixing function, so that values can be
+  generated in any order, on any thread or on the device, and are identical
+  between runs. The key is usually formed from a name, such as the name of a
+  test, and the counter is usually the index of a component.
+*/
+class A2DRandom {
+ public:
+  A2D_FUNCTION A2DRandom() : key(mix(0)) {}
+  A2D_FUNCTION explicit A2DRandom(uint64_t key) : key(mix(key)) {}
+  A2D_FUNCTION A2DRandom(const char* name, uint64_t stream = 0)
+      : key(mix(hash(name) ^ mix(stream))) {}
+
+  // Create an independent generator for a sub-stream of this generator
+  A2D_FUNCTION A2DRandom split(uint64_t stream) const {
+    A2DRandom rng;
+    rng.key = mix(key ^ mix(stream + 1));
+    return rng;
+  }
+
+  // Random bits for the counter
+  A2D_FUNCTION uint64_t bits(uint64_t counter) const {
+    return mix(key + (counter + 1) * 0x9e3779b97f4a7c15ULL);
+  }
+
+  // Uniformly distributed value in [0, 1) for the counter
+  A2D_FUNCTION double uniform(uint64_t counter) const {
+    return (bits(counter) >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  // Uniformly distributed value in [low, high) for the counter
+  A2D_FUNCTION double uniform(uint64_t counter, double low,
+                              double high) const {
+    return low + (high - low) * uniform(counter);
+  }
+
+ private:
+  uint64_t key;
+
+  // SplitMix64 finalizer
+  A2D_FUNCTION static uint64_t mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  // 64-bit FNV-1a hash of a string
+  A2D_FUNCTION static uint64_t hash(const char* str) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (; str && *str; str++) {
+      h = (h ^ static_cast<unsigned char>(*str)) * 0x100000001b3ULL;
+    }
+    return h;
+  }
+};
+
 }  // namespace A2D
 
 #endif  // A2D_DEFS_H
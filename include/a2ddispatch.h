@@ -0,0 +1,85 @@
+#ifndef A2D_DISPATCH_H
+#define A2D_DISPATCH_H
+
+#include "a2ddefs.h"
+
+namespace A2D {
+
+/*
+  Instruction sets with separately compiled variants of the hot cores
+
+  The A2D::kernels library compiles each dispatched core once for each
+  instruction set and selects a variant at run time from the instruction
+  sets supported by the CPU. Code that includes A2D directly is compiled for
+  whatever the compiler flags target, so the dispatched cores let a single
+  binary use AVX2 or AVX-512 when they are available.
+
+  The selection can be forced for testing by SetKernelISA() or by setting
+  the environment variable A2D_KERNEL_ISA to scalar, avx2 or avx512 before
+  the program starts. An instruction set that the CPU does not support is
+  never selected.
+*/
+enum class KernelISA { SCALAR, AVX2, AVX512 };
+
+// The widest instruction set supported by the CPU
+KernelISA DetectKernelISA();
+
+// The instruction set used by the dispatched cores
+KernelISA GetKernelISA();
+
+// Force the instruction set, limited to those the CPU supports. Returns the
+// instruction set that is used.
+KernelISA SetKernelISA(KernelISA isa);
+
+const char* KernelISAName(KernelISA isa);
+
+/*
+  Dispatched versions of MatMatMultCore, SymMatRKCore and SymMatVecCore for
+  double and square sizes 1 to 6. These are only declared here: the
+  variants are compiled into A2D::kernels, so other types and sizes must
+  call the cores directly.
+*/
+template <typename T, int N, MatOp opA = MatOp::NORMAL,
+          MatOp opB = MatOp::NORMAL, bool additive = false>
+void DispatchMatMatMultCore(const T A[], const T B[], T C[]);
+
+template <typename T, int N, MatOp op = MatOp::NORMAL, bool additive = false>
+void DispatchSymMatRKCore(const T A[], T S[]);
+
+template <typename T, int M, bool additive = false>
+void DispatchSymMatVecCore(const T S[], const T x[], T y[]);
+
+/*
+  The matrix-matrix product and symmetric rank-k expressions call the
+  dispatched cores when the code links to A2D::kernels, which defines
+  A2D_USE_EXTERN_KERNELS, the core is compiled for T and N, and N is a size
+  at which the dispatched core was measured to be faster than the inlined
+  core (see the dispatch timings in benchmark_ad_expressions). For smaller
+  sizes the out-of-line call and the branch on the instruction set cost more
+  than the wider instructions save, and the symmetric matrix-vector product
+  is faster inlined at every size. Otherwise the expressions call the cores
+  directly.
+*/
+#if defined(A2D_USE_EXTERN_KERNELS) && !defined(__CUDACC__)
+template <typename T, int N>
+struct use_dispatch_core
+    : std::integral_constant<bool, std::is_same<T, double>::value &&
+                                       N >= 1 && N <= 6> {};
+#else
+template <typename T, int N>
+struct use_dispatch_core : std::false_type {};
+#endif
+
+template <typename T, int N>
+struct use_dispatch_mat_mat_mult
+    : std::integral_constant<bool, use_dispatch_core<T, N>::value &&
+                                       (N == 4 || N == 6)> {};
+
+template <typename T, int N>
+struct use_dispatch_sym_mat_rk
+    : std::integral_constant<bool,
+                             use_dispatch_core<T, N>::value && N >= 5> {};
+
+}  // namespace A2D
+
+#endif  // A2D_DISPATCH_H
@@ -0,0 +1,140 @@
+#ifndef A2D_KERNELS_H
+#define A2D_KERNELS_H
+
+/*
+  Explicit instantiations of the common cores for double and complex and the
+  sizes 1 to 6 (1 to 3 for the determinant and inverse)
+
+  The A2D::kernels library compiles these instantiations once and defines
+  A2D_USE_EXTERN_KERNELS for the code that links to it. The declarations
+  below are then extern, so each translation unit that includes a2dcore.h
+  calls the compiled cores instead of generating its own copies. Cores for
+  other sizes and types are still instantiated in place.
+
+  The declarations are skipped for CUDA, where the cores are device code.
+*/
+
+#include "a2ddefs.h"
+#include "ad/a2dgemm.h"
+#include "ad/a2dmatdet.h"
+#include "ad/a2dmatinv.h"
+#include "ad/a2dmatvecmult.h"
+#include "ad/a2dsymeigs.h"
+#include "ad/a2dsymrk.h"
+
+#if defined(A2D_KERNELS_INSTANTIATE)
+#define A2D_KERNEL_EXTERN
+#else
+#define A2D_KERNEL_EXTERN extern
+#endif
+
+#if (defined(A2D_USE_EXTERN_KERNELS) || defined(A2D_KERNELS_INSTANTIATE)) && \
+    !defined(__CUDACC__)
+
+// Square matrix-matrix products for all transposes, C = op(A) * op(B) and
+// C += op(A) * op(B)
+#define A2D_KERNEL_MATMATMULT_OP(T, N, opA, opB)                            \
+  A2D_KERNEL_EXTERN template void                                           \
+  MatMatMultCore<T, N, N, N, N, N, N, opA, opB, false>(const T[], const T[], \
+                                                       T[]);                \
+  A2D_KERNEL_EXTERN template void                                           \
+  MatMatMultCore<T, N, N, N, N, N, N, opA, opB, true>(const T[], const T[],  \
+                                                      T[]);
+
+#define A2D_KERNEL_MATMATMULT(T, N)                                         \
+  A2D_KERNEL_MATMATMULT_OP(T, N, MatOp::NORMAL, MatOp::NORMAL)              \
+  A2D_KERNEL_MATMATMULT_OP(T, N, MatOp::NORMAL, MatOp::TRANSPOSE)           \
+  A2D_KERNEL_MATMATMULT_OP(T, N, MatOp::TRANSPOSE, MatOp::NORMAL)           \
+  A2D_KERNEL_MATMATMULT_OP(T, N, MatOp::TRANSPOSE, MatOp::TRANSPOSE)
+
+// Square matrix-vector products y = op(A) * x and y += op(A) * x
+#define A2D_KERNEL_MATVEC_OP(T, N, op)                                      \
+  A2D_KERNEL_EXTERN template void MatVecCore<T, N, N, op, false>(           \
+      const T[], const T[], T[]) noexcept;                                  \
+  A2D_KERNEL_EXTERN template void MatVecCore<T, N, N, op, true>(            \
+      const T[], const T[], T[]) noexcept;
+
+#define A2D_KERNEL_MATVEC(T, N)              \
+  A2D_KERNEL_MATVEC_OP(T, N, MatOp::NORMAL) \
+  A2D_KERNEL_MATVEC_OP(T, N, MatOp::TRANSPOSE)
+
+// Symmetric rank-k products S = op(A) * op(A)^{T} with square A
+#define A2D_KERNEL_SYMRK_OP(T, N, op)                                        \
+  A2D_KERNEL_EXTERN template void SymMatRKCore<T, N, N, op, false>(const T[], \
+                                                                   T[]);     \
+  A2D_KERNEL_EXTERN template void SymMatRKCore<T, N, N, op, true>(const T[],  \
+                                                                  T[]);      \
+  A2D_KERNEL_EXTERN template void SymMatRKCoreReverse<T, N, N, op>(          \
+      const T[], const T[], T[]);
+
+#define A2D_KERNEL_SYMRK(T, N)              \
+  A2D_KERNEL_SYMRK_OP(T, N, MatOp::NORMAL) \
+  A2D_KERNEL_SYMRK_OP(T, N, MatOp::TRANSPOSE)
+
+// Symmetric eigenvalue decomposition and its derivatives
+#define A2D_KERNEL_SYMEIGS(T, N)                                             \
+  A2D_KERNEL_EXTERN template void SymEigsGeneral<T, N>(const T*, T*, T*);    \
+  A2D_KERNEL_EXTERN template void SymEigsForward<T, N>(const T*, const T*,   \
+                                                       const T*, T*);        \
+  A2D_KERNEL_EXTERN template void SymEigsReverse<T, N>(const T*, const T*,   \
+                                                       const T*, T*);        \
+  A2D_KERNEL_EXTERN template void SymEigsHReverse<T, N>(                     \
+      const T*, const T*, const T*, const T*, T*);
+
+// Determinant and inverse, implemented for N <= 3
+#define A2D_KERNEL_DETINV(T, N)                                              \
+  A2D_KERNEL_EXTERN template T MatDetCore<T, N>(const T[]);                  \
+  A2D_KERNEL_EXTERN template T MatDetForwardCore<T, N>(const T[], const T[]); \
+  A2D_KERNEL_EXTERN template void MatDetReverseCore<T, N>(const T, const T[], \
+                                                          T[]);              \
+  A2D_KERNEL_EXTERN template void MatDetHReverseCore<T, N>(                  \
+      const T, const T, const T[], const T[], T[]);                          \
+  A2D_KERNEL_EXTERN template T SymMatDetCore<T, N>(const T[]);               \
+  A2D_KERNEL_EXTERN template void MatInvCore<T, N>(const T[], T[]);          \
+  A2D_KERNEL_EXTERN template void SymMatInvCore<T, N>(const T[], T[]);
+
+#define A2D_KERNEL_SIZE(T, N) \
+  A2D_KERNEL_MATMATMULT(T, N) \
+  A2D_KERNEL_MATVEC(T, N)     \
+  A2D_KERNEL_SYMRK(T, N)      \
+  A2D_KERNEL_SYMEIGS(T, N)
+
+#define A2D_KERNEL_TYPE(T)  \
+  A2D_KERNEL_SIZE(T, 1)     \
+  A2D_KERNEL_SIZE(T, 2)     \
+  A2D_KERNEL_SIZE(T, 3)     \
+  A2D_KERNEL_SIZE(T, 4)     \
+  A2D_KERNEL_SIZE(T, 5)     \
+  A2D_KERNEL_SIZE(T, 6)     \
+  A2D_KERNEL_DETINV(T, 1)   \
+  A2D_KERNEL_DETINV(T, 2)   \
+  A2D_KERNEL_DETINV(T, 3)
+
+namespace A2D {
+
+A2D_KERNEL_TYPE(double)
+A2D_KERNEL_TYPE(A2D_complex_t<double>)
+
+}  // namespace A2D
+
+#undef A2D_KERNEL_TYPE
+#undef A2D_KERNEL_SIZE
+#undef A2D_KERNEL_DETINV
+#undef A2D_KERNEL_SYMEIGS
+#undef A2D_KERNEL_SYMRK
+#undef A2D_KERNEL_SYMRK_OP
+#undef A2D_KERNEL_MATVEC
+#undef A2D_KERNEL_MATVEC_OP
+#undef A2D_KERNEL_MATMATMULT
+#undef A2D_KERNEL_MATMATMULT_OP
+
+#endif  // A2D_USE_EXTERN_KERNELS || A2D_KERNELS_INSTANTIATE
+
+#undef A2D_KERNEL_EXTERN
+
+// The dispatched cores are also compiled into A2D::kernels
+#if defined(A2D_USE_EXTERN_KERNELS) && !defined(__CUDACC__)
+#include "a2ddispatch.h"
+#endif
+
+#endif  // A2D_KERNELS_H
@@ -2,6 +2,7 @@
 #define A2D_BINARY_OPS_H
 
 #include "../a2ddefs.h"
+#include "../a2dtuple.h"
 
 namespace A2D {
 
@@ -21,6 +22,24 @@ A2D_FUNCTION T min2(const T a, const T b) {
   return b;
 }
 
+/*
+  Smooth maximum of two values from the Kreisselmeier-Steinhauser (KS)
+  function
+
+  ksmax2(a, b, rho) = m + log(exp(rho * (a - m)) + exp(rho * (b - m))) / rho
+
+  where m = max2(a, b) is subtracted to avoid overflow. The derivatives are
+  the weights wa = exp(rho * (a - ksmax2)) and wb = 1 - wa, and the Hessian is
+  rho * wa * wb * [[1, -1], [-1, 1]].
+*/
+template <typename T, typename R,
+          std::enable_if_t<is_scalar_type<T>::value, bool> = true,
+          std::enable_if_t<is_scalar_type<R>::value, bool> = true>
+A2D_FUNCTION T ksmax2(const T a, const T b, const R rho) {
+  T m = max2(a, b), r = rho;
+  return m + log(exp(r * (a - m)) + exp(r * (b - m))) / r;
+}
+
 #define A2D_1ST_BINARY_BASIC(OBJNAME, OPERNAME, FUNCBODY, FORWARDBODY,       \
                              AREVBODY, BREVBODY)                             \
                                                                              \
@@ -96,13 +115,8 @@ A2D_FUNCTION T min2(const T a, const T b) {
 
 // A2D_1ST_BINARY_BASIC(OBJNAME, OPERNAME, FUNCBODY, FORWARDBODY, AREVBODY,
 //                      BREVBODY)
-A2D_1ST_BINARY_BASIC(AddExpr, operator+, a.value() + b.value(),
-                     a.bvalue() + b.bvalue(), bval, bval)
 A2D_1ST_BINARY_BASIC(SubExpr, operator-, a.value() - b.value(),
                      a.bvalue() - b.bvalue(), bval, -bval)
-A2D_1ST_BINARY_BASIC(MultExpr, operator*, a.value() * b.value(),
-                     a.bvalue() * b.value() + a.value() * b.bvalue(),
-                     b.value() * bval, a.value() * bval)
 
 #define A2D_1ST_BINARY(OBJNAME, OPERNAME, FUNCBODY, TEMPBODY, FORWARDBODY,   \
                        AREVBODY, BREVBODY)                                   \
@@ -188,13 +202,103 @@ A2D_1ST_BINARY(Max, max2,
                                                           : b.value()),
                (RealPart(a.value()) > RealPart(b.value()) ? T(1.0) : T(0.0)),
                tmp* a.bvalue() + (1.0 - tmp) * b.value(), tmp* bval,
-               (1.0 - tmp) * bval)
+               (T(1.0) - tmp) * bval)
 A2D_1ST_BINARY(Min, min2,
                (RealPart(a.value()) < RealPart(b.value()) ? a.value()
                                                           : b.value()),
                (RealPart(a.value()) < RealPart(b.value()) ? T(1.0) : T(0.0)),
                tmp* a.bvalue() + (1.0 - tmp) * b.value(), tmp* bval,
-               (1.0 - tmp) * bval)
+               (T(1.0) - tmp) * bval)
+A2D_1ST_BINARY(PowABExpr, pow, pow(a.value(), b.value()), log(a.value()),
+               val*(b.value() * a.bvalue() / a.value() + tmp * b.bvalue()),
+               b.value() * val / a.value() * bval, val* tmp* bval)
+A2D_1ST_BINARY(Atan2Expr, atan2, atan2(a.value(), b.value()),
+               T(1.0) / (a.value() * a.value() + b.value() * b.value()),
+               tmp*(b.value() * a.bvalue() - a.value() * b.bvalue()),
+               tmp* b.value() * bval, -tmp* a.value() * bval)
+A2D_1ST_BINARY(HypotExpr, hypot, hypot(a.value(), b.value()), T(1.0) / val,
+               tmp*(a.value() * a.bvalue() + b.value() * b.bvalue()),
+               tmp* a.value() * bval, tmp* b.value() * bval)
+
+template <class A, class Ta, class B, class Tb, class R, class T, bool CA,
+          bool CB>
+class KSMax : public ADExpr<KSMax<A, Ta, B, Tb, R, T, CA, CB>, T> {
+ public:
+  using Aexpr_t =
+      typename std::conditional<CA, const ADExpr<A, Ta>, ADExpr<A, Ta>>::type;
+  using Bexpr_t =
+      typename std::conditional<CB, const ADExpr<B, Tb>, ADExpr<B, Tb>>::type;
+  using A_t = typename std::conditional<CA, A, A&>::type;
+  using B_t = typename std::conditional<CB, B, B&>::type;
+
+  A2D_FUNCTION KSMax(Aexpr_t& a0, Bexpr_t& b0, const R rho)
+      : a(a0.self()), b(b0.self()), rho(rho), tmp(0.0), val(0.0), bval(0.0) {}
+  A2D_FUNCTION void eval() {
+    a.eval();
+    b.eval();
+    val = ksmax2(a.value(), b.value(), rho);
+    tmp = exp(rho * (a.value() - val));
+  }
+  A2D_FUNCTION void forward() {
+    a.forward();
+    b.forward();
+    bval = tmp * a.bvalue() + (1.0 - tmp) * b.bvalue();
+  }
+  A2D_FUNCTION void reverse() {
+    a.bvalue() += tmp * bval;
+    b.bvalue() += (T(1.0) - tmp) * bval;
+    a.reverse();
+    b.reverse();
+  }
+  A2D_FUNCTION void bzero() {
+    bval = T(0.0);
+    a.bzero();
+    b.bzero();
+  }
+  A2D_FUNCTION T& value() { return val; }
+  A2D_FUNCTION const T& value() const { return val; }
+  A2D_FUNCTION T& bvalue() { return bval; }
+  A2D_FUNCTION const T& bvalue() const { return bval; }
+
+ private:
+  A_t a;
+  B_t b;
+  const T rho;
+  T tmp, val, bval;
+};
+
+template <class A, class Ta, class B, class Tb, class R,
+          std::enable_if_t<is_same_type<Ta, Tb>::value, bool> = true,
+          std::enable_if_t<is_scalar_type<R>::value, bool> = true>
+A2D_FUNCTION inline auto ksmax2(const ADExpr<A, Ta>& a, const ADExpr<B, Tb>& b,
+                                const R rho) {
+  using T = typename remove_const_and_refs<Tb>::type;
+  return KSMax<A, Ta, B, Tb, R, T, true, true>(a, b, rho);
+}
+template <class A, class Ta, class B, class Tb, class R,
+          std::enable_if_t<is_same_type<Ta, Tb>::value, bool> = true,
+          std::enable_if_t<is_scalar_type<R>::value, bool> = true>
+A2D_FUNCTION inline auto ksmax2(const ADExpr<A, Ta>& a, ADExpr<B, Tb>& b,
+                                const R rho) {
+  using T = typename remove_const_and_refs<Tb>::type;
+  return KSMax<A, Ta, B, Tb, R, T, true, false>(a, b, rho);
+}
+template <class A, class Ta, class B, class Tb, class R,
+          std::enable_if_t<is_same_type<Ta, Tb>::value, bool> = true,
+          std::enable_if_t<is_scalar_type<R>::value, bool> = true>
+A2D_FUNCTION inline auto ksmax2(ADExpr<A, Ta>& a, const ADExpr<B, Tb>& b,
+                                const R rho) {
+  using T = typename remove_const_and_refs<Tb>::type;
+  return KSMax<A, Ta, B, Tb, R, T, false, true>(a, b, rho);
+}
+template <class A, class Ta, class B, class Tb, class R,
+          std::enable_if_t<is_same_type<Ta, Tb>::value, bool> = true,
+          std::enable_if_t<is_scalar_type<R>::value, bool> = true>
+A2D_FUNCTION inline auto ksmax2(ADExpr<A, Ta>& a, ADExpr<B, Tb>& b,
+                                const R rho) {
+  using T = typename remove_const_and_refs<Tb>::type;
+  return KSMax<A, Ta, B, Tb, R, T, false, false>(a, b, rho);
+}
 
 #define A2D_2ND_BINARY_BASIC(OBJNAME, OPERNAME, FUNCBODY, AREVBODY, BREVBODY, \
                              HFORWARDBODY, HAREVBODY, HBREVBODY)              \
@@ -291,15 +395,382 @@ A2D_1ST_BINARY(Min, min2,
 
 // A2D_2ND_BINARY_BASIC(OBJNAME, OPERNAME, FUNCBODY, AREVBODY, BREVBODY,
 //                      HFORWARDBODY, HAREVBODY, HBREVBODY)
-A2D_2ND_BINARY_BASIC(AddExpr2, operator+, a.value() + b.value(), bval, bval,
-                     a.pvalue() + b.pvalue(), hval, hval)
 A2D_2ND_BINARY_BASIC(SubExpr2, operator-, a.value() - b.value(), bval, -bval,
                      a.pvalue() - b.pvalue(), hval, -hval)
-A2D_2ND_BINARY_BASIC(MultExpr2, operator*, a.value() * b.value(),
-                     b.value() * bval, a.value() * bval,
-                     a.pvalue() * b.value() + a.value() * b.pvalue(),
-                     b.value() * hval + bval * b.pvalue(),
-                     a.value() * hval + bval * a.pvalue())
+
+/*
+  Flattened n-ary sums and products
+
+  A chain of k additions or multiplications is stored in a single SumExpr or
+  ProdExpr node with k terms instead of a depth-k tree of binary nodes. The
+  terms are stored in a tuple, by value for temporary expressions and by
+  reference otherwise. Applying operator+ to a SumExpr (or operator* to a
+  ProdExpr) appends the new terms to a new flattened node, so each sweep is a
+  single pass over the terms.
+*/
+
+// Pass a stored term to a new tuple of terms. Terms held by value are copied
+// and terms held by reference remain references to the original expression.
+template <class L>
+A2D_FUNCTION L a2d_term(const typename std::remove_reference<L>::type& t) {
+  return const_cast<typename std::remove_reference<L>::type&>(t);
+}
+
+// Concatenate the terms of two operands into a new n-ary expression
+template <template <class, class...> class Node, class T, class... S1,
+          class... S2, std::size_t... I, std::size_t... J>
+A2D_FUNCTION auto ExprTermsConcat(const a2d_tuple<S1...>& t1,
+                                  const a2d_tuple<S2...>& t2,
+                                  std::index_sequence<I...>,
+                                  std::index_sequence<J...>) {
+  return Node<T, S1..., S2...>(a2d_tuple<S1..., S2...>(
+      a2d_term<S1>(a2d_get<I>(t1))..., a2d_term<S2>(a2d_get<J>(t2))...));
+}
+
+template <template <class, class...> class Node, class T, class... S1,
+          class... S2>
+A2D_FUNCTION auto ExprTermsConcat(const a2d_tuple<S1...>& t1,
+                                  const a2d_tuple<S2...>& t2) {
+  return ExprTermsConcat<Node, T>(t1, t2, std::index_sequence_for<S1...>(),
+                                  std::index_sequence_for<S2...>());
+}
+
+/*
+  Compute the products P[i] = prod_{j != i} v[j] with a prefix and suffix
+  pass so that no division is required
+*/
+template <typename T, int N>
+A2D_FUNCTION void ExclusiveProductCore(const T v[], T P[]) {
+  T s = 1.0;
+  for (int i = 0; i < N; i++) {
+    P[i] = s;
+    s *= v[i];
+  }
+  s = 1.0;
+  for (int i = N - 1; i >= 0; i--) {
+    P[i] *= s;
+    s *= v[i];
+  }
+}
+
+/*
+  Compute P[i] = prod_{j != i} v[j] and its directional derivative dP[i] in
+  the direction p
+*/
+template <typename T, int N>
+A2D_FUNCTION void ExclusiveProductCore(const T v[], const T p[], T P[],
+                                       T dP[]) {
+  T s = 1.0, ds = 0.0;
+  for (int i = 0; i < N; i++) {
+    P[i] = s;
+    dP[i] = ds;
+    ds = ds * v[i] + s * p[i];
+    s *= v[i];
+  }
+  s = 1.0, ds = 0.0;
+  for (int i = N - 1; i >= 0; i--) {
+    dP[i] = dP[i] * s + P[i] * ds;
+    P[i] *= s;
+    ds = ds * v[i] + s * p[i];
+    s *= v[i];
+  }
+}
+
+template <class T, class... Terms>
+class SumExpr : public ADExpr<SumExpr<T, Terms...>, T> {
+ public:
+  static constexpr int nterms = sizeof...(Terms);
+  using terms_t = a2d_tuple<Terms...>;
+
+  A2D_FUNCTION SumExpr(terms_t&& t)
+      : terms(std::move(t)), val(0.0), bval(0.0) {}
+  A2D_FUNCTION void eval() { eval_(std::index_sequence_for<Terms...>()); }
+  A2D_FUNCTION void forward() { forward_(std::index_sequence_for<Terms...>()); }
+  A2D_FUNCTION void reverse() { reverse_(std::index_sequence_for<Terms...>()); }
+  A2D_FUNCTION void bzero() { bzero_(std::index_sequence_for<Terms...>()); }
+  A2D_FUNCTION T& value() { return val; }
+  A2D_FUNCTION const T& value() const { return val; }
+  A2D_FUNCTION T& bvalue() { return bval; }
+  A2D_FUNCTION const T& bvalue() const { return bval; }
+  A2D_FUNCTION const terms_t& get_terms() const { return terms; }
+
+ private:
+  terms_t terms;
+  T val, bval;
+
+  template <std::size_t... I>
+  A2D_FUNCTION void eval_(std::index_sequence<I...>) {
+    (a2d_get<I>(terms).eval(), ...);
+    val = (a2d_get<I>(terms).value() + ...);
+  }
+  template <std::size_t... I>
+  A2D_FUNCTION void forward_(std::index_sequence<I...>) {
+    (a2d_get<I>(terms).forward(), ...);
+    bval = (a2d_get<I>(terms).bvalue() + ...);
+  }
+  template <std::size_t... I>
+  A2D_FUNCTION void reverse_(std::index_sequence<I...>) {
+    ((a2d_get<I>(terms).bvalue() += bval), ...);
+    (a2d_get<I>(terms).reverse(), ...);
+  }
+  template <std::size_t... I>
+  A2D_FUNCTION void bzero_(std::index_sequence<I...>) {
+    bval = T(0.0);
+    (a2d_get<I>(terms).bzero(), ...);
+  }
+};
+
+template <class T, class... Terms>
+class ProdExpr : public ADExpr<ProdExpr<T, Terms...>, T> {
+ public:
+  static constexpr int nterms = sizeof...(Terms);
+  using terms_t = a2d_tuple<Terms...>;
+
+  A2D_FUNCTION ProdExpr(terms_t&& t)
+      : terms(std::move(t)), val(0.0), bval(0.0) {}
+  A2D_FUNCTION void eval() { eval_(std::index_sequence_for<Terms...>()); }
+  A2D_FUNCTION void forward() { forward_(std::index_sequence_for<Terms...>()); }
+  A2D_FUNCTION void reverse() { reverse_(std::index_sequence_for<Terms...>()); }
+  A2D_FUNCTION void bzero() { bzero_(std::index_sequence_for<Terms...>()); }
+  A2D_FUNCTION T& value() { return val; }
+  A2D_FUNCTION const T& value() const { return val; }
+  A2D_FUNCTION T& bvalue() { return bval; }
+  A2D_FUNCTION const T& bvalue() const { return bval; }
+  A2D_FUNCTION const terms_t& get_terms() const { return terms; }
+
+ private:
+  terms_t terms;
+  T val, bval;
+
+  template <std::size_t... I>
+  A2D_FUNCTION void eval_(std::index_sequence<I...>) {
+    (a2d_get<I>(terms).eval(), ...);
+    val = (a2d_get<I>(terms).value() * ...);
+  }
+  template <std::size_t... I>
+  A2D_FUNCTION void forward_(std::index_sequence<I...>) {
+    (a2d_get<I>(terms).forward(), ...);
+    T v[] = {a2d_get<I>(terms).value()...};
+    T P[nterms];
+    ExclusiveProductCore<T, nterms>(v, P);
+    bval = ((P[I] * a2d_get<I>(terms).bvalue()) + ...);
+  }
+  template <std::size_t... I>
+  A2D_FUNCTION void reverse_(std::index_sequence<I...>) {
+    T v[] = {a2d_get<I>(terms).value()...};
+    T P[nterms];
+    ExclusiveProductCore<T, nterms>(v, P);
+    ((a2d_get<I>(terms).bvalue() += P[I] * bval), ...);
+    (a2d_get<I>(terms).reverse(), ...);
+  }
+  template <std::size_t... I>
+  A2D_FUNCTION void bzero_(std::index_sequence<I...>) {
+    bval = T(0.0);
+    (a2d_get<I>(terms).bzero(), ...);
+  }
+};
+
+template <class T, class... Terms>
+class SumExpr2 : public A2DExpr<SumExpr2<T, Terms...>, T> {
+ public:
+  static constexpr int nterms = sizeof...(Terms);
+  using terms_t = a2d_tuple<Terms...>;
+
+  A2D_FUNCTION SumExpr2(terms_t&& t)
+      : terms(std::move(t)), val(0.0), bval(0.0), pval(0.0), hval(0.0) {}
+  A2D_FUNCTION void eval() { eval_(std::index_sequence_for<Terms...>()); }
+  A2D_FUNCTION void reverse() { reverse_(std::index_sequence_for<Terms...>()); }
+  A2D_FUNCTION void hforward() {
+    hforward_(std::index_sequence_for<Terms...>());
+  }
+  A2D_FUNCTION void hreverse() {
+    hreverse_(std::index_sequence_for<Terms...>());
+  }
+  A2D_FUNCTION void bzero() { bzero_(std::index_sequence_for<Terms...>()); }
+  A2D_FUNCTION void hzero() { hzero_(std::index_sequence_for<Terms...>()); }
+  A2D_FUNCTION T& value() { return val; }
+  A2D_FUNCTION const T& value() const { return val; }
+  A2D_FUNCTION T& bvalue() { return bval; }
+  A2D_FUNCTION const T& bvalue() const { return bval; }
+  A2D_FUNCTION T& pvalue() { return pval; }
+  A2D_FUNCTION const T& pvalue() const { return pval; }
+  A2D_FUNCTION T& hvalue() { return hval; }
+  A2D_FUNCTION const T& hvalue() const { return hval; }
+  A2D_FUNCTION const terms_t& get_terms() const { return terms; }
+
+ private:
+  terms_t terms;
+  T val, bval, pval, hval;
+
+  template <std::size_t... I>
+  A2D_FUNCTION void eval_(std::index_sequence<I...>) {
+    (a2d_get<I>(terms).eval(), ...);
+    val = (a2d_get<I>(terms).value() + ...);
+  }
+  template <std::size_t... I>
+  A2D_FUNCTION void reverse_(std::index_sequence<I...>) {
+    ((a2d_get<I>(terms).bvalue() += bval), ...);
+    (a2d_get<I>(terms).reverse(), ...);
+  }
+  template <std::size_t... I>
+  A2D_FUNCTION void hforward_(std::index_sequence<I...>) {
+    (a2d_get<I>(terms).hforward(), ...);
+    pval = (a2d_get<I>(terms).pvalue() + ...);
+  }
+  template <std::size_t... I>
+  A2D_FUNCTION void hreverse_(std::index_sequence<I...>) {
+    ((a2d_get<I>(terms).hvalue() += hval), ...);
+    (a2d_get<I>(terms).hreverse(), ...);
+  }
+  template <std::size_t... I>
+  A2D_FUNCTION void bzero_(std::index_sequence<I...>) {
+    bval = T(0.0);
+    (a2d_get<I>(terms).bzero(), ...);
+  }
+  template <std::size_t... I>
+  A2D_FUNCTION void hzero_(std::index_sequence<I...>) {
+    hval = T(0.0);
+    (a2d_get<I>(terms).hzero(), ...);
+  }
+};
+
+template <class T, class... Terms>
+class ProdExpr2 : public A2DExpr<ProdExpr2<T, Terms...>, T> {
+ public:
+  static constexpr int nterms = sizeof...(Terms);
+  using terms_t = a2d_tuple<Terms...>;
+
+  A2D_FUNCTION ProdExpr2(terms_t&& t)
+      : terms(std::move(t)), val(0.0), bval(0.0), pval(0.0), hval(0.0) {}
+  A2D_FUNCTION void eval() { eval_(std::index_sequence_for<Terms...>()); }
+  A2D_FUNCTION void reverse() { reverse_(std::index_sequence_for<Terms...>()); }
+  A2D_FUNCTION void hforward() {
+    hforward_(std::index_sequence_for<Terms...>());
+  }
+  A2D_FUNCTION void hreverse() {
+    hreverse_(std::index_sequence_for<Terms...>());
+  }
+  A2D_FUNCTION void bzero() { bzero_(std::index_sequence_for<Terms...>()); }
+  A2D_FUNCTION void hzero() { hzero_(std::index_sequence_for<Terms...>()); }
+  A2D_FUNCTION T& value() { return val; }
+  A2D_FUNCTION const T& value() const { return val; }
+  A2D_FUNCTION T& bvalue() { return bval; }
+  A2D_FUNCTION const T& bvalue() const { return bval; }
+  A2D_FUNCTION T& pvalue() { return pval; }
+  A2D_FUNCTION const T& pvalue() const { return pval; }
+  A2D_FUNCTION T& hvalue() { return hval; }
+  A2D_FUNCTION const T& hvalue() const { return hval; }
+  A2D_FUNCTION const terms_t& get_terms() const { return terms; }
+
+ private:
+  terms_t terms;
+  T val, bval, pval, hval;
+
+  template <std::size_t... I>
+  A2D_FUNCTION void eval_(std::index_sequence<I...>) {
+    (a2d_get<I>(terms).eval(), ...);
+    val = (a2d_get<I>(terms).value() * ...);
+  }
+  template <std::size_t... I>
+  A2D_FUNCTION void reverse_(std::index_sequence<I...>) {
+    T v[] = {a2d_get<I>(terms).value()...};
+    T P[nterms];
+    ExclusiveProductCore<T, nterms>(v, P);
+    ((a2d_get<I>(terms).bvalue() += P[I] * bval), ...);
+    (a2d_get<I>(terms).reverse(), ...);
+  }
+  template <std::size_t... I>
+  A2D_FUNCTION void hforward_(std::index_sequence<I...>) {
+    (a2d_get<I>(terms).hforward(), ...);
+    T v[] = {a2d_get<I>(terms).value()...};
+    T P[nterms];
+    ExclusiveProductCore<T, nterms>(v, P);
+    pval = ((P[I] * a2d_get<I>(terms).pvalue()) + ...);
+  }
+  template <std::size_t... I>
+  A2D_FUNCTION void hreverse_(std::index_sequence<I...>) {
+    T v[] = {a2d_get<I>(terms).value()...};
+    T p[] = {a2d_get<I>(terms).pvalue()...};
+    T P[nterms], dP[nterms];
+    ExclusiveProductCore<T, nterms>(v, p, P, dP);
+    ((a2d_get<I>(terms).hvalue() += P[I] * hval + dP[I] * bval), ...);
+    (a2d_get<I>(terms).hreverse(), ...);
+  }
+  template <std::size_t... I>
+  A2D_FUNCTION void bzero_(std::index_sequence<I...>) {
+    bval = T(0.0);
+    (a2d_get<I>(terms).bzero(), ...);
+  }
+  template <std::size_t... I>
+  A2D_FUNCTION void hzero_(std::index_sequence<I...>) {
+    hval = T(0.0);
+    (a2d_get<I>(terms).hzero(), ...);
+  }
+};
+
+/*
+  Operators that form the flattened n-ary expressions
+
+  OBJNAME: The n-ary expression template name
+  OPERNAME: Name of the operator
+  EXPRNAME: The expression base class, ADExpr or A2DExpr
+  TERMSNAME: Name of the function that returns the tuple of terms
+*/
+#define A2D_NARY_OPERATOR(OBJNAME, OPERNAME, EXPRNAME, TERMSNAME)            \
+                                                                             \
+  template <class A>                                                         \
+  A2D_FUNCTION auto TERMSNAME(const A& a) {                                  \
+    return a2d_tuple<A>(a2d_term<A>(a));                                     \
+  }                                                                          \
+  template <class A>                                                         \
+  A2D_FUNCTION auto TERMSNAME(A& a) {                                        \
+    return a2d_tuple<A&>(a2d_term<A&>(a));                                   \
+  }                                                                          \
+  template <class T, class... S>                                             \
+  A2D_FUNCTION const auto& TERMSNAME(const OBJNAME<T, S...>& a) {            \
+    return a.get_terms();                                                    \
+  }                                                                          \
+  template <class T, class... S>                                             \
+  A2D_FUNCTION const auto& TERMSNAME(OBJNAME<T, S...>& a) {                  \
+    return a.get_terms();                                                    \
+  }                                                                          \
+  template <class A, class Ta, class B, class Tb,                            \
+            std::enable_if_t<is_same_type<Ta, Tb>::value, bool> = true>      \
+  A2D_FUNCTION inline auto OPERNAME(const EXPRNAME<A, Ta>& a,                \
+                                    const EXPRNAME<B, Tb>& b) {              \
+    using T = typename remove_const_and_refs<Tb>::type;                      \
+    return ExprTermsConcat<OBJNAME, T>(TERMSNAME(a.self()),                  \
+                                       TERMSNAME(b.self()));                 \
+  }                                                                          \
+  template <class A, class Ta, class B, class Tb,                            \
+            std::enable_if_t<is_same_type<Ta, Tb>::value, bool> = true>      \
+  A2D_FUNCTION inline auto OPERNAME(const EXPRNAME<A, Ta>& a,                \
+                                    EXPRNAME<B, Tb>& b) {                    \
+    using T = typename remove_const_and_refs<Tb>::type;                      \
+    return ExprTermsConcat<OBJNAME, T>(TERMSNAME(a.self()),                  \
+                                       TERMSNAME(b.self()));                 \
+  }                                                                          \
+  template <class A, class Ta, class B, class Tb,                            \
+            std::enable_if_t<is_same_type<Ta, Tb>::value, bool> = true>      \
+  A2D_FUNCTION inline auto OPERNAME(EXPRNAME<A, Ta>& a,                      \
+                                    const EXPRNAME<B, Tb>& b) {              \
+    using T = typename remove_const_and_refs<Tb>::type;                      \
+    return ExprTermsConcat<OBJNAME, T>(TERMSNAME(a.self()),                  \
+                                       TERMSNAME(b.self()));                 \
+  }                                                                          \
+  template <class A, class Ta, class B, class Tb,                            \
+            std::enable_if_t<is_same_type<Ta, Tb>::value, bool> = true>      \
+  A2D_FUNCTION inline auto OPERNAME(EXPRNAME<A, Ta>& a, EXPRNAME<B, Tb>& b) { \
+    using T = typename remove_const_and_refs<Tb>::type;                      \
+    return ExprTermsConcat<OBJNAME, T>(TERMSNAME(a.self()),                  \
+                                       TERMSNAME(b.self()));                 \
+  }
+
+// A2D_NARY_OPERATOR(OBJNAME, OPERNAME, EXPRNAME, TERMSNAME)
+A2D_NARY_OPERATOR(SumExpr, operator+, ADExpr, SumExprTerms)
+A2D_NARY_OPERATOR(ProdExpr, operator*, ADExpr, ProdExprTerms)
+A2D_NARY_OPERATOR(SumExpr2, operator+, A2DExpr, SumExpr2Terms)
+A2D_NARY_OPERATOR(ProdExpr2, operator*, A2DExpr, ProdExpr2Terms)
 
 #define A2D_2ND_BINARY(OBJNAME, OPERNAME, FUNCBODY, TEMPBODY, AREVBODY,      \
                        BREVBODY, HFORWARDBODY, HAREVBODY, HBREVBODY)         \
@@ -402,22 +873,160 @@ A2D_2ND_BINARY(Divide2, operator/, a.value() / b.value(), T(1.0) / b.value(),
                tmp* bval, -tmp* tmp* a.value() * bval,
                tmp*(a.pvalue() - tmp * a.value() * b.pvalue()),
                tmp*(hval - tmp * bval * b.pvalue()),
-               tmp* tmp * (2.0 * tmp * a.value() * bval * b.pvalue() -
+               tmp* tmp * (T(2.0) * tmp * a.value() * bval * b.pvalue() -
                            a.value() * hval - bval * a.pvalue()))
 A2D_2ND_BINARY(Max2, max2,
                (RealPart(a.value()) > RealPart(b.value()) ? a.value()
                                                           : b.value()),
                (RealPart(a.value()) > RealPart(b.value()) ? T(1.0) : T(0.0)),
-               tmp* bval, (1.0 - tmp) * bval,
-               tmp* a.bvalue() + (1.0 - tmp) * b.value(), tmp* hval,
-               (1.0 - tmp) * hval)
+               tmp* bval, (T(1.0) - tmp) * bval,
+               tmp* a.bvalue() + (T(1.0) - tmp) * b.value(), tmp* hval,
+               (T(1.0) - tmp) * hval)
 A2D_2ND_BINARY(Min2, min2,
                (RealPart(a.value()) < RealPart(b.value()) ? a.value()
                                                           : b.value()),
                (RealPart(a.value()) < RealPart(b.value()) ? T(1.0) : T(0.0)),
-               tmp* bval, (1.0 - tmp) * bval,
-               tmp* a.bvalue() + (1.0 - tmp) * b.value(), tmp* hval,
-               (1.0 - tmp) * hval)
+               tmp* bval, (T(1.0) - tmp) * bval,
+               tmp* a.bvalue() + (T(1.0) - tmp) * b.value(), tmp* hval,
+               (T(1.0) - tmp) * hval)
+A2D_2ND_BINARY(PowABExpr2, pow, pow(a.value(), b.value()), log(a.value()),
+               b.value() * val / a.value() * bval, val* tmp* bval,
+               val*(b.value() * a.pvalue() / a.value() + tmp * b.pvalue()),
+               b.value() * val / a.value() * hval +
+                   bval * val / a.value() *
+                       ((b.value() - T(1.0)) * b.value() / a.value() *
+                            a.pvalue() +
+                        (T(1.0) + b.value() * tmp) * b.pvalue()),
+               val* tmp* hval +
+                   bval * val *
+                       ((T(1.0) + b.value() * tmp) / a.value() * a.pvalue() +
+                        tmp * tmp * b.pvalue()))
+A2D_2ND_BINARY(Atan2Expr2, atan2, atan2(a.value(), b.value()),
+               T(1.0) / (a.value() * a.value() + b.value() * b.value()),
+               tmp* b.value() * bval, -tmp* a.value() * bval,
+               tmp*(b.value() * a.pvalue() - a.value() * b.pvalue()),
+               tmp* b.value() * hval +
+                   bval * tmp * tmp *
+                       ((a.value() * a.value() - b.value() * b.value()) *
+                            b.pvalue() -
+                        T(2.0) * a.value() * b.value() * a.pvalue()),
+               -tmp* a.value() * hval +
+                   bval * tmp * tmp *
+                       ((a.value() * a.value() - b.value() * b.value()) *
+                            a.pvalue() +
+                        T(2.0) * a.value() * b.value() * b.pvalue()))
+A2D_2ND_BINARY(HypotExpr2, hypot, hypot(a.value(), b.value()), T(1.0) / val,
+               tmp* a.value() * bval, tmp* b.value() * bval,
+               tmp*(a.value() * a.pvalue() + b.value() * b.pvalue()),
+               tmp* a.value() * hval +
+                   bval * tmp * tmp * tmp * b.value() *
+                       (b.value() * a.pvalue() - a.value() * b.pvalue()),
+               tmp* b.value() * hval +
+                   bval * tmp * tmp * tmp * a.value() *
+                       (a.value() * b.pvalue() - b.value() * a.pvalue()))
+
+template <class A, class Ta, class B, class Tb, class R, class T, bool CA,
+          bool CB>
+class KSMax2 : public A2DExpr<KSMax2<A, Ta, B, Tb, R, T, CA, CB>, T> {
+ public:
+  using Aexpr_t =
+      typename std::conditional<CA, const A2DExpr<A, Ta>, A2DExpr<A, Ta>>::type;
+  using Bexpr_t =
+      typename std::conditional<CB, const A2DExpr<B, Tb>, A2DExpr<B, Tb>>::type;
+  using A_t = typename std::conditional<CA, A, A&>::type;
+  using B_t = typename std::conditional<CB, B, B&>::type;
+
+  A2D_FUNCTION KSMax2(Aexpr_t& a0, Bexpr_t& b0, const R rho)
+      : a(a0.self()),
+        b(b0.self()),
+        rho(rho),
+        tmp(0.0),
+        val(0.0),
+        bval(0.0),
+        pval(0.0),
+        hval(0.0) {}
+  A2D_FUNCTION void eval() {
+    a.eval();
+    b.eval();
+    val = ksmax2(a.value(), b.value(), rho);
+    tmp = exp(rho * (a.value() - val));
+  }
+  A2D_FUNCTION void reverse() {
+    a.bvalue() += tmp * bval;
+    b.bvalue() += (T(1.0) - tmp) * bval;
+    a.reverse();
+    b.reverse();
+  }
+  A2D_FUNCTION void hforward() {
+    a.hforward();
+    b.hforward();
+    pval = tmp * a.pvalue() + (T(1.0) - tmp) * b.pvalue();
+  }
+  A2D_FUNCTION void hreverse() {
+    T h = rho * tmp * (T(1.0) - tmp) * bval * (a.pvalue() - b.pvalue());
+    a.hvalue() += tmp * hval + h;
+    b.hvalue() += (T(1.0) - tmp) * hval - h;
+    a.hreverse();
+    b.hreverse();
+  }
+  A2D_FUNCTION void bzero() {
+    bval = T(0.0);
+    a.bzero();
+    b.bzero();
+  }
+  A2D_FUNCTION void hzero() {
+    hval = T(0.0);
+    a.hzero();
+    b.hzero();
+  }
+  A2D_FUNCTION T& value() { return val; }
+  A2D_FUNCTION const T& value() const { return val; }
+  A2D_FUNCTION T& bvalue() { return bval; }
+  A2D_FUNCTION const T& bvalue() const { return bval; }
+  A2D_FUNCTION T& pvalue() { return pval; }
+  A2D_FUNCTION const T& pvalue() const { return pval; }
+  A2D_FUNCTION T& hvalue() { return hval; }
+  A2D_FUNCTION const T& hvalue() const { return hval; }
+
+ private:
+  A_t a;
+  B_t b;
+  const T rho;
+  T tmp, val, bval, pval, hval;
+};
+
+template <class A, class Ta, class B, class Tb, class R,
+          std::enable_if_t<is_same_type<Ta, Tb>::value, bool> = true,
+          std::enable_if_t<is_scalar_type<R>::value, bool> = true>
+A2D_FUNCTION inline auto ksmax2(const A2DExpr<A, Ta>& a,
+                                const A2DExpr<B, Tb>& b, const R rho) {
+  using T = typename remove_const_and_refs<Tb>::type;
+  return KSMax2<A, Ta, B, Tb, R, T, true, true>(a, b, rho);
+}
+template <class A, class Ta, class B, class Tb, class R,
+          std::enable_if_t<is_same_type<Ta, Tb>::value, bool> = true,
+          std::enable_if_t<is_scalar_type<R>::value, bool> = true>
+A2D_FUNCTION inline auto ksmax2(const A2DExpr<A, Ta>& a, A2DExpr<B, Tb>& b,
+                                const R rho) {
+  using T = typename remove_const_and_refs<Tb>::type;
+  return KSMax2<A, Ta, B, Tb, R, T, true, false>(a, b, rho);
+}
+template <class A, class Ta, class B, class Tb, class R,
+          std::enable_if_t<is_same_type<Ta, Tb>::value, bool> = true,
+          std::enable_if_t<is_scalar_type<R>::value, bool> = true>
+A2D_FUNCTION inline auto ksmax2(A2DExpr<A, Ta>& a, const A2DExpr<B, Tb>& b,
+                                const R rho) {
+  using T = typename remove_const_and_refs<Tb>::type;
+  return KSMax2<A, Ta, B, Tb, R, T, false, true>(a, b, rho);
+}
+template <class A, class Ta, class B, class Tb, class R,
+          std::enable_if_t<is_same_type<Ta, Tb>::value, bool> = true,
+          std::enable_if_t<is_scalar_type<R>::value, bool> = true>
+A2D_FUNCTION inline auto ksmax2(A2DExpr<A, Ta>& a, A2DExpr<B, Tb>& b,
+                                const R rho) {
+  using T = typename remove_const_and_refs<Tb>::type;
+  return KSMax2<A, Ta, B, Tb, R, T, false, false>(a, b, rho);
+}
 
 /*
   Definitions for memory-less forward and reverse-mode first-order AD
@@ -462,7 +1071,7 @@ A2D_2ND_BINARY(Min2, min2,
                                                                         \
    private:                                                             \
     A_t a;                                                              \
-    const B b;                                                          \
+    const T b;                                                          \
     T val, bval;                                                        \
   };                                                                    \
   template <class A, class Ta, class B,                                 \
@@ -486,8 +1095,8 @@ A2D_1ST_BINARY_LEFT_BASIC(LMultExpr, operator*, a.value() * b, a.bvalue() * b,
 A2D_1ST_BINARY_LEFT_BASIC(LDivide, operator/, a.value() / b, a.bvalue() / b,
                           bval / b)
 A2D_1ST_BINARY_LEFT_BASIC(PowExpr, pow, pow(a.value(), b),
-                          a.bvalue() * b * pow(a.value(), b - 1.0),
-                          b* pow(a.value(), b - 1.0) * bval)
+                          a.bvalue() * b * pow(a.value(), b - T(1.0)),
+                          b* pow(a.value(), b - T(1.0)) * bval)
 
 /*
   Definitions for memory-less forward and reverse-mode first-order AD
@@ -545,7 +1154,7 @@ A2D_1ST_BINARY_LEFT_BASIC(PowExpr, pow, pow(a.value(), b),
                                                                            \
    private:                                                                \
     A_t a;                                                                 \
-    const B b;                                                             \
+    const T b;                                                             \
     T val, bval, pval, hval;                                               \
   };                                                                       \
   template <class A, class Ta, class B,                                    \
@@ -572,11 +1181,11 @@ A2D_2ND_BINARY_LEFT_BASIC(LMultExpr2, operator*, a.value() * b, b* bval,
 A2D_2ND_BINARY_LEFT_BASIC(LDivide2, operator/, a.value() / b, bval / b,
                           a.pvalue() / b, hval / b)
 A2D_2ND_BINARY_LEFT_BASIC(PowExpr2, pow, pow(a.value(), b),
-                          bval* b* pow(a.value(), b - 1.0),
-                          a.pvalue() * b * pow(a.value(), b - 1.0),
-                          hval* b* pow(a.value(), b - 1.0) +
-                              bval * a.pvalue() * b * (b - 1.0) *
-                                  pow(a.value(), b - 2.0));
+                          bval* b* pow(a.value(), b - T(1.0)),
+                          a.pvalue() * b * pow(a.value(), b - T(1.0)),
+                          hval* b* pow(a.value(), b - T(1.0)) +
+                              bval * a.pvalue() * b * (b - T(1.0)) *
+                                  pow(a.value(), b - T(2.0)));
 
 /*
   Definitions for memory-less forward and reverse-mode first-order AD
@@ -620,7 +1229,7 @@ A2D_2ND_BINARY_LEFT_BASIC(PowExpr2, pow, pow(a.value(), b),
     A2D_FUNCTION const T& bvalue() const { return bval; }                \
                                                                          \
    private:                                                              \
-    const A a;                                                           \
+    const T a;                                                           \
     B_t b;                                                               \
     T val, bval;                                                         \
   };                                                                     \
@@ -646,6 +1255,73 @@ A2D_1ST_BINARY_RIGHT_BASIC(RDivide, operator/, a / b.value(),
 A2D_1ST_BINARY_RIGHT_BASIC(RMultExpr, operator*, a* b.value(), a* b.bvalue(),
                            a* bval)
 
+/*
+  Definitions for first-order AD with a scalar on the left and a term that
+  depends only on the scalar, computed once when the expression is created
+
+  OBJNAME: Expression template name
+  OPERNAME: Name of the operator
+  TEMPBODY: Body of the term stored in tmp
+  FUNCBODY: Body of the function evaluation
+  FORWARD: Body of the forward derivative
+  REVERSE: Body of the reverse derivative
+*/
+#define A2D_1ST_BINARY_RIGHT(OBJNAME, OPERNAME, TEMPBODY, FUNCBODY, FORWARD, \
+                             REVERSE)                                        \
+                                                                             \
+  template <class A, class B, class Tb, class T, bool CB>                    \
+  class OBJNAME : public ADExpr<OBJNAME<A, B, Tb, T, CB>, T> {               \
+   public:                                                                   \
+    using expr_t = typename std::conditional<CB, const ADExpr<B, Tb>,        \
+                                             ADExpr<B, Tb>>::type;           \
+    using B_t = typename std::conditional<CB, B, B&>::type;                  \
+    A2D_FUNCTION OBJNAME(const A& a0, expr_t& b0)                            \
+        : a(a0), b(b0.self()), tmp(TEMPBODY), val(0.0), bval(0.0) {}         \
+    A2D_FUNCTION void eval() {                                               \
+      b.eval();                                                              \
+      val = (FUNCBODY);                                                      \
+    }                                                                        \
+    A2D_FUNCTION void forward() {                                            \
+      b.forward();                                                           \
+      bval = (FORWARD);                                                      \
+    }                                                                        \
+    A2D_FUNCTION void reverse() {                                            \
+      b.bvalue() += (REVERSE);                                               \
+      b.reverse();                                                           \
+    }                                                                        \
+    A2D_FUNCTION void bzero() {                                              \
+      bval = T(0.0);                                                         \
+      b.bzero();                                                             \
+    }                                                                        \
+    A2D_FUNCTION T& value() { return val; }                                  \
+    A2D_FUNCTION const T& value() const { return val; }                      \
+    A2D_FUNCTION T& bvalue() { return bval; }                                \
+    A2D_FUNCTION const T& bvalue() const { return bval; }                    \
+                                                                             \
+   private:                                                                  \
+    const T a;                                                               \
+    B_t b;                                                                   \
+    const T tmp;                                                             \
+    T val, bval;                                                             \
+  };                                                                         \
+  template <class A, class B, class Tb,                                      \
+            std::enable_if_t<is_scalar_type<A>::value, bool> = true>         \
+  A2D_FUNCTION auto OPERNAME(const A& a, const ADExpr<B, Tb>& b) {           \
+    using T = typename remove_const_and_refs<Tb>::type;                      \
+    return OBJNAME<A, B, Tb, T, true>(a, b);                                 \
+  }                                                                          \
+  template <class A, class B, class Tb,                                      \
+            std::enable_if_t<is_scalar_type<A>::value, bool> = true>         \
+  A2D_FUNCTION auto OPERNAME(const A& a, ADExpr<B, Tb>& b) {                 \
+    using T = typename remove_const_and_refs<Tb>::type;                      \
+    return OBJNAME<A, B, Tb, T, false>(a, b);                                \
+  }
+
+// A2D_1ST_BINARY_RIGHT(OBJNAME, OPERNAME, TEMPBODY, FUNCBODY, FORWARD,
+//                      REVERSE)
+A2D_1ST_BINARY_RIGHT(RPowExpr, pow, log(a), exp(tmp * b.value()),
+                     tmp* val* b.bvalue(), tmp* val* bval)
+
 /*
   Definitions for memory-less forward and reverse-mode first-order AD
 
@@ -700,7 +1376,7 @@ A2D_1ST_BINARY_RIGHT_BASIC(RMultExpr, operator*, a* b.value(), a* b.bvalue(),
     A2D_FUNCTION const T& hvalue() const { return hval; }                  \
                                                                            \
    private:                                                                \
-    const A a;                                                             \
+    const T a;                                                             \
     B_t b;                                                                 \
     T val, bval, pval, hval;                                               \
   };                                                                       \
@@ -728,9 +1404,96 @@ A2D_2ND_BINARY_RIGHT_BASIC(RMultExpr2, operator*, a* b.value(), a* bval,
 A2D_2ND_BINARY_RIGHT_BASIC(RDivide2, operator/, a / b.value(),
                            -bval* val / b.value(), -val* b.pvalue() / b.value(),
                            -hval* val / b.value() +
-                               2.0 * val / (b.value() * b.value()) * bval *
+                               T(2.0) * val / (b.value() * b.value()) * bval *
                                    b.pvalue())
 
+/*
+  Definitions for second-order AD with a scalar on the left and a term that
+  depends only on the scalar, computed once when the expression is created
+
+  OBJNAME: Expression template name
+  OPERNAME: Name of the operator
+  TEMPBODY: Body of the term stored in tmp
+  FUNCBODY: Body of the function evaluation
+  REVERSE: Body of the reverse derivative
+  HFORWARD: Body of the second-order forward derivative
+  HREVERSE: Body of the second-order reverse derivative
+*/
+#define A2D_2ND_BINARY_RIGHT(OBJNAME, OPERNAME, TEMPBODY, FUNCBODY, REVERSE, \
+                             HFORWARD, HREVERSE)                             \
+                                                                             \
+  template <class A, class B, class Tb, class T, bool CB>                    \
+  class OBJNAME : public A2DExpr<OBJNAME<A, B, Tb, T, CB>, T> {              \
+   public:                                                                   \
+    using expr_t = typename std::conditional<CB, const A2DExpr<B, Tb>,       \
+                                             A2DExpr<B, Tb>>::type;          \
+    using B_t = typename std::conditional<CB, B, B&>::type;                  \
+    A2D_FUNCTION OBJNAME(const A& a0, expr_t& b0)                            \
+        : a(a0),                                                             \
+          b(b0.self()),                                                      \
+          tmp(TEMPBODY),                                                     \
+          val(0.0),                                                          \
+          bval(0.0),                                                         \
+          pval(0.0),                                                         \
+          hval(0.0) {}                                                       \
+    A2D_FUNCTION void eval() {                                               \
+      b.eval();                                                              \
+      val = (FUNCBODY);                                                      \
+    }                                                                        \
+    A2D_FUNCTION void reverse() {                                            \
+      b.bvalue() += (REVERSE);                                               \
+      b.reverse();                                                           \
+    }                                                                        \
+    A2D_FUNCTION void hforward() {                                           \
+      b.hforward();                                                          \
+      pval = (HFORWARD);                                                     \
+    }                                                                        \
+    A2D_FUNCTION void hreverse() {                                           \
+      b.hvalue() += (HREVERSE);                                              \
+      b.hreverse();                                                          \
+    }                                                                        \
+    A2D_FUNCTION void bzero() {                                              \
+      bval = T(0.0);                                                         \
+      b.bzero();                                                             \
+    }                                                                        \
+    A2D_FUNCTION void hzero() {                                              \
+      hval = T(0.0);                                                         \
+      b.hzero();                                                             \
+    }                                                                        \
+    A2D_FUNCTION T& value() { return val; }                                  \
+    A2D_FUNCTION const T& value() const { return val; }                      \
+    A2D_FUNCTION T& bvalue() { return bval; }                                \
+    A2D_FUNCTION const T& bvalue() const { return bval; }                    \
+    A2D_FUNCTION T& pvalue() { return pval; }                                \
+    A2D_FUNCTION const T& pvalue() const { return pval; }                    \
+    A2D_FUNCTION T& hvalue() { return hval; }                                \
+    A2D_FUNCTION const T& hvalue() const { return hval; }                    \
+                                                                             \
+   private:                                                                  \
+    const T a;                                                               \
+    B_t b;                                                                   \
+    const T tmp;                                                             \
+    T val, bval, pval, hval;                                                 \
+  };                                                                         \
+  template <class A, class B, class Tb,                                      \
+            std::enable_if_t<is_scalar_type<A>::value, bool> = true>         \
+  A2D_FUNCTION auto OPERNAME(const A& a, const A2DExpr<B, Tb>& b) {          \
+    using T = typename remove_const_and_refs<Tb>::type;                      \
+    return OBJNAME<A, B, Tb, T, true>(a, b);                                 \
+  }                                                                          \
+  template <class A, class B, class Tb,                                      \
+            std::enable_if_t<is_scalar_type<A>::value, bool> = true>         \
+  A2D_FUNCTION auto OPERNAME(const A& a, A2DExpr<B, Tb>& b) {                \
+    using T = typename remove_const_and_refs<Tb>::type;                      \
+    return OBJNAME<A, B, Tb, T, false>(a, b);                                \
+  }
+
+// A2D_2ND_BINARY_RIGHT(OBJNAME, OPERNAME, TEMPBODY, FUNCBODY, REVERSE,
+//                      HFORWARD, HREVERSE)
+A2D_2ND_BINARY_RIGHT(RPowExpr2, pow, log(a), exp(tmp * b.value()),
+                     tmp* val* bval, tmp* val* b.pvalue(),
+                     tmp* val*(hval + tmp * bval * b.pvalue()))
+
 }  // namespace A2D
 
 #endif  // A2D_BINARY_OPS_H
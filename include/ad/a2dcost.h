@@ -0,0 +1,160 @@
+#ifndef A2D_COST_H
+#define A2D_COST_H
+
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#include "../a2ddefs.h"
+
+namespace A2D {
+
+/*
+  Compile-time operation counts for a single phase of an operation
+
+  The flops are counted in arithmetic on the numeric type, so that an add or
+  a multiply of two complex numbers counts as one operation. The bytes are
+  the entries read and written by the kernels as they are called, where an
+  accumulation into an array counts as both a read and a write. Temporaries
+  are not counted.
+*/
+struct ADPhaseCost {
+  index_t flops;
+  index_t bytes;
+
+  constexpr ADPhaseCost() : flops(0), bytes(0) {}
+  constexpr ADPhaseCost(index_t flops, index_t bytes)
+      : flops(flops), bytes(bytes) {}
+
+  constexpr ADPhaseCost operator+(const ADPhaseCost& c) const {
+    return ADPhaseCost(flops + c.flops, bytes + c.bytes);
+  }
+
+  // Flops per byte of memory traffic
+  constexpr double intensity() const {
+    return bytes > 0 ? double(flops) / double(bytes) : 0.0;
+  }
+};
+
+constexpr ADPhaseCost operator*(index_t n, const ADPhaseCost& c) {
+  return ADPhaseCost(n * c.flops, n * c.bytes);
+}
+
+/*
+  Cost of a kernel that performs the given number of flops and reads and
+  writes the given number of entries of type T
+*/
+template <typename T>
+constexpr ADPhaseCost KernelCost(index_t flops, index_t reads, index_t writes) {
+  return ADPhaseCost(flops, index_t(sizeof(T)) * (reads + writes));
+}
+
+/*
+  Operation counts for each of the phases of an operation in an
+  OperationStack. The hforward phase is the second-order forward pass.
+*/
+struct ADCost {
+  const char* name;
+  ADPhaseCost eval, forward, reverse, hforward, hreverse;
+
+  // Number of operations without counts that are missing from the totals
+  index_t unknown;
+
+  constexpr ADCost(const char* name = "unknown", index_t unknown = 0)
+      : name(name),
+        eval(),
+        forward(),
+        reverse(),
+        hforward(),
+        hreverse(),
+        unknown(unknown) {}
+
+  constexpr ADCost operator+(const ADCost& c) const {
+    ADCost sum("total", unknown + c.unknown);
+    sum.eval = eval + c.eval;
+    sum.forward = forward + c.forward;
+    sum.reverse = reverse + c.reverse;
+    sum.hforward = hforward + c.hforward;
+    sum.hreverse = hreverse + c.hreverse;
+    return sum;
+  }
+
+  // Cost of the Hessian-vector product performed by OperationStack::hproduct
+  constexpr ADPhaseCost hproduct() const {
+    return reverse + hforward + hreverse;
+  }
+
+  // True when every operation contributed its counts
+  constexpr bool complete() const { return unknown == 0; }
+};
+
+/*
+  Operations report their costs with a static constexpr member function
+  cost(). Operations without one contribute nothing to the totals, are
+  reported as unknown and are counted in ADCost::unknown.
+*/
+template <class Op, class = void>
+struct has_ad_cost : std::false_type {};
+
+template <class Op>
+struct has_ad_cost<Op, std::void_t<decltype(Op::cost())>> : std::true_type {};
+
+template <class Op>
+constexpr ADCost get_ad_cost() {
+  using OpType = std::remove_cv_t<std::remove_reference_t<Op>>;
+  if constexpr (has_ad_cost<OpType>::value) {
+    return OpType::cost();
+  } else {
+    return ADCost("unknown", 1);
+  }
+}
+
+/*
+  Write a table of the operation costs to the stream, one line per operation
+  followed by the totals. Each entry is the flop count and the bytes moved.
+*/
+template <class... Operations>
+void WriteCostTable(std::ostream& out) {
+  constexpr ADCost costs[] = {get_ad_cost<Operations>()...};
+
+  auto entry = [](const ADPhaseCost& c) {
+    std::stringstream s;
+    s << c.flops << "/" << c.bytes;
+    return s.str();
+  };
+  auto line = [&](const std::string& label, const ADCost& c) {
+    out << std::left << std::setw(24) << label << std::right << std::setw(12)
+        << entry(c.eval) << std::setw(12) << entry(c.forward) << std::setw(12)
+        << entry(c.reverse) << std::setw(12) << entry(c.hforward)
+        << std::setw(12) << entry(c.hreverse) << std::endl;
+  };
+
+  out << std::left << std::setw(24) << "operation (flops/bytes)" << std::right
+      << std::setw(12) << "eval" << std::setw(12) << "forward"
+      << std::setw(12) << "reverse" << std::setw(12) << "hforward"
+      << std::setw(12) << "hreverse" << std::endl;
+
+  ADCost total("total");
+  for (index_t i = 0; i < sizeof...(Operations); i++) {
+    std::stringstream label;
+    label << i << ": " << costs[i].name;
+    line(label.str(), costs[i]);
+    total = total + costs[i];
+  }
+  line("total", total);
+  if (!total.complete()) {
+    out << "total excludes " << total.unknown << " ops unknown" << std::endl;
+  }
+
+  ADPhaseCost h = total.hproduct();
+  std::stringstream intensity;
+  intensity << std::setprecision(3) << h.intensity();
+  out << "hproduct: " << h.flops << " flops, " << h.bytes
+      << " bytes, intensity " << intensity.str() << " flops/byte" << std::endl;
+}
+
+}  // namespace A2D
+
+#endif  // A2D_COST_H
@@ -7,7 +7,9 @@
 #include "a2dmat.h"
 #include "a2dstack.h"
 #include "a2dtest.h"
+#include "core/a2ddiagmatcore.h"
 #include "core/a2dgemmcore.h"
+#include "core/a2dskewmatcore.h"
 
 namespace A2D {
 
@@ -49,19 +51,62 @@ namespace A2D {
 */
 
 // compute C = op(A) * op(B) and returns nothing, where A and B are all
-// passive variables
-template <typename T, int N, int M, int K, int L, int P, int Q>
-A2D_FUNCTION void MatMatMult(const Mat<T, N, M>& A, const Mat<T, K, L>& B,
-                             Mat<T, P, Q>& C) {
-  MatMatMultCore<T, N, M, K, L, P, Q, MatOp::NORMAL, MatOp::NORMAL>(
-      get_data(A), get_data(B), get_data(C));
+// passive variables stored in any layout
+template <typename T, int N, int M, int K, int L, int P, int Q,
+          MatLayout layoutA, MatLayout layoutB, MatLayout layoutC>
+A2D_FUNCTION void MatMatMult(const Mat<T, N, M, layoutA>& A,
+                             const Mat<T, K, L, layoutB>& B,
+                             Mat<T, P, Q, layoutC>& C) {
+  MatMatMultLayoutCore<T, N, M, K, L, P, Q, MatOp::NORMAL, MatOp::NORMAL,
+                       layoutA, layoutB, layoutC>(get_data(A), get_data(B),
+                                                  get_data(C));
 }
 template <MatOp opA, MatOp opB, typename T, int N, int M, int K, int L, int P,
-          int Q>
-A2D_FUNCTION void MatMatMult(const Mat<T, N, M>& A, const Mat<T, K, L>& B,
-                             Mat<T, P, Q>& C) {
-  MatMatMultCore<T, N, M, K, L, P, Q, opA, opB>(get_data(A), get_data(B),
-                                                get_data(C));
+          int Q, MatLayout layoutA, MatLayout layoutB, MatLayout layoutC>
+A2D_FUNCTION void MatMatMult(const Mat<T, N, M, layoutA>& A,
+                             const Mat<T, K, L, layoutB>& B,
+                             Mat<T, P, Q, layoutC>& C) {
+  MatMatMultLayoutCore<T, N, M, K, L, P, Q, opA, opB, layoutA, layoutB,
+                       layoutC>(get_data(A), get_data(B), get_data(C));
+}
+
+// compute C = op(S) * B or C = A * op(S) where S is a skew-symmetric matrix
+template <typename T, int N, int L>
+A2D_FUNCTION void MatMatMult(const SkewMat<T, N>& S, const Mat<T, N, L>& B,
+                             Mat<T, N, L>& C) {
+  SkewMatMatMultCore<T, L>(get_data(S), get_data(B), get_data(C));
+}
+template <typename T, int M, int N>
+A2D_FUNCTION void MatMatMult(const Mat<T, M, N>& A, const SkewMat<T, N>& S,
+                             Mat<T, M, N>& C) {
+  MatSkewMatMultCore<T, M>(get_data(A), get_data(S), get_data(C));
+}
+
+template <MatOp opS, MatOp opB, typename T, int N, int L>
+A2D_FUNCTION void MatMatMult(const SkewMat<T, N>& S, const Mat<T, N, L>& B,
+                             Mat<T, N, L>& C) {
+  static_assert(opB == MatOp::NORMAL,
+                "The matrix multiplied by a SkewMat cannot be transposed");
+  SkewMatMatMultCore<T, L, opS>(get_data(S), get_data(B), get_data(C));
+}
+template <MatOp opA, MatOp opS, typename T, int M, int N>
+A2D_FUNCTION void MatMatMult(const Mat<T, M, N>& A, const SkewMat<T, N>& S,
+                             Mat<T, M, N>& C) {
+  static_assert(opA == MatOp::NORMAL,
+                "The matrix multiplied by a SkewMat cannot be transposed");
+  MatSkewMatMultCore<T, M, opS>(get_data(A), get_data(S), get_data(C));
+}
+
+// compute C = D * B or C = A * D where D is a diagonal matrix
+template <typename T, int N, int L>
+A2D_FUNCTION void MatMatMult(const DiagMat<T, N>& D, const Mat<T, N, L>& B,
+                             Mat<T, N, L>& C) {
+  DiagMatMatMultCore<T, N, L>(get_data(D), get_data(B), get_data(C));
+}
+template <typename T, int M, int N>
+A2D_FUNCTION void MatMatMult(const Mat<T, M, N>& A, const DiagMat<T, N>& D,
+                             Mat<T, M, N>& C) {
+  MatDiagMatMultCore<T, M, N>(get_data(A), get_data(D), get_data(C));
 }
 
 // Note: we probably don't want these unless they're really inevitable, because
@@ -88,12 +133,17 @@ class MatMatMultExpr {
   typedef typename get_object_numeric_type<Ctype>::type T;
 
   // Extract the dimensions of the matrices
-  static constexpr int N = get_matrix_rows<Atype>::size;
-  static constexpr int M = get_matrix_columns<Atype>::size;
-  static constexpr int K = get_matrix_rows<Btype>::size;
-  static constexpr int L = get_matrix_columns<Btype>::size;
-  static constexpr int P = get_matrix_rows<Ctype>::size;
-  static constexpr int Q = get_matrix_columns<Ctype>::size;
+  static constexpr int N = get_matrix_layout<Atype>::rows;
+  static constexpr int M = get_matrix_layout<Atype>::columns;
+  static constexpr int K = get_matrix_layout<Btype>::rows;
+  static constexpr int L = get_matrix_layout<Btype>::columns;
+  static constexpr int P = get_matrix_layout<Ctype>::rows;
+  static constexpr int Q = get_matrix_layout<Ctype>::columns;
+
+  // Extract the storage layouts of the matrices
+  static constexpr MatLayout layoutA = get_matrix_layout<Atype>::value;
+  static constexpr MatLayout layoutB = get_matrix_layout<Btype>::value;
+  static constexpr MatLayout layoutC = get_matrix_layout<Ctype>::value;
 
   // Get the types of the matrices
   static constexpr ADiffType adA = get_diff_type<Atype>::diff_type;
@@ -106,8 +156,8 @@ class MatMatMultExpr {
       : A(A), B(B), C(C) {}
 
   A2D_FUNCTION void eval() {
-    MatMatMultCore<T, N, M, K, L, P, Q, opA, opB>(get_data(A), get_data(B),
-                                                  get_data(C));
+    MatMatMultLayoutCore<T, N, M, K, L, P, Q, opA, opB, layoutA, layoutB,
+                         layoutC>(get_data(A), get_data(B), get_data(C));
   }
 
   A2D_FUNCTION void bzero() { C.bzero(); }
@@ -121,15 +171,19 @@ class MatMatMultExpr {
                                               ADseed::b, ADseed::p>::value;
     if constexpr (adA == ADiffType::ACTIVE && adB == ADiffType::ACTIVE) {
       constexpr bool additive = true;
-      MatMatMultCore<T, N, M, K, L, P, Q, opA, opB>(
+      MatMatMultLayoutCore<T, N, M, K, L, P, Q, opA, opB, layoutA, layoutB,
+                           layoutC>(
           GetSeed<seed>::get_data(A), get_data(B), GetSeed<seed>::get_data(C));
-      MatMatMultCore<T, N, M, K, L, P, Q, opA, opB, additive>(
+      MatMatMultLayoutCore<T, N, M, K, L, P, Q, opA, opB, layoutA, layoutB,
+                           layoutC, additive>(
           get_data(A), GetSeed<seed>::get_data(B), GetSeed<seed>::get_data(C));
     } else if constexpr (adA == ADiffType::ACTIVE) {
-      MatMatMultCore<T, N, M, K, L, P, Q, opA, opB>(
+      MatMatMultLayoutCore<T, N, M, K, L, P, Q, opA, opB, layoutA, layoutB,
+                           layoutC>(
           GetSeed<seed>::get_data(A), get_data(B), GetSeed<seed>::get_data(C));
     } else if constexpr (adB == ADiffType::ACTIVE) {
-      MatMatMultCore<T, N, M, K, L, P, Q, opA, opB>(
+      MatMatMultLayoutCore<T, N, M, K, L, P, Q, opA, opB, layoutA, layoutB,
+                           layoutC>(
           get_data(A), GetSeed<seed>::get_data(B), GetSeed<seed>::get_data(C));
     }
   }
@@ -138,12 +192,14 @@ class MatMatMultExpr {
     if constexpr (adA == ADiffType::ACTIVE) {
       if constexpr (opA == MatOp::NORMAL) {
         // bar{A} += bar{C} * not_opB(B)
-        MatMatMultCore<T, P, Q, K, L, N, M, MatOp::NORMAL, not_opB, true>(
+        MatMatMultLayoutCore<T, P, Q, K, L, N, M, MatOp::NORMAL, not_opB,
+                             layoutC, layoutB, layoutA, true>(
             GetSeed<ADseed::b>::get_data(C), get_data(B),
             GetSeed<ADseed::b>::get_data(A));
       } else {
         // bar{A} += opB(B) * bar{C}^{T}
-        MatMatMultCore<T, K, L, P, Q, N, M, opB, MatOp::TRANSPOSE, true>(
+        MatMatMultLayoutCore<T, K, L, P, Q, N, M, opB, MatOp::TRANSPOSE,
+                             layoutB, layoutC, layoutA, true>(
             get_data(B), GetSeed<ADseed::b>::get_data(C),
             GetSeed<ADseed::b>::get_data(A));
       }
@@ -151,12 +207,14 @@ class MatMatMultExpr {
     if constexpr (adB == ADiffType::ACTIVE) {
       if constexpr (opB == MatOp::NORMAL) {
         // bar{B} += not_opA(A) * bar{C}
-        MatMatMultCore<T, N, M, P, Q, K, L, not_opA, MatOp::NORMAL, true>(
+        MatMatMultLayoutCore<T, N, M, P, Q, K, L, not_opA, MatOp::NORMAL,
+                             layoutA, layoutC, layoutB, true>(
             get_data(A), GetSeed<ADseed::b>::get_data(C),
             GetSeed<ADseed::b>::get_data(B));
       } else {
         // bar{B} += bar{C}^{T} * opA(A)
-        MatMatMultCore<T, P, Q, N, M, K, L, MatOp::TRANSPOSE, opA, true>(
+        MatMatMultLayoutCore<T, P, Q, N, M, K, L, MatOp::TRANSPOSE, opA,
+                             layoutC, layoutA, layoutB, true>(
             GetSeed<ADseed::b>::get_data(C), get_data(A),
             GetSeed<ADseed::b>::get_data(B));
       }
@@ -171,107 +229,689 @@ class MatMatMultExpr {
 
     if constexpr (adA == ADiffType::ACTIVE) {
       if constexpr (opA == MatOp::NORMAL) {
-        MatMatMultCore<T, P, Q, K, L, N, M, MatOp::NORMAL, not_opB, true>(
+        MatMatMultLayoutCore<T, P, Q, K, L, N, M, MatOp::NORMAL, not_opB,
+                             layoutC, layoutB, layoutA, true>(
             GetSeed<ADseed::h>::get_data(C), get_data(B),
             GetSeed<ADseed::h>::get_data(A));
       } else {
-        MatMatMultCore<T, K, L, P, Q, N, M, opB, MatOp::TRANSPOSE, true>(
+        MatMatMultLayoutCore<T, K, L, P, Q, N, M, opB, MatOp::TRANSPOSE,
+                             layoutB, layoutC, layoutA, true>(
             get_data(B), GetSeed<ADseed::h>::get_data(C),
             GetSeed<ADseed::h>::get_data(A));
       }
     }
     if constexpr (adB == ADiffType::ACTIVE) {
       if constexpr (opB == MatOp::NORMAL) {
-        MatMatMultCore<T, N, M, P, Q, K, L, not_opA, MatOp::NORMAL, true>(
+        MatMatMultLayoutCore<T, N, M, P, Q, K, L, not_opA, MatOp::NORMAL,
+                             layoutA, layoutC, layoutB, true>(
             get_data(A), GetSeed<ADseed::h>::get_data(C),
             GetSeed<ADseed::h>::get_data(B));
       } else {
-        MatMatMultCore<T, P, Q, N, M, K, L, MatOp::TRANSPOSE, opA, true>(
+        MatMatMultLayoutCore<T, P, Q, N, M, K, L, MatOp::TRANSPOSE, opA,
+                             layoutC, layoutA, layoutB, true>(
             GetSeed<ADseed::h>::get_data(C), get_data(A),
             GetSeed<ADseed::h>::get_data(B));
       }
     }
     if constexpr (adA == ADiffType::ACTIVE and adB == ADiffType::ACTIVE) {
       if constexpr (opA == MatOp::NORMAL) {
-        MatMatMultCore<T, P, Q, K, L, N, M, MatOp::NORMAL, not_opB, true>(
+        MatMatMultLayoutCore<T, P, Q, K, L, N, M, MatOp::NORMAL, not_opB,
+                             layoutC, layoutB, layoutA, true>(
             GetSeed<ADseed::b>::get_data(C), GetSeed<ADseed::p>::get_data(B),
             GetSeed<ADseed::h>::get_data(A));
 
       } else {
-        MatMatMultCore<T, K, L, P, Q, N, M, opB, MatOp::TRANSPOSE, true>(
+        MatMatMultLayoutCore<T, K, L, P, Q, N, M, opB, MatOp::TRANSPOSE,
+                             layoutB, layoutC, layoutA, true>(
             GetSeed<ADseed::p>::get_data(B), GetSeed<ADseed::b>::get_data(C),
             GetSeed<ADseed::h>::get_data(A));
       }
 
       if constexpr (opB == MatOp::NORMAL) {
-        MatMatMultCore<T, N, M, P, Q, K, L, not_opA, MatOp::NORMAL, true>(
+        MatMatMultLayoutCore<T, N, M, P, Q, K, L, not_opA, MatOp::NORMAL,
+                             layoutA, layoutC, layoutB, true>(
             GetSeed<ADseed::p>::get_data(A), GetSeed<ADseed::b>::get_data(C),
             GetSeed<ADseed::h>::get_data(B));
 
       } else {
-        MatMatMultCore<T, P, Q, N, M, K, L, MatOp::TRANSPOSE, opA, true>(
+        MatMatMultLayoutCore<T, P, Q, N, M, K, L, MatOp::TRANSPOSE, opA,
+                             layoutC, layoutA, layoutB, true>(
             GetSeed<ADseed::b>::get_data(C), GetSeed<ADseed::p>::get_data(A),
             GetSeed<ADseed::h>::get_data(B));
       }
     }
   }
 
+  // Operation counts for the compile-time cost model
+  static constexpr ADCost cost() {
+    constexpr index_t R = (opA == MatOp::NORMAL ? M : N);
+    constexpr index_t flops = 2 * P * Q * R;
+    constexpr index_t sizeA = N * M, sizeB = K * L, sizeC = P * Q;
+    constexpr index_t actA = (adA == ADiffType::ACTIVE);
+    constexpr index_t actB = (adB == ADiffType::ACTIVE);
+
+    ADCost c("MatMatMult");
+    c.eval = KernelCost<T>(flops, sizeA + sizeB, sizeC);
+    c.forward = (actA + actB) * KernelCost<T>(flops, sizeA + sizeB, sizeC) +
+                actA * actB * KernelCost<T>(0, sizeC, 0);
+    c.reverse =
+        actA * KernelCost<T>(flops, sizeA + sizeB + sizeC, sizeA) +
+        actB * KernelCost<T>(flops, sizeA + sizeB + sizeC, sizeB);
+    c.hforward = c.forward;
+    c.hreverse = (1 + actA * actB) * c.reverse;
+    return c;
+  }
+
  private:
   Atype& A;
   Btype& B;
   Ctype& C;
 };
 
+/*
+  Compute C = op(S) * B where S = [s]^{x} is a 3 x 3 skew-symmetric matrix
+  stored as its axial vector.
+
+  Since S^{T} = -S, the transpose only flips signs and the derivatives are
+
+  bar{B} += op(S)^{T} * bar{C}
+  bar{s} += +/- sum_{l} b_l x bar{c}_l
+
+  where b_l and bar{c}_l are the columns of B and bar{C}, and the minus sign
+  is for op = TRANSPOSE.
+*/
+template <MatOp op, class Stype, class Btype, class Ctype>
+class SkewMatMatMultExpr {
+ public:
+  static constexpr MatOp not_op =
+      conditional_value<MatOp, op == MatOp::NORMAL, MatOp::TRANSPOSE,
+                        MatOp::NORMAL>::value;
+
+  // Extract the numeric type to use
+  typedef typename get_object_numeric_type<Ctype>::type T;
+
+  // Extract the dimensions of the matrices
+  static constexpr int N = get_skewmatrix_size<Stype>::size;
+  static constexpr int K = get_matrix_rows<Btype>::size;
+  static constexpr int L = get_matrix_columns<Btype>::size;
+  static constexpr int P = get_matrix_rows<Ctype>::size;
+  static constexpr int Q = get_matrix_columns<Ctype>::size;
+
+  static_assert(N == K && N == P && L == Q, "Matrix dimensions must agree");
+
+  // Get the types of the matrices
+  static constexpr ADiffType adS = get_diff_type<Stype>::diff_type;
+  static constexpr ADiffType adB = get_diff_type<Btype>::diff_type;
+
+  // Get the differentiation order from the output
+  static constexpr ADorder order = get_diff_order<Ctype>::order;
+
+  A2D_FUNCTION SkewMatMatMultExpr(Stype& S, Btype& B, Ctype& C)
+      : S(S), B(B), C(C) {}
+
+  A2D_FUNCTION void eval() {
+    SkewMatMatMultCore<T, L, op>(get_data(S), get_data(B), get_data(C));
+  }
+
+  A2D_FUNCTION void bzero() { C.bzero(); }
+
+  template <ADorder forder>
+  A2D_FUNCTION void forward() {
+    static_assert(
+        !(order == ADorder::FIRST and forder == ADorder::SECOND),
+        "Can't perform second order forward with first order objects");
+    constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
+                                              ADseed::b, ADseed::p>::value;
+    if constexpr (adS == ADiffType::ACTIVE && adB == ADiffType::ACTIVE) {
+      constexpr bool additive = true;
+      SkewMatMatMultCore<T, L, op>(GetSeed<seed>::get_data(S), get_data(B),
+                                   GetSeed<seed>::get_data(C));
+      SkewMatMatMultCore<T, L, op, additive>(
+          get_data(S), GetSeed<seed>::get_data(B), GetSeed<seed>::get_data(C));
+    } else if constexpr (adS == ADiffType::ACTIVE) {
+      SkewMatMatMultCore<T, L, op>(GetSeed<seed>::get_data(S), get_data(B),
+                                   GetSeed<seed>::get_data(C));
+    } else if constexpr (adB == ADiffType::ACTIVE) {
+      SkewMatMatMultCore<T, L, op>(get_data(S), GetSeed<seed>::get_data(B),
+                                   GetSeed<seed>::get_data(C));
+    }
+  }
+
+  A2D_FUNCTION void reverse() {
+    constexpr bool additive = true;
+    if constexpr (adS == ADiffType::ACTIVE) {
+      SkewMatColCrossCore<T, L, op>(get_data(B),
+                                    GetSeed<ADseed::b>::get_data(C),
+                                    GetSeed<ADseed::b>::get_data(S));
+    }
+    if constexpr (adB == ADiffType::ACTIVE) {
+      SkewMatMatMultCore<T, L, not_op, additive>(
+          get_data(S), GetSeed<ADseed::b>::get_data(C),
+          GetSeed<ADseed::b>::get_data(B));
+    }
+  }
+
+  A2D_FUNCTION void hzero() { C.hzero(); }
+
+  A2D_FUNCTION void hreverse() {
+    static_assert(order == ADorder::SECOND,
+                  "hreverse() can be called for only second order objects.");
+    constexpr bool additive = true;
+    if constexpr (adS == ADiffType::ACTIVE) {
+      SkewMatColCrossCore<T, L, op>(get_data(B),
+                                    GetSeed<ADseed::h>::get_data(C),
+                                    GetSeed<ADseed::h>::get_data(S));
+    }
+    if constexpr (adB == ADiffType::ACTIVE) {
+      SkewMatMatMultCore<T, L, not_op, additive>(
+          get_data(S), GetSeed<ADseed::h>::get_data(C),
+          GetSeed<ADseed::h>::get_data(B));
+    }
+    if constexpr (adS == ADiffType::ACTIVE && adB == ADiffType::ACTIVE) {
+      SkewMatColCrossCore<T, L, op>(GetSeed<ADseed::p>::get_data(B),
+                                    GetSeed<ADseed::b>::get_data(C),
+                                    GetSeed<ADseed::h>::get_data(S));
+      SkewMatMatMultCore<T, L, not_op, additive>(
+          GetSeed<ADseed::p>::get_data(S), GetSeed<ADseed::b>::get_data(C),
+          GetSeed<ADseed::h>::get_data(B));
+    }
+  }
+
+ private:
+  Stype& S;
+  Btype& B;
+  Ctype& C;
+};
+
+/*
+  Compute C = A * op(S) where S = [s]^{x} is a 3 x 3 skew-symmetric matrix
+  stored as its axial vector.
+
+  The derivatives are
+
+  bar{A} += bar{C} * op(S)^{T}
+  bar{s} += +/- sum_{i} bar{c}_i x a_i
+
+  where a_i and bar{c}_i are the rows of A and bar{C}, and the minus sign is
+  for op = TRANSPOSE.
+*/
+template <MatOp op, class Atype, class Stype, class Ctype>
+class MatSkewMatMultExpr {
+ public:
+  static constexpr MatOp not_op =
+      conditional_value<MatOp, op == MatOp::NORMAL, MatOp::TRANSPOSE,
+                        MatOp::NORMAL>::value;
+
+  // Extract the numeric type to use
+  typedef typename get_object_numeric_type<Ctype>::type T;
+
+  // Extract the dimensions of the matrices
+  static constexpr int N = get_matrix_rows<Atype>::size;
+  static constexpr int M = get_matrix_columns<Atype>::size;
+  static constexpr int K = get_skewmatrix_size<Stype>::size;
+  static constexpr int P = get_matrix_rows<Ctype>::size;
+  static constexpr int Q = get_matrix_columns<Ctype>::size;
+
+  static_assert(M == K && K == Q && N == P, "Matrix dimensions must agree");
+
+  // Get the types of the matrices
+  static constexpr ADiffType adA = get_diff_type<Atype>::diff_type;
+  static constexpr ADiffType adS = get_diff_type<Stype>::diff_type;
+
+  // Get the differentiation order from the output
+  static constexpr ADorder order = get_diff_order<Ctype>::order;
+
+  A2D_FUNCTION MatSkewMatMultExpr(Atype& A, Stype& S, Ctype& C)
+      : A(A), S(S), C(C) {}
+
+  A2D_FUNCTION void eval() {
+    MatSkewMatMultCore<T, N, op>(get_data(A), get_data(S), get_data(C));
+  }
+
+  A2D_FUNCTION void bzero() { C.bzero(); }
+
+  template <ADorder forder>
+  A2D_FUNCTION void forward() {
+    static_assert(
+        !(order == ADorder::FIRST and forder == ADorder::SECOND),
+        "Can't perform second order forward with first order objects");
+    constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
+                                              ADseed::b, ADseed::p>::value;
+    if constexpr (adA == ADiffType::ACTIVE && adS == ADiffType::ACTIVE) {
+      constexpr bool additive = true;
+      MatSkewMatMultCore<T, N, op>(GetSeed<seed>::get_data(A), get_data(S),
+                                   GetSeed<seed>::get_data(C));
+      MatSkewMatMultCore<T, N, op, additive>(
+          get_data(A), GetSeed<seed>::get_data(S), GetSeed<seed>::get_data(C));
+    } else if constexpr (adA == ADiffType::ACTIVE) {
+      MatSkewMatMultCore<T, N, op>(GetSeed<seed>::get_data(A), get_data(S),
+                                   GetSeed<seed>::get_data(C));
+    } else if constexpr (adS == ADiffType::ACTIVE) {
+      MatSkewMatMultCore<T, N, op>(get_data(A), GetSeed<seed>::get_data(S),
+                                   GetSeed<seed>::get_data(C));
+    }
+  }
+
+  A2D_FUNCTION void reverse() {
+    constexpr bool additive = true;
+    if constexpr (adA == ADiffType::ACTIVE) {
+      MatSkewMatMultCore<T, N, not_op, additive>(
+          GetSeed<ADseed::b>::get_data(C), get_data(S),
+          GetSeed<ADseed::b>::get_data(A));
+    }
+    if constexpr (adS == ADiffType::ACTIVE) {
+      SkewMatRowCrossCore<T, N, op>(GetSeed<ADseed::b>::get_data(C),
+                                    get_data(A),
+                                    GetSeed<ADseed::b>::get_data(S));
+    }
+  }
+
+  A2D_FUNCTION void hzero() { C.hzero(); }
+
+  A2D_FUNCTION void hreverse() {
+    static_assert(order == ADorder::SECOND,
+                  "hreverse() can be called for only second order objects.");
+    constexpr bool additive = true;
+    if constexpr (adA == ADiffType::ACTIVE) {
+      MatSkewMatMultCore<T, N, not_op, additive>(
+          GetSeed<ADseed::h>::get_data(C), get_data(S),
+          GetSeed<ADseed::h>::get_data(A));
+    }
+    if constexpr (adS == ADiffType::ACTIVE) {
+      SkewMatRowCrossCore<T, N, op>(GetSeed<ADseed::h>::get_data(C),
+                                    get_data(A),
+                                    GetSeed<ADseed::h>::get_data(S));
+    }
+    if constexpr (adA == ADiffType::ACTIVE && adS == ADiffType::ACTIVE) {
+      MatSkewMatMultCore<T, N, not_op, additive>(
+          GetSeed<ADseed::b>::get_data(C), GetSeed<ADseed::p>::get_data(S),
+          GetSeed<ADseed::h>::get_data(A));
+      SkewMatRowCrossCore<T, N, op>(GetSeed<ADseed::b>::get_data(C),
+                                    GetSeed<ADseed::p>::get_data(A),
+                                    GetSeed<ADseed::h>::get_data(S));
+    }
+  }
+
+ private:
+  Atype& A;
+  Stype& S;
+  Ctype& C;
+};
+
+/*
+  Compute C = D * B where D is a diagonal matrix. The derivatives are
+
+  bar{B} += D * bar{C}
+  bar{d}_i += sum_{j} bar{C}_ij * B_ij
+*/
+template <class Dtype, class Btype, class Ctype>
+class DiagMatMatMultExpr {
+ public:
+  // Extract the numeric type to use
+  typedef typename get_object_numeric_type<Ctype>::type T;
+
+  // Extract the dimensions of the matrices
+  static constexpr int N = get_diagmatrix_size<Dtype>::size;
+  static constexpr int K = get_matrix_rows<Btype>::size;
+  static constexpr int L = get_matrix_columns<Btype>::size;
+  static constexpr int P = get_matrix_rows<Ctype>::size;
+  static constexpr int Q = get_matrix_columns<Ctype>::size;
+
+  static_assert(N == K && N == P && L == Q, "Matrix dimensions must agree");
+
+  // Get the types of the matrices
+  static constexpr ADiffType adD = get_diff_type<Dtype>::diff_type;
+  static constexpr ADiffType adB = get_diff_type<Btype>::diff_type;
+
+  // Get the differentiation order from the output
+  static constexpr ADorder order = get_diff_order<Ctype>::order;
+
+  A2D_FUNCTION DiagMatMatMultExpr(Dtype& D, Btype& B, Ctype& C)
+      : D(D), B(B), C(C) {}
+
+  A2D_FUNCTION void eval() {
+    DiagMatMatMultCore<T, N, L>(get_data(D), get_data(B), get_data(C));
+  }
+
+  A2D_FUNCTION void bzero() { C.bzero(); }
+
+  template <ADorder forder>
+  A2D_FUNCTION void forward() {
+    static_assert(
+        !(order == ADorder::FIRST and forder == ADorder::SECOND),
+        "Can't perform second order forward with first order objects");
+    constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
+                                              ADseed::b, ADseed::p>::value;
+    if constexpr (adD == ADiffType::ACTIVE && adB == ADiffType::ACTIVE) {
+      constexpr bool additive = true;
+      DiagMatMatMultCore<T, N, L>(GetSeed<seed>::get_data(D), get_data(B),
+                                  GetSeed<seed>::get_data(C));
+      DiagMatMatMultCore<T, N, L, additive>(
+          get_data(D), GetSeed<seed>::get_data(B), GetSeed<seed>::get_data(C));
+    } else if constexpr (adD == ADiffType::ACTIVE) {
+      DiagMatMatMultCore<T, N, L>(GetSeed<seed>::get_data(D), get_data(B),
+                                  GetSeed<seed>::get_data(C));
+    } else if constexpr (adB == ADiffType::ACTIVE) {
+      DiagMatMatMultCore<T, N, L>(get_data(D), GetSeed<seed>::get_data(B),
+                                  GetSeed<seed>::get_data(C));
+    }
+  }
+
+  A2D_FUNCTION void reverse() {
+    constexpr bool additive = true;
+    if constexpr (adD == ADiffType::ACTIVE) {
+      DiagMatRowDotCore<T, N, L>(GetSeed<ADseed::b>::get_data(C), get_data(B),
+                                 GetSeed<ADseed::b>::get_data(D));
+    }
+    if constexpr (adB == ADiffType::ACTIVE) {
+      DiagMatMatMultCore<T, N, L, additive>(get_data(D),
+                                            GetSeed<ADseed::b>::get_data(C),
+                                            GetSeed<ADseed::b>::get_data(B));
+    }
+  }
+
+  A2D_FUNCTION void hzero() { C.hzero(); }
+
+  A2D_FUNCTION void hreverse() {
+    static_assert(order == ADorder::SECOND,
+                  "hreverse() can be called for only second order objects.");
+    constexpr bool additive = true;
+    if constexpr (adD == ADiffType::ACTIVE) {
+      DiagMatRowDotCore<T, N, L>(GetSeed<ADseed::h>::get_data(C), get_data(B),
+                                 GetSeed<ADseed::h>::get_data(D));
+    }
+    if constexpr (adB == ADiffType::ACTIVE) {
+      DiagMatMatMultCore<T, N, L, additive>(get_data(D),
+                                            GetSeed<ADseed::h>::get_data(C),
+                                            GetSeed<ADseed::h>::get_data(B));
+    }
+    if constexpr (adD == ADiffType::ACTIVE && adB == ADiffType::ACTIVE) {
+      DiagMatRowDotCore<T, N, L>(GetSeed<ADseed::b>::get_data(C),
+                                 GetSeed<ADseed::p>::get_data(B),
+                                 GetSeed<ADseed::h>::get_data(D));
+      DiagMatMatMultCore<T, N, L, additive>(GetSeed<ADseed::p>::get_data(D),
+                                            GetSeed<ADseed::b>::get_data(C),
+                                            GetSeed<ADseed::h>::get_data(B));
+    }
+  }
+
+ private:
+  Dtype& D;
+  Btype& B;
+  Ctype& C;
+};
+
+/*
+  Compute C = A * D where D is a diagonal matrix. The derivatives are
+
+  bar{A} += bar{C} * D
+  bar{d}_j += sum_{i} bar{C}_ij * A_ij
+*/
+template <class Atype, class Dtype, class Ctype>
+class MatDiagMatMultExpr {
+ public:
+  // Extract the numeric type to use
+  typedef typename get_object_numeric_type<Ctype>::type T;
+
+  // Extract the dimensions of the matrices
+  static constexpr int M = get_matrix_rows<Atype>::size;
+  static constexpr int N = get_matrix_columns<Atype>::size;
+  static constexpr int K = get_diagmatrix_size<Dtype>::size;
+  static constexpr int P = get_matrix_rows<Ctype>::size;
+  static constexpr int Q = get_matrix_columns<Ctype>::size;
+
+  static_assert(N == K && K == Q && M == P, "Matrix dimensions must agree");
+
+  // Get the types of the matrices
+  static constexpr ADiffType adA = get_diff_type<Atype>::diff_type;
+  static constexpr ADiffType adD = get_diff_type<Dtype>::diff_type;
+
+  // Get the differentiation order from the output
+  static constexpr ADorder order = get_diff_order<Ctype>::order;
+
+  A2D_FUNCTION MatDiagMatMultExpr(Atype& A, Dtype& D, Ctype& C)
+      : A(A), D(D), C(C) {}
+
+  A2D_FUNCTION void eval() {
+    MatDiagMatMultCore<T, M, N>(get_data(A), get_data(D), get_data(C));
+  }
+
+  A2D_FUNCTION void bzero() { C.bzero(); }
+
+  template <ADorder forder>
+  A2D_FUNCTION void forward() {
+    static_assert(
+        !(order == ADorder::FIRST and forder == ADorder::SECOND),
+        "Can't perform second order forward with first order objects");
+    constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
+                                              ADseed::b, ADseed::p>::value;
+    if constexpr (adA == ADiffType::ACTIVE && adD == ADiffType::ACTIVE) {
+      constexpr bool additive = true;
+      MatDiagMatMultCore<T, M, N>(GetSeed<seed>::get_data(A), get_data(D),
+                                  GetSeed<seed>::get_data(C));
+      MatDiagMatMultCore<T, M, N, additive>(
+          get_data(A), GetSeed<seed>::get_data(D), GetSeed<seed>::get_data(C));
+    } else if constexpr (adA == ADiffType::ACTIVE) {
+      MatDiagMatMultCore<T, M, N>(GetSeed<seed>::get_data(A), get_data(D),
+                                  GetSeed<seed>::get_data(C));
+    } else if constexpr (adD == ADiffType::ACTIVE) {
+      MatDiagMatMultCore<T, M, N>(get_data(A), GetSeed<seed>::get_data(D),
+                                  GetSeed<seed>::get_data(C));
+    }
+  }
+
+  A2D_FUNCTION void reverse() {
+    constexpr bool additive = true;
+    if constexpr (adA == ADiffType::ACTIVE) {
+      MatDiagMatMultCore<T, M, N, additive>(GetSeed<ADseed::b>::get_data(C),
+                                            get_data(D),
+                                            GetSeed<ADseed::b>::get_data(A));
+    }
+    if constexpr (adD == ADiffType::ACTIVE) {
+      DiagMatColDotCore<T, M, N>(GetSeed<ADseed::b>::get_data(C), get_data(A),
+                                 GetSeed<ADseed::b>::get_data(D));
+    }
+  }
+
+  A2D_FUNCTION void hzero() { C.hzero(); }
+
+  A2D_FUNCTION void hreverse() {
+    static_assert(order == ADorder::SECOND,
+                  "hreverse() can be called for only second order objects.");
+    constexpr bool additive = true;
+    if constexpr (adA == ADiffType::ACTIVE) {
+      MatDiagMatMultCore<T, M, N, additive>(GetSeed<ADseed::h>::get_data(C),
+                                            get_data(D),
+                                            GetSeed<ADseed::h>::get_data(A));
+    }
+    if constexpr (adD == ADiffType::ACTIVE) {
+      DiagMatColDotCore<T, M, N>(GetSeed<ADseed::h>::get_data(C), get_data(A),
+                                 GetSeed<ADseed::h>::get_data(D));
+    }
+    if constexpr (adA == ADiffType::ACTIVE && adD == ADiffType::ACTIVE) {
+      MatDiagMatMultCore<T, M, N, additive>(GetSeed<ADseed::b>::get_data(C),
+                                            GetSeed<ADseed::p>::get_data(D),
+                                            GetSeed<ADseed::h>::get_data(A));
+      DiagMatColDotCore<T, M, N>(GetSeed<ADseed::b>::get_data(C),
+                                 GetSeed<ADseed::p>::get_data(A),
+                                 GetSeed<ADseed::h>::get_data(D));
+    }
+  }
+
+ private:
+  Atype& A;
+  Dtype& D;
+  Ctype& C;
+};
+
 // compute C = op(A) * op(B) and return an expression, where A and B are all
 // active variables
 template <class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatMatMult(ADObj<Atype>& A, ADObj<Btype>& B,
                              ADObj<Ctype>& C) {
-  return MatMatMultExpr<MatOp::NORMAL, MatOp::NORMAL, ADObj<Atype>,
-                        ADObj<Btype>, ADObj<Ctype>>(A, B, C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    return SkewMatMatMultExpr<MatOp::NORMAL, ADObj<Atype>, ADObj<Btype>,
+                              ADObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::SKEWMAT) {
+    return MatSkewMatMultExpr<MatOp::NORMAL, ADObj<Atype>, ADObj<Btype>,
+                              ADObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::DIAGMAT) {
+    return DiagMatMatMultExpr<ADObj<Atype>, ADObj<Btype>, ADObj<Ctype>>(A, B,
+                                                                        C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::DIAGMAT) {
+    return MatDiagMatMultExpr<ADObj<Atype>, ADObj<Btype>, ADObj<Ctype>>(A, B,
+                                                                        C);
+  } else {
+    return MatMatMultExpr<MatOp::NORMAL, MatOp::NORMAL, ADObj<Atype>,
+                          ADObj<Btype>, ADObj<Ctype>>(A, B, C);
+  }
 }
 template <class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatMatMult(A2DObj<Atype>& A, A2DObj<Btype>& B,
                              A2DObj<Ctype>& C) {
-  return MatMatMultExpr<MatOp::NORMAL, MatOp::NORMAL, A2DObj<Atype>,
-                        A2DObj<Btype>, A2DObj<Ctype>>(A, B, C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    return SkewMatMatMultExpr<MatOp::NORMAL, A2DObj<Atype>, A2DObj<Btype>,
+                              A2DObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::SKEWMAT) {
+    return MatSkewMatMultExpr<MatOp::NORMAL, A2DObj<Atype>, A2DObj<Btype>,
+                              A2DObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::DIAGMAT) {
+    return DiagMatMatMultExpr<A2DObj<Atype>, A2DObj<Btype>, A2DObj<Ctype>>(
+        A, B, C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::DIAGMAT) {
+    return MatDiagMatMultExpr<A2DObj<Atype>, A2DObj<Btype>, A2DObj<Ctype>>(
+        A, B, C);
+  } else {
+    return MatMatMultExpr<MatOp::NORMAL, MatOp::NORMAL, A2DObj<Atype>,
+                          A2DObj<Btype>, A2DObj<Ctype>>(A, B, C);
+  }
 }
 template <MatOp opA, MatOp opB, class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatMatMult(ADObj<Atype>& A, ADObj<Btype>& B,
                              ADObj<Ctype>& C) {
-  return MatMatMultExpr<opA, opB, ADObj<Atype>, ADObj<Btype>, ADObj<Ctype>>(
-      A, B, C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    static_assert(opB == MatOp::NORMAL,
+                  "The matrix multiplied by a SkewMat cannot be transposed");
+    return SkewMatMatMultExpr<opA, ADObj<Atype>, ADObj<Btype>,
+                              ADObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::SKEWMAT) {
+    static_assert(opA == MatOp::NORMAL,
+                  "The matrix multiplied by a SkewMat cannot be transposed");
+    return MatSkewMatMultExpr<opB, ADObj<Atype>, ADObj<Btype>,
+                              ADObj<Ctype>>(A, B, C);
+  } else {
+    return MatMatMultExpr<opA, opB, ADObj<Atype>, ADObj<Btype>,
+                          ADObj<Ctype>>(A, B, C);
+  }
 }
 template <MatOp opA, MatOp opB, class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatMatMult(A2DObj<Atype>& A, A2DObj<Btype>& B,
                              A2DObj<Ctype>& C) {
-  return MatMatMultExpr<opA, opB, A2DObj<Atype>, A2DObj<Btype>, A2DObj<Ctype>>(
-      A, B, C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    static_assert(opB == MatOp::NORMAL,
+                  "The matrix multiplied by a SkewMat cannot be transposed");
+    return SkewMatMatMultExpr<opA, A2DObj<Atype>, A2DObj<Btype>,
+                              A2DObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::SKEWMAT) {
+    static_assert(opA == MatOp::NORMAL,
+                  "The matrix multiplied by a SkewMat cannot be transposed");
+    return MatSkewMatMultExpr<opB, A2DObj<Atype>, A2DObj<Btype>,
+                              A2DObj<Ctype>>(A, B, C);
+  } else {
+    return MatMatMultExpr<opA, opB, A2DObj<Atype>, A2DObj<Btype>,
+                          A2DObj<Ctype>>(A, B, C);
+  }
 }
 
 // compute C = op(A) * op(B) and return an expression, where A is passive, B is
 // active variables
 template <class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatMatMult(const Atype& A, ADObj<Btype>& B, ADObj<Ctype>& C) {
-  return MatMatMultExpr<MatOp::NORMAL, MatOp::NORMAL, const Atype, ADObj<Btype>,
-                        ADObj<Ctype>>(A, B, C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    return SkewMatMatMultExpr<MatOp::NORMAL, const Atype, ADObj<Btype>,
+                              ADObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::SKEWMAT) {
+    return MatSkewMatMultExpr<MatOp::NORMAL, const Atype, ADObj<Btype>,
+                              ADObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::DIAGMAT) {
+    return DiagMatMatMultExpr<const Atype, ADObj<Btype>, ADObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::DIAGMAT) {
+    return MatDiagMatMultExpr<const Atype, ADObj<Btype>, ADObj<Ctype>>(A, B, C);
+  } else {
+    return MatMatMultExpr<MatOp::NORMAL, MatOp::NORMAL, const Atype,
+                          ADObj<Btype>, ADObj<Ctype>>(A, B, C);
+  }
 }
 template <class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatMatMult(const Atype& A, A2DObj<Btype>& B,
                              A2DObj<Ctype>& C) {
-  return MatMatMultExpr<MatOp::NORMAL, MatOp::NORMAL, const Atype,
-                        A2DObj<Btype>, A2DObj<Ctype>>(A, B, C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    return SkewMatMatMultExpr<MatOp::NORMAL, const Atype, A2DObj<Btype>,
+                              A2DObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::SKEWMAT) {
+    return MatSkewMatMultExpr<MatOp::NORMAL, const Atype, A2DObj<Btype>,
+                              A2DObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::DIAGMAT) {
+    return DiagMatMatMultExpr<const Atype, A2DObj<Btype>, A2DObj<Ctype>>(A, B,
+                                                                         C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::DIAGMAT) {
+    return MatDiagMatMultExpr<const Atype, A2DObj<Btype>, A2DObj<Ctype>>(A, B,
+                                                                         C);
+  } else {
+    return MatMatMultExpr<MatOp::NORMAL, MatOp::NORMAL, const Atype,
+                          A2DObj<Btype>, A2DObj<Ctype>>(A, B, C);
+  }
 }
 template <MatOp opA, MatOp opB, class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatMatMult(const Atype& A, ADObj<Btype>& B, ADObj<Ctype>& C) {
-  return MatMatMultExpr<opA, opB, const Atype, ADObj<Btype>, ADObj<Ctype>>(A, B,
-                                                                           C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    static_assert(opB == MatOp::NORMAL,
+                  "The matrix multiplied by a SkewMat cannot be transposed");
+    return SkewMatMatMultExpr<opA, const Atype, ADObj<Btype>,
+                              ADObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::SKEWMAT) {
+    static_assert(opA == MatOp::NORMAL,
+                  "The matrix multiplied by a SkewMat cannot be transposed");
+    return MatSkewMatMultExpr<opB, const Atype, ADObj<Btype>,
+                              ADObj<Ctype>>(A, B, C);
+  } else {
+    return MatMatMultExpr<opA, opB, const Atype, ADObj<Btype>,
+                          ADObj<Ctype>>(A, B, C);
+  }
 }
 template <MatOp opA, MatOp opB, class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatMatMult(const Atype& A, A2DObj<Btype>& B,
                              A2DObj<Ctype>& C) {
-  return MatMatMultExpr<opA, opB, const Atype, A2DObj<Btype>, A2DObj<Ctype>>(
-      A, B, C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    static_assert(opB == MatOp::NORMAL,
+                  "The matrix multiplied by a SkewMat cannot be transposed");
+    return SkewMatMatMultExpr<opA, const Atype, A2DObj<Btype>,
+                              A2DObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::SKEWMAT) {
+    static_assert(opA == MatOp::NORMAL,
+                  "The matrix multiplied by a SkewMat cannot be transposed");
+    return MatSkewMatMultExpr<opB, const Atype, A2DObj<Btype>,
+                              A2DObj<Ctype>>(A, B, C);
+  } else {
+    return MatMatMultExpr<opA, opB, const Atype, A2DObj<Btype>,
+                          A2DObj<Ctype>>(A, B, C);
+  }
 }
 
 // compute C = op(A) * op(B) and return an expression, where A is active, B
@@ -279,25 +919,83 @@ A2D_FUNCTION auto MatMatMult(const Atype& A, A2DObj<Btype>& B,
 
 template <class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatMatMult(ADObj<Atype>& A, const Btype& B, ADObj<Ctype>& C) {
-  return MatMatMultExpr<MatOp::NORMAL, MatOp::NORMAL, ADObj<Atype>, const Btype,
-                        ADObj<Ctype>>(A, B, C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    return SkewMatMatMultExpr<MatOp::NORMAL, ADObj<Atype>, const Btype,
+                              ADObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::SKEWMAT) {
+    return MatSkewMatMultExpr<MatOp::NORMAL, ADObj<Atype>, const Btype,
+                              ADObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::DIAGMAT) {
+    return DiagMatMatMultExpr<ADObj<Atype>, const Btype, ADObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::DIAGMAT) {
+    return MatDiagMatMultExpr<ADObj<Atype>, const Btype, ADObj<Ctype>>(A, B, C);
+  } else {
+    return MatMatMultExpr<MatOp::NORMAL, MatOp::NORMAL, ADObj<Atype>,
+                          const Btype, ADObj<Ctype>>(A, B, C);
+  }
 }
 template <class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatMatMult(A2DObj<Atype>& A, const Btype& B,
                              A2DObj<Ctype>& C) {
-  return MatMatMultExpr<MatOp::NORMAL, MatOp::NORMAL, A2DObj<Atype>,
-                        const Btype, A2DObj<Ctype>>(A, B, C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    return SkewMatMatMultExpr<MatOp::NORMAL, A2DObj<Atype>, const Btype,
+                              A2DObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::SKEWMAT) {
+    return MatSkewMatMultExpr<MatOp::NORMAL, A2DObj<Atype>, const Btype,
+                              A2DObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::DIAGMAT) {
+    return DiagMatMatMultExpr<A2DObj<Atype>, const Btype, A2DObj<Ctype>>(A, B,
+                                                                         C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::DIAGMAT) {
+    return MatDiagMatMultExpr<A2DObj<Atype>, const Btype, A2DObj<Ctype>>(A, B,
+                                                                         C);
+  } else {
+    return MatMatMultExpr<MatOp::NORMAL, MatOp::NORMAL, A2DObj<Atype>,
+                          const Btype, A2DObj<Ctype>>(A, B, C);
+  }
 }
 template <MatOp opA, MatOp opB, class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatMatMult(ADObj<Atype>& A, const Btype& B, ADObj<Ctype>& C) {
-  return MatMatMultExpr<opA, opB, ADObj<Atype>, const Btype, ADObj<Ctype>>(A, B,
-                                                                           C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    static_assert(opB == MatOp::NORMAL,
+                  "The matrix multiplied by a SkewMat cannot be transposed");
+    return SkewMatMatMultExpr<opA, ADObj<Atype>, const Btype,
+                              ADObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::SKEWMAT) {
+    static_assert(opA == MatOp::NORMAL,
+                  "The matrix multiplied by a SkewMat cannot be transposed");
+    return MatSkewMatMultExpr<opB, ADObj<Atype>, const Btype,
+                              ADObj<Ctype>>(A, B, C);
+  } else {
+    return MatMatMultExpr<opA, opB, ADObj<Atype>, const Btype,
+                          ADObj<Ctype>>(A, B, C);
+  }
 }
 template <MatOp opA, MatOp opB, class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatMatMult(A2DObj<Atype>& A, const Btype& B,
                              A2DObj<Ctype>& C) {
-  return MatMatMultExpr<opA, opB, A2DObj<Atype>, const Btype, A2DObj<Ctype>>(
-      A, B, C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    static_assert(opB == MatOp::NORMAL,
+                  "The matrix multiplied by a SkewMat cannot be transposed");
+    return SkewMatMatMultExpr<opA, A2DObj<Atype>, const Btype,
+                              A2DObj<Ctype>>(A, B, C);
+  } else if constexpr (get_a2d_object_type<Btype>::value ==
+                       ADObjType::SKEWMAT) {
+    static_assert(opA == MatOp::NORMAL,
+                  "The matrix multiplied by a SkewMat cannot be transposed");
+    return MatSkewMatMultExpr<opB, A2DObj<Atype>, const Btype,
+                              A2DObj<Ctype>>(A, B, C);
+  } else {
+    return MatMatMultExpr<opA, opB, A2DObj<Atype>, const Btype,
+                          A2DObj<Ctype>>(A, B, C);
+  }
 }
 
 namespace Test {
@@ -329,6 +1027,12 @@ class MatMatMultTest
     return s.str();
   }
 
+  // Operation counts of the stack used in deriv and hprod
+  ADCost cost() {
+    return MatMatMultExpr<opA, opB, A2DObj<Mat<T, N, M>>, A2DObj<Mat<T, K, L>>,
+                          A2DObj<Mat<T, P, Q>>>::cost();
+  }
+
   // Evaluate the matrix-matrix product
   Output eval(const Input& x) {
     Mat<T, N, M> A;
@@ -389,6 +1093,171 @@ bool MatMatMultTestHelper(bool component = false, bool write_output = true) {
   return passed;
 }
 
+/*
+  Test C = opA(A) * opB(B) for matrices stored in the given layouts. The
+  reference value is computed from row-major copies of A and B.
+*/
+template <MatOp opA, MatOp opB, typename T, int N, int M, int K, int L, int P,
+          int Q, MatLayout layoutA, MatLayout layoutB, MatLayout layoutC>
+class MatMatMultLayoutTest
+    : public A2DTest<T, Mat<T, P, Q, layoutC>, Mat<T, N, M, layoutA>,
+                     Mat<T, K, L, layoutB>> {
+ public:
+  using Amat = Mat<T, N, M, layoutA>;
+  using Bmat = Mat<T, K, L, layoutB>;
+  using Cmat = Mat<T, P, Q, layoutC>;
+  using Input = VarTuple<T, Amat, Bmat>;
+  using Output = VarTuple<T, Cmat>;
+
+  // Assemble a string to describe the test
+  std::string name() {
+    std::stringstream s;
+    s << "MatMatMultLayout<";
+    s << (opA == MatOp::NORMAL ? "N," : "T,");
+    s << (opB == MatOp::NORMAL ? "N," : "T,");
+    s << (layoutA == MatLayout::ROW_MAJOR ? "R," : "C,");
+    s << (layoutB == MatLayout::ROW_MAJOR ? "R," : "C,");
+    s << (layoutC == MatLayout::ROW_MAJOR ? "R," : "C,");
+    s << N << "," << M << "," << K << "," << L << "," << P << "," << Q << ">";
+
+    return s.str();
+  }
+
+  // Evaluate the matrix-matrix product with row-major copies
+  Output eval(const Input& x) {
+    Amat A;
+    Bmat B;
+    x.get_values(A, B);
+
+    Mat<T, N, M> Ar(A);
+    Mat<T, K, L> Br(B);
+    Mat<T, P, Q> Cr;
+    MatMatMult<opA, opB>(Ar, Br, Cr);
+
+    Cmat C(Cr);
+    return MakeVarTuple<T>(C);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& x, Input& g) {
+    ADObj<Amat> A;
+    ADObj<Bmat> B;
+    ADObj<Cmat> C;
+
+    x.get_values(A.value(), B.value());
+    auto stack = MakeStack(MatMatMult<opA, opB>(A, B, C));
+    seed.get_values(C.bvalue());
+    stack.reverse();
+    g.set_values(A.bvalue(), B.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& x,
+             const Input& p, Input& h) {
+    A2DObj<Amat> A;
+    A2DObj<Bmat> B;
+    A2DObj<Cmat> C;
+
+    x.get_values(A.value(), B.value());
+    p.get_values(A.pvalue(), B.pvalue());
+    auto stack = MakeStack(MatMatMult<opA, opB>(A, B, C));
+    seed.get_values(C.bvalue());
+    hval.get_values(C.hvalue());
+    stack.hproduct();
+    h.set_values(A.hvalue(), B.hvalue());
+  }
+};
+
+/*
+  Test C = A^{T} * B where A^{T} is a transposed view of a row-major matrix
+  used with MatOp::NORMAL
+*/
+template <typename T, int N, int M, int K>
+class MatMatMultTransposeViewTest
+    : public A2DTest<T, Mat<T, M, K>, Mat<T, N, M>, Mat<T, N, K>> {
+ public:
+  using Input = VarTuple<T, Mat<T, N, M>, Mat<T, N, K>>;
+  using Output = VarTuple<T, Mat<T, M, K>>;
+
+  // Assemble a string to describe the test
+  std::string name() {
+    std::stringstream s;
+    s << "MatMatMultTransposeView<" << N << "," << M << "," << K << ">";
+    return s.str();
+  }
+
+  // Evaluate the matrix-matrix product
+  Output eval(const Input& x) {
+    Mat<T, N, M> A;
+    Mat<T, N, K> B;
+    Mat<T, M, K> C;
+
+    x.get_values(A, B);
+    MatMatMult<MatOp::TRANSPOSE, MatOp::NORMAL>(A, B, C);
+    return MakeVarTuple<T>(C);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& x, Input& g) {
+    ADObj<Mat<T, N, M>> A;
+    ADObj<Mat<T, N, K>> B;
+    ADObj<Mat<T, M, K>> C;
+
+    x.get_values(A.value(), B.value());
+    auto At = Transpose(A);
+    auto stack = MakeStack(MatMatMult(At, B, C));
+    seed.get_values(C.bvalue());
+    stack.reverse();
+    g.set_values(A.bvalue(), B.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& x,
+             const Input& p, Input& h) {
+    A2DObj<Mat<T, N, M>> A;
+    A2DObj<Mat<T, N, K>> B;
+    A2DObj<Mat<T, M, K>> C;
+
+    x.get_values(A.value(), B.value());
+    p.get_values(A.pvalue(), B.pvalue());
+    auto At = Transpose(A);
+    auto stack = MakeStack(MatMatMult(At, B, C));
+    seed.get_values(C.bvalue());
+    hval.get_values(C.hvalue());
+    stack.hproduct();
+    h.set_values(A.hvalue(), B.hvalue());
+  }
+};
+
+template <typename T, int N, int M, int K>
+bool MatMatMultLayoutTestHelper(bool component = false,
+                                bool write_output = true) {
+  const MatOp NORMAL = MatOp::NORMAL;
+  const MatOp TRANSPOSE = MatOp::TRANSPOSE;
+  const MatLayout ROW = MatLayout::ROW_MAJOR;
+  const MatLayout COL = MatLayout::COLUMN_MAJOR;
+  using Tc = A2D_complex_t<T>;
+
+  bool passed = true;
+  MatMatMultLayoutTest<NORMAL, NORMAL, Tc, N, M, M, K, N, K, COL, ROW, ROW>
+      test1;
+  passed = passed && Run(test1, component, write_output);
+  MatMatMultLayoutTest<NORMAL, TRANSPOSE, Tc, N, M, K, M, N, K, ROW, COL, COL>
+      test2;
+  passed = passed && Run(test2, component, write_output);
+  MatMatMultLayoutTest<TRANSPOSE, NORMAL, Tc, N, M, N, K, M, K, COL, COL, ROW>
+      test3;
+  passed = passed && Run(test3, component, write_output);
+  MatMatMultLayoutTest<TRANSPOSE, TRANSPOSE, Tc, N, M, K, N, M, K, COL, COL,
+                       COL>
+      test4;
+  passed = passed && Run(test4, component, write_output);
+  MatMatMultTransposeViewTest<Tc, N, M, K> test5;
+  passed = passed && Run(test5, component, write_output);
+
+  return passed;
+}
+
 inline bool MatMatMultTestAll(bool component = false,
                               bool write_output = true) {
   bool passed = true;
@@ -398,6 +1267,208 @@ inline bool MatMatMultTestAll(bool component = false,
       passed && MatMatMultTestHelper<double, 2, 3, 4>(component, write_output);
   passed =
       passed && MatMatMultTestHelper<double, 5, 4, 2>(component, write_output);
+  passed = passed &&
+           MatMatMultLayoutTestHelper<double, 2, 3, 4>(component, write_output);
+  passed = passed &&
+           MatMatMultLayoutTestHelper<double, 3, 3, 3>(component, write_output);
+
+  return passed;
+}
+
+/*
+  Test C = op(S) * B for B in R^{3 x M} when left is true, otherwise test
+  C = A * op(S) for A in R^{M x 3}
+*/
+template <bool left, MatOp op, typename T, int M>
+class SkewMatMatMultTest
+    : public A2DTest<T, typename std::conditional<left, Mat<T, 3, M>,
+                                                  Mat<T, M, 3>>::type,
+                     SkewMat<T, 3>,
+                     typename std::conditional<left, Mat<T, 3, M>,
+                                               Mat<T, M, 3>>::type> {
+ public:
+  using MatType =
+      typename std::conditional<left, Mat<T, 3, M>, Mat<T, M, 3>>::type;
+  using Input = VarTuple<T, SkewMat<T, 3>, MatType>;
+  using Output = VarTuple<T, MatType>;
+
+  // Assemble a string to describe the test
+  std::string name() {
+    std::stringstream s;
+    if (left) {
+      s << "SkewMatMatMult<";
+    } else {
+      s << "MatSkewMatMult<";
+    }
+    s << (op == MatOp::NORMAL ? "N," : "T,") << M << ">";
+    return s.str();
+  }
+
+  // Evaluate the matrix-matrix product
+  Output eval(const Input& x) {
+    SkewMat<T, 3> S;
+    MatType A, C;
+    x.get_values(S, A);
+    product(S, A, C);
+    return MakeVarTuple<T>(C);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& x, Input& g) {
+    ADObj<SkewMat<T, 3>> S;
+    ADObj<MatType> A, C;
+    x.get_values(S.value(), A.value());
+    auto stack = MakeStack(product(S, A, C));
+    seed.get_values(C.bvalue());
+    stack.reverse();
+    g.set_values(S.bvalue(), A.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& x,
+             const Input& p, Input& h) {
+    A2DObj<SkewMat<T, 3>> S;
+    A2DObj<MatType> A, C;
+    x.get_values(S.value(), A.value());
+    p.get_values(S.pvalue(), A.pvalue());
+    auto stack = MakeStack(product(S, A, C));
+    seed.get_values(C.bvalue());
+    hval.get_values(C.hvalue());
+    stack.hproduct();
+    h.set_values(S.hvalue(), A.hvalue());
+  }
+
+ private:
+  // Use the plain factories for S and the op-templated ones for S^{T}
+  template <class Stype, class Atype, class Ctype>
+  static auto product(Stype& S, Atype& A, Ctype& C) {
+    if constexpr (op == MatOp::NORMAL && left) {
+      return MatMatMult(S, A, C);
+    } else if constexpr (op == MatOp::NORMAL) {
+      return MatMatMult(A, S, C);
+    } else if constexpr (left) {
+      return MatMatMult<op, MatOp::NORMAL>(S, A, C);
+    } else {
+      return MatMatMult<MatOp::NORMAL, op>(A, S, C);
+    }
+  }
+};
+
+inline bool SkewMatMatMultTestAll(bool component = false,
+                                  bool write_output = true) {
+  using Tc = A2D_complex_t<double>;
+  constexpr MatOp N = MatOp::NORMAL, T = MatOp::TRANSPOSE;
+
+  bool passed = true;
+  SkewMatMatMultTest<true, N, Tc, 3> test1;
+  passed = passed && Run(test1, component, write_output);
+  SkewMatMatMultTest<true, N, Tc, 5> test2;
+  passed = passed && Run(test2, component, write_output);
+  SkewMatMatMultTest<false, N, Tc, 3> test3;
+  passed = passed && Run(test3, component, write_output);
+  SkewMatMatMultTest<false, N, Tc, 2> test4;
+  passed = passed && Run(test4, component, write_output);
+  SkewMatMatMultTest<true, T, Tc, 4> test5;
+  passed = passed && Run(test5, component, write_output);
+  SkewMatMatMultTest<false, T, Tc, 3> test6;
+  passed = passed && Run(test6, component, write_output);
+
+  return passed;
+}
+
+/*
+  Test C = D * B for B in R^{N x M} when left is true, otherwise test
+  C = A * D for A in R^{M x N}
+*/
+template <bool left, typename T, int N, int M>
+class DiagMatMatMultTest
+    : public A2DTest<T, typename std::conditional<left, Mat<T, N, M>,
+                                                  Mat<T, M, N>>::type,
+                     DiagMat<T, N>,
+                     typename std::conditional<left, Mat<T, N, M>,
+                                               Mat<T, M, N>>::type> {
+ public:
+  using MatType =
+      typename std::conditional<left, Mat<T, N, M>, Mat<T, M, N>>::type;
+  using Input = VarTuple<T, DiagMat<T, N>, MatType>;
+  using Output = VarTuple<T, MatType>;
+
+  // Assemble a string to describe the test
+  std::string name() {
+    std::stringstream s;
+    if (left) {
+      s << "DiagMatMatMult<" << N << "," << M << ">";
+    } else {
+      s << "MatDiagMatMult<" << M << "," << N << ">";
+    }
+    return s.str();
+  }
+
+  // Evaluate the matrix-matrix product
+  Output eval(const Input& x) {
+    DiagMat<T, N> D;
+    MatType A, C;
+    x.get_values(D, A);
+    if constexpr (left) {
+      MatMatMult(D, A, C);
+    } else {
+      MatMatMult(A, D, C);
+    }
+    return MakeVarTuple<T>(C);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& x, Input& g) {
+    ADObj<DiagMat<T, N>> D;
+    ADObj<MatType> A, C;
+    x.get_values(D.value(), A.value());
+    if constexpr (left) {
+      auto stack = MakeStack(MatMatMult(D, A, C));
+      seed.get_values(C.bvalue());
+      stack.reverse();
+    } else {
+      auto stack = MakeStack(MatMatMult(A, D, C));
+      seed.get_values(C.bvalue());
+      stack.reverse();
+    }
+    g.set_values(D.bvalue(), A.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& x,
+             const Input& p, Input& h) {
+    A2DObj<DiagMat<T, N>> D;
+    A2DObj<MatType> A, C;
+    x.get_values(D.value(), A.value());
+    p.get_values(D.pvalue(), A.pvalue());
+    if constexpr (left) {
+      auto stack = MakeStack(MatMatMult(D, A, C));
+      seed.get_values(C.bvalue());
+      hval.get_values(C.hvalue());
+      stack.hproduct();
+    } else {
+      auto stack = MakeStack(MatMatMult(A, D, C));
+      seed.get_values(C.bvalue());
+      hval.get_values(C.hvalue());
+      stack.hproduct();
+    }
+    h.set_values(D.hvalue(), A.hvalue());
+  }
+};
+
+inline bool DiagMatMatMultTestAll(bool component = false,
+                                  bool write_output = true) {
+  using Tc = A2D_complex_t<double>;
+
+  bool passed = true;
+  DiagMatMatMultTest<true, Tc, 3, 3> test1;
+  passed = passed && Run(test1, component, write_output);
+  DiagMatMatMultTest<true, Tc, 4, 2> test2;
+  passed = passed && Run(test2, component, write_output);
+  DiagMatMatMultTest<false, Tc, 3, 3> test3;
+  passed = passed && Run(test3, component, write_output);
+  DiagMatMatMultTest<false, Tc, 2, 5> test4;
+  passed = passed && Run(test4, component, write_output);
 
   return passed;
 }
@@ -17,13 +17,13 @@ A2D_FUNCTION void SymIsotropicCore(const T mu, const T lambda, const T E[],
 
   if constexpr (N == 2) {
     T tr = lambda * (E[0] + E[2]);
-    T mu2 = 2.0 * mu;
+    T mu2 = T(2.0) * mu;
     S[0] = mu2 * E[0] + tr;
     S[1] = mu2 * E[1];
     S[2] = mu2 * E[2] + tr;
   } else {
     T tr = lambda * (E[0] + E[2] + E[5]);
-    T mu2 = 2.0 * mu;
+    T mu2 = T(2.0) * mu;
     S[0] = mu2 * E[0] + tr;
     S[1] = mu2 * E[1];
     S[2] = mu2 * E[2] + tr;
@@ -40,13 +40,13 @@ A2D_FUNCTION void SymIsotropicAddCore(const T mu, const T lambda, const T E[],
 
   if constexpr (N == 2) {
     T tr = lambda * (E[0] + E[2]);
-    T mu2 = 2.0 * mu;
+    T mu2 = T(2.0) * mu;
     S[0] += mu2 * E[0] + tr;
     S[1] += mu2 * E[1];
     S[2] += mu2 * E[2] + tr;
   } else {
     T tr = lambda * (E[0] + E[2] + E[5]);
-    T mu2 = 2.0 * mu;
+    T mu2 = T(2.0) * mu;
     S[0] += mu2 * E[0] + tr;
     S[1] += mu2 * E[1];
     S[2] += mu2 * E[2] + tr;
@@ -63,11 +63,11 @@ A2D_FUNCTION void SymIsotropicReverseCoefCore(const T E[], const T Sb[], T& mu,
 
   if constexpr (N == 2) {
     lambda += (Sb[0] + Sb[2]) * (E[0] + E[2]);
-    mu += 2.0 * (Sb[0] * E[0] + Sb[1] * E[1] + Sb[2] * E[2]);
+    mu += T(2.0) * (Sb[0] * E[0] + Sb[1] * E[1] + Sb[2] * E[2]);
   } else {
     lambda += (Sb[0] + Sb[2] + Sb[5]) * (E[0] + E[2] + E[5]);
-    mu += 2.0 * (Sb[0] * E[0] + Sb[1] * E[1] + Sb[2] * E[2] + Sb[3] * E[3] +
-                 Sb[4] * E[4] + Sb[5] * E[5]);
+    mu += T(2.0) * (Sb[0] * E[0] + Sb[1] * E[1] + Sb[2] * E[2] + Sb[3] * E[3] +
+                    Sb[4] * E[4] + Sb[5] * E[5]);
   }
 }
 
@@ -5,7 +5,14 @@
 
 namespace A2D {
 
-template <typename T, int M, int N>
+/*
+ * The entries of a row-major matrix are stored as A[N * i + j] and the
+ * entries of a column-major matrix as A[M * j + i]. The column-major storage
+ * of a matrix is the row-major storage of its transpose, so the matrix
+ * products use the layout of each operand to select the traversal of the
+ * data instead of copying it.
+ * */
+template <typename T, int M, int N, MatLayout layout = MatLayout::ROW_MAJOR>
 class Mat {
  public:
   typedef T type;
@@ -13,6 +20,7 @@ class Mat {
   static const index_t ncomp = M * N;
   static const int nrows = M;
   static const int ncols = N;
+  static constexpr MatLayout mat_layout = layout;
 
   A2D_FUNCTION Mat() {
     for (int i = 0; i < M * N; i++) {
@@ -25,11 +33,11 @@ class Mat {
       A[i] = vals[i];
     }
   }
-  template <typename T2>
-  A2D_FUNCTION Mat(const Mat<T2, M, N>& src) {
+  template <typename T2, MatLayout layout2>
+  A2D_FUNCTION Mat(const Mat<T2, M, N, layout2>& src) {
     for (int i = 0; i < M; i++) {
       for (int j = 0; j < N; j++) {
-        A[N * i + j] = src(i, j);
+        A[index(i, j)] = src(i, j);
       }
     }
   }
@@ -38,29 +46,29 @@ class Mat {
       A[i] = 0.0;
     }
   }
-  template <typename T2>
-  A2D_FUNCTION void copy(const Mat<T2, M, N>& src) {
+  template <typename T2, MatLayout layout2>
+  A2D_FUNCTION void copy(const Mat<T2, M, N, layout2>& src) {
     for (int i = 0; i < M; i++) {
       for (int j = 0; j < N; j++) {
-        A[N * i + j] = src(i, j);
+        A[index(i, j)] = src(i, j);
       }
     }
   }
-  template <typename T2>
-  A2D_FUNCTION void get(Mat<T2, M, N>& mat) {
+  template <typename T2, MatLayout layout2>
+  A2D_FUNCTION void get(Mat<T2, M, N, layout2>& mat) {
     for (int i = 0; i < M; i++) {
       for (int j = 0; j < N; j++) {
-        mat(i, j) = A[N * i + j];
+        mat(i, j) = A[index(i, j)];
       }
     }
   }
   template <class IdxType1, class IdxType2>
   A2D_FUNCTION T& operator()(const IdxType1 i, const IdxType2 j) {
-    return A[N * i + j];
+    return A[index(i, j)];
   }
   template <class IdxType1, class IdxType2>
   A2D_FUNCTION const T& operator()(const IdxType1 i, const IdxType2 j) const {
-    return A[N * i + j];
+    return A[index(i, j)];
   }
 
   A2D_FUNCTION T* get_data() { return A; }
@@ -76,10 +84,54 @@ class Mat {
     return A[i];
   }
 
+  // Offset of entry (i, j) in the storage
+  static A2D_FUNCTION constexpr int index(const int i, const int j) {
+    return (layout == MatLayout::ROW_MAJOR ? N * i + j : M * j + i);
+  }
+
  private:
   T A[M * N];
 };
 
+/*
+ * A view of an M x N matrix stored in memory owned elsewhere. The view holds
+ * only the pointer to the data and is used to reinterpret the storage of a
+ * matrix without copying it. A row-major M x N matrix and a column-major
+ * N x M view of its data are transposes of each other, see Transpose().
+ * */
+template <typename T, int M, int N, MatLayout layout = MatLayout::ROW_MAJOR>
+class MatView {
+ public:
+  typedef T type;
+  static const ADObjType obj_type = ADObjType::MATRIX;
+  static const index_t ncomp = M * N;
+  static const int nrows = M;
+  static const int ncols = N;
+  static constexpr MatLayout mat_layout = layout;
+
+  A2D_FUNCTION MatView(T* A) : A(A) {}
+
+  A2D_FUNCTION void zero() {
+    for (int i = 0; i < M * N; i++) {
+      A[i] = 0.0;
+    }
+  }
+  template <class IdxType1, class IdxType2>
+  A2D_FUNCTION T& operator()(const IdxType1 i, const IdxType2 j) const {
+    return A[Mat<T, M, N, layout>::index(i, j)];
+  }
+
+  A2D_FUNCTION T* get_data() const { return A; }
+
+  template <typename I>
+  A2D_FUNCTION T& operator[](const I i) const {
+    return A[i];
+  }
+
+ private:
+  T* A;
+};
+
 /*
  * Only lower triangle entries of the SymMat are stored in the following order:
  *
@@ -173,6 +225,173 @@ class SymMat {
   T A[MAT_SIZE];
 };
 
+/*
+ * The skew-symmetric matrix S = [s]^{x} is stored as the axial vector s
+ * such that S * x = s x x for any vector x
+ *
+ *    0   -S[2]  S[1]
+ *  S[2]    0   -S[0]
+ * -S[1]  S[0]    0
+ *
+ * Only N = 3 is supported.
+ * */
+template <typename T, int N>
+class SkewMat {
+ public:
+  static_assert(N == 3, "SkewMat is only defined for N = 3");
+
+  typedef T type;
+  static const ADObjType obj_type = ADObjType::SKEWMAT;
+  static const int MAT_SIZE = 3;
+  static const index_t ncomp = MAT_SIZE;
+  static constexpr int nrows = N;
+  static constexpr int ncols = N;
+
+  A2D_FUNCTION SkewMat() {
+    for (int i = 0; i < MAT_SIZE; i++) {
+      A[i] = 0.0;
+    }
+  }
+  A2D_FUNCTION SkewMat(const T* vals) {
+    for (int i = 0; i < MAT_SIZE; i++) {
+      A[i] = vals[i];
+    }
+  }
+  template <typename T2>
+  A2D_FUNCTION SkewMat(const SkewMat<T2, N>& src) {
+    for (int i = 0; i < MAT_SIZE; i++) {
+      A[i] = src[i];
+    }
+  }
+  A2D_FUNCTION void zero() {
+    for (int i = 0; i < MAT_SIZE; i++) {
+      A[i] = 0.0;
+    }
+  }
+  template <typename T2>
+  A2D_FUNCTION void copy(const SkewMat<T2, N>& src) {
+    for (int i = 0; i < MAT_SIZE; i++) {
+      A[i] = src[i];
+    }
+  }
+  template <typename T2>
+  A2D_FUNCTION void get(Mat<T2, N, N>& mat) const {
+    for (int i = 0; i < N; i++) {
+      for (int j = 0; j < N; j++) {
+        mat(i, j) = (*this)(i, j);
+      }
+    }
+  }
+
+  // The entries are computed from the axial vector and returned by value
+  template <class IdxType1, class IdxType2>
+  A2D_FUNCTION T operator()(const IdxType1 i, const IdxType2 j) const {
+    const int ii = i, jj = j;
+    if (ii == jj) {
+      return T(0.0);
+    } else if ((jj - ii + 3) % 3 == 1) {
+      return -A[3 - ii - jj];
+    } else {
+      return A[3 - ii - jj];
+    }
+  }
+
+  A2D_FUNCTION T* get_data() { return A; }
+  A2D_FUNCTION const T* get_data() const { return A; }
+
+  template <typename I>
+  A2D_FUNCTION T& operator[](const I i) {
+    return A[i];
+  }
+  template <typename I>
+  A2D_FUNCTION const T& operator[](const I i) const {
+    return A[i];
+  }
+
+ private:
+  T A[MAT_SIZE];
+};
+
+/*
+ * Only the diagonal entries of the DiagMat are stored. The identity matrix
+ * is a DiagMat with unit diagonal entries.
+ * */
+template <typename T, int N>
+class DiagMat {
+ public:
+  typedef T type;
+  static const ADObjType obj_type = ADObjType::DIAGMAT;
+  static const int MAT_SIZE = N;
+  static const index_t ncomp = MAT_SIZE;
+  static constexpr int nrows = N;
+  static constexpr int ncols = N;
+
+  A2D_FUNCTION DiagMat() {
+    for (int i = 0; i < MAT_SIZE; i++) {
+      A[i] = 0.0;
+    }
+  }
+  A2D_FUNCTION DiagMat(const T* vals) {
+    for (int i = 0; i < MAT_SIZE; i++) {
+      A[i] = vals[i];
+    }
+  }
+  template <typename T2>
+  A2D_FUNCTION DiagMat(const DiagMat<T2, N>& src) {
+    for (int i = 0; i < MAT_SIZE; i++) {
+      A[i] = src[i];
+    }
+  }
+  A2D_FUNCTION void zero() {
+    for (int i = 0; i < MAT_SIZE; i++) {
+      A[i] = 0.0;
+    }
+  }
+  A2D_FUNCTION void identity() {
+    for (int i = 0; i < MAT_SIZE; i++) {
+      A[i] = 1.0;
+    }
+  }
+  template <typename T2>
+  A2D_FUNCTION void copy(const DiagMat<T2, N>& src) {
+    for (int i = 0; i < MAT_SIZE; i++) {
+      A[i] = src[i];
+    }
+  }
+  template <typename T2>
+  A2D_FUNCTION void get(Mat<T2, N, N>& mat) const {
+    for (int i = 0; i < N; i++) {
+      for (int j = 0; j < N; j++) {
+        mat(i, j) = (i == j ? A[i] : T(0.0));
+      }
+    }
+  }
+
+  // The off-diagonal entries are not stored so entries are returned by value
+  template <class IdxType1, class IdxType2>
+  A2D_FUNCTION T operator()(const IdxType1 i, const IdxType2 j) const {
+    if (i == j) {
+      return A[i];
+    }
+    return T(0.0);
+  }
+
+  A2D_FUNCTION T* get_data() { return A; }
+  A2D_FUNCTION const T* get_data() const { return A; }
+
+  template <typename I>
+  A2D_FUNCTION T& operator[](const I i) {
+    return A[i];
+  }
+  template <typename I>
+  A2D_FUNCTION const T& operator[](const I i) const {
+    return A[i];
+  }
+
+ private:
+  T A[MAT_SIZE];
+};
+
 }  // namespace A2D
 
 #endif  // A2D_MAT_H
@@ -72,6 +72,21 @@ class MatDetExpr {
                              GetSeed<ADseed::h>::get_data(A));
   }
 
+  // Operation counts for the compile-time cost model
+  static constexpr ADCost cost() {
+    constexpr index_t size = N * N;
+
+    ADCost c("MatDet");
+    c.eval = KernelCost<T>(N == 1 ? 0 : (N == 2 ? 3 : 14), size, 1);
+    c.forward = KernelCost<T>(N == 1 ? 0 : (N == 2 ? 7 : 44), 2 * size, 1);
+    c.reverse =
+        KernelCost<T>(N == 1 ? 1 : (N == 2 ? 8 : 45), 2 * size + 1, size);
+    c.hforward = c.forward;
+    c.hreverse =
+        KernelCost<T>(N == 1 ? 1 : (N == 2 ? 16 : 126), 3 * size + 2, size);
+    return c;
+  }
+
   Atype& A;
   dtype& det;
 };
@@ -177,6 +192,12 @@ class MatDetTest : public A2DTest<T, T, Mat<T, N, N>> {
     return s.str();
   }
 
+  // Operation counts of the stack used in deriv and hprod
+  ADCost cost() {
+    return MatDetExpr<A2DObj<Mat<T, N, N>>, A2DObj<T>>::cost() +
+           MatInvExpr<A2DObj<Mat<T, N, N>>, A2DObj<Mat<T, N, N>>>::cost();
+  }
+
   // Evaluate the matrix-matrix product
   Output eval(const Input& x) {
     T det;
@@ -2,6 +2,7 @@
 #define A2D_MAT_INV_H
 
 #include "../a2ddefs.h"
+#include "a2dcost.h"
 #include "a2dmat.h"
 #include "a2dobj.h"
 #include "a2dtest.h"
@@ -120,6 +121,21 @@ class MatInvExpr {
         T(-1.0), temp, get_data(Ainv), GetSeed<ADseed::h>::get_data(A));
   }
 
+  // Operation counts for the compile-time cost model
+  static constexpr ADCost cost() {
+    constexpr index_t size = N * N;
+    constexpr index_t inv_flops = (N == 1 ? 1 : (N == 2 ? 8 : 51));
+    constexpr index_t flops = 4 * N * N * N + size;
+
+    ADCost c("MatInv");
+    c.eval = KernelCost<T>(inv_flops, size, size);
+    c.forward = KernelCost<T>(flops, 3 * size, size);
+    c.reverse = KernelCost<T>(flops, 4 * size, size);
+    c.hforward = c.forward;
+    c.hreverse = KernelCost<T>(4 * flops, 13 * size, 3 * size);
+    return c;
+  }
+
   Atype& A;
   Btype& Ainv;
 };
@@ -149,6 +165,11 @@ class MatInvTest : public A2DTest<T, Mat<T, N, N>, Mat<T, N, N>> {
     return s.str();
   }
 
+  // Operation counts of the stack used in deriv and hprod
+  ADCost cost() {
+    return MatInvExpr<A2DObj<Mat<T, N, N>>, A2DObj<Mat<T, N, N>>>::cost();
+  }
+
   // Evaluate the matrix-matrix product
   Output eval(const Input& x) {
     Mat<T, N, N> A;
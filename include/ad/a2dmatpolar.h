@@ -0,0 +1,246 @@
+#ifndef A2D_MAT_POLAR_H
+#define A2D_MAT_POLAR_H
+
+#include "../a2ddefs.h"
+#include "a2dmat.h"
+#include "a2dobj.h"
+#include "a2dstack.h"
+#include "a2dtest.h"
+#include "core/a2dmatpolarcore.h"
+
+namespace A2D {
+
+/*
+  Compute the polar decomposition F = R * U where R is a rotation and U is
+  symmetric positive definite. F must have a positive determinant. Returns
+  false if the iteration for the rotation did not converge.
+
+  The derivatives are computed from the solution of the Sylvester equation
+
+  U * Omega + Omega * U = S
+
+  for the skew-symmetric matrix Omega = R^{T} * dot{R}, see
+  a2dmatpolarcore.h for details.
+*/
+template <typename T, int N>
+A2D_FUNCTION bool MatPolarDecomp(const Mat<T, N, N>& F, Mat<T, N, N>& R,
+                                 SymMat<T, N>& U) {
+  return MatPolarCore<T, N>(get_data(F), get_data(R), get_data(U));
+}
+
+template <class Ftype, class Rtype, class Utype>
+class MatPolarDecompExpr {
+ public:
+  // Extract the numeric type to use
+  typedef typename get_object_numeric_type<Rtype>::type T;
+
+  // Extract the dimensions of the matrices
+  static constexpr int N = get_matrix_rows<Ftype>::size;
+  static constexpr int M = get_matrix_columns<Ftype>::size;
+  static constexpr int K = get_matrix_rows<Rtype>::size;
+  static constexpr int L = get_matrix_columns<Rtype>::size;
+  static constexpr int P = get_symmatrix_size<Utype>::size;
+
+  static_assert(N == M, "Matrix must be square");
+  static_assert(N == K && N == L && N == P, "Matrix dimensions must match");
+
+  // Get the differentiation order from the output
+  static constexpr ADorder order = get_diff_order<Rtype>::order;
+
+  A2D_FUNCTION MatPolarDecompExpr(Ftype& F, Rtype& R, Utype& U)
+      : F(F), R(R), U(U) {}
+
+  A2D_FUNCTION void eval() {
+    MatPolarCore<T, N>(get_data(F), get_data(R), get_data(U));
+  }
+
+  A2D_FUNCTION void bzero() {
+    R.bzero();
+    U.bzero();
+  }
+
+  template <ADorder forder>
+  A2D_FUNCTION void forward() {
+    static_assert(
+        !(order == ADorder::FIRST and forder == ADorder::SECOND),
+        "Can't perform second order forward with first order objects");
+    constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
+                                              ADseed::b, ADseed::p>::value;
+    MatPolarForwardCore<T, N>(get_data(R), get_data(U),
+                              GetSeed<seed>::get_data(F),
+                              GetSeed<seed>::get_data(R),
+                              GetSeed<seed>::get_data(U));
+  }
+
+  A2D_FUNCTION void reverse() {
+    constexpr ADseed seed = ADseed::b;
+    MatPolarReverseCore<T, N>(get_data(R), get_data(U),
+                              GetSeed<seed>::get_data(R),
+                              GetSeed<seed>::get_data(U),
+                              GetSeed<seed>::get_data(F));
+  }
+
+  A2D_FUNCTION void hzero() {
+    R.hzero();
+    U.hzero();
+  }
+
+  A2D_FUNCTION void hreverse() {
+    static_assert(order == ADorder::SECOND,
+                  "hreverse() can be called for only second order objects.");
+    MatPolarReverseCore<T, N>(get_data(R), get_data(U),
+                              GetSeed<ADseed::h>::get_data(R),
+                              GetSeed<ADseed::h>::get_data(U),
+                              GetSeed<ADseed::h>::get_data(F));
+    MatPolarHReverseCore<T, N>(
+        get_data(R), get_data(U), GetSeed<ADseed::b>::get_data(R),
+        GetSeed<ADseed::b>::get_data(U), GetSeed<ADseed::p>::get_data(F),
+        GetSeed<ADseed::h>::get_data(F));
+  }
+
+ private:
+  Ftype& F;
+  Rtype& R;
+  Utype& U;
+};
+
+template <class Ftype, class Rtype, class Utype>
+A2D_FUNCTION auto MatPolarDecomp(ADObj<Ftype>& F, ADObj<Rtype>& R,
+                                 ADObj<Utype>& U) {
+  return MatPolarDecompExpr<ADObj<Ftype>, ADObj<Rtype>, ADObj<Utype>>(F, R, U);
+}
+
+template <class Ftype, class Rtype, class Utype>
+A2D_FUNCTION auto MatPolarDecomp(A2DObj<Ftype>& F, A2DObj<Rtype>& R,
+                                 A2DObj<Utype>& U) {
+  return MatPolarDecompExpr<A2DObj<Ftype>, A2DObj<Rtype>, A2DObj<Utype>>(F, R,
+                                                                         U);
+}
+
+namespace Test {
+
+/*
+  Test the rotation and stretch outputs of the polar decomposition. The
+  outputs are packed into a single matrix
+
+  [ R ]
+  [ U ]
+
+  where the stretch U is stored as a full matrix.
+*/
+template <typename T, int N>
+class MatPolarDecompTest : public A2DTest<T, Mat<T, 2 * N, N>, Mat<T, N, N>> {
+ public:
+  using Input = VarTuple<T, Mat<T, N, N>>;
+  using Output = VarTuple<T, Mat<T, 2 * N, N>>;
+
+  // Assemble a string to describe the test
+  std::string name() {
+    std::stringstream s;
+    s << "MatPolarDecomp<" << N << ">";
+    return s.str();
+  }
+
+  // Use a point close to the identity so that det(F) > 0
+  void get_point(Input& x) {
+    x.set_rand(this->get_rng("point"));
+    for (int i = 0; i < N; i++) {
+      x[(N + 1) * i] += 2.0;
+    }
+  }
+
+  // Evaluate the polar decomposition
+  Output eval(const Input& x) {
+    Mat<T, N, N> F, R;
+    SymMat<T, N> U;
+    x.get_values(F);
+    MatPolarDecomp(F, R, U);
+
+    Mat<T, 2 * N, N> out;
+    pack(R, U, out);
+    return MakeVarTuple<T>(out);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& x, Input& g) {
+    ADObj<Mat<T, N, N>> F, R;
+    ADObj<SymMat<T, N>> U;
+    x.get_values(F.value());
+    auto stack = MakeStack(MatPolarDecomp(F, R, U));
+
+    Mat<T, 2 * N, N> sb;
+    seed.get_values(sb);
+    unpack(sb, R.bvalue(), U.bvalue());
+    stack.reverse();
+    g.set_values(F.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& x,
+             const Input& p, Input& h) {
+    A2DObj<Mat<T, N, N>> F, R;
+    A2DObj<SymMat<T, N>> U;
+    x.get_values(F.value());
+    p.get_values(F.pvalue());
+    auto stack = MakeStack(MatPolarDecomp(F, R, U));
+
+    Mat<T, 2 * N, N> sb, sh;
+    seed.get_values(sb);
+    hval.get_values(sh);
+    unpack(sb, R.bvalue(), U.bvalue());
+    unpack(sh, R.hvalue(), U.hvalue());
+    stack.hproduct();
+    h.set_values(F.hvalue());
+  }
+
+ private:
+  void pack(const Mat<T, N, N>& R, const SymMat<T, N>& U,
+            Mat<T, 2 * N, N>& out) {
+    for (int i = 0; i < N; i++) {
+      for (int j = 0; j < N; j++) {
+        out(i, j) = R(i, j);
+        out(N + i, j) = U(i, j);
+      }
+    }
+  }
+
+  // Convert the seed for the full matrix to the seed for the packed matrix
+  void unpack(const Mat<T, 2 * N, N>& s, Mat<T, N, N>& Rs, SymMat<T, N>& Us) {
+    for (int i = 0; i < N; i++) {
+      for (int j = 0; j < N; j++) {
+        Rs(i, j) = s(i, j);
+      }
+      for (int j = 0; j <= i; j++) {
+        if (i == j) {
+          Us(i, j) = s(N + i, j);
+        } else {
+          Us(i, j) = s(N + i, j) + s(N + j, i);
+        }
+      }
+    }
+  }
+};
+
+inline bool MatPolarDecompTestAll(bool component = false,
+                                  bool write_output = true) {
+  using Tc = A2D_complex_t<double>;
+
+  bool passed = true;
+  for (int i = 0; i < 5; i++) {
+    MatPolarDecompTest<Tc, 2> test1;
+    test1.set_trial(i);
+    passed = passed && Run(test1, component, write_output);
+
+    MatPolarDecompTest<Tc, 3> test2;
+    test2.set_trial(i);
+    passed = passed && Run(test2, component, write_output);
+  }
+
+  return passed;
+}
+
+}  // namespace Test
+
+}  // namespace A2D
+
+#endif  // A2D_MAT_POLAR_H
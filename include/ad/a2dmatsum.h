@@ -7,6 +7,7 @@
 #include "a2dmat.h"
 #include "a2dstack.h"
 #include "a2dtest.h"
+#include "core/a2ddiagmatcore.h"
 #include "core/a2dveccore.h"
 
 namespace A2D {
@@ -36,6 +37,20 @@ A2D_FUNCTION void MatSum(const T alpha, const SymMat<T, N> &A, const T beta,
                                    get_data(C));
 }
 
+template <typename T, int N>
+A2D_FUNCTION void MatSum(const Mat<T, N, N> &A, const DiagMat<T, N> &D,
+                         Mat<T, N, N> &C) {
+  VecCopyCore<T, N * N>(get_data(A), get_data(C));
+  MatAddDiagMatCore<T, N>(get_data(D), get_data(C));
+}
+
+template <typename T, int N>
+A2D_FUNCTION void MatSum(const DiagMat<T, N> &D, const Mat<T, N, N> &B,
+                         Mat<T, N, N> &C) {
+  VecCopyCore<T, N * N>(get_data(B), get_data(C));
+  MatAddDiagMatCore<T, N>(get_data(D), get_data(C));
+}
+
 template <class Atype, class Btype, class Ctype>
 class MatSumExpr {
  public:
@@ -117,35 +132,177 @@ class MatSumExpr {
   Ctype &C;
 };
 
+/*
+  Compute C = A + D where D is a diagonal matrix. Only the diagonal of the
+  seed of C contributes to the derivative with respect to D.
+*/
+template <class Atype, class Dtype, class Ctype>
+class MatDiagSumExpr {
+ public:
+  // Extract the numeric type to use
+  typedef typename get_object_numeric_type<Ctype>::type T;
+
+  // Get the sizes of the matrices
+  static constexpr int N = get_diagmatrix_size<Dtype>::size;
+  static constexpr int K = get_matrix_rows<Atype>::size;
+  static constexpr int L = get_matrix_columns<Atype>::size;
+  static constexpr int P = get_matrix_rows<Ctype>::size;
+  static constexpr int Q = get_matrix_columns<Ctype>::size;
+  static const int size = N * N;
+
+  static_assert(N == K && N == L && N == P && N == Q,
+                "Matrix dimensions must agree");
+
+  // Get the types of the matrices
+  static constexpr ADiffType adA = get_diff_type<Atype>::diff_type;
+  static constexpr ADiffType adD = get_diff_type<Dtype>::diff_type;
+
+  A2D_FUNCTION
+  MatDiagSumExpr(Atype &A, Dtype &D, Ctype &C) : A(A), D(D), C(C) {}
+
+  A2D_FUNCTION void eval() {
+    VecCopyCore<T, size>(get_data(A), get_data(C));
+    MatAddDiagMatCore<T, N>(get_data(D), get_data(C));
+  }
+
+  A2D_FUNCTION void bzero() { C.bzero(); }
+
+  template <ADorder forder>
+  A2D_FUNCTION void forward() {
+    constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
+                                              ADseed::b, ADseed::p>::value;
+    if constexpr (adA == ADiffType::ACTIVE) {
+      VecCopyCore<T, size>(GetSeed<seed>::get_data(A),
+                           GetSeed<seed>::get_data(C));
+    } else {
+      VecZeroCore<T, size>(GetSeed<seed>::get_data(C));
+    }
+    if constexpr (adD == ADiffType::ACTIVE) {
+      MatAddDiagMatCore<T, N>(GetSeed<seed>::get_data(D),
+                              GetSeed<seed>::get_data(C));
+    }
+  }
+
+  A2D_FUNCTION void reverse() {
+    constexpr ADseed seed = ADseed::b;
+    if constexpr (adA == ADiffType::ACTIVE) {
+      VecAddCore<T, size>(GetSeed<seed>::get_data(C),
+                          GetSeed<seed>::get_data(A));
+    }
+    if constexpr (adD == ADiffType::ACTIVE) {
+      DiagMatAddDiagCore<T, N>(GetSeed<seed>::get_data(C),
+                               GetSeed<seed>::get_data(D));
+    }
+  }
+
+  A2D_FUNCTION void hzero() { C.hzero(); }
+
+  A2D_FUNCTION void hreverse() {
+    constexpr ADseed seed = ADseed::h;
+    if constexpr (adA == ADiffType::ACTIVE) {
+      VecAddCore<T, size>(GetSeed<seed>::get_data(C),
+                          GetSeed<seed>::get_data(A));
+    }
+    if constexpr (adD == ADiffType::ACTIVE) {
+      DiagMatAddDiagCore<T, N>(GetSeed<seed>::get_data(C),
+                               GetSeed<seed>::get_data(D));
+    }
+  }
+
+  Atype &A;
+  Dtype &D;
+  Ctype &C;
+};
+
 // Full active variants
 template <class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatSum(ADObj<Atype> &A, ADObj<Btype> &B, ADObj<Ctype> &C) {
-  return MatSumExpr<ADObj<Atype>, ADObj<Btype>, ADObj<Ctype>>(A, B, C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::DIAGMAT &&
+                get_a2d_object_type<Btype>::value == ADObjType::MATRIX) {
+    return MatDiagSumExpr<ADObj<Btype>, ADObj<Atype>, ADObj<Ctype>>(B, A, C);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                           ADObjType::MATRIX &&
+                       get_a2d_object_type<Btype>::value ==
+                           ADObjType::DIAGMAT) {
+    return MatDiagSumExpr<ADObj<Atype>, ADObj<Btype>, ADObj<Ctype>>(A, B, C);
+  } else {
+    return MatSumExpr<ADObj<Atype>, ADObj<Btype>, ADObj<Ctype>>(A, B, C);
+  }
 }
 
 template <class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatSum(A2DObj<Atype> &A, A2DObj<Btype> &B, A2DObj<Ctype> &C) {
-  return MatSumExpr<A2DObj<Atype>, A2DObj<Btype>, A2DObj<Ctype>>(A, B, C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::DIAGMAT &&
+                get_a2d_object_type<Btype>::value == ADObjType::MATRIX) {
+    return MatDiagSumExpr<A2DObj<Btype>, A2DObj<Atype>, A2DObj<Ctype>>(B, A, C);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                           ADObjType::MATRIX &&
+                       get_a2d_object_type<Btype>::value ==
+                           ADObjType::DIAGMAT) {
+    return MatDiagSumExpr<A2DObj<Atype>, A2DObj<Btype>, A2DObj<Ctype>>(A, B, C);
+  } else {
+    return MatSumExpr<A2DObj<Atype>, A2DObj<Btype>, A2DObj<Ctype>>(A, B, C);
+  }
 }
 
 template <class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatSum(const Atype &A, ADObj<Btype> &B, ADObj<Ctype> &C) {
-  return MatSumExpr<const Atype, ADObj<Btype>, ADObj<Ctype>>(A, B, C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::DIAGMAT &&
+                get_a2d_object_type<Btype>::value == ADObjType::MATRIX) {
+    return MatDiagSumExpr<ADObj<Btype>, const Atype, ADObj<Ctype>>(B, A, C);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                           ADObjType::MATRIX &&
+                       get_a2d_object_type<Btype>::value ==
+                           ADObjType::DIAGMAT) {
+    return MatDiagSumExpr<const Atype, ADObj<Btype>, ADObj<Ctype>>(A, B, C);
+  } else {
+    return MatSumExpr<const Atype, ADObj<Btype>, ADObj<Ctype>>(A, B, C);
+  }
 }
 
 template <class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatSum(const Atype &A, A2DObj<Btype> &B, A2DObj<Ctype> &C) {
-  return MatSumExpr<const Atype, A2DObj<Btype>, A2DObj<Ctype>>(A, B, C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::DIAGMAT &&
+                get_a2d_object_type<Btype>::value == ADObjType::MATRIX) {
+    return MatDiagSumExpr<A2DObj<Btype>, const Atype, A2DObj<Ctype>>(B, A, C);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                           ADObjType::MATRIX &&
+                       get_a2d_object_type<Btype>::value ==
+                           ADObjType::DIAGMAT) {
+    return MatDiagSumExpr<const Atype, A2DObj<Btype>, A2DObj<Ctype>>(A, B, C);
+  } else {
+    return MatSumExpr<const Atype, A2DObj<Btype>, A2DObj<Ctype>>(A, B, C);
+  }
 }
 
 template <class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatSum(ADObj<Atype> &A, const Btype &B, ADObj<Ctype> &C) {
-  return MatSumExpr<ADObj<Atype>, const Btype, ADObj<Ctype>>(A, B, C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::DIAGMAT &&
+                get_a2d_object_type<Btype>::value == ADObjType::MATRIX) {
+    return MatDiagSumExpr<const Btype, ADObj<Atype>, ADObj<Ctype>>(B, A, C);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                           ADObjType::MATRIX &&
+                       get_a2d_object_type<Btype>::value ==
+                           ADObjType::DIAGMAT) {
+    return MatDiagSumExpr<ADObj<Atype>, const Btype, ADObj<Ctype>>(A, B, C);
+  } else {
+    return MatSumExpr<ADObj<Atype>, const Btype, ADObj<Ctype>>(A, B, C);
+  }
 }
 
 template <class Atype, class Btype, class Ctype>
 A2D_FUNCTION auto MatSum(A2DObj<Atype> &A, const Btype &B, A2DObj<Ctype> &C) {
-  return MatSumExpr<A2DObj<Atype>, const Btype, A2DObj<Ctype>>(A, B, C);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::DIAGMAT &&
+                get_a2d_object_type<Btype>::value == ADObjType::MATRIX) {
+    return MatDiagSumExpr<const Btype, A2DObj<Atype>, A2DObj<Ctype>>(B, A, C);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                           ADObjType::MATRIX &&
+                       get_a2d_object_type<Btype>::value ==
+                           ADObjType::DIAGMAT) {
+    return MatDiagSumExpr<A2DObj<Atype>, const Btype, A2DObj<Ctype>>(A, B, C);
+  } else {
+    return MatSumExpr<A2DObj<Atype>, const Btype, A2DObj<Ctype>>(A, B, C);
+  }
 }
 
 template <class atype, class Atype, class btype, class Btype, class Ctype>
@@ -424,6 +581,92 @@ inline bool MatSumTestAll(bool component = false, bool write_output = true) {
   return passed;
 }
 
+/*
+  Test C = A + D when left is false, otherwise test C = D + A
+*/
+template <bool left, typename T, int N>
+class MatDiagSumTest
+    : public A2DTest<T, Mat<T, N, N>, Mat<T, N, N>, DiagMat<T, N>> {
+ public:
+  using Input = VarTuple<T, Mat<T, N, N>, DiagMat<T, N>>;
+  using Output = VarTuple<T, Mat<T, N, N>>;
+
+  // Assemble a string to describe the test
+  std::string name() {
+    std::stringstream s;
+    if (left) {
+      s << "DiagMatSum<" << N << ">";
+    } else {
+      s << "MatDiagSum<" << N << ">";
+    }
+    return s.str();
+  }
+
+  // Evaluate the matrix sum
+  Output eval(const Input &x) {
+    Mat<T, N, N> A, C;
+    DiagMat<T, N> D;
+    x.get_values(A, D);
+    if constexpr (left) {
+      MatSum(D, A, C);
+    } else {
+      MatSum(A, D, C);
+    }
+    return MakeVarTuple<T>(C);
+  }
+
+  // Compute the derivative
+  void deriv(const Output &seed, const Input &x, Input &g) {
+    ADObj<Mat<T, N, N>> A, C;
+    ADObj<DiagMat<T, N>> D;
+    x.get_values(A.value(), D.value());
+    if constexpr (left) {
+      auto stack = MakeStack(MatSum(D, A, C));
+      seed.get_values(C.bvalue());
+      stack.reverse();
+    } else {
+      auto stack = MakeStack(MatSum(A, D, C));
+      seed.get_values(C.bvalue());
+      stack.reverse();
+    }
+    g.set_values(A.bvalue(), D.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output &seed, const Output &hval, const Input &x,
+             const Input &p, Input &h) {
+    A2DObj<Mat<T, N, N>> A, C;
+    A2DObj<DiagMat<T, N>> D;
+    x.get_values(A.value(), D.value());
+    p.get_values(A.pvalue(), D.pvalue());
+    if constexpr (left) {
+      auto stack = MakeStack(MatSum(D, A, C));
+      seed.get_values(C.bvalue());
+      hval.get_values(C.hvalue());
+      stack.hproduct();
+    } else {
+      auto stack = MakeStack(MatSum(A, D, C));
+      seed.get_values(C.bvalue());
+      hval.get_values(C.hvalue());
+      stack.hproduct();
+    }
+    h.set_values(A.hvalue(), D.hvalue());
+  }
+};
+
+inline bool MatDiagSumTestAll(bool component = false,
+                              bool write_output = true) {
+  using Tc = A2D_complex_t<double>;
+
+  bool passed = true;
+  MatDiagSumTest<false, Tc, 3> test1;
+  passed = passed && Run(test1, component, write_output);
+  MatDiagSumTest<true, Tc, 4> test2;
+  passed = passed && Run(test2, component, write_output);
+
+  return passed;
+}
+
 }  // namespace Test
 
 }  // namespace A2D
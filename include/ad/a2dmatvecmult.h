@@ -7,16 +7,23 @@
 #include "a2dmat.h"
 #include "a2dstack.h"
 #include "a2dtest.h"
+#include "core/a2ddiagmatcore.h"
 #include "core/a2dmatveccore.h"
+#include "core/a2dskewmatcore.h"
 #include "core/a2dsymmatveccore.h"
 #include "core/a2dveccore.h"
 
 namespace A2D {
 
-template <typename T, int N, int M>
-A2D_FUNCTION void MatVecMult(const Mat<T, N, M>& A, const Vec<T, M>& x,
+template <typename T, int N, int M, MatLayout layout>
+A2D_FUNCTION void MatVecMult(const Mat<T, N, M, layout>& A, const Vec<T, M>& x,
                              Vec<T, N>& y) {
-  MatVecCore<T, N, M>(get_data(A), get_data(x), get_data(y));
+  if constexpr (layout == MatLayout::ROW_MAJOR) {
+    MatVecCore<T, N, M>(get_data(A), get_data(x), get_data(y));
+  } else {
+    MatVecCore<T, M, N, MatOp::TRANSPOSE>(get_data(A), get_data(x),
+                                          get_data(y));
+  }
 }
 
 template <typename T, int N>
@@ -25,13 +32,37 @@ A2D_FUNCTION void MatVecMult(const SymMat<T, N>& A, const Vec<T, N>& x,
   SymMatVecCore<T, N>(get_data(A), get_data(x), get_data(y));
 }
 
-template <MatOp op, typename T, int N, int M, int K, int P>
-A2D_FUNCTION void MatVecMult(const Mat<T, N, M>& A, const Vec<T, K>& x,
+template <typename T, int N>
+A2D_FUNCTION void MatVecMult(const SkewMat<T, N>& S, const Vec<T, N>& x,
+                             Vec<T, N>& y) {
+  SkewMatMatMultCore<T, 1>(get_data(S), get_data(x), get_data(y));
+}
+
+template <MatOp op, typename T, int N>
+A2D_FUNCTION void MatVecMult(const SkewMat<T, N>& S, const Vec<T, N>& x,
+                             Vec<T, N>& y) {
+  SkewMatMatMultCore<T, 1, op>(get_data(S), get_data(x), get_data(y));
+}
+
+template <typename T, int N>
+A2D_FUNCTION void MatVecMult(const DiagMat<T, N>& D, const Vec<T, N>& x,
+                             Vec<T, N>& y) {
+  DiagMatMatMultCore<T, N, 1>(get_data(D), get_data(x), get_data(y));
+}
+
+template <MatOp op, typename T, int N, int M, int K, int P, MatLayout layout>
+A2D_FUNCTION void MatVecMult(const Mat<T, N, M, layout>& A, const Vec<T, K>& x,
                              Vec<T, P>& y) {
   static_assert(((op == MatOp::NORMAL && (M == K && N == P)) ||
                  (op == MatOp::TRANSPOSE && (M == P && N == K))),
                 "Matrix and vector dimensions must agree");
-  MatVecCore<T, N, M, op>(get_data(A), get_data(x), get_data(y));
+  if constexpr (layout == MatLayout::ROW_MAJOR) {
+    MatVecCore<T, N, M, op>(get_data(A), get_data(x), get_data(y));
+  } else {
+    constexpr MatOp not_op =
+        (op == MatOp::NORMAL ? MatOp::TRANSPOSE : MatOp::NORMAL);
+    MatVecCore<T, M, N, not_op>(get_data(A), get_data(x), get_data(y));
+  }
 }
 
 template <MatOp op, class Atype, class xtype, class ytype>
@@ -45,11 +76,20 @@ class MatVecMultExpr {
   typedef typename get_object_numeric_type<ytype>::type T;
 
   // Extract the dimensions of the matrices
-  static constexpr int N = get_matrix_rows<Atype>::size;
-  static constexpr int M = get_matrix_columns<Atype>::size;
+  static constexpr int N = get_matrix_layout<Atype>::rows;
+  static constexpr int M = get_matrix_layout<Atype>::columns;
   static constexpr int K = get_vec_size<xtype>::size;
   static constexpr int P = get_vec_size<ytype>::size;
 
+  // A column-major matrix is the row-major storage of its transpose, so the
+  // cores work on the Ns x Ms storage with the op applied to it
+  static constexpr bool row_major =
+      (get_matrix_layout<Atype>::value == MatLayout::ROW_MAJOR);
+  static constexpr int Ns = (row_major ? N : M);
+  static constexpr int Ms = (row_major ? M : N);
+  static constexpr MatOp sop = (row_major ? op : not_op);
+  static constexpr MatOp not_sop = (row_major ? not_op : op);
+
   // Get the types of the matrices
   static constexpr ADiffType adA = get_diff_type<Atype>::diff_type;
   static constexpr ADiffType adx = get_diff_type<xtype>::diff_type;
@@ -64,7 +104,7 @@ class MatVecMultExpr {
   }
 
   A2D_FUNCTION void eval() {
-    MatVecCore<T, N, M, op>(get_data(A), get_data(x), get_data(y));
+    MatVecCore<T, Ns, Ms, sop>(get_data(A), get_data(x), get_data(y));
   }
 
   A2D_FUNCTION void bzero() { y.bzero(); }
@@ -79,37 +119,38 @@ class MatVecMultExpr {
 
     if constexpr (adA == ADiffType::ACTIVE && adx == ADiffType::ACTIVE) {
       constexpr bool additive = true;
-      MatVecCore<T, N, M, op>(GetSeed<seed>::get_data(A), get_data(x),
-                              GetSeed<seed>::get_data(y));
-      MatVecCore<T, N, M, op, additive>(get_data(A), GetSeed<seed>::get_data(x),
-                                        GetSeed<seed>::get_data(y));
+      MatVecCore<T, Ns, Ms, sop>(GetSeed<seed>::get_data(A), get_data(x),
+                                 GetSeed<seed>::get_data(y));
+      MatVecCore<T, Ns, Ms, sop, additive>(get_data(A),
+                                           GetSeed<seed>::get_data(x),
+                                           GetSeed<seed>::get_data(y));
 
     } else if constexpr (adA == ADiffType::ACTIVE) {
-      MatVecCore<T, N, M, op>(GetSeed<seed>::get_data(A), get_data(x),
-                              GetSeed<seed>::get_data(y));
+      MatVecCore<T, Ns, Ms, sop>(GetSeed<seed>::get_data(A), get_data(x),
+                                 GetSeed<seed>::get_data(y));
     } else if constexpr (adx == ADiffType::ACTIVE) {
-      MatVecCore<T, N, M, op>(get_data(A), GetSeed<seed>::get_data(x),
-                              GetSeed<seed>::get_data(y));
+      MatVecCore<T, Ns, Ms, sop>(get_data(A), GetSeed<seed>::get_data(x),
+                                 GetSeed<seed>::get_data(y));
     }
   }
 
   A2D_FUNCTION void reverse() {
     constexpr bool additive = true;
     if constexpr (adA == ADiffType::ACTIVE) {
-      if constexpr (op == MatOp::NORMAL) {
-        VecOuterCore<T, N, M, additive>(GetSeed<ADseed::b>::get_data(y),
-                                        get_data(x),
-                                        GetSeed<ADseed::b>::get_data(A));
+      if constexpr (sop == MatOp::NORMAL) {
+        VecOuterCore<T, Ns, Ms, additive>(GetSeed<ADseed::b>::get_data(y),
+                                          get_data(x),
+                                          GetSeed<ADseed::b>::get_data(A));
       } else {
-        VecOuterCore<T, N, M, additive>(get_data(x),
-                                        GetSeed<ADseed::b>::get_data(y),
-                                        GetSeed<ADseed::b>::get_data(A));
+        VecOuterCore<T, Ns, Ms, additive>(get_data(x),
+                                          GetSeed<ADseed::b>::get_data(y),
+                                          GetSeed<ADseed::b>::get_data(A));
       }
     }
     if constexpr (adx == ADiffType::ACTIVE) {
-      MatVecCore<T, N, M, not_op, additive>(get_data(A),
-                                            GetSeed<ADseed::b>::get_data(y),
-                                            GetSeed<ADseed::b>::get_data(x));
+      MatVecCore<T, Ns, Ms, not_sop, additive>(get_data(A),
+                                               GetSeed<ADseed::b>::get_data(y),
+                                               GetSeed<ADseed::b>::get_data(x));
     }
   }
 
@@ -118,38 +159,56 @@ class MatVecMultExpr {
   A2D_FUNCTION void hreverse() {
     constexpr bool additive = true;
     if constexpr (adA == ADiffType::ACTIVE) {
-      if constexpr (op == MatOp::NORMAL) {
-        VecOuterCore<T, N, M, additive>(GetSeed<ADseed::h>::get_data(y),
-                                        get_data(x),
-                                        GetSeed<ADseed::h>::get_data(A));
+      if constexpr (sop == MatOp::NORMAL) {
+        VecOuterCore<T, Ns, Ms, additive>(GetSeed<ADseed::h>::get_data(y),
+                                          get_data(x),
+                                          GetSeed<ADseed::h>::get_data(A));
       } else {
-        VecOuterCore<T, N, M, additive>(get_data(x),
-                                        GetSeed<ADseed::h>::get_data(y),
-                                        GetSeed<ADseed::h>::get_data(A));
+        VecOuterCore<T, Ns, Ms, additive>(get_data(x),
+                                          GetSeed<ADseed::h>::get_data(y),
+                                          GetSeed<ADseed::h>::get_data(A));
       }
     }
     if constexpr (adx == ADiffType::ACTIVE) {
-      MatVecCore<T, N, M, not_op, additive>(get_data(A),
-                                            GetSeed<ADseed::h>::get_data(y),
-                                            GetSeed<ADseed::h>::get_data(x));
+      MatVecCore<T, Ns, Ms, not_sop, additive>(get_data(A),
+                                               GetSeed<ADseed::h>::get_data(y),
+                                               GetSeed<ADseed::h>::get_data(x));
     }
     if constexpr (adA == ADiffType::ACTIVE && adx == ADiffType::ACTIVE) {
-      if constexpr (op == MatOp::NORMAL) {
-        VecOuterCore<T, N, M, additive>(GetSeed<ADseed::b>::get_data(y),
-                                        GetSeed<ADseed::p>::get_data(x),
-                                        GetSeed<ADseed::h>::get_data(A));
+      if constexpr (sop == MatOp::NORMAL) {
+        VecOuterCore<T, Ns, Ms, additive>(GetSeed<ADseed::b>::get_data(y),
+                                          GetSeed<ADseed::p>::get_data(x),
+                                          GetSeed<ADseed::h>::get_data(A));
       } else {
-        VecOuterCore<T, N, M, additive>(GetSeed<ADseed::p>::get_data(x),
-                                        GetSeed<ADseed::b>::get_data(y),
-                                        GetSeed<ADseed::h>::get_data(A));
+        VecOuterCore<T, Ns, Ms, additive>(GetSeed<ADseed::p>::get_data(x),
+                                          GetSeed<ADseed::b>::get_data(y),
+                                          GetSeed<ADseed::h>::get_data(A));
       }
 
-      MatVecCore<T, N, M, not_op, additive>(GetSeed<ADseed::p>::get_data(A),
-                                            GetSeed<ADseed::b>::get_data(y),
-                                            GetSeed<ADseed::h>::get_data(x));
+      MatVecCore<T, Ns, Ms, not_sop, additive>(GetSeed<ADseed::p>::get_data(A),
+                                               GetSeed<ADseed::b>::get_data(y),
+                                               GetSeed<ADseed::h>::get_data(x));
     }
   }
 
+  // Operation counts for the compile-time cost model
+  static constexpr ADCost cost() {
+    constexpr index_t flops = 2 * N * M;
+    constexpr index_t sizeA = N * M;
+    constexpr index_t actA = (adA == ADiffType::ACTIVE);
+    constexpr index_t actx = (adx == ADiffType::ACTIVE);
+
+    ADCost c("MatVecMult");
+    c.eval = KernelCost<T>(flops, sizeA + K, P);
+    c.forward = (actA + actx) * KernelCost<T>(flops, sizeA + K, P) +
+                actA * actx * KernelCost<T>(0, P, 0);
+    c.reverse = actA * KernelCost<T>(flops, sizeA + K + P, sizeA) +
+                actx * KernelCost<T>(flops, sizeA + K + P, K);
+    c.hforward = c.forward;
+    c.hreverse = (1 + actA * actx) * c.reverse;
+    return c;
+  }
+
  private:
   Atype& A;
   xtype& x;
@@ -255,11 +314,223 @@ class SymMatVecMultExpr {
   ytype& y;
 };
 
+/*
+  Compute y = op(S) * x = +/- s x x where S = [s]^{x} is a skew-symmetric
+  matrix stored as its axial vector. The vector is treated as a 3 x 1 matrix
+  so that the cores for SkewMatMatMultExpr can be reused.
+*/
+template <MatOp op, class Stype, class xtype, class ytype>
+class SkewMatVecMultExpr {
+ public:
+  static constexpr MatOp not_op =
+      conditional_value<MatOp, op == MatOp::NORMAL, MatOp::TRANSPOSE,
+                        MatOp::NORMAL>::value;
+
+  // Extract the numeric type to use
+  typedef typename get_object_numeric_type<ytype>::type T;
+
+  // Extract the dimensions of the matrices
+  static constexpr int N = get_skewmatrix_size<Stype>::size;
+  static constexpr int K = get_vec_size<xtype>::size;
+  static constexpr int P = get_vec_size<ytype>::size;
+
+  static_assert(K == P, "Input vector and output vector must have same size");
+  static_assert(N == P, "matrix and vector must have compatible size");
+
+  // Get the types of the matrices
+  static constexpr ADiffType adS = get_diff_type<Stype>::diff_type;
+  static constexpr ADiffType adx = get_diff_type<xtype>::diff_type;
+
+  // Get the differentiation order from the output
+  static constexpr ADorder order = get_diff_order<ytype>::order;
+
+  A2D_FUNCTION SkewMatVecMultExpr(Stype& S, xtype& x, ytype& y)
+      : S(S), x(x), y(y) {}
+
+  A2D_FUNCTION void eval() {
+    SkewMatMatMultCore<T, 1, op>(get_data(S), get_data(x), get_data(y));
+  }
+
+  A2D_FUNCTION void bzero() { y.bzero(); }
+
+  template <ADorder forder>
+  A2D_FUNCTION void forward() {
+    static_assert(
+        !(order == ADorder::FIRST and forder == ADorder::SECOND),
+        "Can't perform second order forward with first order objects");
+    constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
+                                              ADseed::b, ADseed::p>::value;
+
+    if constexpr (adS == ADiffType::ACTIVE && adx == ADiffType::ACTIVE) {
+      constexpr bool additive = true;
+      SkewMatMatMultCore<T, 1, op>(GetSeed<seed>::get_data(S), get_data(x),
+                                   GetSeed<seed>::get_data(y));
+      SkewMatMatMultCore<T, 1, op, additive>(
+          get_data(S), GetSeed<seed>::get_data(x), GetSeed<seed>::get_data(y));
+    } else if constexpr (adS == ADiffType::ACTIVE) {
+      SkewMatMatMultCore<T, 1, op>(GetSeed<seed>::get_data(S), get_data(x),
+                                   GetSeed<seed>::get_data(y));
+    } else if constexpr (adx == ADiffType::ACTIVE) {
+      SkewMatMatMultCore<T, 1, op>(get_data(S), GetSeed<seed>::get_data(x),
+                                   GetSeed<seed>::get_data(y));
+    }
+  }
+
+  A2D_FUNCTION void reverse() {
+    constexpr bool additive = true;
+    if constexpr (adS == ADiffType::ACTIVE) {
+      SkewMatColCrossCore<T, 1, op>(get_data(x),
+                                    GetSeed<ADseed::b>::get_data(y),
+                                    GetSeed<ADseed::b>::get_data(S));
+    }
+    if constexpr (adx == ADiffType::ACTIVE) {
+      SkewMatMatMultCore<T, 1, not_op, additive>(
+          get_data(S), GetSeed<ADseed::b>::get_data(y),
+          GetSeed<ADseed::b>::get_data(x));
+    }
+  }
+
+  A2D_FUNCTION void hzero() { y.hzero(); }
+
+  A2D_FUNCTION void hreverse() {
+    constexpr bool additive = true;
+    if constexpr (adS == ADiffType::ACTIVE) {
+      SkewMatColCrossCore<T, 1, op>(get_data(x),
+                                    GetSeed<ADseed::h>::get_data(y),
+                                    GetSeed<ADseed::h>::get_data(S));
+    }
+    if constexpr (adx == ADiffType::ACTIVE) {
+      SkewMatMatMultCore<T, 1, not_op, additive>(
+          get_data(S), GetSeed<ADseed::h>::get_data(y),
+          GetSeed<ADseed::h>::get_data(x));
+    }
+    if constexpr (adS == ADiffType::ACTIVE && adx == ADiffType::ACTIVE) {
+      SkewMatColCrossCore<T, 1, op>(GetSeed<ADseed::p>::get_data(x),
+                                    GetSeed<ADseed::b>::get_data(y),
+                                    GetSeed<ADseed::h>::get_data(S));
+      SkewMatMatMultCore<T, 1, not_op, additive>(
+          GetSeed<ADseed::p>::get_data(S), GetSeed<ADseed::b>::get_data(y),
+          GetSeed<ADseed::h>::get_data(x));
+    }
+  }
+
+ private:
+  Stype& S;
+  xtype& x;
+  ytype& y;
+};
+
+/*
+  Compute y = D * x where D is a diagonal matrix
+*/
+template <class Dtype, class xtype, class ytype>
+class DiagMatVecMultExpr {
+ public:
+  // Extract the numeric type to use
+  typedef typename get_object_numeric_type<ytype>::type T;
+
+  // Extract the dimensions of the matrices
+  static constexpr int N = get_diagmatrix_size<Dtype>::size;
+  static constexpr int K = get_vec_size<xtype>::size;
+  static constexpr int P = get_vec_size<ytype>::size;
+
+  static_assert(K == P, "Input vector and output vector must have same size");
+  static_assert(N == P, "matrix and vector must have compatible size");
+
+  // Get the types of the matrices
+  static constexpr ADiffType adD = get_diff_type<Dtype>::diff_type;
+  static constexpr ADiffType adx = get_diff_type<xtype>::diff_type;
+
+  // Get the differentiation order from the output
+  static constexpr ADorder order = get_diff_order<ytype>::order;
+
+  A2D_FUNCTION DiagMatVecMultExpr(Dtype& D, xtype& x, ytype& y)
+      : D(D), x(x), y(y) {}
+
+  A2D_FUNCTION void eval() {
+    DiagMatMatMultCore<T, N, 1>(get_data(D), get_data(x), get_data(y));
+  }
+
+  A2D_FUNCTION void bzero() { y.bzero(); }
+
+  template <ADorder forder>
+  A2D_FUNCTION void forward() {
+    static_assert(
+        !(order == ADorder::FIRST and forder == ADorder::SECOND),
+        "Can't perform second order forward with first order objects");
+    constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
+                                              ADseed::b, ADseed::p>::value;
+
+    if constexpr (adD == ADiffType::ACTIVE && adx == ADiffType::ACTIVE) {
+      constexpr bool additive = true;
+      DiagMatMatMultCore<T, N, 1>(GetSeed<seed>::get_data(D), get_data(x),
+                                  GetSeed<seed>::get_data(y));
+      DiagMatMatMultCore<T, N, 1, additive>(
+          get_data(D), GetSeed<seed>::get_data(x), GetSeed<seed>::get_data(y));
+    } else if constexpr (adD == ADiffType::ACTIVE) {
+      DiagMatMatMultCore<T, N, 1>(GetSeed<seed>::get_data(D), get_data(x),
+                                  GetSeed<seed>::get_data(y));
+    } else if constexpr (adx == ADiffType::ACTIVE) {
+      DiagMatMatMultCore<T, N, 1>(get_data(D), GetSeed<seed>::get_data(x),
+                                  GetSeed<seed>::get_data(y));
+    }
+  }
+
+  A2D_FUNCTION void reverse() {
+    constexpr bool additive = true;
+    if constexpr (adD == ADiffType::ACTIVE) {
+      DiagMatRowDotCore<T, N, 1>(GetSeed<ADseed::b>::get_data(y), get_data(x),
+                                 GetSeed<ADseed::b>::get_data(D));
+    }
+    if constexpr (adx == ADiffType::ACTIVE) {
+      DiagMatMatMultCore<T, N, 1, additive>(get_data(D),
+                                            GetSeed<ADseed::b>::get_data(y),
+                                            GetSeed<ADseed::b>::get_data(x));
+    }
+  }
+
+  A2D_FUNCTION void hzero() { y.hzero(); }
+
+  A2D_FUNCTION void hreverse() {
+    constexpr bool additive = true;
+    if constexpr (adD == ADiffType::ACTIVE) {
+      DiagMatRowDotCore<T, N, 1>(GetSeed<ADseed::h>::get_data(y), get_data(x),
+                                 GetSeed<ADseed::h>::get_data(D));
+    }
+    if constexpr (adx == ADiffType::ACTIVE) {
+      DiagMatMatMultCore<T, N, 1, additive>(get_data(D),
+                                            GetSeed<ADseed::h>::get_data(y),
+                                            GetSeed<ADseed::h>::get_data(x));
+    }
+    if constexpr (adD == ADiffType::ACTIVE && adx == ADiffType::ACTIVE) {
+      DiagMatRowDotCore<T, N, 1>(GetSeed<ADseed::b>::get_data(y),
+                                 GetSeed<ADseed::p>::get_data(x),
+                                 GetSeed<ADseed::h>::get_data(D));
+      DiagMatMatMultCore<T, N, 1, additive>(GetSeed<ADseed::p>::get_data(D),
+                                            GetSeed<ADseed::b>::get_data(y),
+                                            GetSeed<ADseed::h>::get_data(x));
+    }
+  }
+
+ private:
+  Dtype& D;
+  xtype& x;
+  ytype& y;
+};
+
 template <class Atype, class xtype, class ytype>
 A2D_FUNCTION auto MatVecMult(ADObj<Atype>& A, ADObj<xtype>& x,
                              ADObj<ytype>& y) {
   if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SYMMAT) {
     return SymMatVecMultExpr<ADObj<Atype>, ADObj<xtype>, ADObj<ytype>>(A, x, y);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::SKEWMAT) {
+    return SkewMatVecMultExpr<MatOp::NORMAL, ADObj<Atype>, ADObj<xtype>,
+                              ADObj<ytype>>(A, x, y);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::DIAGMAT) {
+    return DiagMatVecMultExpr<ADObj<Atype>, ADObj<xtype>, ADObj<ytype>>(A, x,
+                                                                           y);
   } else {
     return MatVecMultExpr<MatOp::NORMAL, ADObj<Atype>, ADObj<xtype>,
                           ADObj<ytype>>(A, x, y);
@@ -271,6 +542,14 @@ A2D_FUNCTION auto MatVecMult(A2DObj<Atype>& A, A2DObj<xtype>& x,
   if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SYMMAT) {
     return SymMatVecMultExpr<A2DObj<Atype>, A2DObj<xtype>, A2DObj<ytype>>(A, x,
                                                                           y);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::SKEWMAT) {
+    return SkewMatVecMultExpr<MatOp::NORMAL, A2DObj<Atype>, A2DObj<xtype>,
+                              A2DObj<ytype>>(A, x, y);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::DIAGMAT) {
+    return DiagMatVecMultExpr<A2DObj<Atype>, A2DObj<xtype>, A2DObj<ytype>>(
+        A, x, y);
   } else {
     return MatVecMultExpr<MatOp::NORMAL, A2DObj<Atype>, A2DObj<xtype>,
                           A2DObj<ytype>>(A, x, y);
@@ -280,6 +559,13 @@ template <class Atype, class xtype, class ytype>
 A2D_FUNCTION auto MatVecMult(ADObj<Atype>& A, const xtype& x, ADObj<ytype>& y) {
   if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SYMMAT) {
     return SymMatVecMultExpr<ADObj<Atype>, const xtype, ADObj<ytype>>(A, x, y);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::SKEWMAT) {
+    return SkewMatVecMultExpr<MatOp::NORMAL, ADObj<Atype>, const xtype,
+                              ADObj<ytype>>(A, x, y);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::DIAGMAT) {
+    return DiagMatVecMultExpr<ADObj<Atype>, const xtype, ADObj<ytype>>(A, x, y);
   } else {
     return MatVecMultExpr<MatOp::NORMAL, ADObj<Atype>, const xtype,
                           ADObj<ytype>>(A, x, y);
@@ -291,6 +577,14 @@ A2D_FUNCTION auto MatVecMult(A2DObj<Atype>& A, const xtype& x,
   if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SYMMAT) {
     return SymMatVecMultExpr<A2DObj<Atype>, const xtype, A2DObj<ytype>>(A, x,
                                                                         y);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::SKEWMAT) {
+    return SkewMatVecMultExpr<MatOp::NORMAL, A2DObj<Atype>, const xtype,
+                              A2DObj<ytype>>(A, x, y);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::DIAGMAT) {
+    return DiagMatVecMultExpr<A2DObj<Atype>, const xtype, A2DObj<ytype>>(A, x,
+                                                                            y);
   } else {
     return MatVecMultExpr<MatOp::NORMAL, A2DObj<Atype>, const xtype,
                           A2DObj<ytype>>(A, x, y);
@@ -300,6 +594,13 @@ template <class Atype, class xtype, class ytype>
 A2D_FUNCTION auto MatVecMult(const Atype& A, ADObj<xtype>& x, ADObj<ytype>& y) {
   if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SYMMAT) {
     return SymMatVecMultExpr<const Atype, ADObj<xtype>, ADObj<ytype>>(A, x, y);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::SKEWMAT) {
+    return SkewMatVecMultExpr<MatOp::NORMAL, const Atype, ADObj<xtype>,
+                              ADObj<ytype>>(A, x, y);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::DIAGMAT) {
+    return DiagMatVecMultExpr<const Atype, ADObj<xtype>, ADObj<ytype>>(A, x, y);
   } else {
     return MatVecMultExpr<MatOp::NORMAL, const Atype, ADObj<xtype>,
                           ADObj<ytype>>(A, x, y);
@@ -311,6 +612,14 @@ A2D_FUNCTION auto MatVecMult(const Atype& A, A2DObj<xtype>& x,
   if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SYMMAT) {
     return SymMatVecMultExpr<const Atype, A2DObj<xtype>, A2DObj<ytype>>(A, x,
                                                                         y);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::SKEWMAT) {
+    return SkewMatVecMultExpr<MatOp::NORMAL, const Atype, A2DObj<xtype>,
+                              A2DObj<ytype>>(A, x, y);
+  } else if constexpr (get_a2d_object_type<Atype>::value ==
+                       ADObjType::DIAGMAT) {
+    return DiagMatVecMultExpr<const Atype, A2DObj<xtype>, A2DObj<ytype>>(A, x,
+                                                                            y);
   } else {
     return MatVecMultExpr<MatOp::NORMAL, const Atype, A2DObj<xtype>,
                           A2DObj<ytype>>(A, x, y);
@@ -320,32 +629,286 @@ A2D_FUNCTION auto MatVecMult(const Atype& A, A2DObj<xtype>& x,
 template <MatOp op, class Atype, class xtype, class ytype>
 A2D_FUNCTION auto MatVecMult(ADObj<Atype>& A, ADObj<xtype>& x,
                              ADObj<ytype>& y) {
-  return MatVecMultExpr<op, ADObj<Atype>, ADObj<xtype>, ADObj<ytype>>(A, x, y);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    return SkewMatVecMultExpr<op, ADObj<Atype>, ADObj<xtype>,
+                              ADObj<ytype>>(A, x, y);
+  } else {
+    return MatVecMultExpr<op, ADObj<Atype>, ADObj<xtype>,
+                          ADObj<ytype>>(A, x, y);
+  }
 }
 template <MatOp op, class Atype, class xtype, class ytype>
 A2D_FUNCTION auto MatVecMult(A2DObj<Atype>& A, A2DObj<xtype>& x,
                              A2DObj<ytype>& y) {
-  return MatVecMultExpr<op, A2DObj<Atype>, A2DObj<xtype>, A2DObj<ytype>>(A, x,
-                                                                         y);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    return SkewMatVecMultExpr<op, A2DObj<Atype>, A2DObj<xtype>,
+                              A2DObj<ytype>>(A, x, y);
+  } else {
+    return MatVecMultExpr<op, A2DObj<Atype>, A2DObj<xtype>,
+                          A2DObj<ytype>>(A, x, y);
+  }
 }
 template <MatOp op, class Atype, class xtype, class ytype>
 A2D_FUNCTION auto MatVecMult(ADObj<Atype>& A, const xtype& x, ADObj<ytype>& y) {
-  return MatVecMultExpr<op, ADObj<Atype>, const xtype, ADObj<ytype>>(A, x, y);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    return SkewMatVecMultExpr<op, ADObj<Atype>, const xtype,
+                              ADObj<ytype>>(A, x, y);
+  } else {
+    return MatVecMultExpr<op, ADObj<Atype>, const xtype, ADObj<ytype>>(A, x, y);
+  }
 }
 template <MatOp op, class Atype, class xtype, class ytype>
 A2D_FUNCTION auto MatVecMult(A2DObj<Atype>& A, const xtype& x,
                              A2DObj<ytype>& y) {
-  return MatVecMultExpr<op, A2DObj<Atype>, const xtype, A2DObj<ytype>>(A, x, y);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    return SkewMatVecMultExpr<op, A2DObj<Atype>, const xtype,
+                              A2DObj<ytype>>(A, x, y);
+  } else {
+    return MatVecMultExpr<op, A2DObj<Atype>, const xtype,
+                          A2DObj<ytype>>(A, x, y);
+  }
 }
 
 template <MatOp op, class Atype, class xtype, class ytype>
 A2D_FUNCTION auto MatVecMult(const Atype& A, ADObj<xtype>& x, ADObj<ytype>& y) {
-  return MatVecMultExpr<op, const Atype, ADObj<xtype>, ADObj<ytype>>(A, x, y);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    return SkewMatVecMultExpr<op, const Atype, ADObj<xtype>,
+                              ADObj<ytype>>(A, x, y);
+  } else {
+    return MatVecMultExpr<op, const Atype, ADObj<xtype>, ADObj<ytype>>(A, x, y);
+  }
 }
 template <MatOp op, class Atype, class xtype, class ytype>
 A2D_FUNCTION auto MatVecMult(const Atype& A, A2DObj<xtype>& x,
                              A2DObj<ytype>& y) {
-  return MatVecMultExpr<op, const Atype, A2DObj<xtype>, A2DObj<ytype>>(A, x, y);
+  if constexpr (get_a2d_object_type<Atype>::value == ADObjType::SKEWMAT) {
+    return SkewMatVecMultExpr<op, const Atype, A2DObj<xtype>,
+                              A2DObj<ytype>>(A, x, y);
+  } else {
+    return MatVecMultExpr<op, const Atype, A2DObj<xtype>,
+                          A2DObj<ytype>>(A, x, y);
+  }
+}
+
+/*
+  Compute y_k = op(A) * x_k for K vectors stored as the rows of X and Y
+
+  The K x M matrix X holds x_k in row k, and similarly for Y. Each row of A is
+  loaded once per product and applied to all K vectors. The derivatives are
+
+  dot{y}_k = op(dot{A}) * x_k + op(A) * dot{x}_k
+  bar{x}_k += not_op(A) * bar{y}_k
+  bar{A} += sum_{k} bar{y}_k * x_k^{T}   (op == NORMAL)
+  bar{A} += sum_{k} x_k * bar{y}_k^{T}   (op == TRANSPOSE)
+*/
+template <MatOp op = MatOp::NORMAL, typename T, int N, int M, int K, int P,
+          int Q, MatLayout layout>
+A2D_FUNCTION void MatMultiVec(const Mat<T, N, M, layout>& A,
+                              const Mat<T, K, P>& X, Mat<T, K, Q>& Y) {
+  static_assert(((op == MatOp::NORMAL && (M == P && N == Q)) ||
+                 (op == MatOp::TRANSPOSE && (M == Q && N == P))),
+                "Matrix and vector dimensions must agree");
+  if constexpr (layout == MatLayout::ROW_MAJOR) {
+    MatMultiVecCore<T, N, M, K, op>(get_data(A), get_data(X), get_data(Y));
+  } else {
+    constexpr MatOp not_op =
+        (op == MatOp::NORMAL ? MatOp::TRANSPOSE : MatOp::NORMAL);
+    MatMultiVecCore<T, M, N, K, not_op>(get_data(A), get_data(X),
+                                        get_data(Y));
+  }
+}
+
+template <MatOp op, class Atype, class Xtype, class Ytype>
+class MatMultiVecExpr {
+ public:
+  static constexpr MatOp not_op =
+      conditional_value<MatOp, op == MatOp::NORMAL, MatOp::TRANSPOSE,
+                        MatOp::NORMAL>::value;
+
+  // Extract the numeric type to use
+  typedef typename get_object_numeric_type<Ytype>::type T;
+
+  // Extract the dimensions of the matrices
+  static constexpr int N = get_matrix_layout<Atype>::rows;
+  static constexpr int M = get_matrix_layout<Atype>::columns;
+  static constexpr int K = get_matrix_rows<Xtype>::size;
+  static constexpr int P = get_matrix_columns<Xtype>::size;
+  static constexpr int Q = get_matrix_columns<Ytype>::size;
+
+  // The cores work on the Ns x Ms storage of A, see MatVecMultExpr
+  static constexpr bool row_major =
+      (get_matrix_layout<Atype>::value == MatLayout::ROW_MAJOR);
+  static constexpr int Ns = (row_major ? N : M);
+  static constexpr int Ms = (row_major ? M : N);
+  static constexpr MatOp sop = (row_major ? op : not_op);
+  static constexpr MatOp not_sop = (row_major ? not_op : op);
+
+  // Get the types of the matrices
+  static constexpr ADiffType adA = get_diff_type<Atype>::diff_type;
+  static constexpr ADiffType adX = get_diff_type<Xtype>::diff_type;
+
+  // Get the differentiation order from the output
+  static constexpr ADorder order = get_diff_order<Ytype>::order;
+
+  A2D_FUNCTION MatMultiVecExpr(Atype& A, Xtype& X, Ytype& Y)
+      : A(A), X(X), Y(Y) {
+    static_assert(get_matrix_rows<Ytype>::size == K,
+                  "The number of vectors must agree");
+    static_assert(((op == MatOp::NORMAL && (M == P && N == Q)) ||
+                   (op == MatOp::TRANSPOSE && (M == Q && N == P))),
+                  "Matrix and vector dimensions must agree");
+  }
+
+  A2D_FUNCTION void eval() {
+    MatMultiVecCore<T, Ns, Ms, K, sop>(get_data(A), get_data(X), get_data(Y));
+  }
+
+  A2D_FUNCTION void bzero() { Y.bzero(); }
+
+  template <ADorder forder>
+  A2D_FUNCTION void forward() {
+    static_assert(
+        !(order == ADorder::FIRST and forder == ADorder::SECOND),
+        "Can't perform second order forward with first order objects");
+    constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
+                                              ADseed::b, ADseed::p>::value;
+
+    if constexpr (adA == ADiffType::ACTIVE && adX == ADiffType::ACTIVE) {
+      constexpr bool additive = true;
+      MatMultiVecCore<T, Ns, Ms, K, sop>(GetSeed<seed>::get_data(A),
+                                         get_data(X),
+                                         GetSeed<seed>::get_data(Y));
+      MatMultiVecCore<T, Ns, Ms, K, sop, additive>(
+          get_data(A), GetSeed<seed>::get_data(X), GetSeed<seed>::get_data(Y));
+    } else if constexpr (adA == ADiffType::ACTIVE) {
+      MatMultiVecCore<T, Ns, Ms, K, sop>(GetSeed<seed>::get_data(A),
+                                         get_data(X),
+                                         GetSeed<seed>::get_data(Y));
+    } else if constexpr (adX == ADiffType::ACTIVE) {
+      MatMultiVecCore<T, Ns, Ms, K, sop>(get_data(A),
+                                         GetSeed<seed>::get_data(X),
+                                         GetSeed<seed>::get_data(Y));
+    }
+  }
+
+  A2D_FUNCTION void reverse() {
+    constexpr bool additive = true;
+    if constexpr (adA == ADiffType::ACTIVE) {
+      if constexpr (sop == MatOp::NORMAL) {
+        MultiVecOuterCore<T, Ns, Ms, K, additive>(
+            GetSeed<ADseed::b>::get_data(Y), get_data(X),
+            GetSeed<ADseed::b>::get_data(A));
+      } else {
+        MultiVecOuterCore<T, Ns, Ms, K, additive>(
+            get_data(X), GetSeed<ADseed::b>::get_data(Y),
+            GetSeed<ADseed::b>::get_data(A));
+      }
+    }
+    if constexpr (adX == ADiffType::ACTIVE) {
+      MatMultiVecCore<T, Ns, Ms, K, not_sop, additive>(
+          get_data(A), GetSeed<ADseed::b>::get_data(Y),
+          GetSeed<ADseed::b>::get_data(X));
+    }
+  }
+
+  A2D_FUNCTION void hzero() { Y.hzero(); }
+
+  A2D_FUNCTION void hreverse() {
+    static_assert(order == ADorder::SECOND,
+                  "hreverse() can be called for only second order objects.");
+    constexpr bool additive = true;
+    if constexpr (adA == ADiffType::ACTIVE) {
+      if constexpr (sop == MatOp::NORMAL) {
+        MultiVecOuterCore<T, Ns, Ms, K, additive>(
+            GetSeed<ADseed::h>::get_data(Y), get_data(X),
+            GetSeed<ADseed::h>::get_data(A));
+      } else {
+        MultiVecOuterCore<T, Ns, Ms, K, additive>(
+            get_data(X), GetSeed<ADseed::h>::get_data(Y),
+            GetSeed<ADseed::h>::get_data(A));
+      }
+    }
+    if constexpr (adX == ADiffType::ACTIVE) {
+      MatMultiVecCore<T, Ns, Ms, K, not_sop, additive>(
+          get_data(A), GetSeed<ADseed::h>::get_data(Y),
+          GetSeed<ADseed::h>::get_data(X));
+    }
+    if constexpr (adA == ADiffType::ACTIVE && adX == ADiffType::ACTIVE) {
+      if constexpr (sop == MatOp::NORMAL) {
+        MultiVecOuterCore<T, Ns, Ms, K, additive>(
+            GetSeed<ADseed::b>::get_data(Y), GetSeed<ADseed::p>::get_data(X),
+            GetSeed<ADseed::h>::get_data(A));
+      } else {
+        MultiVecOuterCore<T, Ns, Ms, K, additive>(
+            GetSeed<ADseed::p>::get_data(X), GetSeed<ADseed::b>::get_data(Y),
+            GetSeed<ADseed::h>::get_data(A));
+      }
+
+      MatMultiVecCore<T, Ns, Ms, K, not_sop, additive>(
+          GetSeed<ADseed::p>::get_data(A), GetSeed<ADseed::b>::get_data(Y),
+          GetSeed<ADseed::h>::get_data(X));
+    }
+  }
+
+  // Operation counts for the compile-time cost model
+  static constexpr ADCost cost() {
+    constexpr index_t flops = 2 * N * M * K;
+    constexpr index_t sizeA = N * M;
+    constexpr index_t sizeX = K * P, sizeY = K * Q;
+    constexpr index_t actA = (adA == ADiffType::ACTIVE);
+    constexpr index_t actX = (adX == ADiffType::ACTIVE);
+
+    ADCost c("MatMultiVec");
+    c.eval = KernelCost<T>(flops, sizeA + sizeX, sizeY);
+    c.forward = (actA + actX) * KernelCost<T>(flops, sizeA + sizeX, sizeY) +
+                actA * actX * KernelCost<T>(0, sizeY, 0);
+    c.reverse =
+        actA * KernelCost<T>(flops, sizeA + sizeX + sizeY, sizeA) +
+        actX * KernelCost<T>(flops, sizeA + sizeX + sizeY, sizeX);
+    c.hforward = c.forward;
+    c.hreverse = (1 + actA * actX) * c.reverse;
+    return c;
+  }
+
+ private:
+  Atype& A;
+  Xtype& X;
+  Ytype& Y;
+};
+
+template <MatOp op = MatOp::NORMAL, class Atype, class Xtype, class Ytype>
+A2D_FUNCTION auto MatMultiVec(ADObj<Atype>& A, ADObj<Xtype>& X,
+                              ADObj<Ytype>& Y) {
+  return MatMultiVecExpr<op, ADObj<Atype>, ADObj<Xtype>, ADObj<Ytype>>(A, X,
+                                                                       Y);
+}
+template <MatOp op = MatOp::NORMAL, class Atype, class Xtype, class Ytype>
+A2D_FUNCTION auto MatMultiVec(A2DObj<Atype>& A, A2DObj<Xtype>& X,
+                              A2DObj<Ytype>& Y) {
+  return MatMultiVecExpr<op, A2DObj<Atype>, A2DObj<Xtype>, A2DObj<Ytype>>(A, X,
+                                                                          Y);
+}
+template <MatOp op = MatOp::NORMAL, class Atype, class Xtype, class Ytype>
+A2D_FUNCTION auto MatMultiVec(ADObj<Atype>& A, const Xtype& X,
+                              ADObj<Ytype>& Y) {
+  return MatMultiVecExpr<op, ADObj<Atype>, const Xtype, ADObj<Ytype>>(A, X, Y);
+}
+template <MatOp op = MatOp::NORMAL, class Atype, class Xtype, class Ytype>
+A2D_FUNCTION auto MatMultiVec(A2DObj<Atype>& A, const Xtype& X,
+                              A2DObj<Ytype>& Y) {
+  return MatMultiVecExpr<op, A2DObj<Atype>, const Xtype, A2DObj<Ytype>>(A, X,
+                                                                        Y);
+}
+template <MatOp op = MatOp::NORMAL, class Atype, class Xtype, class Ytype>
+A2D_FUNCTION auto MatMultiVec(const Atype& A, ADObj<Xtype>& X,
+                              ADObj<Ytype>& Y) {
+  return MatMultiVecExpr<op, const Atype, ADObj<Xtype>, ADObj<Ytype>>(A, X, Y);
+}
+template <MatOp op = MatOp::NORMAL, class Atype, class Xtype, class Ytype>
+A2D_FUNCTION auto MatMultiVec(const Atype& A, A2DObj<Xtype>& X,
+                              A2DObj<Ytype>& Y) {
+  return MatMultiVecExpr<op, const Atype, A2DObj<Xtype>, A2DObj<Ytype>>(A, X,
+                                                                        Y);
 }
 
 // now define MatScale
@@ -475,10 +1038,12 @@ A2D_FUNCTION auto MatScale(A2DObj<T>& alpha, const Atype& x, A2DObj<Btype>& y) {
 
 namespace Test {
 
-template <MatOp op, typename T, int N, int M, int K, int P>
-class MatVecMultTest : public A2DTest<T, Vec<T, P>, Mat<T, N, M>, Vec<T, K>> {
+template <MatOp op, typename T, int N, int M, int K, int P,
+          MatLayout layout = MatLayout::ROW_MAJOR>
+class MatVecMultTest
+    : public A2DTest<T, Vec<T, P>, Mat<T, N, M, layout>, Vec<T, K>> {
  public:
-  using Input = VarTuple<T, Mat<T, N, M>, Vec<T, K>>;
+  using Input = VarTuple<T, Mat<T, N, M, layout>, Vec<T, K>>;
   using Output = VarTuple<T, Vec<T, P>>;
 
   // Assemble a string to describe the test
@@ -490,13 +1055,16 @@ class MatVecMultTest : public A2DTest<T, Vec<T, P>, Mat<T, N, M>, Vec<T, K>> {
     } else {
       s << "T,";
     }
+    if (layout == MatLayout::COLUMN_MAJOR) {
+      s << "C,";
+    }
     s << N << "," << M << "," << K << "," << P << ">";
     return s.str();
   }
 
   // Evaluate the matrix-matrix product
   Output eval(const Input& X) {
-    Mat<T, N, M> A;
+    Mat<T, N, M, layout> A;
     Vec<T, K> x;
     Vec<T, P> y;
 
@@ -507,7 +1075,7 @@ class MatVecMultTest : public A2DTest<T, Vec<T, P>, Mat<T, N, M>, Vec<T, K>> {
 
   // Compute the derivative
   void deriv(const Output& seed, const Input& X, Input& g) {
-    ADObj<Mat<T, N, M>> A;
+    ADObj<Mat<T, N, M, layout>> A;
     ADObj<Vec<T, K>> x;
     ADObj<Vec<T, P>> y;
 
@@ -521,7 +1089,7 @@ class MatVecMultTest : public A2DTest<T, Vec<T, P>, Mat<T, N, M>, Vec<T, K>> {
   // Compute the second-derivative
   void hprod(const Output& seed, const Output& hval, const Input& X,
              const Input& p, Input& h) {
-    A2DObj<Mat<T, N, M>> A;
+    A2DObj<Mat<T, N, M, layout>> A;
     A2DObj<Vec<T, K>> x;
     A2DObj<Vec<T, P>> y;
 
@@ -535,6 +1103,87 @@ class MatVecMultTest : public A2DTest<T, Vec<T, P>, Mat<T, N, M>, Vec<T, K>> {
   }
 };
 
+template <MatOp op, typename T, int N, int M, int K, int P, int Q,
+          MatLayout layout = MatLayout::ROW_MAJOR>
+class MatMultiVecTest
+    : public A2DTest<T, Mat<T, K, Q>, Mat<T, N, M, layout>, Mat<T, K, P>> {
+ public:
+  using Input = VarTuple<T, Mat<T, N, M, layout>, Mat<T, K, P>>;
+  using Output = VarTuple<T, Mat<T, K, Q>>;
+
+  // Assemble a string to describe the test
+  std::string name() {
+    std::stringstream s;
+    s << "MatMultiVec<";
+    if (op == MatOp::NORMAL) {
+      s << "N,";
+    } else {
+      s << "T,";
+    }
+    if (layout == MatLayout::COLUMN_MAJOR) {
+      s << "C,";
+    }
+    s << N << "," << M << "," << K << "," << P << "," << Q << ">";
+    return s.str();
+  }
+
+  // Operation counts of the stack used in deriv and hprod
+  ADCost cost() {
+    return MatMultiVecExpr<op, A2DObj<Mat<T, N, M, layout>>,
+                           A2DObj<Mat<T, K, P>>, A2DObj<Mat<T, K, Q>>>::cost();
+  }
+
+  // Evaluate the products one vector at a time with MatVecMult
+  Output eval(const Input& In) {
+    Mat<T, N, M, layout> A;
+    Mat<T, K, P> X;
+    Mat<T, K, Q> Y;
+
+    In.get_values(A, X);
+    for (int k = 0; k < K; k++) {
+      Vec<T, P> x;
+      Vec<T, Q> y;
+      for (int j = 0; j < P; j++) {
+        x[j] = X(k, j);
+      }
+      MatVecMult<op>(A, x, y);
+      for (int j = 0; j < Q; j++) {
+        Y(k, j) = y[j];
+      }
+    }
+    return MakeVarTuple<T>(Y);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& In, Input& g) {
+    ADObj<Mat<T, N, M, layout>> A;
+    ADObj<Mat<T, K, P>> X;
+    ADObj<Mat<T, K, Q>> Y;
+
+    In.get_values(A.value(), X.value());
+    auto stack = MakeStack(MatMultiVec<op>(A, X, Y));
+    seed.get_values(Y.bvalue());
+    stack.reverse();
+    g.set_values(A.bvalue(), X.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& In,
+             const Input& p, Input& h) {
+    A2DObj<Mat<T, N, M, layout>> A;
+    A2DObj<Mat<T, K, P>> X;
+    A2DObj<Mat<T, K, Q>> Y;
+
+    In.get_values(A.value(), X.value());
+    p.get_values(A.pvalue(), X.pvalue());
+    auto stack = MakeStack(MatMultiVec<op>(A, X, Y));
+    seed.get_values(Y.bvalue());
+    hval.get_values(Y.hvalue());
+    stack.hproduct();
+    h.set_values(A.hvalue(), X.hvalue());
+  }
+};
+
 template <typename T, int N>
 class SymMatVecMultTest
     : public A2DTest<T, Vec<T, N>, SymMat<T, N>, Vec<T, N>> {
@@ -615,6 +1264,12 @@ bool MatVecMultTestHelper(bool component = false, bool write_output = true) {
   MatVecMultTest<TRANSPOSE, Tc, M, N, M, N> test2;
   passed = passed && Run(test2, component, write_output);
 
+  MatVecMultTest<NORMAL, Tc, N, M, M, N, MatLayout::COLUMN_MAJOR> test3;
+  passed = passed && Run(test3, component, write_output);
+
+  MatVecMultTest<TRANSPOSE, Tc, M, N, M, N, MatLayout::COLUMN_MAJOR> test4;
+  passed = passed && Run(test4, component, write_output);
+
   return passed;
 }
 
@@ -631,6 +1286,39 @@ inline bool MatVecMultTestAll(bool component = false,
   return passed;
 }
 
+template <typename T, int N, int M, int K>
+bool MatMultiVecTestHelper(bool component = false, bool write_output = true) {
+  const MatOp NORMAL = MatOp::NORMAL;
+  const MatOp TRANSPOSE = MatOp::TRANSPOSE;
+  using Tc = A2D_complex_t<T>;
+
+  bool passed = true;
+  MatMultiVecTest<NORMAL, Tc, N, M, K, M, N> test1;
+  passed = passed && Run(test1, component, write_output);
+
+  MatMultiVecTest<TRANSPOSE, Tc, N, M, K, N, M> test2;
+  passed = passed && Run(test2, component, write_output);
+
+  MatMultiVecTest<NORMAL, Tc, N, M, K, M, N, MatLayout::COLUMN_MAJOR> test3;
+  passed = passed && Run(test3, component, write_output);
+
+  MatMultiVecTest<TRANSPOSE, Tc, N, M, K, N, M, MatLayout::COLUMN_MAJOR> test4;
+  passed = passed && Run(test4, component, write_output);
+
+  return passed;
+}
+
+inline bool MatMultiVecTestAll(bool component = false,
+                               bool write_output = true) {
+  bool passed = true;
+  passed = passed &&
+           MatMultiVecTestHelper<double, 3, 3, 4>(component, write_output);
+  passed = passed &&
+           MatMultiVecTestHelper<double, 2, 5, 3>(component, write_output);
+
+  return passed;
+}
+
 inline bool SymMatVecMultTestAll(bool component = false,
                                  bool write_output = true) {
   bool passed = true;
@@ -646,6 +1334,140 @@ inline bool SymMatVecMultTestAll(bool component = false,
   return passed;
 }
 
+template <MatOp op, typename T>
+class SkewMatVecMultTest
+    : public A2DTest<T, Vec<T, 3>, SkewMat<T, 3>, Vec<T, 3>> {
+ public:
+  using Input = VarTuple<T, SkewMat<T, 3>, Vec<T, 3>>;
+  using Output = VarTuple<T, Vec<T, 3>>;
+
+  // Assemble a string to describe the test
+  std::string name() {
+    std::stringstream s;
+    s << "SkewMatVecMult<" << (op == MatOp::NORMAL ? "N" : "T") << ">";
+    return s.str();
+  }
+
+  // Evaluate the matrix-vector product
+  Output eval(const Input& X) {
+    SkewMat<T, 3> S;
+    Vec<T, 3> x, y;
+    X.get_values(S, x);
+    product(S, x, y);
+    return MakeVarTuple<T>(y);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& X, Input& g) {
+    ADObj<SkewMat<T, 3>> S;
+    ADObj<Vec<T, 3>> x, y;
+    X.get_values(S.value(), x.value());
+    auto stack = MakeStack(product(S, x, y));
+    seed.get_values(y.bvalue());
+    stack.reverse();
+    g.set_values(S.bvalue(), x.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& X,
+             const Input& p, Input& h) {
+    A2DObj<SkewMat<T, 3>> S;
+    A2DObj<Vec<T, 3>> x, y;
+    X.get_values(S.value(), x.value());
+    p.get_values(S.pvalue(), x.pvalue());
+    auto stack = MakeStack(product(S, x, y));
+    seed.get_values(y.bvalue());
+    hval.get_values(y.hvalue());
+    stack.hproduct();
+    h.set_values(S.hvalue(), x.hvalue());
+  }
+
+ private:
+  // Use the plain factory for S and the op-templated one for S^{T}
+  template <class Stype, class xtype, class ytype>
+  static auto product(Stype& S, xtype& x, ytype& y) {
+    if constexpr (op == MatOp::NORMAL) {
+      return MatVecMult(S, x, y);
+    } else {
+      return MatVecMult<op>(S, x, y);
+    }
+  }
+};
+
+inline bool SkewMatVecMultTestAll(bool component = false,
+                                  bool write_output = true) {
+  using Tc = A2D_complex_t<double>;
+
+  SkewMatVecMultTest<MatOp::NORMAL, Tc> test1;
+  bool passed = Run(test1, component, write_output);
+  SkewMatVecMultTest<MatOp::TRANSPOSE, Tc> test2;
+  passed = passed && Run(test2, component, write_output);
+
+  return passed;
+}
+
+template <typename T, int N>
+class DiagMatVecMultTest
+    : public A2DTest<T, Vec<T, N>, DiagMat<T, N>, Vec<T, N>> {
+ public:
+  using Input = VarTuple<T, DiagMat<T, N>, Vec<T, N>>;
+  using Output = VarTuple<T, Vec<T, N>>;
+
+  // Assemble a string to describe the test
+  std::string name() {
+    std::stringstream s;
+    s << "DiagMatVecMult<" << N << ">";
+    return s.str();
+  }
+
+  // Evaluate the matrix-vector product
+  Output eval(const Input& X) {
+    DiagMat<T, N> D;
+    Vec<T, N> x, y;
+    X.get_values(D, x);
+    MatVecMult(D, x, y);
+    return MakeVarTuple<T>(y);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& X, Input& g) {
+    ADObj<DiagMat<T, N>> D;
+    ADObj<Vec<T, N>> x, y;
+    X.get_values(D.value(), x.value());
+    auto stack = MakeStack(MatVecMult(D, x, y));
+    seed.get_values(y.bvalue());
+    stack.reverse();
+    g.set_values(D.bvalue(), x.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& X,
+             const Input& p, Input& h) {
+    A2DObj<DiagMat<T, N>> D;
+    A2DObj<Vec<T, N>> x, y;
+    X.get_values(D.value(), x.value());
+    p.get_values(D.pvalue(), x.pvalue());
+    auto stack = MakeStack(MatVecMult(D, x, y));
+    seed.get_values(y.bvalue());
+    hval.get_values(y.hvalue());
+    stack.hproduct();
+    h.set_values(D.hvalue(), x.hvalue());
+  }
+};
+
+inline bool DiagMatVecMultTestAll(bool component = false,
+                                  bool write_output = true) {
+  using Tc = A2D_complex_t<double>;
+
+  bool passed = true;
+  DiagMatVecMultTest<Tc, 3> test1;
+  passed = passed && Run(test1, component, write_output);
+  DiagMatVecMultTest<Tc, 5> test2;
+  passed = passed && Run(test2, component, write_output);
+
+  return passed;
+}
+
 }  // namespace Test
 
 }  // namespace A2D
@@ -291,6 +291,76 @@ struct get_symmatrix_size
                 "get_symmatrix_size called on incorrect type");
 };
 
+/*
+  Get the skew-symmetric matrix size
+*/
+template <class T>
+struct __get_skewmatrix_size {
+  static constexpr int size = 0;
+};
+
+template <typename T, int N>
+struct __get_skewmatrix_size<SkewMat<T, N>> {
+  static constexpr int size = N;
+};
+
+template <class T>
+struct get_skewmatrix_size
+    : __get_skewmatrix_size<typename remove_a2dobj<T>::type> {
+  static_assert(get_a2d_object_type<T>::value == ADObjType::SKEWMAT,
+                "get_skewmatrix_size called on incorrect type");
+};
+
+/*
+  Get the diagonal matrix size
+*/
+template <class T>
+struct __get_diagmatrix_size {
+  static constexpr int size = 0;
+};
+
+template <typename T, int N>
+struct __get_diagmatrix_size<DiagMat<T, N>> {
+  static constexpr int size = N;
+};
+
+template <class T>
+struct get_diagmatrix_size
+    : __get_diagmatrix_size<typename remove_a2dobj<T>::type> {
+  static_assert(get_a2d_object_type<T>::value == ADObjType::DIAGMAT,
+                "get_diagmatrix_size called on incorrect type");
+};
+
+/*
+  Get the storage layout of a matrix and its dimensions. The operations that
+  handle both layouts use this in place of get_matrix_rows and
+  get_matrix_columns, which only accept row-major matrices.
+*/
+template <class T>
+struct __get_matrix_layout {
+  static constexpr MatLayout value = MatLayout::ROW_MAJOR;
+  static constexpr int rows = 0;
+  static constexpr int columns = 0;
+};
+
+template <typename T, int N, int M, MatLayout layout>
+struct __get_matrix_layout<Mat<T, N, M, layout>> {
+  static constexpr MatLayout value = layout;
+  static constexpr int rows = N;
+  static constexpr int columns = M;
+};
+
+template <typename T, int N, int M, MatLayout layout>
+struct __get_matrix_layout<MatView<T, N, M, layout>> {
+  static constexpr MatLayout value = layout;
+  static constexpr int rows = N;
+  static constexpr int columns = M;
+};
+
+template <class T>
+struct get_matrix_layout
+    : __get_matrix_layout<typename remove_a2dobj<T>::type> {};
+
 /*
   Get the number of matrix rows
 */
@@ -299,8 +369,13 @@ struct __get_matrix_rows {
   static constexpr int size = 0;
 };
 
-template <template <typename, int, int> class Mat, typename T, int N, int M>
-struct __get_matrix_rows<Mat<T, N, M>> {
+template <typename T, int N, int M, MatLayout layout>
+struct __get_matrix_rows<Mat<T, N, M, layout>> {
+  static constexpr int size = N;
+};
+
+template <typename T, int N, int M, MatLayout layout>
+struct __get_matrix_rows<MatView<T, N, M, layout>> {
   static constexpr int size = N;
 };
 
@@ -313,6 +388,8 @@ template <class T>
 struct get_matrix_rows : __get_matrix_rows<typename remove_a2dobj<T>::type> {
   static_assert(get_a2d_object_type<T>::value == ADObjType::MATRIX,
                 "get_matrix_rows called on incorrect type");
+  static_assert(get_matrix_layout<T>::value == MatLayout::ROW_MAJOR,
+                "Operation requires a row-major matrix");
 };
 
 /*
@@ -323,8 +400,13 @@ struct __get_matrix_columns {
   static constexpr int size = 0;
 };
 
-template <template <typename, int, int> class Mat, typename T, int N, int M>
-struct __get_matrix_columns<Mat<T, N, M>> {
+template <typename T, int N, int M, MatLayout layout>
+struct __get_matrix_columns<Mat<T, N, M, layout>> {
+  static constexpr int size = M;
+};
+
+template <typename T, int N, int M, MatLayout layout>
+struct __get_matrix_columns<MatView<T, N, M, layout>> {
   static constexpr int size = M;
 };
 
@@ -338,6 +420,8 @@ struct get_matrix_columns
     : __get_matrix_columns<typename remove_a2dobj<T>::type> {
   static_assert(get_a2d_object_type<T>::value == ADObjType::MATRIX,
                 "get_matrix_rows called on incorrect type");
+  static_assert(get_matrix_layout<T>::value == MatLayout::ROW_MAJOR,
+                "Operation requires a row-major matrix");
 };
 
 /*
@@ -353,16 +437,33 @@ struct __get_num_matrix_entries<SymMat<T, N>> {
   static constexpr int size = N * (N + 1) / 2;
 };
 
-template <template <typename, int, int> class Mat, typename T, int N, int M>
-struct __get_num_matrix_entries<Mat<T, N, M>> {
+template <typename T, int N, int M, MatLayout layout>
+struct __get_num_matrix_entries<Mat<T, N, M, layout>> {
+  static constexpr int size = N * M;
+};
+
+template <typename T, int N, int M, MatLayout layout>
+struct __get_num_matrix_entries<MatView<T, N, M, layout>> {
   static constexpr int size = N * M;
 };
 
+template <typename T, int N>
+struct __get_num_matrix_entries<SkewMat<T, N>> {
+  static constexpr int size = 3;
+};
+
+template <typename T, int N>
+struct __get_num_matrix_entries<DiagMat<T, N>> {
+  static constexpr int size = N;
+};
+
 template <class T>
 struct get_num_matrix_entries
     : __get_num_matrix_entries<typename remove_a2dobj<T>::type> {
   static_assert((get_a2d_object_type<T>::value == ADObjType::MATRIX ||
-                 get_a2d_object_type<T>::value == ADObjType::SYMMAT),
+                 get_a2d_object_type<T>::value == ADObjType::SYMMAT ||
+                 get_a2d_object_type<T>::value == ADObjType::SKEWMAT ||
+                 get_a2d_object_type<T>::value == ADObjType::DIAGMAT),
                 "get_num_matrix_entries called on incorrect type");
 };
 
@@ -528,14 +629,33 @@ class GetSeed {
     }
   }
 
-  template <typename T, int m, int n>
-  static A2D_FUNCTION T* get_data(ADObj<Mat<T, m, n>>& mat) {
+  template <typename T, int m, int n, MatLayout layout>
+  static A2D_FUNCTION T* get_data(ADObj<Mat<T, m, n, layout>>& mat) {
+    static_assert(seed == ADseed::b, "Incompatible seed type for ADObj");
+    return mat.bvalue().get_data();
+  }
+
+  template <typename T, int m, int n, MatLayout layout>
+  static A2D_FUNCTION T* get_data(A2DObj<Mat<T, m, n, layout>>& mat) {
+    static_assert(seed == ADseed::b or seed == ADseed::p or seed == ADseed::h,
+                  "Incompatible seed type for A2DObj");
+    if constexpr (seed == ADseed::b) {
+      return mat.bvalue().get_data();
+    } else if constexpr (seed == ADseed::p) {
+      return mat.pvalue().get_data();
+    } else {  // seed == ADseed::h
+      return mat.hvalue().get_data();
+    }
+  }
+
+  template <typename T, int m, int n, MatLayout layout>
+  static A2D_FUNCTION T* get_data(ADObj<MatView<T, m, n, layout>>& mat) {
     static_assert(seed == ADseed::b, "Incompatible seed type for ADObj");
     return mat.bvalue().get_data();
   }
 
-  template <typename T, int m, int n>
-  static A2D_FUNCTION T* get_data(A2DObj<Mat<T, m, n>>& mat) {
+  template <typename T, int m, int n, MatLayout layout>
+  static A2D_FUNCTION T* get_data(A2DObj<MatView<T, m, n, layout>>& mat) {
     static_assert(seed == ADseed::b or seed == ADseed::p or seed == ADseed::h,
                   "Incompatible seed type for A2DObj");
     if constexpr (seed == ADseed::b) {
@@ -585,14 +705,14 @@ class GetSeed {
     }
   }
 
-  template <typename T, int m, int n>
-  static A2D_FUNCTION T* get_data(ADObj<Mat<T, m, n>&>& mat) {
+  template <typename T, int m, int n, MatLayout layout>
+  static A2D_FUNCTION T* get_data(ADObj<Mat<T, m, n, layout>&>& mat) {
     static_assert(seed == ADseed::b, "Incompatible seed type for ADObj");
     return mat.bvalue().get_data();
   }
 
-  template <typename T, int m, int n>
-  static A2D_FUNCTION T* get_data(A2DObj<Mat<T, m, n>&>& mat) {
+  template <typename T, int m, int n, MatLayout layout>
+  static A2D_FUNCTION T* get_data(A2DObj<Mat<T, m, n, layout>&>& mat) {
     static_assert(seed == ADseed::b or seed == ADseed::p or seed == ADseed::h,
                   "Incompatible seed type for A2DObj");
     if constexpr (seed == ADseed::b) {
@@ -622,6 +742,82 @@ class GetSeed {
       return mat.hvalue().get_data();
     }
   }
+
+  template <typename T, int m>
+  static A2D_FUNCTION T* get_data(ADObj<SkewMat<T, m>>& mat) {
+    static_assert(seed == ADseed::b, "Incompatible seed type for ADObj");
+    return mat.bvalue().get_data();
+  }
+
+  template <typename T, int m>
+  static A2D_FUNCTION T* get_data(A2DObj<SkewMat<T, m>>& mat) {
+    static_assert(seed == ADseed::b or seed == ADseed::p or seed == ADseed::h,
+                  "Incompatible seed type for A2DObj");
+    if constexpr (seed == ADseed::b) {
+      return mat.bvalue().get_data();
+    } else if constexpr (seed == ADseed::p) {
+      return mat.pvalue().get_data();
+    } else {  // seed == ADseed::h
+      return mat.hvalue().get_data();
+    }
+  }
+
+  template <typename T, int m>
+  static A2D_FUNCTION T* get_data(ADObj<SkewMat<T, m>&>& mat) {
+    static_assert(seed == ADseed::b, "Incompatible seed type for ADObj");
+    return mat.bvalue().get_data();
+  }
+
+  template <typename T, int m>
+  static A2D_FUNCTION T* get_data(A2DObj<SkewMat<T, m>&>& mat) {
+    static_assert(seed == ADseed::b or seed == ADseed::p or seed == ADseed::h,
+                  "Incompatible seed type for A2DObj");
+    if constexpr (seed == ADseed::b) {
+      return mat.bvalue().get_data();
+    } else if constexpr (seed == ADseed::p) {
+      return mat.pvalue().get_data();
+    } else {  // seed == ADseed::h
+      return mat.hvalue().get_data();
+    }
+  }
+
+  template <typename T, int m>
+  static A2D_FUNCTION T* get_data(ADObj<DiagMat<T, m>>& mat) {
+    static_assert(seed == ADseed::b, "Incompatible seed type for ADObj");
+    return mat.bvalue().get_data();
+  }
+
+  template <typename T, int m>
+  static A2D_FUNCTION T* get_data(A2DObj<DiagMat<T, m>>& mat) {
+    static_assert(seed == ADseed::b or seed == ADseed::p or seed == ADseed::h,
+                  "Incompatible seed type for A2DObj");
+    if constexpr (seed == ADseed::b) {
+      return mat.bvalue().get_data();
+    } else if constexpr (seed == ADseed::p) {
+      return mat.pvalue().get_data();
+    } else {  // seed == ADseed::h
+      return mat.hvalue().get_data();
+    }
+  }
+
+  template <typename T, int m>
+  static A2D_FUNCTION T* get_data(ADObj<DiagMat<T, m>&>& mat) {
+    static_assert(seed == ADseed::b, "Incompatible seed type for ADObj");
+    return mat.bvalue().get_data();
+  }
+
+  template <typename T, int m>
+  static A2D_FUNCTION T* get_data(A2DObj<DiagMat<T, m>&>& mat) {
+    static_assert(seed == ADseed::b or seed == ADseed::p or seed == ADseed::h,
+                  "Incompatible seed type for A2DObj");
+    if constexpr (seed == ADseed::b) {
+      return mat.bvalue().get_data();
+    } else if constexpr (seed == ADseed::p) {
+      return mat.pvalue().get_data();
+    } else {  // seed == ADseed::h
+      return mat.hvalue().get_data();
+    }
+  }
 };
 
 template <typename T, std::enable_if_t<is_numeric_type<T>::value, bool> = true>
@@ -657,33 +853,48 @@ A2D_FUNCTION const T& get_data(const A2DObj<T>& value) {
 /**
  * @brief Get data pointers from objects
  */
-template <typename T, int m, int n>
-A2D_FUNCTION T* get_data(Mat<T, m, n>& mat) {
+template <typename T, int m, int n, MatLayout layout>
+A2D_FUNCTION T* get_data(Mat<T, m, n, layout>& mat) {
   return mat.get_data();
 }
 
-template <typename T, int m, int n>
-A2D_FUNCTION const T* get_data(const Mat<T, m, n>& mat) {
+template <typename T, int m, int n, MatLayout layout>
+A2D_FUNCTION const T* get_data(const Mat<T, m, n, layout>& mat) {
   return mat.get_data();
 }
 
-template <typename T, int m, int n>
-A2D_FUNCTION T* get_data(ADObj<Mat<T, m, n>>& mat) {
+template <typename T, int m, int n, MatLayout layout>
+A2D_FUNCTION T* get_data(ADObj<Mat<T, m, n, layout>>& mat) {
+  return mat.value().get_data();
+}
+
+template <typename T, int m, int n, MatLayout layout>
+A2D_FUNCTION T* get_data(A2DObj<Mat<T, m, n, layout>>& mat) {
   return mat.value().get_data();
 }
 
-template <typename T, int m, int n>
-A2D_FUNCTION T* get_data(A2DObj<Mat<T, m, n>>& mat) {
+template <typename T, int m, int n, MatLayout layout>
+A2D_FUNCTION T* get_data(ADObj<Mat<T, m, n, layout>&>& mat) {
   return mat.value().get_data();
 }
 
-template <typename T, int m, int n>
-A2D_FUNCTION T* get_data(ADObj<Mat<T, m, n>&>& mat) {
+template <typename T, int m, int n, MatLayout layout>
+A2D_FUNCTION T* get_data(A2DObj<Mat<T, m, n, layout>&>& mat) {
+  return mat.value().get_data();
+}
+
+template <typename T, int m, int n, MatLayout layout>
+A2D_FUNCTION T* get_data(const MatView<T, m, n, layout>& mat) {
+  return mat.get_data();
+}
+
+template <typename T, int m, int n, MatLayout layout>
+A2D_FUNCTION T* get_data(ADObj<MatView<T, m, n, layout>>& mat) {
   return mat.value().get_data();
 }
 
-template <typename T, int m, int n>
-A2D_FUNCTION T* get_data(A2DObj<Mat<T, m, n>&>& mat) {
+template <typename T, int m, int n, MatLayout layout>
+A2D_FUNCTION T* get_data(A2DObj<MatView<T, m, n, layout>>& mat) {
   return mat.value().get_data();
 }
 
@@ -717,6 +928,66 @@ A2D_FUNCTION T* get_data(A2DObj<SymMat<T, m>&>& mat) {
   return mat.value().get_data();
 }
 
+template <typename T, int m>
+A2D_FUNCTION T* get_data(SkewMat<T, m>& mat) {
+  return mat.get_data();
+}
+
+template <typename T, int m>
+A2D_FUNCTION const T* get_data(const SkewMat<T, m>& mat) {
+  return mat.get_data();
+}
+
+template <typename T, int m>
+A2D_FUNCTION T* get_data(ADObj<SkewMat<T, m>>& mat) {
+  return mat.value().get_data();
+}
+
+template <typename T, int m>
+A2D_FUNCTION T* get_data(A2DObj<SkewMat<T, m>>& mat) {
+  return mat.value().get_data();
+}
+
+template <typename T, int m>
+A2D_FUNCTION T* get_data(ADObj<SkewMat<T, m>&>& mat) {
+  return mat.value().get_data();
+}
+
+template <typename T, int m>
+A2D_FUNCTION T* get_data(A2DObj<SkewMat<T, m>&>& mat) {
+  return mat.value().get_data();
+}
+
+template <typename T, int m>
+A2D_FUNCTION T* get_data(DiagMat<T, m>& mat) {
+  return mat.get_data();
+}
+
+template <typename T, int m>
+A2D_FUNCTION const T* get_data(const DiagMat<T, m>& mat) {
+  return mat.get_data();
+}
+
+template <typename T, int m>
+A2D_FUNCTION T* get_data(ADObj<DiagMat<T, m>>& mat) {
+  return mat.value().get_data();
+}
+
+template <typename T, int m>
+A2D_FUNCTION T* get_data(A2DObj<DiagMat<T, m>>& mat) {
+  return mat.value().get_data();
+}
+
+template <typename T, int m>
+A2D_FUNCTION T* get_data(ADObj<DiagMat<T, m>&>& mat) {
+  return mat.value().get_data();
+}
+
+template <typename T, int m>
+A2D_FUNCTION T* get_data(A2DObj<DiagMat<T, m>&>& mat) {
+  return mat.value().get_data();
+}
+
 template <typename T, int n>
 A2D_FUNCTION T* get_data(Vec<T, n>& vec) {
   return vec.get_data();
@@ -748,21 +1019,14 @@ A2D_FUNCTION T* get_data(A2DObj<Vec<T, n>&>& vec) {
 }
 
 // new ADScalar get_data  (SPE)
+// The numeric type may itself be an ADScalar for forward-over-forward second
+// derivatives with ADScalar<ADScalar<T, N>, N>
 template <class T, int N>
-struct __is_numeric_type<ADScalar<T, N>> : std::is_floating_point<T> {};
+struct __is_numeric_type<ADScalar<T, N>> : is_numeric_type<T> {};
 
 template <class T, int N>
-struct __is_numeric_type<ADScalar<A2D_complex_t<T>, N>>
-    : std::is_floating_point<T> {};
-
-template <int N>
-struct __get_object_numeric_type<ADScalar<double, N>> {
-  using type = ADScalar<double, N>;
-};
-
-template <int N>
-struct __get_object_numeric_type<ADScalar<A2D_complex_t<double>, N>> {
-  using type = ADScalar<A2D_complex_t<double>, N>;
+struct __get_object_numeric_type<ADScalar<T, N>> {
+  using type = ADScalar<T, N>;
 };
 
 template <typename T, int N,
@@ -898,6 +1162,45 @@ A2D_FUNCTION ADScalar<T, N>* get_data(A2DObj<Vec<ADScalar<T, N>, n>&>& vec) {
   return vec.value().get_data();
 }
 
+/*
+  Transposed views of a matrix
+
+  The transpose of a row-major M x N matrix is a column-major N x M view of
+  the same storage, and conversely. For the AD objects the view also refers
+  to the storage of the derivatives, so the view can be used as an operand
+  or output of an expression in place of the transpose without a copy. The
+  returned object must outlive the expressions that use it.
+*/
+template <MatLayout layout>
+using transpose_layout =
+    conditional_value<MatLayout, layout == MatLayout::ROW_MAJOR,
+                      MatLayout::COLUMN_MAJOR, MatLayout::ROW_MAJOR>;
+
+template <typename T, int m, int n, MatLayout layout>
+A2D_FUNCTION auto Transpose(Mat<T, m, n, layout>& mat) {
+  return MatView<T, n, m, transpose_layout<layout>::value>(mat.get_data());
+}
+
+template <typename T, int m, int n, MatLayout layout>
+A2D_FUNCTION auto Transpose(const MatView<T, m, n, layout>& mat) {
+  return MatView<T, n, m, transpose_layout<layout>::value>(mat.get_data());
+}
+
+template <typename T, int m, int n, MatLayout layout>
+A2D_FUNCTION auto Transpose(ADObj<Mat<T, m, n, layout>>& mat) {
+  using View = MatView<T, n, m, transpose_layout<layout>::value>;
+  return ADObj<View>(View(mat.value().get_data()),
+                     View(mat.bvalue().get_data()));
+}
+
+template <typename T, int m, int n, MatLayout layout>
+A2D_FUNCTION auto Transpose(A2DObj<Mat<T, m, n, layout>>& mat) {
+  using View = MatView<T, n, m, transpose_layout<layout>::value>;
+  return A2DObj<View>(
+      View(mat.value().get_data()), View(mat.bvalue().get_data()),
+      View(mat.pvalue().get_data()), View(mat.hvalue().get_data()));
+}
+
 }  // namespace A2D
 
 #endif  // A2D_OBJECTS_H
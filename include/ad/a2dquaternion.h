@@ -12,44 +12,44 @@ namespace A2D {
 
 template <typename T>
 void QuaternionMatrixCore(const T q[], T C[]) {
-  C[0] = 1.0 - 2.0 * (q[2] * q[2] + q[3] * q[3]);
-  C[1] = 2.0 * (q[1] * q[2] + q[3] * q[0]);
-  C[2] = 2.0 * (q[1] * q[3] - q[2] * q[0]);
+  C[0] = T(1.0) - T(2.0) * (q[2] * q[2] + q[3] * q[3]);
+  C[1] = T(2.0) * (q[1] * q[2] + q[3] * q[0]);
+  C[2] = T(2.0) * (q[1] * q[3] - q[2] * q[0]);
 
-  C[3] = 2.0 * (q[2] * q[1] - q[3] * q[0]);
-  C[4] = 1.0 - 2.0 * (q[1] * q[1] + q[3] * q[3]);
-  C[5] = 2.0 * (q[2] * q[3] + q[1] * q[0]);
+  C[3] = T(2.0) * (q[2] * q[1] - q[3] * q[0]);
+  C[4] = T(1.0) - T(2.0) * (q[1] * q[1] + q[3] * q[3]);
+  C[5] = T(2.0) * (q[2] * q[3] + q[1] * q[0]);
 
-  C[6] = 2.0 * (q[3] * q[1] + q[2] * q[0]);
-  C[7] = 2.0 * (q[3] * q[2] - q[1] * q[0]);
-  C[8] = 1.0 - 2.0 * (q[1] * q[1] + q[2] * q[2]);
+  C[6] = T(2.0) * (q[3] * q[1] + q[2] * q[0]);
+  C[7] = T(2.0) * (q[3] * q[2] - q[1] * q[0]);
+  C[8] = T(1.0) - T(2.0) * (q[1] * q[1] + q[2] * q[2]);
 }
 
 template <typename T>
 void QuaternionMatrixForwardCore(const T q[], const T qd[], T Cd[]) {
-  Cd[0] = -4.0 * (q[2] * qd[2] + q[3] * qd[3]);
-  Cd[1] = 2.0 * (q[1] * qd[2] + q[3] * qd[0] + qd[1] * q[2] + qd[3] * q[0]);
-  Cd[2] = 2.0 * (q[1] * qd[3] - q[2] * qd[0] + qd[1] * q[3] - qd[2] * q[0]);
+  Cd[0] = -T(4.0) * (q[2] * qd[2] + q[3] * qd[3]);
+  Cd[1] = T(2.0) * (q[1] * qd[2] + q[3] * qd[0] + qd[1] * q[2] + qd[3] * q[0]);
+  Cd[2] = T(2.0) * (q[1] * qd[3] - q[2] * qd[0] + qd[1] * q[3] - qd[2] * q[0]);
 
-  Cd[3] = 2.0 * (q[2] * qd[1] - q[3] * qd[0] + qd[2] * q[1] - qd[3] * q[0]);
-  Cd[4] = -4.0 * (q[1] * qd[1] + q[3] * qd[3]);
-  Cd[5] = 2.0 * (q[2] * qd[3] + q[1] * qd[0] + qd[2] * q[3] + qd[1] * q[0]);
+  Cd[3] = T(2.0) * (q[2] * qd[1] - q[3] * qd[0] + qd[2] * q[1] - qd[3] * q[0]);
+  Cd[4] = -T(4.0) * (q[1] * qd[1] + q[3] * qd[3]);
+  Cd[5] = T(2.0) * (q[2] * qd[3] + q[1] * qd[0] + qd[2] * q[3] + qd[1] * q[0]);
 
-  Cd[6] = 2.0 * (q[3] * qd[1] + q[2] * qd[0] + qd[3] * q[1] + qd[2] * q[0]);
-  Cd[7] = 2.0 * (q[3] * qd[2] - q[1] * qd[0] + qd[3] * q[2] - qd[1] * q[0]);
-  Cd[8] = -4.0 * (q[1] * qd[1] + q[2] * qd[2]);
+  Cd[6] = T(2.0) * (q[3] * qd[1] + q[2] * qd[0] + qd[3] * q[1] + qd[2] * q[0]);
+  Cd[7] = T(2.0) * (q[3] * qd[2] - q[1] * qd[0] + qd[3] * q[2] - qd[1] * q[0]);
+  Cd[8] = -T(4.0) * (q[1] * qd[1] + q[2] * qd[2]);
 }
 
 template <typename T>
 void QuaternionMatrixReverseCore(const T q[], const T dC[], T r[]) {
-  r[0] += 2.0 * (q[3] * (dC[1] - dC[3]) + q[2] * (dC[6] - dC[2]) +
-                 q[1] * (dC[5] - dC[7]));
-  r[1] += 2.0 * (q[0] * (dC[5] - dC[7]) - 2.0 * q[1] * (dC[4] + dC[8]) +
-                 q[2] * (dC[1] + dC[3]) + q[3] * (dC[2] + dC[6]));
-  r[2] += 2.0 * (q[0] * (dC[6] - dC[2]) + q[1] * (dC[1] + dC[3]) -
-                 2.0 * q[2] * (dC[0] + dC[8]) + q[3] * (dC[7] + dC[5]));
-  r[3] += 2.0 * (q[0] * (dC[1] - dC[3]) + q[1] * (dC[2] + dC[6]) +
-                 q[2] * (dC[5] + dC[7]) - 2.0 * q[3] * (dC[0] + dC[4]));
+  r[0] += T(2.0) * (q[3] * (dC[1] - dC[3]) + q[2] * (dC[6] - dC[2]) +
+                    q[1] * (dC[5] - dC[7]));
+  r[1] += T(2.0) * (q[0] * (dC[5] - dC[7]) - T(2.0) * q[1] * (dC[4] + dC[8]) +
+                    q[2] * (dC[1] + dC[3]) + q[3] * (dC[2] + dC[6]));
+  r[2] += T(2.0) * (q[0] * (dC[6] - dC[2]) + q[1] * (dC[1] + dC[3]) -
+                    T(2.0) * q[2] * (dC[0] + dC[8]) + q[3] * (dC[7] + dC[5]));
+  r[3] += T(2.0) * (q[0] * (dC[1] - dC[3]) + q[1] * (dC[2] + dC[6]) +
+                    q[2] * (dC[5] + dC[7]) - T(2.0) * q[3] * (dC[0] + dC[4]));
 }
 
 template <typename T>
@@ -122,45 +122,46 @@ A2D_FUNCTION auto QuaternionMatrix(A2DObj<qtype>& q, A2DObj<Ctype>& C) {
 
 template <typename T>
 void QuaternionAngularVelocityCore(const T q[], const T qdot[], T omega[]) {
-  omega[0] =
-      2.0 * (q[0] * qdot[1] - qdot[0] * q[1] + q[3] * qdot[2] - q[2] * qdot[3]);
-  omega[1] =
-      2.0 * (q[0] * qdot[2] - qdot[0] * q[2] + q[1] * qdot[3] - q[3] * qdot[1]);
-  omega[2] =
-      2.0 * (q[0] * qdot[3] - qdot[0] * q[3] + q[2] * qdot[1] - q[1] * qdot[2]);
+  omega[0] = T(2.0) * (q[0] * qdot[1] - qdot[0] * q[1] + q[3] * qdot[2] -
+                       q[2] * qdot[3]);
+  omega[1] = T(2.0) * (q[0] * qdot[2] - qdot[0] * q[2] + q[1] * qdot[3] -
+                       q[3] * qdot[1]);
+  omega[2] = T(2.0) * (q[0] * qdot[3] - qdot[0] * q[3] + q[2] * qdot[1] -
+                       q[1] * qdot[2]);
 }
 
 template <typename T>
 void QuaternionAngularVelocityForwardCore(const T q[], const T qdot[],
                                           const T qd[], const T qdotd[],
                                           T omega[]) {
-  omega[0] = 2.0 * (qd[0] * qdot[1] - qdotd[0] * q[1] + qd[3] * qdot[2] -
-                    qd[2] * qdot[3] + q[0] * qdotd[1] - qdot[0] * qd[1] +
-                    q[3] * qdotd[2] - q[2] * qdotd[3]);
-  omega[1] = 2.0 * (qd[0] * qdot[2] - qdotd[0] * q[2] + qd[1] * qdot[3] -
-                    qd[3] * qdot[1] + q[0] * qdotd[2] - qdot[0] * qd[2] +
-                    q[1] * qdotd[3] - q[3] * qdotd[1]);
-  omega[2] = 2.0 * (qd[0] * qdot[3] - qdotd[0] * q[3] + qd[2] * qdot[1] -
-                    qd[1] * qdot[2] + q[0] * qdotd[3] - qdot[0] * qd[3] +
-                    q[2] * qdotd[1] - q[1] * qdotd[2]);
+  omega[0] = T(2.0) * (qd[0] * qdot[1] - qdotd[0] * q[1] + qd[3] * qdot[2] -
+                       qd[2] * qdot[3] + q[0] * qdotd[1] - qdot[0] * qd[1] +
+                       q[3] * qdotd[2] - q[2] * qdotd[3]);
+  omega[1] = T(2.0) * (qd[0] * qdot[2] - qdotd[0] * q[2] + qd[1] * qdot[3] -
+                       qd[3] * qdot[1] + q[0] * qdotd[2] - qdot[0] * qd[2] +
+                       q[1] * qdotd[3] - q[3] * qdotd[1]);
+  omega[2] = T(2.0) * (qd[0] * qdot[3] - qdotd[0] * q[3] + qd[2] * qdot[1] -
+                       qd[1] * qdot[2] + q[0] * qdotd[3] - qdot[0] * qd[3] +
+                       q[2] * qdotd[1] - q[1] * qdotd[2]);
 }
 
 template <typename T>
 void QuaternionAngularVelocityReverseCore(const T q[], const T qdot[],
                                           const T omegab[], T qb[], T qdotb[]) {
-  qb[0] +=
-      2.0 * (qdot[1] * omegab[0] + qdot[2] * omegab[1] + qdot[3] * omegab[2]);
-  qb[1] +=
-      2.0 * (-qdot[0] * omegab[0] + qdot[3] * omegab[1] - qdot[2] * omegab[2]);
-  qb[2] +=
-      2.0 * (-qdot[3] * omegab[0] - qdot[0] * omegab[1] + qdot[1] * omegab[2]);
-  qb[3] +=
-      2.0 * (qdot[2] * omegab[0] - qdot[1] * omegab[1] - qdot[0] * omegab[2]);
-
-  qdotb[0] -= 2.0 * (q[1] * omegab[0] + q[2] * omegab[1] + q[3] * omegab[2]);
-  qdotb[1] += 2.0 * (q[0] * omegab[0] - q[3] * omegab[1] + q[2] * omegab[2]);
-  qdotb[2] += 2.0 * (q[3] * omegab[0] + q[0] * omegab[1] - q[1] * omegab[2]);
-  qdotb[3] += 2.0 * (-q[2] * omegab[0] + q[1] * omegab[1] + q[0] * omegab[2]);
+  qb[0] += T(2.0) * (qdot[1] * omegab[0] + qdot[2] * omegab[1] +
+                     qdot[3] * omegab[2]);
+  qb[1] += T(2.0) * (-qdot[0] * omegab[0] + qdot[3] * omegab[1] -
+                     qdot[2] * omegab[2]);
+  qb[2] += T(2.0) * (-qdot[3] * omegab[0] - qdot[0] * omegab[1] +
+                     qdot[1] * omegab[2]);
+  qb[3] += T(2.0) * (qdot[2] * omegab[0] - qdot[1] * omegab[1] -
+                     qdot[0] * omegab[2]);
+
+  qdotb[0] -= T(2.0) * (q[1] * omegab[0] + q[2] * omegab[1] + q[3] * omegab[2]);
+  qdotb[1] += T(2.0) * (q[0] * omegab[0] - q[3] * omegab[1] + q[2] * omegab[2]);
+  qdotb[2] += T(2.0) * (q[3] * omegab[0] + q[0] * omegab[1] - q[1] * omegab[2]);
+  qdotb[3] +=
+      T(2.0) * (-q[2] * omegab[0] + q[1] * omegab[1] + q[0] * omegab[2]);
 }
 
 template <typename T>
@@ -246,6 +247,582 @@ A2D_FUNCTION auto QuaternionAngularVelocity(A2DObj<qtype>& q,
                                                                      omega);
 }
 
+/*
+  Compute the quaternion product r = p * q. The flags conjp and conjq replace
+  p or q by their conjugates. This is used in the derivative computations
+  since the transpose of the linear map q -> p * q is q -> conj(p) * q.
+*/
+template <typename T, bool conjp = false, bool conjq = false,
+          bool additive = false>
+A2D_FUNCTION void QuaternionProductCore(const T p[], const T q[], T r[]) {
+  const T p0 = p[0];
+  const T p1 = (conjp ? -p[1] : p[1]);
+  const T p2 = (conjp ? -p[2] : p[2]);
+  const T p3 = (conjp ? -p[3] : p[3]);
+
+  const T q0 = q[0];
+  const T q1 = (conjq ? -q[1] : q[1]);
+  const T q2 = (conjq ? -q[2] : q[2]);
+  const T q3 = (conjq ? -q[3] : q[3]);
+
+  if constexpr (additive) {
+    r[0] += p0 * q0 - p1 * q1 - p2 * q2 - p3 * q3;
+    r[1] += p0 * q1 + p1 * q0 + p2 * q3 - p3 * q2;
+    r[2] += p0 * q2 - p1 * q3 + p2 * q0 + p3 * q1;
+    r[3] += p0 * q3 + p1 * q2 - p2 * q1 + p3 * q0;
+  } else {
+    r[0] = p0 * q0 - p1 * q1 - p2 * q2 - p3 * q3;
+    r[1] = p0 * q1 + p1 * q0 + p2 * q3 - p3 * q2;
+    r[2] = p0 * q2 - p1 * q3 + p2 * q0 + p3 * q1;
+    r[3] = p0 * q3 + p1 * q2 - p2 * q1 + p3 * q0;
+  }
+}
+
+template <typename T>
+A2D_FUNCTION void QuaternionProductForwardCore(const T p[], const T q[],
+                                               const T pd[], const T qd[],
+                                               T rd[]) {
+  QuaternionProductCore<T>(pd, q, rd);
+  QuaternionProductCore<T, false, false, true>(p, qd, rd);
+}
+
+template <typename T>
+A2D_FUNCTION void QuaternionProductReverseCore(const T p[], const T q[],
+                                               const T rb[], T pb[], T qb[]) {
+  QuaternionProductCore<T, false, true, true>(rb, q, pb);
+  QuaternionProductCore<T, true, false, true>(p, rb, qb);
+}
+
+template <typename T>
+A2D_FUNCTION void QuaternionProduct(const Vec<T, 4>& p, const Vec<T, 4>& q,
+                                    Vec<T, 4>& r) {
+  QuaternionProductCore<T>(get_data(p), get_data(q), get_data(r));
+}
+
+template <class ptype, class qtype, class rtype>
+class QuaternionProductExpr {
+ public:
+  // Extract the numeric type to use
+  typedef typename get_object_numeric_type<rtype>::type T;
+
+  // Extract the dimensions of the underlying vectors
+  static constexpr int K = get_vec_size<ptype>::size;
+  static constexpr int L = get_vec_size<qtype>::size;
+  static constexpr int M = get_vec_size<rtype>::size;
+
+  static_assert(K == 4 && L == 4 && M == 4, "Quaternion dimension must be 4");
+
+  A2D_FUNCTION QuaternionProductExpr(ptype& p, qtype& q, rtype& r)
+      : p(p), q(q), r(r) {}
+
+  A2D_FUNCTION void eval() {
+    QuaternionProductCore<T>(get_data(p), get_data(q), get_data(r));
+  }
+
+  A2D_FUNCTION void bzero() { r.bzero(); }
+
+  template <ADorder forder>
+  A2D_FUNCTION void forward() {
+    constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
+                                              ADseed::b, ADseed::p>::value;
+    QuaternionProductForwardCore<T>(
+        get_data(p), get_data(q), GetSeed<seed>::get_data(p),
+        GetSeed<seed>::get_data(q), GetSeed<seed>::get_data(r));
+  }
+
+  A2D_FUNCTION void reverse() {
+    constexpr ADseed seed = ADseed::b;
+    QuaternionProductReverseCore<T>(
+        get_data(p), get_data(q), GetSeed<seed>::get_data(r),
+        GetSeed<seed>::get_data(p), GetSeed<seed>::get_data(q));
+  }
+
+  A2D_FUNCTION void hzero() { r.hzero(); }
+
+  A2D_FUNCTION void hreverse() {
+    QuaternionProductReverseCore<T>(
+        get_data(p), get_data(q), GetSeed<ADseed::h>::get_data(r),
+        GetSeed<ADseed::h>::get_data(p), GetSeed<ADseed::h>::get_data(q));
+    QuaternionProductReverseCore<T>(
+        GetSeed<ADseed::p>::get_data(p), GetSeed<ADseed::p>::get_data(q),
+        GetSeed<ADseed::b>::get_data(r), GetSeed<ADseed::h>::get_data(p),
+        GetSeed<ADseed::h>::get_data(q));
+  }
+
+ private:
+  ptype& p;
+  qtype& q;
+  rtype& r;
+};
+
+template <class ptype, class qtype, class rtype>
+A2D_FUNCTION auto QuaternionProduct(ADObj<ptype>& p, ADObj<qtype>& q,
+                                    ADObj<rtype>& r) {
+  return QuaternionProductExpr<ADObj<ptype>, ADObj<qtype>, ADObj<rtype>>(p, q,
+                                                                         r);
+}
+
+template <class ptype, class qtype, class rtype>
+A2D_FUNCTION auto QuaternionProduct(A2DObj<ptype>& p, A2DObj<qtype>& q,
+                                    A2DObj<rtype>& r) {
+  return QuaternionProductExpr<A2DObj<ptype>, A2DObj<qtype>, A2DObj<rtype>>(
+      p, q, r);
+}
+
+/*
+  Compute y = C(q) * x where C(q) is the rotation matrix computed by
+  QuaternionMatrix. With v = (q[1], q[2], q[3]) and t = 2 * v x x, this is
+
+  y = x - q[0] * t + v x t
+*/
+template <typename T>
+A2D_FUNCTION void QuaternionRotateVecCore(const T q[], const T x[], T y[]) {
+  T t[3];
+  t[0] = T(2.0) * (q[2] * x[2] - q[3] * x[1]);
+  t[1] = T(2.0) * (q[3] * x[0] - q[1] * x[2]);
+  t[2] = T(2.0) * (q[1] * x[1] - q[2] * x[0]);
+
+  y[0] = x[0] - q[0] * t[0] + q[2] * t[2] - q[3] * t[1];
+  y[1] = x[1] - q[0] * t[1] + q[3] * t[0] - q[1] * t[2];
+  y[2] = x[2] - q[0] * t[2] + q[1] * t[1] - q[2] * t[0];
+}
+
+template <typename T>
+A2D_FUNCTION void QuaternionRotateVecForwardCore(const T q[], const T x[],
+                                                 const T qd[], const T xd[],
+                                                 T yd[]) {
+  T t[3], td[3];
+  t[0] = T(2.0) * (q[2] * x[2] - q[3] * x[1]);
+  t[1] = T(2.0) * (q[3] * x[0] - q[1] * x[2]);
+  t[2] = T(2.0) * (q[1] * x[1] - q[2] * x[0]);
+
+  td[0] = T(2.0) * (qd[2] * x[2] - qd[3] * x[1] + q[2] * xd[2] - q[3] * xd[1]);
+  td[1] = T(2.0) * (qd[3] * x[0] - qd[1] * x[2] + q[3] * xd[0] - q[1] * xd[2]);
+  td[2] = T(2.0) * (qd[1] * x[1] - qd[2] * x[0] + q[1] * xd[1] - q[2] * xd[0]);
+
+  yd[0] = xd[0] - qd[0] * t[0] + qd[2] * t[2] - qd[3] * t[1] - q[0] * td[0] +
+          q[2] * td[2] - q[3] * td[1];
+  yd[1] = xd[1] - qd[0] * t[1] + qd[3] * t[0] - qd[1] * t[2] - q[0] * td[1] +
+          q[3] * td[0] - q[1] * td[2];
+  yd[2] = xd[2] - qd[0] * t[2] + qd[1] * t[1] - qd[2] * t[0] - q[0] * td[2] +
+          q[1] * td[1] - q[2] * td[0];
+}
+
+template <typename T>
+A2D_FUNCTION void QuaternionRotateVecReverseCore(const T q[], const T x[],
+                                                 const T yb[], T qb[], T xb[]) {
+  T t[3], tb[3];
+  t[0] = T(2.0) * (q[2] * x[2] - q[3] * x[1]);
+  t[1] = T(2.0) * (q[3] * x[0] - q[1] * x[2]);
+  t[2] = T(2.0) * (q[1] * x[1] - q[2] * x[0]);
+
+  // tb = - q[0] * yb + yb x v
+  tb[0] = -q[0] * yb[0] + yb[1] * q[3] - yb[2] * q[2];
+  tb[1] = -q[0] * yb[1] + yb[2] * q[1] - yb[0] * q[3];
+  tb[2] = -q[0] * yb[2] + yb[0] * q[2] - yb[1] * q[1];
+
+  // qb[0] = - yb^{T} t, vb = t x yb + 2 * x x tb
+  qb[0] -= yb[0] * t[0] + yb[1] * t[1] + yb[2] * t[2];
+  qb[1] += t[1] * yb[2] - t[2] * yb[1] + T(2.0) * (x[1] * tb[2] - x[2] * tb[1]);
+  qb[2] += t[2] * yb[0] - t[0] * yb[2] + T(2.0) * (x[2] * tb[0] - x[0] * tb[2]);
+  qb[3] += t[0] * yb[1] - t[1] * yb[0] + T(2.0) * (x[0] * tb[1] - x[1] * tb[0]);
+
+  // xb = yb + 2 * tb x v
+  xb[0] += yb[0] + T(2.0) * (tb[1] * q[3] - tb[2] * q[2]);
+  xb[1] += yb[1] + T(2.0) * (tb[2] * q[1] - tb[0] * q[3]);
+  xb[2] += yb[2] + T(2.0) * (tb[0] * q[2] - tb[1] * q[1]);
+}
+
+template <typename T>
+A2D_FUNCTION void QuaternionRotateVecHReverseCore(const T q[], const T x[],
+                                                  const T qp[], const T xp[],
+                                                  const T yb[], T qh[],
+                                                  T xh[]) {
+  T tp[3], tb[3], tbp[3];
+  tp[0] = T(2.0) * (qp[2] * x[2] - qp[3] * x[1] + q[2] * xp[2] - q[3] * xp[1]);
+  tp[1] = T(2.0) * (qp[3] * x[0] - qp[1] * x[2] + q[3] * xp[0] - q[1] * xp[2]);
+  tp[2] = T(2.0) * (qp[1] * x[1] - qp[2] * x[0] + q[1] * xp[1] - q[2] * xp[0]);
+
+  tb[0] = -q[0] * yb[0] + yb[1] * q[3] - yb[2] * q[2];
+  tb[1] = -q[0] * yb[1] + yb[2] * q[1] - yb[0] * q[3];
+  tb[2] = -q[0] * yb[2] + yb[0] * q[2] - yb[1] * q[1];
+
+  tbp[0] = -qp[0] * yb[0] + yb[1] * qp[3] - yb[2] * qp[2];
+  tbp[1] = -qp[0] * yb[1] + yb[2] * qp[1] - yb[0] * qp[3];
+  tbp[2] = -qp[0] * yb[2] + yb[0] * qp[2] - yb[1] * qp[1];
+
+  qh[0] -= yb[0] * tp[0] + yb[1] * tp[1] + yb[2] * tp[2];
+  qh[1] += tp[1] * yb[2] - tp[2] * yb[1] +
+           T(2.0) * (xp[1] * tb[2] - xp[2] * tb[1] + x[1] * tbp[2] -
+                     x[2] * tbp[1]);
+  qh[2] += tp[2] * yb[0] - tp[0] * yb[2] +
+           T(2.0) * (xp[2] * tb[0] - xp[0] * tb[2] + x[2] * tbp[0] -
+                     x[0] * tbp[2]);
+  qh[3] += tp[0] * yb[1] - tp[1] * yb[0] +
+           T(2.0) * (xp[0] * tb[1] - xp[1] * tb[0] + x[0] * tbp[1] -
+                     x[1] * tbp[0]);
+
+  xh[0] +=
+      T(2.0) * (tbp[1] * q[3] - tbp[2] * q[2] + tb[1] * qp[3] - tb[2] * qp[2]);
+  xh[1] +=
+      T(2.0) * (tbp[2] * q[1] - tbp[0] * q[3] + tb[2] * qp[1] - tb[0] * qp[3]);
+  xh[2] +=
+      T(2.0) * (tbp[0] * q[2] - tbp[1] * q[1] + tb[0] * qp[2] - tb[1] * qp[1]);
+}
+
+template <typename T>
+A2D_FUNCTION void QuaternionRotateVec(const Vec<T, 4>& q, const Vec<T, 3>& x,
+                                      Vec<T, 3>& y) {
+  QuaternionRotateVecCore<T>(get_data(q), get_data(x), get_data(y));
+}
+
+template <class qtype, class xtype, class ytype>
+class QuaternionRotateVecExpr {
+ public:
+  // Extract the numeric type to use
+  typedef typename get_object_numeric_type<ytype>::type T;
+
+  // Extract the dimensions of the underlying vectors
+  static constexpr int L = get_vec_size<qtype>::size;
+  static constexpr int M = get_vec_size<xtype>::size;
+  static constexpr int N = get_vec_size<ytype>::size;
+
+  static_assert(L == 4, "Quaternion dimension must be 4");
+  static_assert(M == 3 && N == 3, "Vector dimension must be 3");
+
+  A2D_FUNCTION QuaternionRotateVecExpr(qtype& q, xtype& x, ytype& y)
+      : q(q), x(x), y(y) {}
+
+  A2D_FUNCTION void eval() {
+    QuaternionRotateVecCore<T>(get_data(q), get_data(x), get_data(y));
+  }
+
+  A2D_FUNCTION void bzero() { y.bzero(); }
+
+  template <ADorder forder>
+  A2D_FUNCTION void forward() {
+    constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
+                                              ADseed::b, ADseed::p>::value;
+    QuaternionRotateVecForwardCore<T>(
+        get_data(q), get_data(x), GetSeed<seed>::get_data(q),
+        GetSeed<seed>::get_data(x), GetSeed<seed>::get_data(y));
+  }
+
+  A2D_FUNCTION void reverse() {
+    constexpr ADseed seed = ADseed::b;
+    QuaternionRotateVecReverseCore<T>(
+        get_data(q), get_data(x), GetSeed<seed>::get_data(y),
+        GetSeed<seed>::get_data(q), GetSeed<seed>::get_data(x));
+  }
+
+  A2D_FUNCTION void hzero() { y.hzero(); }
+
+  A2D_FUNCTION void hreverse() {
+    QuaternionRotateVecReverseCore<T>(
+        get_data(q), get_data(x), GetSeed<ADseed::h>::get_data(y),
+        GetSeed<ADseed::h>::get_data(q), GetSeed<ADseed::h>::get_data(x));
+    QuaternionRotateVecHReverseCore<T>(
+        get_data(q), get_data(x), GetSeed<ADseed::p>::get_data(q),
+        GetSeed<ADseed::p>::get_data(x), GetSeed<ADseed::b>::get_data(y),
+        GetSeed<ADseed::h>::get_data(q), GetSeed<ADseed::h>::get_data(x));
+  }
+
+ private:
+  qtype& q;
+  xtype& x;
+  ytype& y;
+};
+
+template <class qtype, class xtype, class ytype>
+A2D_FUNCTION auto QuaternionRotateVec(ADObj<qtype>& q, ADObj<xtype>& x,
+                                      ADObj<ytype>& y) {
+  return QuaternionRotateVecExpr<ADObj<qtype>, ADObj<xtype>, ADObj<ytype>>(q, x,
+                                                                           y);
+}
+
+template <class qtype, class xtype, class ytype>
+A2D_FUNCTION auto QuaternionRotateVec(A2DObj<qtype>& q, A2DObj<xtype>& x,
+                                      A2DObj<ytype>& y) {
+  return QuaternionRotateVecExpr<A2DObj<qtype>, A2DObj<xtype>, A2DObj<ytype>>(
+      q, x, y);
+}
+
+/*
+  Compute the coefficients of the exponential map as functions of
+  phi = theta^{T} * theta
+
+  a(phi) = sin(|theta|) / |theta|
+  b(phi) = (1 - cos(|theta|)) / |theta|^2
+
+  and their first and second derivatives with respect to phi. The
+  coefficients are stored as c = (a, a', a'', b, b', b''). For small angles,
+  the Taylor series is used to avoid cancellation.
+*/
+template <typename T>
+A2D_FUNCTION void RotationVecCoefCore(const T phi, T c[]) {
+  if (RealPart(phi) < 1.0) {
+    // Series coefficients a_n = (-1)^n/(2n + 1)!, b_n = (-1)^n/(2n + 2)!
+    constexpr int nterms = 10;
+    double an[nterms], bn[nterms];
+    double fa = 1.0, fb = 2.0;
+    for (int n = 0; n < nterms; n++) {
+      an[n] = ((n % 2 == 0) ? 1.0 : -1.0) / fa;
+      bn[n] = ((n % 2 == 0) ? 1.0 : -1.0) / fb;
+      fa *= (2 * n + 2) * (2 * n + 3);
+      fb *= (2 * n + 3) * (2 * n + 4);
+    }
+
+    // Evaluate the series and its derivatives using Horner's method
+    T a = 0.0, ad = 0.0, add = 0.0;
+    T b = 0.0, bd = 0.0, bdd = 0.0;
+    for (int n = nterms - 1; n >= 0; n--) {
+      a = a * phi + T(an[n]);
+      b = b * phi + T(bn[n]);
+      if (n >= 1) {
+        ad = ad * phi + T(n * an[n]);
+        bd = bd * phi + T(n * bn[n]);
+      }
+      if (n >= 2) {
+        add = add * phi + T(n * (n - 1) * an[n]);
+        bdd = bdd * phi + T(n * (n - 1) * bn[n]);
+      }
+    }
+
+    c[0] = a;
+    c[1] = ad;
+    c[2] = add;
+    c[3] = b;
+    c[4] = bd;
+    c[5] = bdd;
+  } else {
+    T theta = sqrt(phi);
+    T s = sin(theta);
+    T co = cos(theta);
+    T theta3 = theta * phi;
+
+    c[0] = s / theta;
+    c[1] = (theta * co - s) / (T(2.0) * theta3);
+    c[2] = (T(3.0) * (s - theta * co) - phi * s) / (T(4.0) * theta3 * phi);
+    c[3] = (T(1.0) - co) / phi;
+    c[4] = (theta * s - T(2.0) * (T(1.0) - co)) / (T(2.0) * phi * phi);
+    c[5] = (phi * co - T(5.0) * theta * s + T(8.0) * (T(1.0) - co)) /
+           (T(4.0) * phi * phi * phi);
+  }
+}
+
+/*
+  Compute the rotation matrix from the rotation vector theta using the
+  exponential map
+
+  C = I - a * theta^{x} + b * theta^{x} * theta^{x}
+
+  This is the matrix computed by QuaternionMatrix for the quaternion
+  q = (cos(|theta|/2), sin(|theta|/2) * theta/|theta|).
+*/
+template <typename T>
+A2D_FUNCTION void RotationVecToMatCore(const T t[], T C[]) {
+  T phi = t[0] * t[0] + t[1] * t[1] + t[2] * t[2];
+  T c[6];
+  RotationVecCoefCore<T>(phi, c);
+  const T a = c[0], b = c[3];
+
+  C[0] = T(1.0) + b * (t[0] * t[0] - phi);
+  C[1] = a * t[2] + b * t[0] * t[1];
+  C[2] = -a * t[1] + b * t[0] * t[2];
+
+  C[3] = -a * t[2] + b * t[1] * t[0];
+  C[4] = T(1.0) + b * (t[1] * t[1] - phi);
+  C[5] = a * t[0] + b * t[1] * t[2];
+
+  C[6] = a * t[1] + b * t[2] * t[0];
+  C[7] = -a * t[0] + b * t[2] * t[1];
+  C[8] = T(1.0) + b * (t[2] * t[2] - phi);
+}
+
+template <typename T>
+A2D_FUNCTION void RotationVecToMatForwardCore(const T t[], const T td[],
+                                              T Cd[]) {
+  T phi = t[0] * t[0] + t[1] * t[1] + t[2] * t[2];
+  T phid = T(2.0) * (t[0] * td[0] + t[1] * td[1] + t[2] * td[2]);
+  T c[6];
+  RotationVecCoefCore<T>(phi, c);
+  const T a = c[0], b = c[3];
+  const T ad = c[1] * phid, bd = c[4] * phid;
+
+  Cd[0] = bd * (t[0] * t[0] - phi) + b * (T(2.0) * t[0] * td[0] - phid);
+  Cd[1] = ad * t[2] + a * td[2] + bd * t[0] * t[1] +
+          b * (td[0] * t[1] + t[0] * td[1]);
+  Cd[2] = -ad * t[1] - a * td[1] + bd * t[0] * t[2] +
+          b * (td[0] * t[2] + t[0] * td[2]);
+
+  Cd[3] = -ad * t[2] - a * td[2] + bd * t[1] * t[0] +
+          b * (td[1] * t[0] + t[1] * td[0]);
+  Cd[4] = bd * (t[1] * t[1] - phi) + b * (T(2.0) * t[1] * td[1] - phid);
+  Cd[5] = ad * t[0] + a * td[0] + bd * t[1] * t[2] +
+          b * (td[1] * t[2] + t[1] * td[2]);
+
+  Cd[6] = ad * t[1] + a * td[1] + bd * t[2] * t[0] +
+          b * (td[2] * t[0] + t[2] * td[0]);
+  Cd[7] = -ad * t[0] - a * td[0] + bd * t[2] * t[1] +
+          b * (td[2] * t[1] + t[2] * td[1]);
+  Cd[8] = bd * (t[2] * t[2] - phi) + b * (T(2.0) * t[2] * td[2] - phid);
+}
+
+/*
+  The reverse mode uses the axial vector w of Cb, the symmetric part
+  S = Cb + Cb^{T} and the trace of Cb such that
+
+  phib = a' * w^{T} * theta + b' * (theta^{T} * Cb * theta - phi * tr(Cb))
+         - b * tr(Cb)
+  thetab = a * w + b * S * theta + 2 * phib * theta
+*/
+template <typename T>
+A2D_FUNCTION void RotationVecToMatReverseCore(const T t[], const T Cb[],
+                                              T tb[]) {
+  T phi = t[0] * t[0] + t[1] * t[1] + t[2] * t[2];
+  T c[6];
+  RotationVecCoefCore<T>(phi, c);
+  const T a = c[0], b = c[3];
+
+  T w[3];
+  w[0] = Cb[5] - Cb[7];
+  w[1] = Cb[6] - Cb[2];
+  w[2] = Cb[1] - Cb[3];
+  T tr = Cb[0] + Cb[4] + Cb[8];
+
+  T St[3];
+  St[0] =
+      T(2.0) * Cb[0] * t[0] + (Cb[1] + Cb[3]) * t[1] + (Cb[2] + Cb[6]) * t[2];
+  St[1] =
+      (Cb[1] + Cb[3]) * t[0] + T(2.0) * Cb[4] * t[1] + (Cb[5] + Cb[7]) * t[2];
+  St[2] =
+      (Cb[2] + Cb[6]) * t[0] + (Cb[5] + Cb[7]) * t[1] + T(2.0) * Cb[8] * t[2];
+
+  T alpha = w[0] * t[0] + w[1] * t[1] + w[2] * t[2];
+  T beta = T(0.5) * (St[0] * t[0] + St[1] * t[1] + St[2] * t[2]) - phi * tr;
+  T phib = c[1] * alpha + c[4] * beta - b * tr;
+
+  for (int i = 0; i < 3; i++) {
+    tb[i] += a * w[i] + b * St[i] + T(2.0) * phib * t[i];
+  }
+}
+
+template <typename T>
+A2D_FUNCTION void RotationVecToMatHReverseCore(const T t[], const T tp[],
+                                               const T Cb[], T th[]) {
+  T phi = t[0] * t[0] + t[1] * t[1] + t[2] * t[2];
+  T phip = T(2.0) * (t[0] * tp[0] + t[1] * tp[1] + t[2] * tp[2]);
+  T c[6];
+  RotationVecCoefCore<T>(phi, c);
+  const T b = c[3];
+
+  T w[3];
+  w[0] = Cb[5] - Cb[7];
+  w[1] = Cb[6] - Cb[2];
+  w[2] = Cb[1] - Cb[3];
+  T tr = Cb[0] + Cb[4] + Cb[8];
+
+  T St[3], Sp[3];
+  St[0] =
+      T(2.0) * Cb[0] * t[0] + (Cb[1] + Cb[3]) * t[1] + (Cb[2] + Cb[6]) * t[2];
+  St[1] =
+      (Cb[1] + Cb[3]) * t[0] + T(2.0) * Cb[4] * t[1] + (Cb[5] + Cb[7]) * t[2];
+  St[2] =
+      (Cb[2] + Cb[6]) * t[0] + (Cb[5] + Cb[7]) * t[1] + T(2.0) * Cb[8] * t[2];
+
+  Sp[0] = T(2.0) * Cb[0] * tp[0] + (Cb[1] + Cb[3]) * tp[1] +
+          (Cb[2] + Cb[6]) * tp[2];
+  Sp[1] = (Cb[1] + Cb[3]) * tp[0] + T(2.0) * Cb[4] * tp[1] +
+          (Cb[5] + Cb[7]) * tp[2];
+  Sp[2] = (Cb[2] + Cb[6]) * tp[0] + (Cb[5] + Cb[7]) * tp[1] +
+          T(2.0) * Cb[8] * tp[2];
+
+  T alpha = w[0] * t[0] + w[1] * t[1] + w[2] * t[2];
+  T beta = T(0.5) * (St[0] * t[0] + St[1] * t[1] + St[2] * t[2]) - phi * tr;
+  T phib = c[1] * alpha + c[4] * beta - b * tr;
+
+  T alphap = w[0] * tp[0] + w[1] * tp[1] + w[2] * tp[2];
+  T betap = St[0] * tp[0] + St[1] * tp[1] + St[2] * tp[2] - phip * tr;
+  T phibp = c[2] * phip * alpha + c[1] * alphap + c[5] * phip * beta +
+            c[4] * betap - c[4] * phip * tr;
+
+  for (int i = 0; i < 3; i++) {
+    th[i] += c[1] * phip * w[i] + c[4] * phip * St[i] + b * Sp[i] +
+             T(2.0) * (phibp * t[i] + phib * tp[i]);
+  }
+}
+
+template <typename T>
+A2D_FUNCTION void RotationVecToMat(const Vec<T, 3>& theta, Mat<T, 3, 3>& C) {
+  RotationVecToMatCore<T>(get_data(theta), get_data(C));
+}
+
+template <class ttype, class Ctype>
+class RotationVecToMatExpr {
+ public:
+  // Extract the numeric type to use
+  typedef typename get_object_numeric_type<Ctype>::type T;
+
+  // Extract the underlying sizes of the matrix
+  static constexpr int M = get_matrix_rows<Ctype>::size;
+  static constexpr int N = get_matrix_columns<Ctype>::size;
+
+  // Extract the dimensions of the underlying vectors
+  static constexpr int L = get_vec_size<ttype>::size;
+
+  static_assert(M == N && N == 3, "Rotation matrix dimension must be 3");
+  static_assert(L == 3, "Rotation vector dimension must be 3");
+
+  A2D_FUNCTION RotationVecToMatExpr(ttype& theta, Ctype& C)
+      : theta(theta), C(C) {}
+
+  A2D_FUNCTION void eval() {
+    RotationVecToMatCore<T>(get_data(theta), get_data(C));
+  }
+
+  A2D_FUNCTION void bzero() { C.bzero(); }
+
+  template <ADorder forder>
+  A2D_FUNCTION void forward() {
+    constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
+                                              ADseed::b, ADseed::p>::value;
+    RotationVecToMatForwardCore<T>(get_data(theta),
+                                   GetSeed<seed>::get_data(theta),
+                                   GetSeed<seed>::get_data(C));
+  }
+
+  A2D_FUNCTION void reverse() {
+    constexpr ADseed seed = ADseed::b;
+    RotationVecToMatReverseCore<T>(get_data(theta), GetSeed<seed>::get_data(C),
+                                   GetSeed<seed>::get_data(theta));
+  }
+
+  A2D_FUNCTION void hzero() { C.hzero(); }
+
+  A2D_FUNCTION void hreverse() {
+    RotationVecToMatReverseCore<T>(get_data(theta),
+                                   GetSeed<ADseed::h>::get_data(C),
+                                   GetSeed<ADseed::h>::get_data(theta));
+    RotationVecToMatHReverseCore<T>(
+        get_data(theta), GetSeed<ADseed::p>::get_data(theta),
+        GetSeed<ADseed::b>::get_data(C), GetSeed<ADseed::h>::get_data(theta));
+  }
+
+ private:
+  ttype& theta;
+  Ctype& C;
+};
+
+template <class ttype, class Ctype>
+A2D_FUNCTION auto RotationVecToMat(ADObj<ttype>& theta, ADObj<Ctype>& C) {
+  return RotationVecToMatExpr<ADObj<ttype>, ADObj<Ctype>>(theta, C);
+}
+
+template <class ttype, class Ctype>
+A2D_FUNCTION auto RotationVecToMat(A2DObj<ttype>& theta, A2DObj<Ctype>& C) {
+  return RotationVecToMatExpr<A2DObj<ttype>, A2DObj<Ctype>>(theta, C);
+}
+
 namespace Test {
 
 template <typename T>
@@ -455,6 +1032,188 @@ inline bool QuaternionAngularVelocityTestAll(bool component = false,
   return passed;
 }
 
+template <typename T>
+class QuaternionProductTest
+    : public A2DTest<T, Vec<T, 4>, Vec<T, 4>, Vec<T, 4>> {
+ public:
+  using Input = VarTuple<T, Vec<T, 4>, Vec<T, 4>>;
+  using Output = VarTuple<T, Vec<T, 4>>;
+
+  // Assemble a string to describe the test
+  std::string name() { return "QuaternionProduct"; }
+
+  // Evaluate the quaternion product
+  Output eval(const Input& X) {
+    Vec<T, 4> p, q, r;
+    X.get_values(p, q);
+    QuaternionProduct(p, q, r);
+    return MakeVarTuple<T>(r);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& X, Input& g) {
+    ADObj<Vec<T, 4>> p, q, r;
+    X.get_values(p.value(), q.value());
+    auto stack = MakeStack(QuaternionProduct(p, q, r));
+    seed.get_values(r.bvalue());
+    stack.reverse();
+    g.set_values(p.bvalue(), q.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& X,
+             const Input& p0, Input& h) {
+    A2DObj<Vec<T, 4>> p, q, r;
+    X.get_values(p.value(), q.value());
+    p0.get_values(p.pvalue(), q.pvalue());
+    auto stack = MakeStack(QuaternionProduct(p, q, r));
+    seed.get_values(r.bvalue());
+    hval.get_values(r.hvalue());
+    stack.hproduct();
+    h.set_values(p.hvalue(), q.hvalue());
+  }
+};
+
+inline bool QuaternionProductTestAll(bool component = false,
+                                     bool write_output = true) {
+  using Tc = A2D_complex_t<double>;
+
+  QuaternionProductTest<Tc> test1;
+  bool passed = Run(test1, component, write_output);
+
+  return passed;
+}
+
+template <typename T>
+class QuaternionRotateVecTest
+    : public A2DTest<T, Vec<T, 3>, Vec<T, 4>, Vec<T, 3>> {
+ public:
+  using Input = VarTuple<T, Vec<T, 4>, Vec<T, 3>>;
+  using Output = VarTuple<T, Vec<T, 3>>;
+
+  // Assemble a string to describe the test
+  std::string name() { return "QuaternionRotateVec"; }
+
+  // Evaluate the rotated vector
+  Output eval(const Input& X) {
+    Vec<T, 4> q;
+    Vec<T, 3> x, y;
+    X.get_values(q, x);
+    QuaternionRotateVec(q, x, y);
+    return MakeVarTuple<T>(y);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& X, Input& g) {
+    ADObj<Vec<T, 4>> q;
+    ADObj<Vec<T, 3>> x, y;
+    X.get_values(q.value(), x.value());
+    auto stack = MakeStack(QuaternionRotateVec(q, x, y));
+    seed.get_values(y.bvalue());
+    stack.reverse();
+    g.set_values(q.bvalue(), x.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& X,
+             const Input& p, Input& h) {
+    A2DObj<Vec<T, 4>> q;
+    A2DObj<Vec<T, 3>> x, y;
+    X.get_values(q.value(), x.value());
+    p.get_values(q.pvalue(), x.pvalue());
+    auto stack = MakeStack(QuaternionRotateVec(q, x, y));
+    seed.get_values(y.bvalue());
+    hval.get_values(y.hvalue());
+    stack.hproduct();
+    h.set_values(q.hvalue(), x.hvalue());
+  }
+};
+
+inline bool QuaternionRotateVecTestAll(bool component = false,
+                                       bool write_output = true) {
+  using Tc = A2D_complex_t<double>;
+
+  QuaternionRotateVecTest<Tc> test1;
+  bool passed = Run(test1, component, write_output);
+
+  return passed;
+}
+
+template <typename T>
+class RotationVecToMatTest : public A2DTest<T, Mat<T, 3, 3>, Vec<T, 3>> {
+ public:
+  using Input = VarTuple<T, Vec<T, 3>>;
+  using Output = VarTuple<T, Mat<T, 3, 3>>;
+
+  RotationVecToMatTest(double scale = 1.0) : scale(scale) {}
+
+  // Assemble a string to describe the test
+  std::string name() {
+    std::stringstream s;
+    s << "RotationVecToMat<scale=" << scale << ">";
+    return s.str();
+  }
+
+  // Scale the rotation vector to test the small and large angle cases
+  void get_point(Input& x) {
+    x.set_rand(this->get_rng("point"));
+    for (index_t i = 0; i < 3; i++) {
+      x[i] *= scale;
+    }
+  }
+
+  // Evaluate the rotation matrix
+  Output eval(const Input& X) {
+    Vec<T, 3> theta;
+    Mat<T, 3, 3> C;
+    X.get_values(theta);
+    RotationVecToMat(theta, C);
+    return MakeVarTuple<T>(C);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& X, Input& g) {
+    ADObj<Vec<T, 3>> theta;
+    ADObj<Mat<T, 3, 3>> C;
+    X.get_values(theta.value());
+    auto stack = MakeStack(RotationVecToMat(theta, C));
+    seed.get_values(C.bvalue());
+    stack.reverse();
+    g.set_values(theta.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& X,
+             const Input& p, Input& h) {
+    A2DObj<Vec<T, 3>> theta;
+    A2DObj<Mat<T, 3, 3>> C;
+    X.get_values(theta.value());
+    p.get_values(theta.pvalue());
+    auto stack = MakeStack(RotationVecToMat(theta, C));
+    seed.get_values(C.bvalue());
+    hval.get_values(C.hvalue());
+    stack.hproduct();
+    h.set_values(theta.hvalue());
+  }
+
+ private:
+  double scale;
+};
+
+inline bool RotationVecToMatTestAll(bool component = false,
+                                    bool write_output = true) {
+  using Tc = A2D_complex_t<double>;
+
+  bool passed = true;
+  const double scales[] = {1e-6, 0.5, 2.0};
+  for (double scale : scales) {
+    RotationVecToMatTest<Tc> test(scale);
+    passed = passed && Run(test, component, write_output);
+  }
+
+  return passed;
+}
+
 }  // namespace Test
 
 }  // namespace A2D
@@ -8,6 +8,282 @@
 
 namespace A2D {
 
+/*
+  Common subexpression sharing for the scalar expression templates
+
+  The scalar expressions store their arguments by value or by reference, so a
+  subexpression that appears more than once in a formula is evaluated and
+  reversed once for each appearance. Share() wraps an expression so that it
+  can be referenced by several parents, and Let() binds the shared expression
+  to the body that uses it:
+
+  auto ab = Share(a * b);
+  Eval(Let(ab, sin(ab) + ab * ab), f);
+
+  The shared expression is evaluated once before the body. The parents
+  accumulate their contributions to its adjoint, and the shared expression is
+  reversed once after the body. Shared expressions must be named (lvalues) so
+  that the parents hold a reference to them. Several shared expressions are
+  bound by nesting Let() calls in the order they depend on one another. Each
+  shared expression should be bound by exactly one Let().
+*/
+template <class A, class Ta, class T, bool CA>
+class ShareExpr : public ADExpr<ShareExpr<A, Ta, T, CA>, T> {
+ public:
+  using expr_t =
+      typename std::conditional<CA, const ADExpr<A, Ta>, ADExpr<A, Ta>>::type;
+  using A_t = typename std::conditional<CA, A, A&>::type;
+
+  // A shared leaf accumulates adjoints from outside the Let as well, so it is
+  // zeroed by its owner rather than by the shared sweep
+  static constexpr bool is_leaf =
+      !std::is_same<typename remove_a2dobj<A>::type, A>::value;
+
+  A2D_FUNCTION ShareExpr(expr_t& a0) : a(a0.self()), val(0.0), bval(0.0) {}
+
+  // The parents do not evaluate or reverse the shared expression
+  A2D_FUNCTION void eval() {}
+  A2D_FUNCTION void forward() {}
+  A2D_FUNCTION void reverse() {}
+  A2D_FUNCTION void bzero() {}
+
+  // The sweeps through the shared expression, called once by LetExpr
+  A2D_FUNCTION void eval_shared() {
+    a.eval();
+    val = a.value();
+  }
+  A2D_FUNCTION void forward_shared() {
+    a.forward();
+    bval = a.bvalue();
+  }
+  A2D_FUNCTION void reverse_shared() {
+    a.bvalue() += bval;
+    a.reverse();
+  }
+  A2D_FUNCTION void bzero_shared() {
+    bval = T(0.0);
+    if constexpr (!is_leaf) {
+      a.bzero();
+    }
+  }
+
+  A2D_FUNCTION T& value() { return val; }
+  A2D_FUNCTION const T& value() const { return val; }
+  A2D_FUNCTION T& bvalue() { return bval; }
+  A2D_FUNCTION const T& bvalue() const { return bval; }
+
+ private:
+  A_t a;
+  T val, bval;
+};
+
+template <class A, class Ta>
+A2D_FUNCTION auto Share(const ADExpr<A, Ta>& a) {
+  using T = typename remove_const_and_refs<Ta>::type;
+  return ShareExpr<A, Ta, T, true>(a);
+}
+template <class A, class Ta>
+A2D_FUNCTION auto Share(ADExpr<A, Ta>& a) {
+  using T = typename remove_const_and_refs<Ta>::type;
+  return ShareExpr<A, Ta, T, false>(a);
+}
+
+template <class S, class B, class Tb, class T, bool CB>
+class LetExpr : public ADExpr<LetExpr<S, B, Tb, T, CB>, T> {
+ public:
+  using expr_t =
+      typename std::conditional<CB, const ADExpr<B, Tb>, ADExpr<B, Tb>>::type;
+  using B_t = typename std::conditional<CB, B, B&>::type;
+  A2D_FUNCTION LetExpr(S& s, expr_t& b0)
+      : s(s), b(b0.self()), val(0.0), bval(0.0) {}
+  A2D_FUNCTION void eval() {
+    s.eval_shared();
+    b.eval();
+    val = b.value();
+  }
+  A2D_FUNCTION void forward() {
+    s.forward_shared();
+    b.forward();
+    bval = b.bvalue();
+  }
+  A2D_FUNCTION void reverse() {
+    // Only the parents within the body contribute to the shared adjoint
+    s.bvalue() = T(0.0);
+    b.bvalue() += bval;
+    b.reverse();
+    s.reverse_shared();
+  }
+  A2D_FUNCTION void bzero() {
+    bval = T(0.0);
+    b.bzero();
+    s.bzero_shared();
+  }
+  A2D_FUNCTION T& value() { return val; }
+  A2D_FUNCTION const T& value() const { return val; }
+  A2D_FUNCTION T& bvalue() { return bval; }
+  A2D_FUNCTION const T& bvalue() const { return bval; }
+
+ private:
+  S& s;
+  B_t b;
+  T val, bval;
+};
+
+template <class A, class Ta, class T, bool CA, class B, class Tb,
+          std::enable_if_t<is_same_type<T, Tb>::value, bool> = true>
+A2D_FUNCTION auto Let(ShareExpr<A, Ta, T, CA>& s, const ADExpr<B, Tb>& b) {
+  return LetExpr<ShareExpr<A, Ta, T, CA>, B, Tb, T, true>(s, b);
+}
+template <class A, class Ta, class T, bool CA, class B, class Tb,
+          std::enable_if_t<is_same_type<T, Tb>::value, bool> = true>
+A2D_FUNCTION auto Let(ShareExpr<A, Ta, T, CA>& s, ADExpr<B, Tb>& b) {
+  return LetExpr<ShareExpr<A, Ta, T, CA>, B, Tb, T, false>(s, b);
+}
+
+template <class A, class Ta, class T, bool CA>
+class ShareExpr2 : public A2DExpr<ShareExpr2<A, Ta, T, CA>, T> {
+ public:
+  using expr_t =
+      typename std::conditional<CA, const A2DExpr<A, Ta>, A2DExpr<A, Ta>>::type;
+  using A_t = typename std::conditional<CA, A, A&>::type;
+
+  // Shared leaves are zeroed by their owner, see ShareExpr
+  static constexpr bool is_leaf =
+      !std::is_same<typename remove_a2dobj<A>::type, A>::value;
+
+  A2D_FUNCTION ShareExpr2(expr_t& a0)
+      : a(a0.self()), val(0.0), bval(0.0), pval(0.0), hval(0.0) {}
+
+  // The parents do not evaluate or reverse the shared expression
+  A2D_FUNCTION void eval() {}
+  A2D_FUNCTION void reverse() {}
+  A2D_FUNCTION void hforward() {}
+  A2D_FUNCTION void hreverse() {}
+  A2D_FUNCTION void bzero() {}
+  A2D_FUNCTION void hzero() {}
+
+  // The sweeps through the shared expression, called once by LetExpr2
+  A2D_FUNCTION void eval_shared() {
+    a.eval();
+    val = a.value();
+  }
+  A2D_FUNCTION void reverse_shared() {
+    a.bvalue() += bval;
+    a.reverse();
+  }
+  A2D_FUNCTION void hforward_shared() {
+    a.hforward();
+    pval = a.pvalue();
+  }
+  A2D_FUNCTION void hreverse_shared() {
+    a.hvalue() += hval;
+    a.hreverse();
+  }
+  A2D_FUNCTION void bzero_shared() {
+    bval = T(0.0);
+    if constexpr (!is_leaf) {
+      a.bzero();
+    }
+  }
+  A2D_FUNCTION void hzero_shared() {
+    hval = T(0.0);
+    if constexpr (!is_leaf) {
+      a.hzero();
+    }
+  }
+
+  A2D_FUNCTION T& value() { return val; }
+  A2D_FUNCTION const T& value() const { return val; }
+  A2D_FUNCTION T& bvalue() { return bval; }
+  A2D_FUNCTION const T& bvalue() const { return bval; }
+  A2D_FUNCTION T& pvalue() { return pval; }
+  A2D_FUNCTION const T& pvalue() const { return pval; }
+  A2D_FUNCTION T& hvalue() { return hval; }
+  A2D_FUNCTION const T& hvalue() const { return hval; }
+
+ private:
+  A_t a;
+  T val, bval, pval, hval;
+};
+
+template <class A, class Ta>
+A2D_FUNCTION auto Share(const A2DExpr<A, Ta>& a) {
+  using T = typename remove_const_and_refs<Ta>::type;
+  return ShareExpr2<A, Ta, T, true>(a);
+}
+template <class A, class Ta>
+A2D_FUNCTION auto Share(A2DExpr<A, Ta>& a) {
+  using T = typename remove_const_and_refs<Ta>::type;
+  return ShareExpr2<A, Ta, T, false>(a);
+}
+
+template <class S, class B, class Tb, class T, bool CB>
+class LetExpr2 : public A2DExpr<LetExpr2<S, B, Tb, T, CB>, T> {
+ public:
+  using expr_t =
+      typename std::conditional<CB, const A2DExpr<B, Tb>, A2DExpr<B, Tb>>::type;
+  using B_t = typename std::conditional<CB, B, B&>::type;
+  A2D_FUNCTION LetExpr2(S& s, expr_t& b0)
+      : s(s), b(b0.self()), val(0.0), bval(0.0), pval(0.0), hval(0.0) {}
+  A2D_FUNCTION void eval() {
+    s.eval_shared();
+    b.eval();
+    val = b.value();
+  }
+  A2D_FUNCTION void reverse() {
+    // Only the parents within the body contribute to the shared adjoint
+    s.bvalue() = T(0.0);
+    b.bvalue() += bval;
+    b.reverse();
+    s.reverse_shared();
+  }
+  A2D_FUNCTION void hforward() {
+    s.hforward_shared();
+    b.hforward();
+    pval = b.pvalue();
+  }
+  A2D_FUNCTION void hreverse() {
+    s.hvalue() = T(0.0);
+    b.hvalue() += hval;
+    b.hreverse();
+    s.hreverse_shared();
+  }
+  A2D_FUNCTION void bzero() {
+    bval = T(0.0);
+    b.bzero();
+    s.bzero_shared();
+  }
+  A2D_FUNCTION void hzero() {
+    hval = T(0.0);
+    b.hzero();
+    s.hzero_shared();
+  }
+  A2D_FUNCTION T& value() { return val; }
+  A2D_FUNCTION const T& value() const { return val; }
+  A2D_FUNCTION T& bvalue() { return bval; }
+  A2D_FUNCTION const T& bvalue() const { return bval; }
+  A2D_FUNCTION T& pvalue() { return pval; }
+  A2D_FUNCTION const T& pvalue() const { return pval; }
+  A2D_FUNCTION T& hvalue() { return hval; }
+  A2D_FUNCTION const T& hvalue() const { return hval; }
+
+ private:
+  S& s;
+  B_t b;
+  T val, bval, pval, hval;
+};
+
+template <class A, class Ta, class T, bool CA, class B, class Tb,
+          std::enable_if_t<is_same_type<T, Tb>::value, bool> = true>
+A2D_FUNCTION auto Let(ShareExpr2<A, Ta, T, CA>& s, const A2DExpr<B, Tb>& b) {
+  return LetExpr2<ShareExpr2<A, Ta, T, CA>, B, Tb, T, true>(s, b);
+}
+template <class A, class Ta, class T, bool CA, class B, class Tb,
+          std::enable_if_t<is_same_type<T, Tb>::value, bool> = true>
+A2D_FUNCTION auto Let(ShareExpr2<A, Ta, T, CA>& s, A2DExpr<B, Tb>& b) {
+  return LetExpr2<ShareExpr2<A, Ta, T, CA>, B, Tb, T, false>(s, b);
+}
+
 template <class Expr, class T>
 class EvalExpr {
  public:
@@ -103,9 +379,10 @@ class ScalarTest : public A2DTest<T, T, T, T> {
     T a, b, f;
     x.get_values(a, b);
 
-    f = log(a * a * sqrt(exp(a * sin(a) + 3.0 * a)) + 2.0 * a * a * a * a) +
-        max2(a, min2(a * b, b * b)) - 4.0 * a / b + pow(5.0 / (b * b), 2.0) +
-        acos(a * 0.1);
+    f = log(a * a * sqrt(exp(a * sin(a) + T(3.0) * a)) +
+            T(2.0) * a * a * a * a) +
+        max2(a, min2(a * b, b * b)) - T(4.0) * a / b +
+        pow(T(5.0) / (b * b), T(2.0)) + acos(a * T(0.1));
 
     return MakeVarTuple<T>(f);
   }
@@ -163,6 +440,304 @@ inline bool ScalarTestAll(bool component, bool write_output) {
   return passed;
 }
 
+/*
+  Evaluate a formula with repeated subexpressions using Share() and Let(). The
+  shared expression bb depends on the shared expression aa, so the Let()
+  calls are nested in dependency order.
+*/
+template <typename T>
+class ScalarShareTest : public A2DTest<T, T, T, T> {
+ public:
+  using Input = VarTuple<T, T, T>;
+  using Output = VarTuple<T, T>;
+
+  // Assemble a string to describe the test
+  std::string name() { return std::string("ScalarShare"); }
+
+  // Evaluate the function without sharing
+  Output eval(const Input& x) {
+    T a, b, f;
+    x.get_values(a, b);
+
+    T aa = a * a;
+    T bb = aa * b + b;
+    f = log(aa * sqrt(exp(a * sin(aa) + T(3.0) * a)) + T(2.0) * aa * aa) +
+        max2(a, min2(bb, b * b)) - T(4.0) * bb / b +
+        pow(T(5.0) / (bb * bb), T(2.0)) + sin(bb) * exp(aa);
+
+    return MakeVarTuple<T>(f);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& x, Input& g) {
+    T a0, ab, b0, bb0;
+    ADObj<T&> a(a0, ab), b(b0, bb0);
+    ADObj<T> f;
+    x.get_values(a.value(), b.value());
+
+    auto aa = Share(a * a);
+    auto bb = Share(aa * b + b);
+    auto stack = MakeStack(Eval(
+        Let(aa, Let(bb, log(aa * sqrt(exp(a * sin(aa) + 3.0 * a)) +
+                            2.0 * aa * aa) +
+                            max2(a, min2(bb, b * b)) - 4.0 * bb / b +
+                            pow(5.0 / (bb * bb), 2.0) + sin(bb) * exp(aa))),
+        f));
+
+    seed.get_values(f.bvalue());
+    stack.reverse();
+    g.set_values(a.bvalue(), b.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& x,
+             const Input& p, Input& h) {
+    T a0, ab, ap, ah, b0, bb0, bp, bh;
+    A2DObj<T&> a(a0, ab, ap, ah), b(b0, bb0, bp, bh);
+    A2DObj<T> f;
+    x.get_values(a.value(), b.value());
+    p.get_values(a.pvalue(), b.pvalue());
+
+    auto aa = Share(a * a);
+    auto bb = Share(aa * b + b);
+    auto stack = MakeStack(Eval(
+        Let(aa, Let(bb, log(aa * sqrt(exp(a * sin(aa) + 3.0 * a)) +
+                            2.0 * aa * aa) +
+                            max2(a, min2(bb, b * b)) - 4.0 * bb / b +
+                            pow(5.0 / (bb * bb), 2.0) + sin(bb) * exp(aa))),
+        f));
+
+    seed.get_values(f.bvalue());
+    hval.get_values(f.hvalue());
+    stack.hproduct();
+    h.set_values(a.hvalue(), b.hvalue());
+  }
+};
+
+/*
+  Share a leaf that is also used outside of the Let() so that its adjoint
+  accumulates contributions from both the body and the rest of the formula
+*/
+template <typename T>
+class ScalarShareLeafTest : public A2DTest<T, T, T, T> {
+ public:
+  using Input = VarTuple<T, T, T>;
+  using Output = VarTuple<T, T>;
+
+  // Assemble a string to describe the test
+  std::string name() { return std::string("ScalarShareLeaf"); }
+
+  // Evaluate the function without sharing
+  Output eval(const Input& x) {
+    T a, b, f;
+    x.get_values(a, b);
+
+    f = a * b + a + (a * a * b + sin(a));
+
+    return MakeVarTuple<T>(f);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& x, Input& g) {
+    T a0, ab, b0, bb0;
+    ADObj<T&> a(a0, ab), b(b0, bb0);
+    ADObj<T> f;
+    x.get_values(a.value(), b.value());
+
+    auto s = Share(a);
+    auto stack = MakeStack(Eval(a * b + a + Let(s, s * s * b + sin(s)), f));
+
+    seed.get_values(f.bvalue());
+    stack.reverse();
+    g.set_values(a.bvalue(), b.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& x,
+             const Input& p, Input& h) {
+    T a0, ab, ap, ah, b0, bb0, bp, bh;
+    A2DObj<T&> a(a0, ab, ap, ah), b(b0, bb0, bp, bh);
+    A2DObj<T> f;
+    x.get_values(a.value(), b.value());
+    p.get_values(a.pvalue(), b.pvalue());
+
+    auto s = Share(a);
+    auto stack = MakeStack(Eval(a * b + a + Let(s, s * s * b + sin(s)), f));
+
+    seed.get_values(f.bvalue());
+    hval.get_values(f.hvalue());
+    stack.hproduct();
+    h.set_values(a.hvalue(), b.hvalue());
+  }
+};
+
+inline bool ScalarShareTestAll(bool component, bool write_output) {
+  using Tc = A2D_complex_t<double>;
+
+  bool passed = true;
+  ScalarShareTest<Tc> test1;
+  passed = passed && Run(test1, component, write_output);
+  ScalarShareLeafTest<Tc> test2;
+  passed = passed && Run(test2, component, write_output);
+
+  return passed;
+}
+
+/*
+  Evaluate long chains of sums and products that are flattened into single
+  n-ary nodes
+*/
+template <typename T>
+class ScalarNaryTest : public A2DTest<T, T, T, T> {
+ public:
+  using Input = VarTuple<T, T, T>;
+  using Output = VarTuple<T, T>;
+
+  // Assemble a string to describe the test
+  std::string name() { return std::string("ScalarNary"); }
+
+  // Evaluate the function
+  Output eval(const Input& x) {
+    T a, b, f;
+    x.get_values(a, b);
+
+    f = a * b * a * b * a + a + b + a * a + b * b +
+        sin(a) * cos(b) * exp(a) + T(3.0) * a + b * a * a +
+        sqrt(a * a + b * b + T(1.0)) + (a + b) * (a * b + a) * (b + T(2.0));
+
+    return MakeVarTuple<T>(f);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& x, Input& g) {
+    T a0, ab, b0, bb;
+    ADObj<T&> a(a0, ab), b(b0, bb);
+    ADObj<T> f;
+    x.get_values(a.value(), b.value());
+
+    auto stack = MakeStack(
+        Eval(a * b * a * b * a + a + b + a * a + b * b +
+                 sin(a) * cos(b) * exp(a) + 3.0 * a + b * a * a +
+                 sqrt(a * a + b * b + 1.0) + (a + b) * (a * b + a) * (b + 2.0),
+             f));
+
+    seed.get_values(f.bvalue());
+    stack.reverse();
+    g.set_values(a.bvalue(), b.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& x,
+             const Input& p, Input& h) {
+    T a0, ab, ap, ah, b0, bb, bp, bh;
+    A2DObj<T&> a(a0, ab, ap, ah), b(b0, bb, bp, bh);
+    A2DObj<T> f;
+    x.get_values(a.value(), b.value());
+    p.get_values(a.pvalue(), b.pvalue());
+
+    auto stack = MakeStack(
+        Eval(a * b * a * b * a + a + b + a * a + b * b +
+                 sin(a) * cos(b) * exp(a) + 3.0 * a + b * a * a +
+                 sqrt(a * a + b * b + 1.0) + (a + b) * (a * b + a) * (b + 2.0),
+             f));
+
+    seed.get_values(f.bvalue());
+    hval.get_values(f.hvalue());
+    stack.hproduct();
+    h.set_values(a.hvalue(), b.hvalue());
+  }
+};
+
+inline bool ScalarNaryTestAll(bool component, bool write_output) {
+  using Tc = A2D_complex_t<double>;
+
+  bool passed = true;
+  ScalarNaryTest<Tc> test1;
+  passed = passed && Run(test1, component, write_output);
+
+  return passed;
+}
+
+/*
+  Test the scalar functions that are not covered by ScalarTest
+*/
+template <typename T>
+class ScalarMathTest : public A2DTest<T, T, T, T> {
+ public:
+  using Input = VarTuple<T, T, T>;
+  using Output = VarTuple<T, T>;
+
+  // Assemble a string to describe the test
+  std::string name() { return std::string("ScalarMath"); }
+
+  // Evaluate the function
+  Output eval(const Input& x) {
+    T a, b, f;
+    x.get_values(a, b);
+
+    f = tanh(a * b) + erf(a - b) + log1p(a * a) + expm1(T(0.5) * b) +
+        atan2(a, b) + hypot(a, b) + softplus(T(3.0) * a) +
+        softplus(-T(4.0) * b) + ksmax2(a, b, T(5.0)) + pow(a * a + T(1.0), b) +
+        pow(T(2.0), a * b);
+
+    return MakeVarTuple<T>(f);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& x, Input& g) {
+    T a0, ab, b0, bb;
+    ADObj<T&> a(a0, ab), b(b0, bb);
+    ADObj<T> f;
+    x.get_values(a.value(), b.value());
+
+    auto stack = MakeStack(
+        Eval(tanh(a * b) + erf(a - b) + log1p(a * a) + expm1(0.5 * b) +
+                 atan2(a, b) + hypot(a, b) + softplus(3.0 * a) +
+                 softplus(-4.0 * b) + ksmax2(a, b, 5.0) +
+                 pow(a * a + 1.0, b) + pow(2.0, a * b),
+             f));
+
+    seed.get_values(f.bvalue());
+    stack.reverse();
+    g.set_values(a.bvalue(), b.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& x,
+             const Input& p, Input& h) {
+    T a0, ab, ap, ah, b0, bb, bp, bh;
+    A2DObj<T&> a(a0, ab, ap, ah), b(b0, bb, bp, bh);
+    A2DObj<T> f;
+    x.get_values(a.value(), b.value());
+    p.get_values(a.pvalue(), b.pvalue());
+
+    auto stack = MakeStack(
+        Eval(tanh(a * b) + erf(a - b) + log1p(a * a) + expm1(0.5 * b) +
+                 atan2(a, b) + hypot(a, b) + softplus(3.0 * a) +
+                 softplus(-4.0 * b) + ksmax2(a, b, 5.0) +
+                 pow(a * a + 1.0, b) + pow(2.0, a * b),
+             f));
+
+    seed.get_values(f.bvalue());
+    hval.get_values(f.hvalue());
+    stack.hproduct();
+    h.set_values(a.hvalue(), b.hvalue());
+  }
+};
+
+inline bool ScalarMathTestAll(bool component, bool write_output) {
+  using Tc = A2D_complex_t<double>;
+
+  bool passed = true;
+  for (int i = 0; i < 5; i++) {
+    ScalarMathTest<Tc> test1;
+    test1.set_trial(i);
+    passed = passed && Run(test1, component, write_output);
+  }
+
+  return passed;
+}
+
 }  // namespace Test
 
 }  // namespace A2D
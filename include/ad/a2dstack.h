@@ -3,11 +3,15 @@
 
 #include "../a2ddefs.h"
 #include "../a2dtuple.h"
+#include "a2dcost.h"
 #include "a2dobj.h"
 #include "a2dtuple.h"
 
 namespace A2D {
 
+// Tag used to construct a stack without evaluating the operations
+struct DeferEval {};
+
 template <class... Operations>
 class OperationStack {
  public:
@@ -18,12 +22,24 @@ class OperationStack {
       : stack(a2d_forward<Operations>(s)...) {
     eval_<0>();
   }
+  A2D_FUNCTION OperationStack(DeferEval, Operations &&...s)
+      : stack(a2d_forward<Operations>(s)...) {}
+
+  // Evaluate the operations again, in order
+  A2D_FUNCTION void eval() { eval_<0>(); }
 
   // First-order AD
-  A2D_FUNCTION void bzero() { bzero_<0>(); }
+  A2D_FUNCTION void bzero() { bzero_<0, num_ops>(); }
   A2D_FUNCTION void forward() { forward_<0>(); }
   A2D_FUNCTION void reverse() { reverse_<num_ops - 1>(); }
 
+  // Zero the seeds of all outputs except the output of the last operation
+  A2D_FUNCTION void bzero_intermediates() {
+    if constexpr (num_ops > 1) {
+      bzero_<0, num_ops - 1>();
+    }
+  }
+
   // Second-order AD
   A2D_FUNCTION void hzero() { hzero_<0>(); }
   A2D_FUNCTION void hforward() { hforward_<0>(); }
@@ -36,6 +52,24 @@ class OperationStack {
     hreverse();
   }
 
+  // Compile-time operation counts summed over the stack
+  static constexpr ADCost cost() {
+    return (ADCost("total") + ... + get_ad_cost<Operations>());
+  }
+
+  // Compile-time operation counts of a single operation
+  template <index_t index>
+  static constexpr ADCost cost() {
+    static_assert(index < num_ops, "Operation index out of range");
+    using Op = decltype(a2d_get<index>(std::declval<StackTuple &>()));
+    return get_ad_cost<Op>();
+  }
+
+  // Write a table of the operation counts for each operation
+  void write_cost(std::ostream &out) const {
+    WriteCostTable<Operations...>(out);
+  }
+
   // Apply Hessian-vector products to extract derivatives
   template <class Input, class Output, class Jacobian>
   A2D_FUNCTION void hextract(Input &p, Output &Jp, Jacobian &jac) {
@@ -74,11 +108,11 @@ class OperationStack {
     }
   }
 
-  template <index_t index>
+  template <index_t index, index_t end>
   A2D_FUNCTION void bzero_() {
     a2d_get<index>(stack).bzero();
-    if constexpr (index < num_ops - 1) {
-      bzero_<index + 1>();
+    if constexpr (index < end - 1) {
+      bzero_<index + 1, end>();
     }
   }
 
@@ -137,6 +171,130 @@ A2D_FUNCTION auto MakeStack(Operations &&...s) {
   return OperationStack<Operations...>(a2d_forward<Operations>(s)...);
 }
 
+/**
+ * @brief Make a segment of a checkpointed stack
+ *
+ * The operations are not evaluated until the segment is added to a
+ * CheckpointStack
+ *
+ * @tparam Operations Template parameter list deduced from context
+ * @param s The operator objects
+ * @return The segment of operations
+ */
+template <class... Operations>
+A2D_FUNCTION auto MakeSegment(Operations &&...s) {
+  return OperationStack<Operations...>(DeferEval(),
+                                       a2d_forward<Operations>(s)...);
+}
+
+/*
+  A stack for first-order reverse mode that trades storage for recomputation.
+
+  The operations are grouped into segments. The output of the last operation
+  in each segment is a checkpoint that must be a distinct object, but the
+  other outputs of a segment (the intermediates) may share storage with the
+  intermediates of other segments. During the reverse sweep, each segment is
+  evaluated again to restore its intermediate values before it is reversed,
+  and the seeds of its intermediates are zeroed afterwards so the storage can
+  be used by the next segment. The memory required is then set by the
+  checkpoints and the largest segment rather than by the whole computation.
+
+  The seeds of the intermediates are not available after reverse(). Only
+  first-order reverse mode is supported.
+*/
+template <class... Segments>
+class CheckpointStack {
+ public:
+  using SegmentTuple = a2d_tuple<Segments...>;
+  static constexpr index_t num_segments = sizeof...(Segments);
+
+  A2D_FUNCTION CheckpointStack(Segments &&...s)
+      : segments(a2d_forward<Segments>(s)...) {
+    eval();
+  }
+
+  // Evaluate all the segments in order
+  A2D_FUNCTION void eval() { eval_<0>(); }
+
+  A2D_FUNCTION void bzero() { bzero_<0>(); }
+  A2D_FUNCTION void reverse() { reverse_<num_segments - 1>(); }
+
+  // Compile-time operation counts summed over the segments
+  static constexpr ADCost cost() {
+    return (ADCost("total") + ... + get_segment_cost<Segments>());
+  }
+
+  // Additional cost of the evaluations repeated in the reverse sweep
+  static constexpr ADPhaseCost recompute_cost() {
+    return recompute_cost_<0>();
+  }
+
+ private:
+  SegmentTuple segments;
+
+  template <class Segment>
+  static constexpr ADCost get_segment_cost() {
+    return std::remove_reference_t<Segment>::cost();
+  }
+
+  template <index_t index>
+  static constexpr ADPhaseCost recompute_cost_() {
+    if constexpr (index < num_segments - 1) {
+      using Segment = std::remove_reference_t<decltype(a2d_get<index>(
+          std::declval<SegmentTuple &>()))>;
+      return Segment::cost().eval + recompute_cost_<index + 1>();
+    } else {
+      return ADPhaseCost();
+    }
+  }
+
+  template <index_t index>
+  A2D_FUNCTION void eval_() {
+    a2d_get<index>(segments).eval();
+    if constexpr (index < num_segments - 1) {
+      eval_<index + 1>();
+    }
+  }
+
+  template <index_t index>
+  A2D_FUNCTION void bzero_() {
+    a2d_get<index>(segments).bzero();
+    if constexpr (index < num_segments - 1) {
+      bzero_<index + 1>();
+    }
+  }
+
+  template <index_t index>
+  A2D_FUNCTION void reverse_() {
+    auto &segment = a2d_get<index>(segments);
+
+    // The last segment was the most recent to be evaluated
+    if constexpr (index < num_segments - 1) {
+      segment.eval();
+    }
+    segment.reverse();
+    segment.bzero_intermediates();
+
+    if constexpr (index) {
+      reverse_<index - 1>();
+    }
+  }
+};
+
+/**
+ * @brief Make a checkpointed stack for first-order reverse mode
+ *
+ * The segments are evaluated in order on construction
+ *
+ * @tparam Segments Template parameter list deduced from context
+ * @param s The segments created by MakeSegment
+ * @return The checkpointed stack
+ */
+template <class... Segments>
+A2D_FUNCTION auto MakeCheckpointStack(Segments &&...s) {
+  return CheckpointStack<Segments...>(a2d_forward<Segments>(s)...);
+}
+
 /**
  * @brief Compute the Jacobian-vector product depending on the input/output
  * states
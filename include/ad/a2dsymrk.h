@@ -4,6 +4,7 @@
 #include <type_traits>
 
 #include "../a2ddefs.h"
+#include "a2dcost.h"
 #include "a2dmat.h"
 #include "a2dtest.h"
 #include "core/a2dgemmcore.h"
@@ -14,7 +15,7 @@ namespace A2D {
 template <typename T, int N, int K, int P>
 A2D_FUNCTION void SymMatRK(const Mat<T, N, K>& A, SymMat<T, P>& S) {
   static_assert(P == N, "SymMatRK matrix dimensions must agree");
-  SymMatRKCore<T, N, K, MatOp::NORMAL>(get_data(A), get_data(S));
+  SymMatRKDispatchCore<T, N, K, MatOp::NORMAL>(get_data(A), get_data(S));
 }
 
 template <typename T, int N, int K, int P>
@@ -30,7 +31,7 @@ A2D_FUNCTION void SymMatRK(const Mat<T, N, K>& A, SymMat<T, P>& S) {
   static_assert(
       (op == MatOp::NORMAL && P == N) || (op == MatOp::TRANSPOSE && K == P),
       "SymMatRK matrix dimensions must agree");
-  SymMatRKCore<T, N, K, op>(get_data(A), get_data(S));
+  SymMatRKDispatchCore<T, N, K, op>(get_data(A), get_data(S));
 }
 
 template <MatOp op, typename T, int N, int K, int P>
@@ -60,7 +61,7 @@ class SymMatRKExpr {
   }
 
   A2D_FUNCTION void eval() {
-    SymMatRKCore<T, N, K, op>(get_data(A), get_data(S));
+    SymMatRKDispatchCore<T, N, K, op>(get_data(A), get_data(S));
   }
 
   A2D_FUNCTION void bzero() { S.bzero(); }
@@ -91,6 +92,20 @@ class SymMatRKExpr {
                                      GetSeed<ADseed::h>::get_data(A));
   }
 
+  // Operation counts for the compile-time cost model
+  static constexpr ADCost cost() {
+    constexpr index_t R = (op == MatOp::NORMAL ? K : N);
+    constexpr index_t sizeA = N * K, sizeS = (P * (P + 1)) / 2;
+
+    ADCost c("SymMatRK");
+    c.eval = KernelCost<T>(2 * R * sizeS, sizeA, sizeS);
+    c.forward = KernelCost<T>(4 * R * sizeS, 2 * sizeA, sizeS);
+    c.reverse = KernelCost<T>(2 * P * P * R, 2 * sizeA + sizeS, sizeA);
+    c.hforward = c.forward;
+    c.hreverse = 2 * c.reverse;
+    return c;
+  }
+
   Atype& A;
   Stype& S;
 };
@@ -167,6 +182,21 @@ class SymMatRKScaleExpr {
         GetSeed<ADseed::h>::get_data(A));
   }
 
+  // Operation counts for the compile-time cost model
+  static constexpr ADCost cost() {
+    constexpr index_t R = (op == MatOp::NORMAL ? K : N);
+    constexpr index_t sizeA = N * K, sizeS = (P * (P + 1)) / 2;
+
+    ADCost c("SymMatRKScale");
+    c.eval = KernelCost<T>(2 * R * sizeS + sizeS, sizeA, sizeS);
+    c.forward = KernelCost<T>(4 * R * sizeS + sizeS, 2 * sizeA, sizeS);
+    c.reverse =
+        KernelCost<T>(2 * P * P * R + sizeA, 2 * sizeA + sizeS, sizeA);
+    c.hforward = c.forward;
+    c.hreverse = 2 * c.reverse;
+    return c;
+  }
+
   const T alpha;
   Atype& A;
   Stype& S;
@@ -213,6 +243,12 @@ class SymMatRKTest : public A2DTest<T, SymMat<T, P>, Mat<T, N, M>> {
     return s.str();
   }
 
+  // Operation counts of the stack used in deriv and hprod
+  ADCost cost() {
+    return SymMatRKExpr<A2DObj<Mat<T, N, M>>, A2DObj<SymMat<T, P>>,
+                        op>::cost();
+  }
+
   // Evaluate the matrix-matrix product
   Output eval(const Input& x) {
     Mat<T, N, M> A;
@@ -0,0 +1,407 @@
+#ifndef A2D_TENSOR_BASIS_H
+#define A2D_TENSOR_BASIS_H
+
+#include "../a2ddefs.h"
+#include "a2dmat.h"
+#include "a2dstack.h"
+#include "a2dtest.h"
+#include "a2dvec.h"
+#include "core/a2dtensorcore.h"
+
+namespace A2D {
+
+/*
+  Tensor-product interpolation for 1D, 2D and 3D elements
+
+  The basis along each direction is the same q x n matrix N, with
+  N[a, i] = N_i(xi_a) for the n 1D basis functions evaluated at the q 1D
+  points, and its derivative D[a, i] = dN_i/dxi(xi_a). The nodal values u
+  and the values at the points are ordered with the first index fastest, so
+  that u[n * (n * k + j) + i] is the value at node (i, j, k).
+
+  The interpolation and its transpose are applied one direction at a time
+  (sum factorization) in O(dim p^{dim + 1}) operations for n ~ q ~ p, so the
+  full q^{dim} x n^{dim} matrix is never formed. Since the interpolation is
+  linear in u, the derivatives are
+
+  dot{uq} = (N x N x N) dot{u}
+  bar{u} += (N x N x N)^{T} bar{uq}
+
+  and similarly for the gradient, which applies D along one direction.
+
+  The operations act on the nodal values of a single element. A batch of
+  elements is handled by calling them once per element.
+*/
+
+// Evaluate the 1D Lagrange basis through the nodes x at the points xi
+template <typename T, int n, int q>
+A2D_FUNCTION void LagrangeBasis(const Vec<T, n>& x, const Vec<T, q>& xi,
+                                Mat<T, q, n>& N, Mat<T, q, n>& D) {
+  LagrangeBasisCore<T, n, q>(get_data(x), get_data(xi), get_data(N),
+                             get_data(D));
+}
+
+// Interpolate the nodal values u to the values uq at the points
+template <typename T, int n, int q, int nu, int nq>
+A2D_FUNCTION void TensorInterp(const Mat<T, q, n>& N, const Vec<T, nu>& u,
+                               Vec<T, nq>& uq) {
+  constexpr int dim = TensorDim(n, nu);
+  static_assert(dim > 0 && TensorDim(q, nq) == dim,
+                "Vector sizes must be n^dim and q^dim for dim = 1, 2, 3");
+  TensorApplyCore<T, dim, n, q>(get_data(N), get_data(N), get_data(N),
+                                get_data(u), get_data(uq));
+}
+
+// Interpolate the derivatives of u with respect to xi to the points, where
+// row k of uxi is the gradient at point k
+template <typename T, int n, int q, int nu, int nq, int dim, MatLayout layout>
+A2D_FUNCTION void TensorInterpGrad(const Mat<T, q, n>& N,
+                                   const Mat<T, q, n>& D, const Vec<T, nu>& u,
+                                   Mat<T, nq, dim, layout>& uxi) {
+  static_assert(TensorDim(n, nu) == dim && TensorDim(q, nq) == dim,
+                "Vector sizes must be n^dim and q^dim for dim = 1, 2, 3");
+  constexpr bool row_major = (layout == MatLayout::ROW_MAJOR);
+  constexpr int sx = (row_major ? dim : 1);
+  constexpr int ox = (row_major ? 1 : nq);
+  TensorApplyGradCore<T, dim, n, q, MatOp::NORMAL, sx, ox>(
+      get_data(N), get_data(D), get_data(u), get_data(uxi));
+}
+
+template <class Ntype, class utype, class uqtype>
+class TensorInterpExpr {
+ public:
+  // Extract the numeric type to use
+  typedef typename get_object_numeric_type<uqtype>::type T;
+
+  // Extract the dimensions of the basis and the vectors
+  static constexpr int q = get_matrix_rows<Ntype>::size;
+  static constexpr int n = get_matrix_columns<Ntype>::size;
+  static constexpr int nu = get_vec_size<utype>::size;
+  static constexpr int nq = get_vec_size<uqtype>::size;
+  static constexpr int dim = TensorDim(n, nu);
+
+  static_assert(dim > 0 && TensorDim(q, nq) == dim,
+                "Vector sizes must be n^dim and q^dim for dim = 1, 2, 3");
+
+  // Get the differentiation order from the output
+  static constexpr ADorder order = get_diff_order<uqtype>::order;
+
+  A2D_FUNCTION TensorInterpExpr(const Ntype& N, utype& u, uqtype& uq)
+      : N(N), u(u), uq(uq) {}
+
+  A2D_FUNCTION void eval() {
+    TensorApplyCore<T, dim, n, q>(get_data(N), get_data(N), get_data(N),
+                                  get_data(u), get_data(uq));
+  }
+
+  A2D_FUNCTION void bzero() { uq.bzero(); }
+
+  template <ADorder forder>
+  A2D_FUNCTION void forward() {
+    static_assert(
+        !(order == ADorder::FIRST and forder == ADorder::SECOND),
+        "Can't perform second order forward with first order objects");
+    constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
+                                              ADseed::b, ADseed::p>::value;
+    TensorApplyCore<T, dim, n, q>(get_data(N), get_data(N), get_data(N),
+                                  GetSeed<seed>::get_data(u),
+                                  GetSeed<seed>::get_data(uq));
+  }
+
+  A2D_FUNCTION void reverse() {
+    constexpr bool additive = true;
+    TensorApplyCore<T, dim, n, q, MatOp::TRANSPOSE, 1, 1, additive>(
+        get_data(N), get_data(N), get_data(N),
+        GetSeed<ADseed::b>::get_data(uq), GetSeed<ADseed::b>::get_data(u));
+  }
+
+  A2D_FUNCTION void hzero() { uq.hzero(); }
+
+  A2D_FUNCTION void hreverse() {
+    static_assert(order == ADorder::SECOND,
+                  "hreverse() can be called for only second order objects.");
+    constexpr bool additive = true;
+    TensorApplyCore<T, dim, n, q, MatOp::TRANSPOSE, 1, 1, additive>(
+        get_data(N), get_data(N), get_data(N),
+        GetSeed<ADseed::h>::get_data(uq), GetSeed<ADseed::h>::get_data(u));
+  }
+
+  // Operation counts for the compile-time cost model
+  static constexpr ADCost cost() {
+    constexpr index_t flops = TensorFlops(n, q, dim);
+    ADCost c("TensorInterp");
+    c.eval = KernelCost<T>(flops, nu + q * n, nq);
+    c.forward = c.eval;
+    c.reverse = KernelCost<T>(flops, nq + q * n, nu);
+    c.hforward = c.forward;
+    c.hreverse = c.reverse;
+    return c;
+  }
+
+ private:
+  const Ntype& N;
+  utype& u;
+  uqtype& uq;
+};
+
+template <class Ntype, class Dtype, class utype, class uxtype>
+class TensorInterpGradExpr {
+ public:
+  // Extract the numeric type to use
+  typedef typename get_object_numeric_type<uxtype>::type T;
+
+  // Extract the dimensions of the basis, the vector and the gradients
+  static constexpr int q = get_matrix_rows<Ntype>::size;
+  static constexpr int n = get_matrix_columns<Ntype>::size;
+  static constexpr int nu = get_vec_size<utype>::size;
+  static constexpr int nq = get_matrix_layout<uxtype>::rows;
+  static constexpr int dim = get_matrix_layout<uxtype>::columns;
+
+  static_assert(TensorDim(n, nu) == dim && TensorDim(q, nq) == dim,
+                "Vector sizes must be n^dim and q^dim for dim = 1, 2, 3");
+  static_assert(get_matrix_rows<Dtype>::size == q &&
+                    get_matrix_columns<Dtype>::size == n,
+                "Basis dimensions must agree");
+
+  // Strides of the gradient entries for point k and direction d
+  static constexpr bool row_major =
+      (get_matrix_layout<uxtype>::value == MatLayout::ROW_MAJOR);
+  static constexpr int sx = (row_major ? dim : 1);
+  static constexpr int ox = (row_major ? 1 : nq);
+
+  // Get the differentiation order from the output
+  static constexpr ADorder order = get_diff_order<uxtype>::order;
+
+  A2D_FUNCTION TensorInterpGradExpr(const Ntype& N, const Dtype& D, utype& u,
+                                    uxtype& uxi)
+      : N(N), D(D), u(u), uxi(uxi) {}
+
+  A2D_FUNCTION void eval() {
+    TensorApplyGradCore<T, dim, n, q, MatOp::NORMAL, sx, ox>(
+        get_data(N), get_data(D), get_data(u), get_data(uxi));
+  }
+
+  A2D_FUNCTION void bzero() { uxi.bzero(); }
+
+  template <ADorder forder>
+  A2D_FUNCTION void forward() {
+    static_assert(
+        !(order == ADorder::FIRST and forder == ADorder::SECOND),
+        "Can't perform second order forward with first order objects");
+    constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
+                                              ADseed::b, ADseed::p>::value;
+    TensorApplyGradCore<T, dim, n, q, MatOp::NORMAL, sx, ox>(
+        get_data(N), get_data(D), GetSeed<seed>::get_data(u),
+        GetSeed<seed>::get_data(uxi));
+  }
+
+  A2D_FUNCTION void reverse() {
+    constexpr bool additive = true;
+    TensorApplyGradCore<T, dim, n, q, MatOp::TRANSPOSE, sx, ox, additive>(
+        get_data(N), get_data(D), GetSeed<ADseed::b>::get_data(uxi),
+        GetSeed<ADseed::b>::get_data(u));
+  }
+
+  A2D_FUNCTION void hzero() { uxi.hzero(); }
+
+  A2D_FUNCTION void hreverse() {
+    static_assert(order == ADorder::SECOND,
+                  "hreverse() can be called for only second order objects.");
+    constexpr bool additive = true;
+    TensorApplyGradCore<T, dim, n, q, MatOp::TRANSPOSE, sx, ox, additive>(
+        get_data(N), get_data(D), GetSeed<ADseed::h>::get_data(uxi),
+        GetSeed<ADseed::h>::get_data(u));
+  }
+
+  // Operation counts for the compile-time cost model
+  static constexpr ADCost cost() {
+    constexpr index_t flops = dim * TensorFlops(n, q, dim);
+    ADCost c("TensorInterpGrad");
+    c.eval = KernelCost<T>(flops, nu + 2 * q * n, nq * dim);
+    c.forward = c.eval;
+    c.reverse = KernelCost<T>(flops, nq * dim + 2 * q * n, nu);
+    c.hforward = c.forward;
+    c.hreverse = c.reverse;
+    return c;
+  }
+
+ private:
+  const Ntype& N;
+  const Dtype& D;
+  utype& u;
+  uxtype& uxi;
+};
+
+template <class Ntype, class utype, class uqtype>
+A2D_FUNCTION auto TensorInterp(const Ntype& N, ADObj<utype>& u,
+                               ADObj<uqtype>& uq) {
+  return TensorInterpExpr<Ntype, ADObj<utype>, ADObj<uqtype>>(N, u, uq);
+}
+
+template <class Ntype, class utype, class uqtype>
+A2D_FUNCTION auto TensorInterp(const Ntype& N, A2DObj<utype>& u,
+                               A2DObj<uqtype>& uq) {
+  return TensorInterpExpr<Ntype, A2DObj<utype>, A2DObj<uqtype>>(N, u, uq);
+}
+
+template <class Ntype, class Dtype, class utype, class uxtype>
+A2D_FUNCTION auto TensorInterpGrad(const Ntype& N, const Dtype& D,
+                                   ADObj<utype>& u, ADObj<uxtype>& uxi) {
+  return TensorInterpGradExpr<Ntype, Dtype, ADObj<utype>, ADObj<uxtype>>(
+      N, D, u, uxi);
+}
+
+template <class Ntype, class Dtype, class utype, class uxtype>
+A2D_FUNCTION auto TensorInterpGrad(const Ntype& N, const Dtype& D,
+                                   A2DObj<utype>& u, A2DObj<uxtype>& uxi) {
+  return TensorInterpGradExpr<Ntype, Dtype, A2DObj<utype>, A2DObj<uxtype>>(
+      N, D, u, uxi);
+}
+
+namespace Test {
+
+/*
+  Test the tensor-product interpolation of the values (grad == false) or the
+  gradient (grad == true) against the assembled tensor-product matrix. The
+  layout applies to the gradient.
+*/
+template <bool grad, typename T, int dim, int n, int q,
+          MatLayout layout = MatLayout::ROW_MAJOR>
+class TensorInterpTest
+    : public A2DTest<T,
+                     typename std::conditional<
+                         grad, Mat<T, TensorSize(q, dim), dim, layout>,
+                         Vec<T, TensorSize(q, dim)>>::type,
+                     Vec<T, TensorSize(n, dim)>> {
+ public:
+  static constexpr int nu = TensorSize(n, dim);
+  static constexpr int nq = TensorSize(q, dim);
+  using Utype = Vec<T, nu>;
+  using Otype = typename std::conditional<grad, Mat<T, nq, dim, layout>,
+                                          Vec<T, nq>>::type;
+  using Input = VarTuple<T, Utype>;
+  using Output = VarTuple<T, Otype>;
+
+  TensorInterpTest() {
+    // Equally spaced nodes and interior points on [-1, 1]
+    Vec<T, n> x;
+    Vec<T, q> xi;
+    for (int i = 0; i < n; i++) {
+      x[i] = -1.0 + 2.0 * i / (n - 1);
+    }
+    for (int a = 0; a < q; a++) {
+      xi[a] = -0.9 + 1.8 * (a + 0.25) / q;
+    }
+    LagrangeBasis(x, xi, N, D);
+  }
+
+  // Assemble a string to describe the test
+  std::string name() {
+    std::stringstream s;
+    s << (grad ? "TensorInterpGrad<" : "TensorInterp<");
+    if (layout == MatLayout::COLUMN_MAJOR) {
+      s << "C,";
+    }
+    s << dim << "," << n << "," << q << ">";
+    return s.str();
+  }
+
+  // Evaluate the operation with the assembled tensor product
+  Output eval(const Input& x) {
+    Utype u;
+    Otype out;
+    x.get_values(u);
+
+    for (int pt = 0; pt < nq; pt++) {
+      for (int d = 0; d < (grad ? dim : 1); d++) {
+        T value = 0.0;
+        for (int node = 0; node < nu; node++) {
+          T w = 1.0;
+          for (int k = 0, a = pt, i = node; k < dim; k++, a /= q, i /= n) {
+            w *= ((grad && k == d) ? D(a % q, i % n) : N(a % q, i % n));
+          }
+          value += w * u[node];
+        }
+        if constexpr (grad) {
+          out(pt, d) = value;
+        } else {
+          out[pt] = value;
+        }
+      }
+    }
+    return MakeVarTuple<T>(out);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& x, Input& g) {
+    ADObj<Utype> u;
+    ADObj<Otype> out;
+    x.get_values(u.value());
+    auto stack = MakeStack(apply(u, out));
+    seed.get_values(out.bvalue());
+    stack.reverse();
+    g.set_values(u.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& x,
+             const Input& p, Input& h) {
+    A2DObj<Utype> u;
+    A2DObj<Otype> out;
+    x.get_values(u.value());
+    p.get_values(u.pvalue());
+    auto stack = MakeStack(apply(u, out));
+    seed.get_values(out.bvalue());
+    hval.get_values(out.hvalue());
+    stack.hproduct();
+    h.set_values(u.hvalue());
+  }
+
+ private:
+  template <class U, class O>
+  auto apply(U& u, O& out) {
+    if constexpr (grad) {
+      return TensorInterpGrad(N, D, u, out);
+    } else {
+      return TensorInterp(N, u, out);
+    }
+  }
+
+  Mat<T, q, n> N, D;
+};
+
+template <typename T, int dim, int n, int q>
+bool TensorInterpTestHelper(bool component = false, bool write_output = true) {
+  using Tc = A2D_complex_t<T>;
+
+  bool passed = true;
+  TensorInterpTest<false, Tc, dim, n, q> test1;
+  passed = passed && Run(test1, component, write_output);
+  TensorInterpTest<true, Tc, dim, n, q> test2;
+  passed = passed && Run(test2, component, write_output);
+  TensorInterpTest<true, Tc, dim, n, q, MatLayout::COLUMN_MAJOR> test3;
+  passed = passed && Run(test3, component, write_output);
+
+  return passed;
+}
+
+inline bool TensorInterpTestAll(bool component = false,
+                                bool write_output = true) {
+  bool passed = true;
+  passed = passed &&
+           TensorInterpTestHelper<double, 1, 4, 5>(component, write_output);
+  passed = passed &&
+           TensorInterpTestHelper<double, 2, 3, 4>(component, write_output);
+  passed = passed &&
+           TensorInterpTestHelper<double, 3, 3, 2>(component, write_output);
+  passed = passed &&
+           TensorInterpTestHelper<double, 3, 4, 4>(component, write_output);
+
+  return passed;
+}
+
+}  // namespace Test
+
+}  // namespace A2D
+
+#endif  // A2D_TENSOR_BASIS_H
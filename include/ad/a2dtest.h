@@ -1,8 +1,15 @@
 #ifndef A2D_TEST_H
 #define A2D_TEST_H
 
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "a2dobj.h"
 #include "a2dstack.h"
@@ -29,6 +36,24 @@ enum class TestType {
   SECOND_ORDER
 };
 
+/*
+  Default complex-step size and tolerances for the precision of the test
+  type. The step for float is larger so that it does not underflow, and the
+  tolerances allow for the rounding errors of float.
+*/
+template <typename T>
+struct TestDefaults {
+  static constexpr double dh = 1e-50, rtol = 1e-10, atol = 1e-30;
+};
+
+template <>
+struct TestDefaults<float> {
+  static constexpr double dh = 1e-20, rtol = 1e-4, atol = 1e-5;
+};
+
+template <>
+struct TestDefaults<A2D_complex_t<float>> : public TestDefaults<float> {};
+
 template <typename T, class Output, class... Inputs>
 class A2DTest {
  public:
@@ -36,8 +61,9 @@ class A2DTest {
    * @brief Construct the Test
    */
   A2DTest(TestType test_type = TestType::SECOND_ORDER_INTEGRATION,
-          double dh = 1e-50, double rtol = 1e-10, double atol = 1e-30)
-      : test_type(test_type), dh(dh), rtol(rtol), atol(atol) {}
+          double dh = TestDefaults<T>::dh, double rtol = TestDefaults<T>::rtol,
+          double atol = TestDefaults<T>::atol)
+      : test_type(test_type), dh(dh), rtol(rtol), atol(atol), trial(0) {}
 
   /**
    * @brief Set the tolerances
@@ -45,7 +71,8 @@ class A2DTest {
    * @param rtol0 Relative tolerance
    * @param atol0 Absolute tolerance
    */
-  void set_tolerances(double rtol0 = 1e-10, double atol0 = 1e-30) {
+  void set_tolerances(double rtol0 = TestDefaults<T>::rtol,
+                      double atol0 = TestDefaults<T>::atol) {
     rtol = rtol0;
     atol = atol0;
   }
@@ -70,7 +97,9 @@ class A2DTest {
    *
    * @param x Variable tuple for the inputs
    */
-  virtual void get_point(VarTuple<T, Inputs...>& x) { x.set_rand(); }
+  virtual void get_point(VarTuple<T, Inputs...>& x) {
+    x.set_rand(get_rng("point"));
+  }
 
   /**
    * @brief Get the name of the test
@@ -110,6 +139,44 @@ class A2DTest {
                      const VarTuple<T, Inputs...>& p,
                      VarTuple<T, Inputs...>& h) {}
 
+  /**
+   * @brief Get the operation counts of the stack used in deriv and hprod
+   *
+   * Tests that override this report GFLOP/s in Benchmark
+   *
+   * @return The operation counts or an unknown cost
+   */
+  virtual ADCost cost() { return ADCost(); }
+
+  /**
+   * @brief Get a counter-based random number generator for the test
+   *
+   * The generator is keyed by the name of the test, the purpose and the
+   * trial, so the random values are independent of the order of the tests
+   * and the number of threads.
+   *
+   * @param purpose What the random values are used for
+   * @return The generator
+   */
+  A2DRandom get_rng(const std::string& purpose) {
+    return A2DRandom((name() + ":" + purpose).c_str(), trial);
+  }
+
+  /**
+   * @brief Set the trial index used to key the random values
+   *
+   * Repeated runs of the same test use different trials to draw different,
+   * reproducible points.
+   *
+   * @param trial0 The trial index
+   */
+  void set_trial(uint64_t trial0) { trial = trial0; }
+
+  /**
+   * @brief Get the trial index
+   */
+  uint64_t get_trial() const { return trial; }
+
   /**
    * @brief Set random values into an array
    *
@@ -117,12 +184,14 @@ class A2DTest {
    * @param array The array to set values into
    * @param low The lower limit
    * @param high The upper limit
+   * @param stream Index used to draw different values for different arrays
    */
   template <typename Array>
   void set_rand(const int size, Array& array, T low = T(-1.0),
-                T high = T(1.0)) {
+                T high = T(1.0), uint64_t stream = 0) {
+    A2DRandom rng = get_rng("array").split(stream);
     for (int i = 0; i < size; i++) {
-      array[i] = low + (high - low) * (static_cast<double>(rand()) / RAND_MAX);
+      array[i] = low + (high - low) * T(rng.uniform(i));
     }
   }
 
@@ -173,17 +242,175 @@ class A2DTest {
 
  private:
   TestType test_type;
-  double dh;    // Complex-step size
-  double rtol;  // relative tolerance
-  double atol;  // absolute tolerance
+  double dh;       // Complex-step size
+  double rtol;     // relative tolerance
+  double atol;     // absolute tolerance
+  uint64_t trial;  // trial index for the random values
+};
+
+/*
+  The number of threads used by Run for the component-by-component tests when
+  the number is not passed explicitly, read from the environment variable
+  A2D_TEST_THREADS. The tests run on one thread when it is not set.
+*/
+inline int DefaultNumThreads() {
+  const char* value = std::getenv("A2D_TEST_THREADS");
+  int num_threads = (value ? std::atoi(value) : 1);
+  return (num_threads > 1 ? num_threads : 1);
+}
+
+/**
+ * @brief Call func(k) for k = 0, ..., n - 1 using a pool of threads
+ *
+ * The calls are distributed dynamically, so func must be safe to call
+ * concurrently for different values of k.
+ *
+ * @param n The number of tasks
+ * @param num_threads The number of threads to use
+ * @param func The task function
+ */
+template <class Func>
+void ParallelFor(const int n, const int num_threads, const Func& func) {
+  int nthreads = (num_threads < n ? num_threads : n);
+  if (nthreads <= 1) {
+    for (int k = 0; k < n; k++) {
+      func(k);
+    }
+    return;
+  }
+
+  std::atomic<int> next(0);
+  auto worker = [&]() {
+    for (int k = next++; k < n; k = next++) {
+      func(k);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 1; i < nthreads; i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
+/*
+  Timing results from Benchmark in nanoseconds per call and GFLOP/s. The
+  GFLOP/s are zero when the test does not report its operation counts.
+*/
+struct BenchmarkResult {
+  std::string name;
+  double eval_ns, deriv_ns, hprod_ns;
+  double eval_gflops, deriv_gflops, hprod_gflops;
 };
 
+/**
+ * @brief Write the header of the table of benchmark results
+ */
+inline void WriteBenchmarkHeader(std::ostream& out) {
+  out << std::left << std::setw(40) << "test" << std::right << std::setw(12)
+      << "eval ns" << std::setw(12) << "deriv ns" << std::setw(12)
+      << "hprod ns" << std::setw(12) << "eval GF/s" << std::setw(12)
+      << "deriv GF/s" << std::setw(12) << "hprod GF/s" << std::endl;
+}
+
+/**
+ * @brief Time the eval, deriv and hprod functions of a test
+ *
+ * Each function is called num_warmup times and then timed over num_reps
+ * calls at the test point. The deriv time includes the evaluation performed
+ * when the stack is created, and the hprod time includes the evaluation and
+ * the first-order reverse sweep.
+ *
+ * @param test The test to time
+ * @param num_reps The number of timed calls of each function
+ * @param num_warmup The number of calls before timing
+ * @param out Stream for a one-line summary, or nullptr
+ * @return The timing results
+ */
+template <typename T, class Output, class... Inputs>
+BenchmarkResult Benchmark(A2DTest<T, Output, Inputs...>& test,
+                          int num_reps = 10000, int num_warmup = 100,
+                          std::ostream* out = &std::cout) {
+  using clock = std::chrono::steady_clock;
+
+  VarTuple<T, Inputs...> x, g, p, h;
+  VarTuple<T, Output> seed, hvalue, value;
+  test.get_point(x);
+  seed.set_rand(test.get_rng("seed"));
+  hvalue.set_rand(test.get_rng("hvalue"));
+  p.set_rand(test.get_rng("direction"));
+
+  // Accumulate the results so that the calls are not optimized away
+  double sum = 0.0;
+  auto time = [&](auto&& func) {
+    for (int i = 0; i < num_warmup; i++) {
+      func();
+    }
+    auto start = clock::now();
+    for (int i = 0; i < num_reps; i++) {
+      func();
+    }
+    std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+    return elapsed.count() / (num_reps > 0 ? num_reps : 1);
+  };
+
+  BenchmarkResult r;
+  r.name = test.name();
+  r.eval_ns = time([&]() {
+    value = test.eval(x);
+    sum += RealPart(value[0]);
+  });
+  r.deriv_ns = time([&]() {
+    test.deriv(seed, x, g);
+    sum += RealPart(g[0]);
+  });
+  r.hprod_ns = time([&]() {
+    test.hprod(seed, hvalue, x, p, h);
+    sum += RealPart(h[0]);
+  });
+
+  ADCost c = test.cost();
+  double deriv_flops = (c.eval + c.reverse).flops;
+  double hprod_flops = (c.eval + c.hproduct()).flops;
+  r.eval_gflops = c.eval.flops / r.eval_ns;
+  r.deriv_gflops = deriv_flops / r.deriv_ns;
+  r.hprod_gflops = hprod_flops / r.hprod_ns;
+
+  if (out) {
+    std::ostream& s = *out;
+    std::ios_base::fmtflags flags = s.flags();
+    std::streamsize precision = s.precision();
+    s << std::left << std::setw(40) << r.name << std::right << std::fixed
+      << std::setprecision(1) << std::setw(12) << r.eval_ns << std::setw(12)
+      << r.deriv_ns << std::setw(12) << r.hprod_ns << std::setprecision(3)
+      << std::setw(12) << r.eval_gflops << std::setw(12) << r.deriv_gflops
+      << std::setw(12) << r.hprod_gflops << std::endl;
+    s.flags(flags);
+    s.precision(precision);
+  }
+
+  // Keep the accumulated results live
+  volatile double sink = sum;
+  (void)sink;
+
+  return r;
+}
+
 /**
  * Run the AD test
+ *
+ * In the component-by-component test, each direction is an independent task
+ * that is distributed across num_threads threads. The eval, deriv and hprod
+ * functions of the test must then be safe to call concurrently. The output
+ * is written in the same order as a serial run.
  */
 template <typename T, class Output, class... Inputs>
 bool Run(A2DTest<A2D_complex_t<T>, Output, Inputs...>& test,
-         bool component = false, bool write_output = true) {
+         bool component = false, bool write_output = true,
+         int num_threads = DefaultNumThreads()) {
   // Declare all of the variables needed
   VarTuple<A2D_complex_t<T>, Inputs...> x, g, x1, p, h;
   VarTuple<A2D_complex_t<T>, Output> seed, hvalue;
@@ -192,8 +419,8 @@ bool Run(A2DTest<A2D_complex_t<T>, Output, Inputs...>& test,
   if (test_type == TestType::FIRST_ORDER_INTEGRATION ||
       test_type == TestType::SECOND_ORDER_INTEGRATION) {
     // Set a random seed input
-    seed.set_rand();
-    hvalue.set_rand();
+    seed.set_rand(test.get_rng("seed"));
+    hvalue.set_rand(test.get_rng("hvalue"));
   } else {
     for (int i = 0; i < seed.get_num_components(); i++) {
       seed[i] = T(1.0);
@@ -209,16 +436,21 @@ bool Run(A2DTest<A2D_complex_t<T>, Output, Inputs...>& test,
   // Perform a component-by-component test for gradients and the Hessian-vector
   // products
   if (component) {
-    for (int k = 0; k < p.get_num_components(); k++) {
+    const int ncomp = p.get_num_components();
+    std::vector<char> task_passed(ncomp);
+    std::vector<std::string> task_output(ncomp);
+
+    ParallelFor(ncomp, num_threads, [&](int k) {
+      VarTuple<A2D_complex_t<T>, Inputs...> p, g, x1;
       p.zero();
       p[k] = T(1.0);
 
       test.deriv(seed, x, g);
 
       // Set x1 = x + dh * p1
-      double dh = test.get_step_size();
+      T dh = test.get_step_size();
       for (index_t i = 0; i < x.get_num_components(); i++) {
-        x1[i] = A2D_complex_t<double>(RealPart(x[i]), RealPart(dh * p[i]));
+        x1[i] = A2D_complex_t<T>(RealPart(x[i]), dh * RealPart(p[i]));
       }
 
       // Compute the complex-step result: fd = p^{T} * df/dx
@@ -234,12 +466,19 @@ bool Run(A2DTest<A2D_complex_t<T>, Output, Inputs...>& test,
         ans += RealPart(g[i] * p[i]);
       }
 
-      passed = passed && test.is_close(ans, fd);
+      task_passed[k] = test.is_close(ans, fd);
 
       if (write_output) {
+        std::stringstream out;
         std::string str = test.name();
-        test.write_result(str + " first-order", std::cout, ans, fd);
+        test.write_result(str + " first-order", out, ans, fd);
+        task_output[k] = out.str();
       }
+    });
+
+    for (int k = 0; k < ncomp; k++) {
+      passed = passed && task_passed[k];
+      std::cout << task_output[k];
     }
 
     if (!passed) {
@@ -248,56 +487,67 @@ bool Run(A2DTest<A2D_complex_t<T>, Output, Inputs...>& test,
 
     if (test_type == TestType::SECOND_ORDER ||
         test_type == TestType::SECOND_ORDER_INTEGRATION) {
-      for (int k = 0; k < p.get_num_components(); k++) {
+      ParallelFor(ncomp, num_threads, [&](int k) {
+        VarTuple<A2D_complex_t<T>, Inputs...> p, g, x1, h;
         p.zero();
-        p[k] = 1.0;
+        p[k] = T(1.0);
 
         test.hprod(seed, hvalue, x, p, h);
 
         // Set x1 = x + dh * p1
-        double dh = test.get_step_size();
+        T dh = test.get_step_size();
         for (index_t i = 0; i < x.get_num_components(); i++) {
-          x1[i] = A2D_complex_t<double>(RealPart(x[i]), RealPart(dh * p[i]));
+          x1[i] = A2D_complex_t<T>(RealPart(x[i]), dh * RealPart(p[i]));
         }
 
         // Set the seed and include the second-derivative parts
         VarTuple<A2D_complex_t<T>, Output> seedh;
         for (index_t i = 0; i < seed.get_num_components(); i++) {
           seedh[i] =
-              seed[i] + A2D_complex_t<double>(0.0, RealPart(dh * hvalue[i]));
+              seed[i] + A2D_complex_t<T>(0.0, dh * RealPart(hvalue[i]));
         }
         test.deriv(seedh, x1, g);
 
+        bool result = true;
+        std::stringstream out;
         for (index_t i = 0; i < x.get_num_components(); i++) {
           T ans = RealPart(h[i]);
           T fd = ImagPart(g[i]) / dh;
 
-          passed = passed && test.is_close(ans, fd);
+          result = result && test.is_close(ans, fd);
 
           if (write_output) {
             std::stringstream s;
             s << " second-order [" << i << "]";
             std::string str = test.name() + s.str();
-            test.write_result(str, std::cout, ans, fd);
+            test.write_result(str, out, ans, fd);
           }
         }
         if (write_output) {
-          std::cout << " " << std::endl;
+          out << " " << std::endl;
         }
+
+        task_passed[k] = result;
+        task_output[k] = out.str();
+      });
+
+      for (int k = 0; k < ncomp; k++) {
+        passed = passed && task_passed[k];
+        std::cout << task_output[k];
       }
     }
   } else {
     // Set a random direction for the test
-    p.set_rand();
+    p.set_rand(test.get_rng("direction"));
 
     // Evaluate the function and its derivatives
     test.deriv(seed, x, g);
     test.hprod(seed, hvalue, x, p, h);
 
     // Set x1 = x + dh * p1
-    double dh = test.get_step_size();
+    T dh = test.get_step_size();
     for (index_t i = 0; i < x.get_num_components(); i++) {
-      x1[i] = A2D_complex_t<double>(RealPart(x[i]), RealPart(dh * p[i]));
+      x1[i] = A2D_complex_t<T>(RealPart(x[i]), dh * RealPart(p[i]));
     }
 
     // Compute the complex-step result: fd = p^{T} * df/dx
@@ -325,7 +575,7 @@ bool Run(A2DTest<A2D_complex_t<T>, Output, Inputs...>& test,
       // Set the seed and include the second-derivative parts
       for (index_t i = 0; i < seed.get_num_components(); i++) {
         seed[i] =
-            seed[i] + A2D_complex_t<double>(0.0, RealPart(dh * hvalue[i]));
+            seed[i] + A2D_complex_t<T>(0.0, dh * RealPart(hvalue[i]));
       }
       test.deriv(seed, x1, g);
 
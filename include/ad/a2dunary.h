@@ -5,6 +5,37 @@
 
 namespace A2D {
 
+/*
+  The softplus function log(1 + exp(a)), a smooth approximation of max(a, 0)
+  that is evaluated without overflow for large arguments
+*/
+template <typename T, std::enable_if_t<is_scalar_type<T>::value, bool> = true>
+A2D_FUNCTION T softplus(const T a) {
+  if (RealPart(a) > 0.0) {
+    return a + log1p(exp(-a));
+  }
+  return log1p(exp(a));
+}
+
+/*
+  The softplus function and its derivative, the sigmoid 1 / (1 + exp(-a)),
+  from the single exponential e = exp(-|a|)
+
+  softplus(a) = max(a, 0) + log1p(e)
+  sigmoid(a) = 1 / (1 + e)  (a > 0)  or  e / (1 + e)  (a <= 0)
+*/
+template <typename T, std::enable_if_t<is_scalar_type<T>::value, bool> = true>
+A2D_FUNCTION T softplus(const T a, T& sigmoid) {
+  if (RealPart(a) > 0.0) {
+    const T e = exp(-a);
+    sigmoid = T(1.0) / (T(1.0) + e);
+    return a + log1p(e);
+  }
+  const T e = exp(a);
+  sigmoid = e / (T(1.0) + e);
+  return log1p(e);
+}
+
 /*
   Definitions for memory-less forward and reverse-mode first-order AD
 
@@ -191,12 +222,20 @@ A2D_2ND_UNARY_BASIC(UnaryNeg2, operator-, -a.value(), -T(1.0))
 // A2D_1ST_UNARY(OBJNAME, OPERNAME, FUNCBODY, TEMPBODY, DERIVBODY)
 A2D_1ST_UNARY(SinExpr, sin, sin(a.value()), cos(a.value()), tmp)
 A2D_1ST_UNARY(CosExpr, cos, cos(a.value()), sin(a.value()), -tmp)
-A2D_1ST_UNARY(SqrtExpr, sqrt, sqrt(a.value()), 1.0 / val, 0.5 * tmp)
-A2D_1ST_UNARY(LogExpr, log, log(a.value()), 1.0 / a.value(), tmp)
+A2D_1ST_UNARY(SqrtExpr, sqrt, sqrt(a.value()), T(1.0) / val, T(0.5) * tmp)
+A2D_1ST_UNARY(LogExpr, log, log(a.value()), T(1.0) / a.value(), tmp)
 A2D_1ST_UNARY(ACosExpr, acos, acos(a.value()),
-              -1.0 / sqrt(1.0 - a.value() * a.value()), tmp)
+              -T(1.0) / sqrt(T(1.0) - a.value() * a.value()), tmp)
 A2D_1ST_UNARY(ASinExpr, asin, asin(a.value()),
-              1.0 / sqrt(1.0 - a.value() * a.value()), tmp)
+              T(1.0) / sqrt(T(1.0) - a.value() * a.value()), tmp)
+A2D_1ST_UNARY(TanhExpr, tanh, tanh(a.value()), T(1.0) - val * val, tmp)
+A2D_1ST_UNARY(ErfExpr, erf, erf(a.value()),
+              T(1.1283791670955126) * exp(-a.value() * a.value()), tmp)
+A2D_1ST_UNARY(Log1pExpr, log1p, log1p(a.value()),
+              T(1.0) / (T(1.0) + a.value()), tmp)
+A2D_1ST_UNARY(Expm1Expr, expm1, expm1(a.value()), val + T(1.0), tmp)
+// The sigmoid is stored in tmp when the value is computed
+A2D_1ST_UNARY(SoftplusExpr, softplus, softplus(a.value(), tmp), tmp, tmp)
 
 /*
   Definitions for forward and reverse-mode first-order AD with temporary
@@ -272,15 +311,25 @@ A2D_1ST_UNARY(ASinExpr, asin, asin(a.value()),
 A2D_2ND_UNARY(ExpExpr2, exp, exp(a.value()), val, tmp, tmp)
 A2D_2ND_UNARY(SinExpr2, sin, sin(a.value()), cos(a.value()), tmp, -val)
 A2D_2ND_UNARY(CosExpr2, cos, cos(a.value()), sin(a.value()), -tmp, -val)
-A2D_2ND_UNARY(SqrtExpr2, sqrt, sqrt(a.value()), 1.0 / val, 0.5 * tmp,
-              -0.25 * tmp * tmp * tmp)
-A2D_2ND_UNARY(LogExpr2, log, log(a.value()), 1.0 / a.value(), tmp, -tmp *tmp)
+A2D_2ND_UNARY(SqrtExpr2, sqrt, sqrt(a.value()), T(1.0) / val, T(0.5) * tmp,
+              -T(0.25) * tmp * tmp * tmp)
+A2D_2ND_UNARY(LogExpr2, log, log(a.value()), T(1.0) / a.value(), tmp, -tmp *tmp)
 A2D_2ND_UNARY(ACosExpr2, acos, acos(a.value()),
-              -1.0 / sqrt(1.0 - a.value() * a.value()), tmp,
-              -a.value() / pow(1.0 - a.value() * a.value(), 1.5))
+              -T(1.0) / sqrt(T(1.0) - a.value() * a.value()), tmp,
+              -a.value() / pow(T(1.0) - a.value() * a.value(), T(1.5)))
 A2D_2ND_UNARY(ASinExpr2, asin, asin(a.value()),
-              1.0 / sqrt(1.0 - a.value() * a.value()), tmp,
-              a.value() / pow(1.0 - a.value() * a.value(), 1.5))
+              T(1.0) / sqrt(T(1.0) - a.value() * a.value()), tmp,
+              a.value() / pow(T(1.0) - a.value() * a.value(), T(1.5)))
+A2D_2ND_UNARY(TanhExpr2, tanh, tanh(a.value()), T(1.0) - val * val, tmp,
+              -T(2.0) * val * tmp)
+A2D_2ND_UNARY(ErfExpr2, erf, erf(a.value()),
+              T(1.1283791670955126) * exp(-a.value() * a.value()), tmp,
+              -T(2.0) * a.value() * tmp)
+A2D_2ND_UNARY(Log1pExpr2, log1p, log1p(a.value()),
+              T(1.0) / (T(1.0) + a.value()), tmp, -tmp * tmp)
+A2D_2ND_UNARY(Expm1Expr2, expm1, expm1(a.value()), val + T(1.0), tmp, tmp)
+A2D_2ND_UNARY(SoftplusExpr2, softplus, softplus(a.value(), tmp), tmp, tmp,
+              tmp * (T(1.0) - tmp))
 
 }  // namespace A2D
 
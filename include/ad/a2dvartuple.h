@@ -176,6 +176,23 @@ class VarTupleBase {
       set_rand_<index + 1, TupleObj, Remain...>(var, low, high);
     }
   }
+
+  template <index_t index, class TupleObj, class First, class... Remain>
+  A2D_FUNCTION void set_rand_(TupleObj& var, const A2DRandom& rng,
+                              index_t offset, const T low, const T high) {
+    if constexpr (__is_scalar_type<First>::value) {
+      a2d_get<index>(var) = low + (high - low) * T(rng.uniform(offset));
+      offset++;
+    } else if constexpr (First::ncomp > 0) {
+      First& val = a2d_get<index>(var);
+      for (index_t i = 0; i < First::ncomp; i++, offset++) {
+        val[i] = low + (high - low) * T(rng.uniform(offset));
+      }
+    }
+    if constexpr (sizeof...(Remain) > 0) {
+      set_rand_<index + 1, TupleObj, Remain...>(var, rng, offset, low, high);
+    }
+  }
 };
 
 template <typename T, class... Vars>
@@ -218,6 +235,16 @@ class VarTuple : public VarTupleBase<T, Vars...> {
     }
   }
 
+  /// @brief Set random values on an interval where component i is the value
+  /// drawn from the counter-based generator for the counter i
+  A2D_FUNCTION void set_rand(const A2DRandom& rng, T low = T(-1.0),
+                             T high = T(1.0)) {
+    if constexpr (sizeof...(Vars) > 0) {
+      this->template set_rand_<0, VarTupleObj, Vars...>(var, rng, 0, low,
+                                                        high);
+    }
+  }
+
   /// @brief Set values into the tuple from a list of objects
   A2D_FUNCTION void set_values(const Vars&... s) {
     if constexpr (sizeof...(Vars) > 0) {
@@ -278,6 +305,16 @@ class TieTuple : public VarTupleBase<T, Vars...> {
     }
   }
 
+  /// @brief Set random values on an interval where component i is the value
+  /// drawn from the counter-based generator for the counter i
+  A2D_FUNCTION void set_rand(const A2DRandom& rng, T low = T(-1.0),
+                             T high = T(1.0)) {
+    if constexpr (sizeof...(Vars) > 0) {
+      this->template set_rand_<0, VarTupleObj, Vars...>(var, rng, 0, low,
+                                                        high);
+    }
+  }
+
   /// @brief Set values into the tuple from a list of objects
   A2D_FUNCTION void set_values(const Vars&... s) {
     if constexpr (sizeof...(Vars) > 0) {
@@ -0,0 +1,348 @@
+#ifndef A2D_VEC_AGGREGATE_H
+#define A2D_VEC_AGGREGATE_H
+
+#include "../a2ddefs.h"
+#include "a2dobj.h"
+#include "a2dstack.h"
+#include "a2dtest.h"
+#include "a2dvec.h"
+#include "core/a2dvecaggregatecore.h"
+#include "core/a2dveccore.h"
+
+namespace A2D {
+
+/*
+  Compute the KS aggregate of the entries of x
+
+  ks = max_i x_i + log(sum_i exp(rho * (x_i - max_i x_i))) / rho
+
+  The aggregate is computed in a single pass with a shifted log-sum-exp. The
+  weights w_i = exp(rho * (x_i - ks)) are recomputed from the output in the
+  derivative sweeps, so no per-entry data is stored.
+*/
+template <typename T, int N, typename R,
+          std::enable_if_t<is_scalar_type<R>::value, bool> = true>
+A2D_FUNCTION void VecKSAggregate(const R rho, const Vec<T, N>& x, T& ks) {
+  ks = VecKSCore<T, N>(T(rho), get_data(x));
+}
+
+template <class xtype, class dtype>
+class VecKSAggregateExpr {
+ public:
+  // Extract the numeric type to use
+  typedef typename get_object_numeric_type<dtype>::type T;
+
+  // Extract the dimensions of the underlying vectors
+  static constexpr int N = get_vec_size<xtype>::size;
+
+  // Get the differentiation order from the output
+  static constexpr ADorder order = get_diff_order<dtype>::order;
+
+  A2D_FUNCTION VecKSAggregateExpr(const T rho, xtype& x, dtype& ks)
+      : rho(rho), x(x), ks(ks) {}
+
+  A2D_FUNCTION void eval() {
+    get_data(ks) = VecKSCore<T, N>(rho, get_data(x));
+  }
+
+  A2D_FUNCTION void bzero() { ks.bzero(); }
+
+  template <ADorder forder>
+  A2D_FUNCTION void forward() {
+    constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
+                                              ADseed::b, ADseed::p>::value;
+    T w[N];
+    VecKSWeightsCore<T, N>(rho, get_data(ks), get_data(x), w);
+    GetSeed<seed>::get_data(ks) =
+        VecDotCore<T, N>(w, GetSeed<seed>::get_data(x));
+  }
+
+  A2D_FUNCTION void reverse() {
+    constexpr ADseed seed = ADseed::b;
+    T w[N];
+    VecKSWeightsCore<T, N>(rho, get_data(ks), get_data(x), w);
+    VecAddCore<T, N>(GetSeed<seed>::get_data(ks), w,
+                     GetSeed<seed>::get_data(x));
+  }
+
+  A2D_FUNCTION void hzero() { ks.hzero(); }
+
+  A2D_FUNCTION void hreverse() {
+    static_assert(order == ADorder::SECOND,
+                  "hreverse() can be called for only second order objects.");
+    VecKSHReverseCore<T, N>(
+        rho, get_data(ks), get_data(x), GetSeed<ADseed::p>::get_data(x),
+        GetSeed<ADseed::b>::get_data(ks), GetSeed<ADseed::h>::get_data(ks),
+        GetSeed<ADseed::h>::get_data(x));
+  }
+
+  // Operation counts for the compile-time cost model
+  static constexpr ADCost cost() {
+    ADCost c("VecKSAggregate");
+    c.eval = KernelCost<T>(4 * N + 2, N, 1);
+    c.forward = KernelCost<T>(5 * N, 2 * N + 1, 1);
+    c.reverse = KernelCost<T>(5 * N, 3 * N + 2, N);
+    c.hforward = c.forward;
+    c.hreverse = KernelCost<T>(10 * N, 4 * N + 3, N);
+    return c;
+  }
+
+ private:
+  const T rho;
+  xtype& x;
+  dtype& ks;
+};
+
+template <class xtype, class dtype, typename R,
+          std::enable_if_t<is_scalar_type<R>::value, bool> = true>
+A2D_FUNCTION auto VecKSAggregate(const R rho, ADObj<xtype>& x,
+                                 ADObj<dtype>& ks) {
+  using T = typename get_object_numeric_type<dtype>::type;
+  return VecKSAggregateExpr<ADObj<xtype>, ADObj<dtype>>(T(rho), x, ks);
+}
+
+template <class xtype, class dtype, typename R,
+          std::enable_if_t<is_scalar_type<R>::value, bool> = true>
+A2D_FUNCTION auto VecKSAggregate(const R rho, A2DObj<xtype>& x,
+                                 A2DObj<dtype>& ks) {
+  using T = typename get_object_numeric_type<dtype>::type;
+  return VecKSAggregateExpr<A2DObj<xtype>, A2DObj<dtype>>(T(rho), x, ks);
+}
+
+/*
+  Compute the p-norm aggregate of the entries of x
+
+  alpha = (sum_i |x_i|^p)^(1/p)
+
+  The sum is scaled by max_i |x_i| so that large values of p do not overflow.
+*/
+template <typename T, int N, typename R,
+          std::enable_if_t<is_scalar_type<R>::value, bool> = true>
+A2D_FUNCTION void VecPNormAggregate(const R p, const Vec<T, N>& x, T& alpha) {
+  alpha = VecPNormCore<T, N>(T(p), get_data(x));
+}
+
+template <class xtype, class dtype>
+class VecPNormAggregateExpr {
+ public:
+  // Extract the numeric type to use
+  typedef typename get_object_numeric_type<dtype>::type T;
+
+  // Extract the dimensions of the underlying vectors
+  static constexpr int N = get_vec_size<xtype>::size;
+
+  // Get the differentiation order from the output
+  static constexpr ADorder order = get_diff_order<dtype>::order;
+
+  A2D_FUNCTION VecPNormAggregateExpr(const T p, xtype& x, dtype& alpha)
+      : p(p), x(x), alpha(alpha) {}
+
+  A2D_FUNCTION void eval() {
+    get_data(alpha) = VecPNormCore<T, N>(p, get_data(x));
+  }
+
+  A2D_FUNCTION void bzero() { alpha.bzero(); }
+
+  template <ADorder forder>
+  A2D_FUNCTION void forward() {
+    constexpr ADseed seed = conditional_value<ADseed, forder == ADorder::FIRST,
+                                              ADseed::b, ADseed::p>::value;
+    T g[N];
+    VecPNormWeightsCore<T, N>(p, get_data(alpha), get_data(x), g);
+    GetSeed<seed>::get_data(alpha) =
+        VecDotCore<T, N>(g, GetSeed<seed>::get_data(x));
+  }
+
+  A2D_FUNCTION void reverse() {
+    constexpr ADseed seed = ADseed::b;
+    T g[N];
+    VecPNormWeightsCore<T, N>(p, get_data(alpha), get_data(x), g);
+    VecAddCore<T, N>(GetSeed<seed>::get_data(alpha), g,
+                     GetSeed<seed>::get_data(x));
+  }
+
+  A2D_FUNCTION void hzero() { alpha.hzero(); }
+
+  A2D_FUNCTION void hreverse() {
+    static_assert(order == ADorder::SECOND,
+                  "hreverse() can be called for only second order objects.");
+    VecPNormHReverseCore<T, N>(
+        p, get_data(alpha), get_data(x), GetSeed<ADseed::p>::get_data(x),
+        GetSeed<ADseed::b>::get_data(alpha),
+        GetSeed<ADseed::h>::get_data(alpha), GetSeed<ADseed::h>::get_data(x));
+  }
+
+  // Operation counts for the compile-time cost model
+  static constexpr ADCost cost() {
+    ADCost c("VecPNormAggregate");
+    c.eval = KernelCost<T>(4 * N + 2, N, 1);
+    c.forward = KernelCost<T>(6 * N, 2 * N + 1, 1);
+    c.reverse = KernelCost<T>(6 * N, 3 * N + 2, N);
+    c.hforward = c.forward;
+    c.hreverse = KernelCost<T>(13 * N, 4 * N + 3, N);
+    return c;
+  }
+
+ private:
+  const T p;
+  xtype& x;
+  dtype& alpha;
+};
+
+template <class xtype, class dtype, typename R,
+          std::enable_if_t<is_scalar_type<R>::value, bool> = true>
+A2D_FUNCTION auto VecPNormAggregate(const R p, ADObj<xtype>& x,
+                                    ADObj<dtype>& alpha) {
+  using T = typename get_object_numeric_type<dtype>::type;
+  return VecPNormAggregateExpr<ADObj<xtype>, ADObj<dtype>>(T(p), x, alpha);
+}
+
+template <class xtype, class dtype, typename R,
+          std::enable_if_t<is_scalar_type<R>::value, bool> = true>
+A2D_FUNCTION auto VecPNormAggregate(const R p, A2DObj<xtype>& x,
+                                    A2DObj<dtype>& alpha) {
+  using T = typename get_object_numeric_type<dtype>::type;
+  return VecPNormAggregateExpr<A2DObj<xtype>, A2DObj<dtype>>(T(p), x, alpha);
+}
+
+namespace Test {
+
+template <typename T, int N>
+class VecKSAggregateTest : public A2DTest<T, T, Vec<T, N>> {
+ public:
+  using Input = VarTuple<T, Vec<T, N>>;
+  using Output = VarTuple<T, T>;
+
+  VecKSAggregateTest(double rho) : rho(rho) {}
+
+  // Assemble a string to describe the test
+  std::string name() {
+    std::stringstream s;
+    s << "VecKSAggregate<" << N << "> rho=" << rho;
+    return s.str();
+  }
+
+  // Operation counts of the stack used in deriv and hprod
+  ADCost cost() {
+    return VecKSAggregateExpr<A2DObj<Vec<T, N>>, A2DObj<T>>::cost();
+  }
+
+  // Evaluate the aggregate
+  Output eval(const Input& X) {
+    T ks;
+    Vec<T, N> x;
+    X.get_values(x);
+    VecKSAggregate(rho, x, ks);
+    return MakeVarTuple<T>(ks);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& X, Input& g) {
+    ADObj<T> ks;
+    ADObj<Vec<T, N>> x;
+    X.get_values(x.value());
+    auto stack = MakeStack(VecKSAggregate(rho, x, ks));
+    seed.get_values(ks.bvalue());
+    stack.reverse();
+    g.set_values(x.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& X,
+             const Input& p, Input& h) {
+    A2DObj<T> ks;
+    A2DObj<Vec<T, N>> x;
+    X.get_values(x.value());
+    p.get_values(x.pvalue());
+    auto stack = MakeStack(VecKSAggregate(rho, x, ks));
+    seed.get_values(ks.bvalue());
+    hval.get_values(ks.hvalue());
+    stack.hproduct();
+    h.set_values(x.hvalue());
+  }
+
+ private:
+  double rho;
+};
+
+template <typename T, int N>
+class VecPNormAggregateTest : public A2DTest<T, T, Vec<T, N>> {
+ public:
+  using Input = VarTuple<T, Vec<T, N>>;
+  using Output = VarTuple<T, T>;
+
+  VecPNormAggregateTest(double p) : p(p) {}
+
+  // Assemble a string to describe the test
+  std::string name() {
+    std::stringstream s;
+    s << "VecPNormAggregate<" << N << "> p=" << p;
+    return s.str();
+  }
+
+  // Operation counts of the stack used in deriv and hprod
+  ADCost cost() {
+    return VecPNormAggregateExpr<A2DObj<Vec<T, N>>, A2DObj<T>>::cost();
+  }
+
+  // Evaluate the aggregate
+  Output eval(const Input& X) {
+    T alpha;
+    Vec<T, N> x;
+    X.get_values(x);
+    VecPNormAggregate(p, x, alpha);
+    return MakeVarTuple<T>(alpha);
+  }
+
+  // Compute the derivative
+  void deriv(const Output& seed, const Input& X, Input& g) {
+    ADObj<T> alpha;
+    ADObj<Vec<T, N>> x;
+    X.get_values(x.value());
+    auto stack = MakeStack(VecPNormAggregate(p, x, alpha));
+    seed.get_values(alpha.bvalue());
+    stack.reverse();
+    g.set_values(x.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output& seed, const Output& hval, const Input& X,
+             const Input& pt, Input& h) {
+    A2DObj<T> alpha;
+    A2DObj<Vec<T, N>> x;
+    X.get_values(x.value());
+    pt.get_values(x.pvalue());
+    auto stack = MakeStack(VecPNormAggregate(p, x, alpha));
+    seed.get_values(alpha.bvalue());
+    hval.get_values(alpha.hvalue());
+    stack.hproduct();
+    h.set_values(x.hvalue());
+  }
+
+ private:
+  double p;
+};
+
+inline bool VecAggregateTestAll(bool component = false,
+                                bool write_output = true) {
+  using Tc = A2D_complex_t<double>;
+
+  bool passed = true;
+  VecKSAggregateTest<Tc, 3> test1(10.0);
+  passed = passed && Run(test1, component, write_output);
+  VecKSAggregateTest<Tc, 50> test2(50.0);
+  passed = passed && Run(test2, component, write_output);
+
+  VecPNormAggregateTest<Tc, 3> test3(2.0);
+  passed = passed && Run(test3, component, write_output);
+  VecPNormAggregateTest<Tc, 50> test4(8.0);
+  passed = passed && Run(test4, component, write_output);
+
+  return passed;
+}
+
+}  // namespace Test
+
+}  // namespace A2D
+
+#endif  // A2D_VEC_AGGREGATE_H
@@ -30,7 +30,7 @@ class VecNormExpr {
 
   A2D_FUNCTION void eval() {
     get_data(alpha) = sqrt(VecDotCore<T, N>(get_data(x), get_data(x)));
-    inv = 1.0 / get_data(alpha);
+    inv = T(1.0) / get_data(alpha);
   }
   A2D_FUNCTION void bzero() { alpha.bzero(); }
 
@@ -62,6 +62,17 @@ class VecNormExpr {
     VecAddCore<T, N>(scale, get_data(x), GetSeed<ADseed::h>::get_data(x));
   }
 
+  // Operation counts for the compile-time cost model
+  static constexpr ADCost cost() {
+    ADCost c("VecNorm");
+    c.eval = KernelCost<T>(2 * N + 2, N, 1);
+    c.forward = KernelCost<T>(2 * N + 1, 2 * N, 1);
+    c.reverse = KernelCost<T>(2 * N + 1, 2 * N + 1, N);
+    c.hforward = c.forward;
+    c.hreverse = KernelCost<T>(8 * N + 5, 8 * N + 2, 3 * N);
+    return c;
+  }
+
   vtype &x;
   dtype &alpha;
   T inv;
@@ -80,7 +91,7 @@ A2D_FUNCTION auto VecNorm(A2DObj<vtype> &x, A2DObj<dtype> &alpha) {
 template <typename T, int N>
 A2D_FUNCTION void VecNormalize(const Vec<T, N> &x, Vec<T, N> &y) {
   T alpha = sqrt(VecDotCore<T, N>(get_data(x), get_data(x)));
-  VecScaleCore<T, N>(1.0 / alpha, get_data(x), get_data(y));
+  VecScaleCore<T, N>(T(1.0) / alpha, get_data(x), get_data(y));
 }
 
 template <class xtype, class ytype>
@@ -107,7 +118,7 @@ class VecNormalizeExpr {
 
   A2D_FUNCTION void eval() {
     T alpha = sqrt(VecDotCore<T, N>(get_data(x), get_data(x)));
-    inv = 1.0 / alpha;
+    inv = T(1.0) / alpha;
     VecScaleCore<T, N>(inv, get_data(x), get_data(y));
   }
 
@@ -153,7 +164,7 @@ class VecNormalizeExpr {
     VecAddCore<T, N>(-inv2 * tmp2, GetSeed<ADseed::b>::get_data(y),
                      GetSeed<ADseed::h>::get_data(x));
 
-    T scale = inv2 * (3.0 * tmp1 * tmp2 - tmp3 - tmp4);
+    T scale = inv2 * (T(3.0) * tmp1 * tmp2 - tmp3 - tmp4);
     VecAddCore<T, N>(scale, get_data(y), GetSeed<ADseed::h>::get_data(x));
   }
 
@@ -377,6 +388,20 @@ class VecDotExpr {
     }
   }
 
+  // Operation counts for the compile-time cost model
+  static constexpr ADCost cost() {
+    constexpr index_t actx = (adx == ADiffType::ACTIVE);
+    constexpr index_t acty = (ady == ADiffType::ACTIVE);
+
+    ADCost c("VecDot");
+    c.eval = KernelCost<T>(2 * N, 2 * N, 1);
+    c.forward = (actx + acty) * KernelCost<T>(2 * N, 2 * N, 1);
+    c.reverse = (actx + acty) * KernelCost<T>(2 * N, 2 * N + 1, N);
+    c.hforward = c.forward;
+    c.hreverse = (1 + actx * acty) * c.reverse;
+    return c;
+  }
+
   xtype &x;
   ytype &y;
   dtype &alpha;
@@ -436,6 +461,11 @@ class VecNormTest : public A2DTest<T, T, Vec<T, N>> {
     return MakeVarTuple<T>(alpha);
   }
 
+  // Operation counts of the stack used in deriv and hprod
+  ADCost cost() {
+    return VecNormExpr<A2DObj<Vec<T, N>>, A2DObj<T>>::cost();
+  }
+
   // Compute the derivative
   void deriv(const Output &seed, const Input &X, Input &g) {
     ADObj<T> alpha;
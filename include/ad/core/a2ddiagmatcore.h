@@ -0,0 +1,114 @@
+#ifndef A2D_DIAGMAT_CORE_H
+#define A2D_DIAGMAT_CORE_H
+
+#include "../../a2ddefs.h"
+
+namespace A2D {
+
+/*
+  Compute C = D * B where D is diagonal and B, C are N x M matrices. This
+  scales the rows of B and takes N * M operations.
+*/
+template <typename T, int N, int M, bool additive = false>
+A2D_FUNCTION void DiagMatMatMultCore(const T d[], const T B[], T C[]) {
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < M; j++, B++, C++) {
+      if constexpr (additive) {
+        C[0] += d[i] * B[0];
+      } else {
+        C[0] = d[i] * B[0];
+      }
+    }
+  }
+}
+
+/*
+  Compute C = A * D where D is diagonal and A, C are M x N matrices. This
+  scales the columns of A.
+*/
+template <typename T, int M, int N, bool additive = false>
+A2D_FUNCTION void MatDiagMatMultCore(const T A[], const T d[], T C[]) {
+  for (int i = 0; i < M; i++) {
+    for (int j = 0; j < N; j++, A++, C++) {
+      if constexpr (additive) {
+        C[0] += A[0] * d[j];
+      } else {
+        C[0] = A[0] * d[j];
+      }
+    }
+  }
+}
+
+/*
+  Compute d[i] += sum_{j} A[i, j] * B[i, j] for the N x M matrices A and B.
+  This is the derivative of DiagMatMatMultCore with respect to d.
+*/
+template <typename T, int N, int M>
+A2D_FUNCTION void DiagMatRowDotCore(const T A[], const T B[], T d[]) {
+  using R = typename accumulate_type<T>::type;
+
+  for (int i = 0; i < N; i++) {
+    R value = R(0.0);
+    for (int j = 0; j < M; j++, A++, B++) {
+      value += R(A[0]) * R(B[0]);
+    }
+    d[i] += T(value);
+  }
+}
+
+/*
+  Compute d[j] += sum_{i} A[i, j] * B[i, j] for the M x N matrices A and B.
+  This is the derivative of MatDiagMatMultCore with respect to d.
+*/
+template <typename T, int M, int N>
+A2D_FUNCTION void DiagMatColDotCore(const T A[], const T B[], T d[]) {
+  using R = typename accumulate_type<T>::type;
+
+  if constexpr (std::is_same<R, T>::value) {
+    for (int i = 0; i < M; i++) {
+      for (int j = 0; j < N; j++, A++, B++) {
+        d[j] += A[0] * B[0];
+      }
+    }
+  } else {
+    // Accumulate the columns in the wider type and round once on store
+    R values[N];
+    for (int j = 0; j < N; j++) {
+      values[j] = R(0.0);
+    }
+
+    for (int i = 0; i < M; i++) {
+      for (int j = 0; j < N; j++, A++, B++) {
+        values[j] += R(A[0]) * R(B[0]);
+      }
+    }
+
+    for (int j = 0; j < N; j++) {
+      d[j] += T(values[j]);
+    }
+  }
+}
+
+/*
+  Add the diagonal matrix to the N x N matrix A, A += D
+*/
+template <typename T, int N>
+A2D_FUNCTION void MatAddDiagMatCore(const T d[], T A[]) {
+  for (int i = 0; i < N; i++, A += N + 1) {
+    A[0] += d[i];
+  }
+}
+
+/*
+  Extract the diagonal of the N x N matrix A and add it to d, d += diag(A)
+*/
+template <typename T, int N>
+A2D_FUNCTION void DiagMatAddDiagCore(const T A[], T d[]) {
+  for (int i = 0; i < N; i++, A += N + 1) {
+    d[i] += A[0];
+  }
+}
+
+}  // namespace A2D
+
+#endif  // A2D_DIAGMAT_CORE_H
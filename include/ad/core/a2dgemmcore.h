@@ -4,6 +4,7 @@
 #include <stdexcept>
 
 #include "../../a2ddefs.h"
+#include "../../a2ddispatch.h"
 
 namespace A2D {
 
@@ -229,89 +230,81 @@ template <typename T, int Anrows, int Ancols, int Bnrows, int Bncols,
           int Cnrows, int Cncols, MatOp opA = MatOp::NORMAL,
           MatOp opB = MatOp::NORMAL, bool additive = false>
 A2D_FUNCTION void MatMatMultCoreGeneral(const T A[], const T B[], T C[]) {
+  using R = typename accumulate_type<T>::type;
+
   // Op(A) is M-by-P, Op(B) is P-by-N, C is M-by-N
   constexpr int M = Cnrows;
   constexpr int N = Cncols;
-  // constexpr int P =
-  //    int_conditional<opA == MatOp::NORMAL, Ancols, Anrows>::value;
-
-  if constexpr (opA == MatOp::NORMAL) {
-    if (opB == MatOp::NORMAL) {
-      for (int i = 0; i < M; i++) {
-        for (int j = 0; j < N; j++, C++) {
-          const T *a = &A[Ancols * i];
-          const T *aend = a + Ancols;
-          const T *b = &B[j];
-
-          T value = T(0.0);
-          for (; a < aend; a++, b += Bncols) {
-            value += a[0] * b[0];
-          }
+  constexpr int P = (opA == MatOp::NORMAL ? Ancols : Anrows);
+
+  // The loops are ordered so that the innermost loop runs over contiguous
+  // entries of the operands for each combination of op(A) and op(B).
+  if constexpr (opA == MatOp::NORMAL && opB == MatOp::TRANSPOSE) {
+    // C(i, j) is the dot product of row i of A and row j of B
+    for (int i = 0; i < M; i++) {
+      for (int j = 0; j < N; j++, C++) {
+        const T *a = &A[Ancols * i];
+        const T *aend = a + Ancols;
+        const T *b = &B[Bncols * j];
+
+        R value = R(0.0);
+        for (; a < aend; a++, b++) {
+          value += R(a[0]) * R(b[0]);
+        }
 
-          if constexpr (additive) {
-            C[0] += value;
-          } else {
-            C[0] = value;
-          }
+        if constexpr (additive) {
+          C[0] += T(value);
+        } else {
+          C[0] = T(value);
         }
       }
-    } else {  // opB == MatOp::TRANSPOSE
-      for (int i = 0; i < M; i++) {
-        for (int j = 0; j < N; j++, C++) {
-          const T *a = &A[Ancols * i];
-          const T *aend = a + Ancols;
-          const T *b = &B[Bncols * j];
+    }
+  } else if constexpr (opB == MatOp::NORMAL) {
+    // Row i of C is the sum of the rows of B scaled by row i of op(A)
+    for (int i = 0; i < M; i++, C += N) {
+      R values[N];
+      for (int j = 0; j < N; j++) {
+        values[j] = R(0.0);
+      }
 
-          T value = T(0.0);
-          for (; a < aend; a++, b++) {
-            value += a[0] * b[0];
-          }
+      for (int k = 0; k < P; k++) {
+        const R a = R(opA == MatOp::NORMAL ? A[Ancols * i + k]
+                                           : A[Ancols * k + i]);
+        const T *b = &B[Bncols * k];
+        for (int j = 0; j < N; j++) {
+          values[j] += a * R(b[j]);
+        }
+      }
 
-          if constexpr (additive) {
-            C[0] += value;
-          } else {
-            C[0] = value;
-          }
+      for (int j = 0; j < N; j++) {
+        if constexpr (additive) {
+          C[j] += T(values[j]);
+        } else {
+          C[j] = T(values[j]);
         }
       }
     }
-  } else {  // opA == MatOp::TRANSPOSE
-    if (opB == MatOp::NORMAL) {
+  } else {  // opA == MatOp::TRANSPOSE && opB == MatOp::TRANSPOSE
+    // Column j of C is the sum of the rows of A scaled by row j of B
+    for (int j = 0; j < N; j++) {
+      R values[M];
       for (int i = 0; i < M; i++) {
-        for (int j = 0; j < N; j++, C++) {
-          const T *a = &A[i];
-          const T *b = &B[j];
-          const T *bend = b + Bnrows * Bncols;
-
-          T value = T(0.0);
-          for (; b < bend; a += Ancols, b += Bncols) {
-            value += a[0] * b[0];
-          }
+        values[i] = R(0.0);
+      }
 
-          if constexpr (additive) {
-            C[0] += value;
-          } else {
-            C[0] = value;
-          }
+      for (int k = 0; k < P; k++) {
+        const R b = R(B[Bncols * j + k]);
+        const T *a = &A[Ancols * k];
+        for (int i = 0; i < M; i++) {
+          values[i] += b * R(a[i]);
         }
       }
-    } else {  // opB == MatOp::TRANSPOSE
-      for (int i = 0; i < M; i++) {
-        for (int j = 0; j < N; j++, C++) {
-          const T *a = &A[i];
-          const T *b = &B[Bncols * j];
-          const T *bend = b + Bncols;
 
-          T value = T(0.0);
-          for (; b < bend; a += Ancols, b++) {
-            value += a[0] * b[0];
-          }
-
-          if constexpr (additive) {
-            C[0] += value;
-          } else {
-            C[0] = value;
-          }
+      for (int i = 0; i < M; i++) {
+        if constexpr (additive) {
+          C[N * i + j] += T(values[i]);
+        } else {
+          C[N * i + j] = T(values[i]);
         }
       }
     }
@@ -347,6 +340,8 @@ template <typename T, int Anrows, int Ancols, int Bnrows, int Bncols,
           MatOp opB = MatOp::NORMAL, bool additive = false>
 A2D_FUNCTION void MatMatMultScaleCoreGeneral(const T alpha, const T A[],
                                              const T B[], T C[]) {
+  using R = typename accumulate_type<T>::type;
+
   // Op(A) is M-by-P, Op(B) is P-by-N, C is M-by-N
   constexpr int M = Cnrows;
   constexpr int N = Cncols;
@@ -361,15 +356,15 @@ A2D_FUNCTION void MatMatMultScaleCoreGeneral(const T alpha, const T A[],
           const T *aend = a + Ancols;
           const T *b = &B[j];
 
-          T value = T(0.0);
+          R value = R(0.0);
           for (; a < aend; a++, b += Bncols) {
-            value += a[0] * b[0];
+            value += R(a[0]) * R(b[0]);
           }
 
           if constexpr (additive) {
-            C[0] += alpha * value;
+            C[0] += alpha * T(value);
           } else {
-            C[0] = alpha * value;
+            C[0] = alpha * T(value);
           }
         }
       }
@@ -380,15 +375,15 @@ A2D_FUNCTION void MatMatMultScaleCoreGeneral(const T alpha, const T A[],
           const T *aend = a + Ancols;
           const T *b = &B[Bncols * j];
 
-          T value = T(0.0);
+          R value = R(0.0);
           for (; a < aend; a++, b++) {
-            value += a[0] * b[0];
+            value += R(a[0]) * R(b[0]);
           }
 
           if constexpr (additive) {
-            C[0] += alpha * value;
+            C[0] += alpha * T(value);
           } else {
-            C[0] = alpha * value;
+            C[0] = alpha * T(value);
           }
         }
       }
@@ -401,15 +396,15 @@ A2D_FUNCTION void MatMatMultScaleCoreGeneral(const T alpha, const T A[],
           const T *b = &B[j];
           const T *bend = b + Bnrows * Bncols;
 
-          T value = T(0.0);
+          R value = R(0.0);
           for (; b < bend; a += Ancols, b += Bncols) {
-            value += a[0] * b[0];
+            value += R(a[0]) * R(b[0]);
           }
 
           if constexpr (additive) {
-            C[0] += alpha * value;
+            C[0] += alpha * T(value);
           } else {
-            C[0] = alpha * value;
+            C[0] = alpha * T(value);
           }
         }
       }
@@ -420,15 +415,15 @@ A2D_FUNCTION void MatMatMultScaleCoreGeneral(const T alpha, const T A[],
           const T *b = &B[Bncols * j];
           const T *bend = b + Bncols;
 
-          T value = T(0.0);
+          R value = R(0.0);
           for (; b < bend; a += Ancols, b++) {
-            value += a[0] * b[0];
+            value += R(a[0]) * R(b[0]);
           }
 
           if constexpr (additive) {
-            C[0] += alpha * value;
+            C[0] += alpha * T(value);
           } else {
-            C[0] = alpha * value;
+            C[0] = alpha * T(value);
           }
         }
       }
@@ -525,6 +520,70 @@ inline void MatMatMultScaleCore(T alpha, const T A[], const T B[], T C[]) {
   }
 }
 
+/**
+ * @brief mat-mat multiplication C = Op(A) * Op(B) that calls the dispatched
+ * core for square matrices of the sizes where it is faster, see a2ddispatch.h
+ */
+template <typename T, int Anrows, int Ancols, int Bnrows, int Bncols,
+          int Cnrows, int Cncols, MatOp opA, MatOp opB, bool additive = false>
+A2D_FUNCTION void MatMatMultDispatchCore(const T A[], const T B[], T C[]) {
+  constexpr bool square = (Ancols == Anrows && Bnrows == Anrows &&
+                           Bncols == Anrows && Cnrows == Anrows &&
+                           Cncols == Anrows);
+  if constexpr (square && use_dispatch_mat_mat_mult<T, Anrows>::value) {
+    DispatchMatMatMultCore<T, Anrows, opA, opB, additive>(A, B, C);
+  } else {
+    MatMatMultCore<T, Anrows, Ancols, Bnrows, Bncols, Cnrows, Cncols, opA,
+                   opB, additive>(A, B, C);
+  }
+}
+
+/**
+ * @brief mat-mat multiplication C = Op(A) * Op(B) for matrices stored in
+ * either layout
+ *
+ * The dimensions are those of the matrices, not of their storage. A
+ * column-major matrix is stored as the row-major storage of its transpose, so
+ * each operand is passed to MatMatMultCore with its op reversed. When C is
+ * column-major the transposed product C^{T} = Op(B)^{T} * Op(A)^{T} is formed
+ * in its storage instead.
+ *
+ * @tparam layoutA: storage layout of A
+ * @tparam layoutB: storage layout of B
+ * @tparam layoutC: storage layout of C
+ */
+template <typename T, int Anrows, int Ancols, int Bnrows, int Bncols,
+          int Cnrows, int Cncols, MatOp opA, MatOp opB, MatLayout layoutA,
+          MatLayout layoutB, MatLayout layoutC, bool additive = false>
+A2D_FUNCTION void MatMatMultLayoutCore(const T A[], const T B[], T C[]) {
+  constexpr bool rowA = (layoutA == MatLayout::ROW_MAJOR);
+  constexpr bool rowB = (layoutB == MatLayout::ROW_MAJOR);
+
+  // Dimensions of the row-major storage of A and B
+  constexpr int Am = (rowA ? Anrows : Ancols);
+  constexpr int An = (rowA ? Ancols : Anrows);
+  constexpr int Bm = (rowB ? Bnrows : Bncols);
+  constexpr int Bn = (rowB ? Bncols : Bnrows);
+
+  // The ops applied to the storage of A and B
+  constexpr MatOp sopA =
+      (rowA == (opA == MatOp::NORMAL) ? MatOp::NORMAL : MatOp::TRANSPOSE);
+  constexpr MatOp sopB =
+      (rowB == (opB == MatOp::NORMAL) ? MatOp::NORMAL : MatOp::TRANSPOSE);
+
+  if constexpr (layoutC == MatLayout::ROW_MAJOR) {
+    MatMatMultDispatchCore<T, Am, An, Bm, Bn, Cnrows, Cncols, sopA, sopB,
+                           additive>(A, B, C);
+  } else {
+    constexpr MatOp topA =
+        (sopA == MatOp::NORMAL ? MatOp::TRANSPOSE : MatOp::NORMAL);
+    constexpr MatOp topB =
+        (sopB == MatOp::NORMAL ? MatOp::TRANSPOSE : MatOp::NORMAL);
+    MatMatMultDispatchCore<T, Bm, Bn, Am, An, Cncols, Cnrows, topB, topA,
+                           additive>(B, A, C);
+  }
+}
+
 template <typename T>
 A2D_FUNCTION void SMatSMatMultCore2x2(const T SA[], const T SB[], T C[]) {
   C[0] = SA[0] * SB[0] + SA[1] * SB[1];
@@ -615,17 +674,19 @@ A2D_FUNCTION void SMatSMatMultCore3x3ScaleAdd(const T scalar, const T SA[],
 
 template <typename T, int Anrows, bool additive = false>
 A2D_FUNCTION void SMatSMatMultCoreGeneral(const T SA[], const T SB[], T C[]) {
+  using R = typename accumulate_type<T>::type;
+
   for (int i = 0; i < Anrows; i++) {
     for (int k = 0; k < Anrows; k++) {
-      T value = T(0.0);
+      R value = R(0.0);
       for (int j = 0; j < Anrows; j++) {
-        value += SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2] *
-                 SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2];
+        value += R(SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2]) *
+                 R(SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2]);
       }
       if (additive) {
-        C[i * Anrows + k] += value;
+        C[i * Anrows + k] += T(value);
       } else {
-        C[i * Anrows + k] = value;
+        C[i * Anrows + k] = T(value);
       }
     }
   }
@@ -634,17 +695,19 @@ A2D_FUNCTION void SMatSMatMultCoreGeneral(const T SA[], const T SB[], T C[]) {
 template <typename T, int Anrows, bool additive = false>
 A2D_FUNCTION void SMatSMatMultScaleCoreGeneral(const T scalar, const T SA[],
                                                const T SB[], T C[]) {
+  using R = typename accumulate_type<T>::type;
+
   for (int i = 0; i < Anrows; i++) {
     for (int k = 0; k < Anrows; k++) {
-      T value = T(0.0);
+      R value = R(0.0);
       for (int j = 0; j < Anrows; j++) {
-        value += SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2] *
-                 SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2];
+        value += R(SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2]) *
+                 R(SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2]);
       }
       if (additive) {
-        C[i * Anrows + k] += scalar * value;
+        C[i * Anrows + k] += scalar * T(value);
       } else {
-        C[i * Anrows + k] = scalar * value;
+        C[i * Anrows + k] = scalar * T(value);
       }
     }
   }
@@ -866,6 +929,8 @@ A2D_FUNCTION void SMatMatMultCore3x3ScaleAdd(const T scalar, const T S[],
 template <typename T, int Anrows, int Bnrows, int Bncols,
           MatOp opB = MatOp::NORMAL, bool additive = false>
 A2D_FUNCTION void SMatMatMultCoreGeneral(const T SA[], const T B[], T C[]) {
+  using R = typename accumulate_type<T>::type;
+
   int idim = Anrows;
   int jdim = Anrows;
   int kdim = opB == MatOp::NORMAL ? Bncols : Bnrows;
@@ -873,30 +938,30 @@ A2D_FUNCTION void SMatMatMultCoreGeneral(const T SA[], const T B[], T C[]) {
   if constexpr (opB == MatOp::NORMAL) {
     for (int i = 0; i < idim; i++) {
       for (int k = 0; k < kdim; k++) {
-        T value = T(0.0);
+        R value = R(0.0);
         for (int j = 0; j < jdim; j++) {
-          value += SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2] *
-                   B[j * Bncols + k];
+          value += R(SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2]) *
+                   R(B[j * Bncols + k]);
         }
         if (additive) {
-          C[i * Bncols + k] += value;  // C: Anrows-by-Bncols
+          C[i * Bncols + k] += T(value);  // C: Anrows-by-Bncols
         } else {
-          C[i * Bncols + k] = value;  // C: Anrows-by-Bncols
+          C[i * Bncols + k] = T(value);  // C: Anrows-by-Bncols
         }
       }
     }
   } else {
     for (int i = 0; i < idim; i++) {
       for (int k = 0; k < kdim; k++) {
-        T value = T(0.0);
+        R value = R(0.0);
         for (int j = 0; j < jdim; j++) {
-          value += SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2] *
-                   B[k * Bncols + j];
+          value += R(SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2]) *
+                   R(B[k * Bncols + j]);
         }
         if (additive) {
-          C[i * Bnrows + k] += value;  // C: Anrows-by-Bnrows
+          C[i * Bnrows + k] += T(value);  // C: Anrows-by-Bnrows
         } else {
-          C[i * Bnrows + k] = value;  // C: Anrows-by-Bnrows
+          C[i * Bnrows + k] = T(value);  // C: Anrows-by-Bnrows
         }
       }
     }
@@ -907,6 +972,8 @@ template <typename T, int Anrows, int Bnrows, int Bncols,
           MatOp opB = MatOp::NORMAL, bool additive = false>
 A2D_FUNCTION void SMatMatMultScaleCoreGeneral(const T alpha, const T SA[],
                                               const T B[], T C[]) {
+  using R = typename accumulate_type<T>::type;
+
   int idim = Anrows;
   int jdim = Anrows;
   int kdim = opB == MatOp::NORMAL ? Bncols : Bnrows;
@@ -914,30 +981,30 @@ A2D_FUNCTION void SMatMatMultScaleCoreGeneral(const T alpha, const T SA[],
   if constexpr (opB == MatOp::NORMAL) {
     for (int i = 0; i < idim; i++) {
       for (int k = 0; k < kdim; k++) {
-        T value = T(0.0);
+        R value = R(0.0);
         for (int j = 0; j < jdim; j++) {
-          value += SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2] *
-                   B[j * Bncols + k];
+          value += R(SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2]) *
+                   R(B[j * Bncols + k]);
         }
         if (additive) {
-          C[i * Bncols + k] += alpha * value;  // C: Anrows-by-Bncols
+          C[i * Bncols + k] += alpha * T(value);  // C: Anrows-by-Bncols
         } else {
-          C[i * Bncols + k] = alpha * value;  // C: Anrows-by-Bncols
+          C[i * Bncols + k] = alpha * T(value);  // C: Anrows-by-Bncols
         }
       }
     }
   } else {
     for (int i = 0; i < idim; i++) {
       for (int k = 0; k < kdim; k++) {
-        T value = T(0.0);
+        R value = R(0.0);
         for (int j = 0; j < jdim; j++) {
-          value += SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2] *
-                   B[k * Bncols + j];
+          value += R(SA[i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2]) *
+                   R(B[k * Bncols + j]);
         }
         if (additive) {
-          C[i * Bnrows + k] += alpha * value;  // C: Anrows-by-Bnrows
+          C[i * Bnrows + k] += alpha * T(value);  // C: Anrows-by-Bnrows
         } else {
-          C[i * Bnrows + k] = alpha * value;  // C: Anrows-by-Bnrows
+          C[i * Bnrows + k] = alpha * T(value);  // C: Anrows-by-Bnrows
         }
       }
     }
@@ -1172,6 +1239,8 @@ A2D_FUNCTION void MatSMatMultCore3x3ScaleAdd(const T scalar, const T A[],
 template <typename T, int Anrows, int Ancols, int Bncols,
           MatOp opA = MatOp::NORMAL, bool additive = false>
 A2D_FUNCTION void MatSMatMultCoreGeneral(const T A[], const T SB[], T C[]) {
+  using R = typename accumulate_type<T>::type;
+
   int idim = opA == MatOp::NORMAL ? Anrows : Ancols;
   int jdim = opA == MatOp::NORMAL ? Ancols : Anrows;
   int kdim = Bncols;
@@ -1179,30 +1248,30 @@ A2D_FUNCTION void MatSMatMultCoreGeneral(const T A[], const T SB[], T C[]) {
   if constexpr (opA == MatOp::NORMAL) {
     for (int i = 0; i < idim; i++) {
       for (int k = 0; k < kdim; k++) {
-        T value = T(0.0);
+        R value = R(0.0);
         for (int j = 0; j < jdim; j++) {
-          value += A[i * Ancols + j] *
-                   SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2];
+          value += R(A[i * Ancols + j]) *
+                   R(SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2]);
         }
         if (additive) {
-          C[i * Bncols + k] += value;  // C: Anrows-by-Bncols
+          C[i * Bncols + k] += T(value);  // C: Anrows-by-Bncols
         } else {
-          C[i * Bncols + k] = value;  // C: Anrows-by-Bncols
+          C[i * Bncols + k] = T(value);  // C: Anrows-by-Bncols
         }
       }
     }
   } else {
     for (int i = 0; i < idim; i++) {
       for (int k = 0; k < kdim; k++) {
-        T value = T(0.0);
+        R value = R(0.0);
         for (int j = 0; j < jdim; j++) {
-          value += A[j * Ancols + i] *
-                   SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2];
+          value += R(A[j * Ancols + i]) *
+                   R(SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2]);
         }
         if (additive) {
-          C[i * Bncols + k] += value;  // C: Ancols-by-Bncols
+          C[i * Bncols + k] += T(value);  // C: Ancols-by-Bncols
         } else {
-          C[i * Bncols + k] = value;  // C: Ancols-by-Bncols
+          C[i * Bncols + k] = T(value);  // C: Ancols-by-Bncols
         }
       }
     }
@@ -1213,6 +1282,8 @@ template <typename T, int Anrows, int Ancols, int Bncols,
           MatOp opA = MatOp::NORMAL, bool additive = false>
 A2D_FUNCTION void MatSMatMultScaleCoreGeneral(const T alpha, const T A[],
                                               const T SB[], T C[]) {
+  using R = typename accumulate_type<T>::type;
+
   int idim = opA == MatOp::NORMAL ? Anrows : Ancols;
   int jdim = opA == MatOp::NORMAL ? Ancols : Anrows;
   int kdim = Bncols;
@@ -1220,30 +1291,30 @@ A2D_FUNCTION void MatSMatMultScaleCoreGeneral(const T alpha, const T A[],
   if constexpr (opA == MatOp::NORMAL) {
     for (int i = 0; i < idim; i++) {
       for (int k = 0; k < kdim; k++) {
-        T value = T(0.0);
+        R value = R(0.0);
         for (int j = 0; j < jdim; j++) {
-          value += A[i * Ancols + j] *
-                   SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2];
+          value += R(A[i * Ancols + j]) *
+                   R(SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2]);
         }
         if (additive) {
-          C[i * Bncols + k] += alpha * value;  // C: Anrows-by-Bncols
+          C[i * Bncols + k] += alpha * T(value);  // C: Anrows-by-Bncols
         } else {
-          C[i * Bncols + k] = alpha * value;  // C: Anrows-by-Bncols
+          C[i * Bncols + k] = alpha * T(value);  // C: Anrows-by-Bncols
         }
       }
     }
   } else {
     for (int i = 0; i < idim; i++) {
       for (int k = 0; k < kdim; k++) {
-        T value = T(0.0);
+        R value = R(0.0);
         for (int j = 0; j < jdim; j++) {
-          value += A[j * Ancols + i] *
-                   SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2];
+          value += R(A[j * Ancols + i]) *
+                   R(SB[j >= k ? k + j * (j + 1) / 2 : j + k * (k + 1) / 2]);
         }
         if (additive) {
-          C[i * Bncols + k] += alpha * value;  // C: Ancols-by-Bncols
+          C[i * Bncols + k] += alpha * T(value);  // C: Ancols-by-Bncols
         } else {
-          C[i * Bncols + k] = alpha * value;  // C: Ancols-by-Bncols
+          C[i * Bncols + k] = alpha * T(value);  // C: Ancols-by-Bncols
         }
       }
     }
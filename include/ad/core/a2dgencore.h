@@ -0,0 +1,360 @@
+#ifndef A2D_GEN_CORE_H
+#define A2D_GEN_CORE_H
+
+#include "../../a2ddefs.h"
+
+/*
+  This file is generated by python/make_ad_cores.py. Do not edit it by hand.
+
+  Each operation Op has the cores
+
+  GenOpCore(x, y)
+  GenOpForwardCore(x, xd, yd)
+  GenOpReverseCore(x, yb, xb)
+  GenOpHReverseCore(x, xp, yb, yh, xh)
+
+  where every argument is an array, so that a scalar output such as the
+  determinant is an array of length one. The reverse and hreverse cores add
+  to their outputs. The arguments do not follow the hand-written cores, for
+  instance MatDetCore(A) returns the determinant and MatDetReverseCore(bdet,
+  A, Ab) takes the seed first. Subexpressions that are shared by the outputs
+  of a core are computed once.
+*/
+
+namespace A2D {
+
+template <typename T, int N>
+A2D_FUNCTION void GenMatDetCore(const T A[], T det[]) {
+  static_assert(N == 2 || N == 3,
+                "Generated core not available for N");
+
+  if constexpr (N == 2) {
+    det[0] = A[0] * A[3] - A[1] * A[2];
+  } else {  // N == 3
+    det[0] = A[0] * (A[4] * A[8] - A[5] * A[7]) -
+        A[1] * (A[3] * A[8] - A[5] * A[6]) + A[2] * (A[3] * A[7] - A[4] * A[6]);
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void GenMatDetForwardCore(const T A[], const T Ad[], T detd[]) {
+  static_assert(N == 2 || N == 3,
+                "Generated core not available for N");
+
+  if constexpr (N == 2) {
+    detd[0] = A[3] * Ad[0] - A[2] * Ad[1] - A[1] * Ad[2] + A[0] * Ad[3];
+  } else {  // N == 3
+    detd[0] = (A[4] * A[8] - A[5] * A[7]) * Ad[0] -
+        (A[3] * A[8] - A[5] * A[6]) * Ad[1] +
+        (A[3] * A[7] - A[4] * A[6]) * Ad[2] +
+        Ad[3] * (-A[1] * A[8] + A[2] * A[7]) +
+        Ad[4] * (A[0] * A[8] - A[2] * A[6]) +
+        Ad[5] * (-A[0] * A[7] + A[1] * A[6]) +
+        Ad[6] * (A[1] * A[5] - A[2] * A[4]) +
+        Ad[7] * (-A[0] * A[5] + A[2] * A[3]) +
+        Ad[8] * (A[0] * A[4] - A[1] * A[3]);
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void GenMatDetReverseCore(const T A[], const T detb[], T Ab[]) {
+  static_assert(N == 2 || N == 3,
+                "Generated core not available for N");
+
+  if constexpr (N == 2) {
+    Ab[0] += A[3] * detb[0];
+    Ab[1] += -A[2] * detb[0];
+    Ab[2] += -A[1] * detb[0];
+    Ab[3] += A[0] * detb[0];
+  } else {  // N == 3
+    Ab[0] += (A[4] * A[8] - A[5] * A[7]) * detb[0];
+    Ab[1] += -(A[3] * A[8] - A[5] * A[6]) * detb[0];
+    Ab[2] += (A[3] * A[7] - A[4] * A[6]) * detb[0];
+    Ab[3] += (-A[1] * A[8] + A[2] * A[7]) * detb[0];
+    Ab[4] += (A[0] * A[8] - A[2] * A[6]) * detb[0];
+    Ab[5] += (-A[0] * A[7] + A[1] * A[6]) * detb[0];
+    Ab[6] += (A[1] * A[5] - A[2] * A[4]) * detb[0];
+    Ab[7] += (-A[0] * A[5] + A[2] * A[3]) * detb[0];
+    Ab[8] += (A[0] * A[4] - A[1] * A[3]) * detb[0];
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void GenMatDetHReverseCore(const T A[], const T Ap[],
+                                        const T detb[], const T deth[],
+                                        T Ah[]) {
+  static_assert(N == 2 || N == 3,
+                "Generated core not available for N");
+
+  if constexpr (N == 2) {
+    Ah[0] += A[3] * deth[0] + detb[0] * Ap[3];
+    Ah[1] += -A[2] * deth[0] - detb[0] * Ap[2];
+    Ah[2] += -A[1] * deth[0] - detb[0] * Ap[1];
+    Ah[3] += A[0] * deth[0] + detb[0] * Ap[0];
+  } else {  // N == 3
+    Ah[0] += (A[4] * A[8] - A[5] * A[7]) * deth[0] + A[8] * detb[0] * Ap[4] -
+        A[7] * detb[0] * Ap[5] - A[5] * detb[0] * Ap[7] +
+        A[4] * detb[0] * Ap[8];
+    Ah[1] += -(A[3] * A[8] - A[5] * A[6]) * deth[0] - A[8] * detb[0] * Ap[3] +
+        A[6] * detb[0] * Ap[5] + A[5] * detb[0] * Ap[6] -
+        A[3] * detb[0] * Ap[8];
+    Ah[2] += (A[3] * A[7] - A[4] * A[6]) * deth[0] + A[7] * detb[0] * Ap[3] -
+        A[6] * detb[0] * Ap[4] - A[4] * detb[0] * Ap[6] +
+        A[3] * detb[0] * Ap[7];
+    Ah[3] += (-A[1] * A[8] + A[2] * A[7]) * deth[0] - A[8] * detb[0] * Ap[1] +
+        A[7] * detb[0] * Ap[2] + A[2] * detb[0] * Ap[7] -
+        A[1] * detb[0] * Ap[8];
+    Ah[4] += (A[0] * A[8] - A[2] * A[6]) * deth[0] + A[8] * detb[0] * Ap[0] -
+        A[6] * detb[0] * Ap[2] - A[2] * detb[0] * Ap[6] +
+        A[0] * detb[0] * Ap[8];
+    Ah[5] += (-A[0] * A[7] + A[1] * A[6]) * deth[0] - A[7] * detb[0] * Ap[0] +
+        A[6] * detb[0] * Ap[1] + A[1] * detb[0] * Ap[6] -
+        A[0] * detb[0] * Ap[7];
+    Ah[6] += (A[1] * A[5] - A[2] * A[4]) * deth[0] + A[5] * detb[0] * Ap[1] -
+        A[4] * detb[0] * Ap[2] - A[2] * detb[0] * Ap[4] +
+        A[1] * detb[0] * Ap[5];
+    Ah[7] += (-A[0] * A[5] + A[2] * A[3]) * deth[0] - A[5] * detb[0] * Ap[0] +
+        A[3] * detb[0] * Ap[2] + A[2] * detb[0] * Ap[3] -
+        A[0] * detb[0] * Ap[5];
+    Ah[8] += (A[0] * A[4] - A[1] * A[3]) * deth[0] + A[4] * detb[0] * Ap[0] -
+        A[3] * detb[0] * Ap[1] - A[1] * detb[0] * Ap[3] +
+        A[0] * detb[0] * Ap[4];
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void GenNonlinearGreenStrainCore(const T Ux[], T E[]) {
+  static_assert(N == 2 || N == 3,
+                "Generated core not available for N");
+
+  if constexpr (N == 2) {
+    E[0] = T(0.5) * (Ux[0] * Ux[0] + Ux[2] * Ux[2] + T(2.0) * Ux[0]);
+    E[1] = T(0.5) * (Ux[1] + Ux[2] + Ux[0] * Ux[1] + Ux[2] * Ux[3]);
+    E[2] = T(0.5) * (Ux[1] * Ux[1] + Ux[3] * Ux[3] + T(2.0) * Ux[3]);
+  } else {  // N == 3
+    E[0] = T(0.5) *
+        (Ux[0] * Ux[0] + T(2.0) * Ux[0] + Ux[3] * Ux[3] + Ux[6] * Ux[6]);
+    E[1] = T(0.5) *
+        (Ux[1] + Ux[3] + Ux[0] * Ux[1] + Ux[3] * Ux[4] + Ux[6] * Ux[7]);
+    E[2] = T(0.5) *
+        (Ux[1] * Ux[1] + Ux[4] * Ux[4] + Ux[7] * Ux[7] + T(2.0) * Ux[4]);
+    E[3] = T(0.5) *
+        (Ux[2] + Ux[6] + Ux[0] * Ux[2] + Ux[3] * Ux[5] + Ux[6] * Ux[8]);
+    E[4] = T(0.5) *
+        (Ux[5] + Ux[7] + Ux[1] * Ux[2] + Ux[4] * Ux[5] + Ux[7] * Ux[8]);
+    E[5] = T(0.5) *
+        (Ux[2] * Ux[2] + Ux[5] * Ux[5] + Ux[8] * Ux[8] + T(2.0) * Ux[8]);
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void GenNonlinearGreenStrainForwardCore(const T Ux[],
+                                                     const T Uxd[], T Ed[]) {
+  static_assert(N == 2 || N == 3,
+                "Generated core not available for N");
+
+  if constexpr (N == 2) {
+    T t0 = T(1.0) + Ux[0];
+    T t1 = T(1.0) + Ux[3];
+
+    Ed[0] = Uxd[0] * t0 + Ux[2] * Uxd[2];
+    Ed[1] = T(0.5) * Ux[1] * Uxd[0] + T(0.5) * Uxd[1] * t0 +
+        T(0.5) * Uxd[2] * t1 + T(0.5) * Ux[2] * Uxd[3];
+    Ed[2] = Ux[1] * Uxd[1] + Uxd[3] * t1;
+  } else {  // N == 3
+    T t0 = T(1.0) + Ux[0];
+    T t1 = T(1.0) + Ux[4];
+    T t2 = T(1.0) + Ux[8];
+
+    Ed[0] = Uxd[0] * t0 + Ux[3] * Uxd[3] + Ux[6] * Uxd[6];
+    Ed[1] = T(0.5) * Ux[1] * Uxd[0] + T(0.5) * Uxd[1] * t0 +
+        T(0.5) * Uxd[3] * t1 + T(0.5) * Ux[3] * Uxd[4] +
+        T(0.5) * Ux[7] * Uxd[6] + T(0.5) * Ux[6] * Uxd[7];
+    Ed[2] = Ux[1] * Uxd[1] + Uxd[4] * t1 + Ux[7] * Uxd[7];
+    Ed[3] = T(0.5) * Ux[2] * Uxd[0] + T(0.5) * Uxd[2] * t0 +
+        T(0.5) * Ux[5] * Uxd[3] + T(0.5) * Ux[3] * Uxd[5] +
+        T(0.5) * Uxd[6] * t2 + T(0.5) * Ux[6] * Uxd[8];
+    Ed[4] = T(0.5) * Ux[2] * Uxd[1] + T(0.5) * Ux[1] * Uxd[2] +
+        T(0.5) * Ux[5] * Uxd[4] + T(0.5) * Uxd[5] * t1 + T(0.5) * Uxd[7] * t2 +
+        T(0.5) * Ux[7] * Uxd[8];
+    Ed[5] = Ux[2] * Uxd[2] + Ux[5] * Uxd[5] + Uxd[8] * t2;
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void GenNonlinearGreenStrainReverseCore(const T Ux[], const T Eb[],
+                                                     T Uxb[]) {
+  static_assert(N == 2 || N == 3,
+                "Generated core not available for N");
+
+  if constexpr (N == 2) {
+    T t0 = T(1.0) + Ux[0];
+    T t1 = T(1.0) + Ux[3];
+
+    Uxb[0] += t0 * Eb[0] + T(0.5) * Ux[1] * Eb[1];
+    Uxb[1] += T(0.5) * t0 * Eb[1] + Ux[1] * Eb[2];
+    Uxb[2] += Ux[2] * Eb[0] + T(0.5) * t1 * Eb[1];
+    Uxb[3] += T(0.5) * Ux[2] * Eb[1] + t1 * Eb[2];
+  } else {  // N == 3
+    T t0 = T(1.0) + Ux[0];
+    T t1 = T(1.0) + Ux[4];
+    T t2 = T(1.0) + Ux[8];
+
+    Uxb[0] += t0 * Eb[0] + T(0.5) * Ux[1] * Eb[1] + T(0.5) * Ux[2] * Eb[3];
+    Uxb[1] += T(0.5) * t0 * Eb[1] + Ux[1] * Eb[2] + T(0.5) * Ux[2] * Eb[4];
+    Uxb[2] += T(0.5) * t0 * Eb[3] + T(0.5) * Ux[1] * Eb[4] + Ux[2] * Eb[5];
+    Uxb[3] += Ux[3] * Eb[0] + T(0.5) * t1 * Eb[1] + T(0.5) * Ux[5] * Eb[3];
+    Uxb[4] += T(0.5) * Ux[3] * Eb[1] + t1 * Eb[2] + T(0.5) * Ux[5] * Eb[4];
+    Uxb[5] += T(0.5) * Ux[3] * Eb[3] + T(0.5) * t1 * Eb[4] + Ux[5] * Eb[5];
+    Uxb[6] += Ux[6] * Eb[0] + T(0.5) * Ux[7] * Eb[1] + T(0.5) * t2 * Eb[3];
+    Uxb[7] += T(0.5) * Ux[6] * Eb[1] + Ux[7] * Eb[2] + T(0.5) * t2 * Eb[4];
+    Uxb[8] += T(0.5) * Ux[6] * Eb[3] + T(0.5) * Ux[7] * Eb[4] + t2 * Eb[5];
+  }
+}
+
+template <typename T, int N>
+A2D_FUNCTION void GenNonlinearGreenStrainHReverseCore(const T Ux[],
+                                                      const T Uxp[],
+                                                      const T Eb[],
+                                                      const T Eh[], T Uxh[]) {
+  static_assert(N == 2 || N == 3,
+                "Generated core not available for N");
+
+  if constexpr (N == 2) {
+    T t0 = T(1.0) + Ux[0];
+    T t1 = T(1.0) + Ux[3];
+
+    Uxh[0] += t0 * Eh[0] + T(0.5) * Ux[1] * Eh[1] + Eb[0] * Uxp[0] +
+        T(0.5) * Eb[1] * Uxp[1];
+    Uxh[1] += T(0.5) * t0 * Eh[1] + Ux[1] * Eh[2] + T(0.5) * Eb[1] * Uxp[0] +
+        Eb[2] * Uxp[1];
+    Uxh[2] += Ux[2] * Eh[0] + T(0.5) * t1 * Eh[1] + Eb[0] * Uxp[2] +
+        T(0.5) * Eb[1] * Uxp[3];
+    Uxh[3] += T(0.5) * Ux[2] * Eh[1] + t1 * Eh[2] + T(0.5) * Eb[1] * Uxp[2] +
+        Eb[2] * Uxp[3];
+  } else {  // N == 3
+    T t0 = T(1.0) + Ux[0];
+    T t1 = T(1.0) + Ux[4];
+    T t2 = T(1.0) + Ux[8];
+
+    Uxh[0] += t0 * Eh[0] + T(0.5) * Ux[1] * Eh[1] + Eb[0] * Uxp[0] +
+        T(0.5) * Eb[1] * Uxp[1] + T(0.5) * Ux[2] * Eh[3] +
+        T(0.5) * Eb[3] * Uxp[2];
+    Uxh[1] += T(0.5) * t0 * Eh[1] + Ux[1] * Eh[2] + T(0.5) * Eb[1] * Uxp[0] +
+        Eb[2] * Uxp[1] + T(0.5) * Ux[2] * Eh[4] + T(0.5) * Eb[4] * Uxp[2];
+    Uxh[2] += T(0.5) * t0 * Eh[3] + T(0.5) * Ux[1] * Eh[4] + Ux[2] * Eh[5] +
+        T(0.5) * Eb[3] * Uxp[0] + T(0.5) * Eb[4] * Uxp[1] + Eb[5] * Uxp[2];
+    Uxh[3] += Ux[3] * Eh[0] + T(0.5) * t1 * Eh[1] + T(0.5) * Ux[5] * Eh[3] +
+        Eb[0] * Uxp[3] + T(0.5) * Eb[1] * Uxp[4] + T(0.5) * Eb[3] * Uxp[5];
+    Uxh[4] += T(0.5) * Eb[1] * Uxp[3] + T(0.5) * Ux[3] * Eh[1] + t1 * Eh[2] +
+        T(0.5) * Ux[5] * Eh[4] + Eb[2] * Uxp[4] + T(0.5) * Eb[4] * Uxp[5];
+    Uxh[5] += T(0.5) * Ux[3] * Eh[3] + T(0.5) * t1 * Eh[4] + Ux[5] * Eh[5] +
+        T(0.5) * Eb[3] * Uxp[3] + T(0.5) * Eb[4] * Uxp[4] + Eb[5] * Uxp[5];
+    Uxh[6] += Ux[6] * Eh[0] + T(0.5) * Ux[7] * Eh[1] + T(0.5) * t2 * Eh[3] +
+        Eb[0] * Uxp[6] + T(0.5) * Eb[1] * Uxp[7] + T(0.5) * Eb[3] * Uxp[8];
+    Uxh[7] += T(0.5) * Ux[6] * Eh[1] + Ux[7] * Eh[2] + T(0.5) * t2 * Eh[4] +
+        T(0.5) * Eb[1] * Uxp[6] + Eb[2] * Uxp[7] + T(0.5) * Eb[4] * Uxp[8];
+    Uxh[8] += T(0.5) * Ux[6] * Eh[3] + T(0.5) * Ux[7] * Eh[4] + t2 * Eh[5] +
+        T(0.5) * Eb[3] * Uxp[6] + T(0.5) * Eb[4] * Uxp[7] + Eb[5] * Uxp[8];
+  }
+}
+
+template <typename T>
+A2D_FUNCTION void GenQuaternionMatrixCore(const T q[], T C[]) {
+  T t0 = q[2] * q[2];
+  T t1 = q[3] * q[3];
+  T t2 = q[1] * q[2];
+  T t3 = q[1] * q[3];
+  T t4 = q[1] * q[1];
+  T t5 = q[2] * q[3];
+
+  C[0] = T(1.0) - T(2.0) * (t0 + t1);
+  C[1] = T(2.0) * (t2 + q[0] * q[3]);
+  C[2] = T(2.0) * (t3 - q[0] * q[2]);
+  C[3] = T(2.0) * (t2 - q[0] * q[3]);
+  C[4] = T(1.0) - T(2.0) * (t1 + t4);
+  C[5] = T(2.0) * (t5 + q[0] * q[1]);
+  C[6] = T(2.0) * (t3 + q[0] * q[2]);
+  C[7] = T(2.0) * (t5 - q[0] * q[1]);
+  C[8] = T(1.0) - T(2.0) * (t0 + t4);
+}
+
+template <typename T>
+A2D_FUNCTION void GenQuaternionMatrixForwardCore(const T q[], const T qd[],
+                                                 T Cd[]) {
+  T t0 = T(-4.0) * q[2] * qd[2];
+  T t1 = T(-4.0) * q[3] * qd[3];
+  T t2 = T(2.0) * q[2] * qd[1];
+  T t3 = T(2.0) * q[1] * qd[2];
+  T t4 = T(2.0) * q[3] * qd[1];
+  T t5 = T(2.0) * q[1] * qd[3];
+  T t6 = T(-4.0) * q[1] * qd[1];
+  T t7 = T(2.0) * q[3] * qd[2];
+  T t8 = T(2.0) * q[2] * qd[3];
+
+  Cd[0] = t0 + t1;
+  Cd[1] = T(2.0) * q[3] * qd[0] + t2 + t3 + T(2.0) * q[0] * qd[3];
+  Cd[2] = T(-2.0) * q[2] * qd[0] + t4 - T(2.0) * q[0] * qd[2] + t5;
+  Cd[3] = t2 + t3 - T(2.0) * q[3] * qd[0] - T(2.0) * q[0] * qd[3];
+  Cd[4] = t1 + t6;
+  Cd[5] = T(2.0) * q[1] * qd[0] + T(2.0) * q[0] * qd[1] + t7 + t8;
+  Cd[6] = t4 + t5 + T(2.0) * q[2] * qd[0] + T(2.0) * q[0] * qd[2];
+  Cd[7] = t7 + t8 - T(2.0) * q[1] * qd[0] - T(2.0) * q[0] * qd[1];
+  Cd[8] = t0 + t6;
+}
+
+template <typename T>
+A2D_FUNCTION void GenQuaternionMatrixReverseCore(const T q[], const T Cb[],
+                                                 T qb[]) {
+  qb[0] += T(2.0) * q[3] * Cb[1] - T(2.0) * q[2] * Cb[2] -
+      T(2.0) * q[3] * Cb[3] + T(2.0) * q[1] * Cb[5] + T(2.0) * q[2] * Cb[6] -
+      T(2.0) * q[1] * Cb[7];
+  qb[1] += T(2.0) * q[2] * Cb[1] + T(2.0) * q[3] * Cb[2] +
+      T(2.0) * q[2] * Cb[3] - T(4.0) * q[1] * Cb[4] + T(2.0) * q[0] * Cb[5] +
+      T(2.0) * q[3] * Cb[6] - T(2.0) * q[0] * Cb[7] - T(4.0) * q[1] * Cb[8];
+  qb[2] += T(-4.0) * q[2] * Cb[0] + T(2.0) * q[1] * Cb[1] -
+      T(2.0) * q[0] * Cb[2] + T(2.0) * q[1] * Cb[3] + T(2.0) * q[3] * Cb[5] +
+      T(2.0) * q[0] * Cb[6] + T(2.0) * q[3] * Cb[7] - T(4.0) * q[2] * Cb[8];
+  qb[3] += T(-4.0) * q[3] * Cb[0] + T(2.0) * q[0] * Cb[1] +
+      T(2.0) * q[1] * Cb[2] - T(2.0) * q[0] * Cb[3] - T(4.0) * q[3] * Cb[4] +
+      T(2.0) * q[2] * Cb[5] + T(2.0) * q[1] * Cb[6] + T(2.0) * q[2] * Cb[7];
+}
+
+template <typename T>
+A2D_FUNCTION void GenQuaternionMatrixHReverseCore(const T q[], const T qp[],
+                                                  const T Cb[], const T Ch[],
+                                                  T qh[]) {
+  T t0 = Cb[5] - Cb[7];
+  T t1 = Cb[6] - Cb[2];
+  T t2 = Cb[1] - Cb[3];
+  T t3 = -Cb[4];
+  T t4 = -Cb[8];
+  T t5 = Cb[1] + Cb[3];
+  T t6 = Cb[2] + Cb[6];
+  T t7 = -Cb[0];
+  T t8 = Cb[5] + Cb[7];
+
+  qh[0] += T(2.0) * q[3] * Ch[1] - T(2.0) * q[2] * Ch[2] -
+      T(2.0) * q[3] * Ch[3] + T(2.0) * q[1] * Ch[5] + T(2.0) * q[2] * Ch[6] -
+      T(2.0) * q[1] * Ch[7] + T(2.0) * qp[1] * t0 + T(2.0) * qp[2] * t1 +
+      T(2.0) * qp[3] * t2;
+  qh[1] += T(2.0) * q[2] * Ch[1] + T(2.0) * q[3] * Ch[2] +
+      T(2.0) * q[2] * Ch[3] - T(4.0) * q[1] * Ch[4] + T(2.0) * q[0] * Ch[5] +
+      T(2.0) * q[3] * Ch[6] - T(2.0) * q[0] * Ch[7] - T(4.0) * q[1] * Ch[8] +
+      T(2.0) * qp[0] * t0 + T(4.0) * qp[1] * (t3 + t4) + T(2.0) * qp[2] * t5 +
+      T(2.0) * qp[3] * t6;
+  qh[2] += T(-4.0) * q[2] * Ch[0] + T(2.0) * q[1] * Ch[1] -
+      T(2.0) * q[0] * Ch[2] + T(2.0) * q[1] * Ch[3] + T(2.0) * q[3] * Ch[5] +
+      T(2.0) * q[0] * Ch[6] + T(2.0) * q[3] * Ch[7] - T(4.0) * q[2] * Ch[8] +
+      T(2.0) * qp[0] * t1 + T(2.0) * qp[1] * t5 + T(4.0) * qp[2] * (t4 + t7) +
+      T(2.0) * qp[3] * t8;
+  qh[3] += T(-4.0) * q[3] * Ch[0] + T(2.0) * q[0] * Ch[1] +
+      T(2.0) * q[1] * Ch[2] - T(2.0) * q[0] * Ch[3] - T(4.0) * q[3] * Ch[4] +
+      T(2.0) * q[2] * Ch[5] + T(2.0) * q[1] * Ch[6] + T(2.0) * q[2] * Ch[7] +
+      T(2.0) * qp[0] * t2 + T(2.0) * qp[1] * t6 + T(2.0) * qp[2] * t8 +
+      T(4.0) * qp[3] * (t3 + t7);
+}
+
+}  // namespace A2D
+
+#endif  // A2D_GEN_CORE_H
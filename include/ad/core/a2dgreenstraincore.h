@@ -13,16 +13,16 @@ A2D_FUNCTION void LinearGreenStrainCore(const T Ux[], T E[]) {
   if constexpr (N == 2) {
     E[0] = Ux[0];
 
-    E[1] = 0.5 * (Ux[1] + Ux[2]);
+    E[1] = T(0.5) * (Ux[1] + Ux[2]);
     E[2] = Ux[3];
   } else {
     E[0] = Ux[0];
 
-    E[1] = 0.5 * (Ux[1] + Ux[3]);
+    E[1] = T(0.5) * (Ux[1] + Ux[3]);
     E[2] = Ux[4];
 
-    E[3] = 0.5 * (Ux[2] + Ux[6]);
-    E[4] = 0.5 * (Ux[5] + Ux[7]);
+    E[3] = T(0.5) * (Ux[2] + Ux[6]);
+    E[4] = T(0.5) * (Ux[5] + Ux[7]);
     E[5] = Ux[8];
   }
 }
@@ -34,22 +34,22 @@ A2D_FUNCTION void NonlinearGreenStrainCore(const T Ux[], T E[]) {
 
   // E = 0.5 * (Ux + Ux^{T} + Ux^{T} * Ux)
   if constexpr (N == 2) {
-    E[0] = Ux[0] + 0.5 * (Ux[0] * Ux[0] + Ux[2] * Ux[2]);
+    E[0] = Ux[0] + T(0.5) * (Ux[0] * Ux[0] + Ux[2] * Ux[2]);
 
-    E[1] = 0.5 * (Ux[1] + Ux[2] + Ux[0] * Ux[1] + Ux[2] * Ux[3]);
-    E[2] = Ux[3] + 0.5 * (Ux[1] * Ux[1] + Ux[3] * Ux[3]);
+    E[1] = T(0.5) * (Ux[1] + Ux[2] + Ux[0] * Ux[1] + Ux[2] * Ux[3]);
+    E[2] = Ux[3] + T(0.5) * (Ux[1] * Ux[1] + Ux[3] * Ux[3]);
   } else {
-    E[0] = Ux[0] + 0.5 * (Ux[0] * Ux[0] + Ux[3] * Ux[3] + Ux[6] * Ux[6]);
+    E[0] = Ux[0] + T(0.5) * (Ux[0] * Ux[0] + Ux[3] * Ux[3] + Ux[6] * Ux[6]);
 
-    E[1] =
-        0.5 * (Ux[1] + Ux[3] + Ux[0] * Ux[1] + Ux[3] * Ux[4] + Ux[6] * Ux[7]);
-    E[2] = Ux[4] + 0.5 * (Ux[1] * Ux[1] + Ux[4] * Ux[4] + Ux[7] * Ux[7]);
+    E[1] = T(0.5) * (Ux[1] + Ux[3] + Ux[0] * Ux[1] + Ux[3] * Ux[4] +
+                     Ux[6] * Ux[7]);
+    E[2] = Ux[4] + T(0.5) * (Ux[1] * Ux[1] + Ux[4] * Ux[4] + Ux[7] * Ux[7]);
 
-    E[3] =
-        0.5 * (Ux[2] + Ux[6] + Ux[0] * Ux[2] + Ux[3] * Ux[5] + Ux[6] * Ux[8]);
-    E[4] =
-        0.5 * (Ux[5] + Ux[7] + Ux[1] * Ux[2] + Ux[4] * Ux[5] + Ux[7] * Ux[8]);
-    E[5] = Ux[8] + 0.5 * (Ux[2] * Ux[2] + Ux[5] * Ux[5] + Ux[8] * Ux[8]);
+    E[3] = T(0.5) * (Ux[2] + Ux[6] + Ux[0] * Ux[2] + Ux[3] * Ux[5] +
+                     Ux[6] * Ux[8]);
+    E[4] = T(0.5) * (Ux[5] + Ux[7] + Ux[1] * Ux[2] + Ux[4] * Ux[5] +
+                     Ux[7] * Ux[8]);
+    E[5] = Ux[8] + T(0.5) * (Ux[2] * Ux[2] + Ux[5] * Ux[5] + Ux[8] * Ux[8]);
   }
 }
 
@@ -62,16 +62,16 @@ A2D_FUNCTION void LinearGreenStrainForwardCore(const T Ud[], T E[]) {
   if constexpr (N == 2) {
     E[0] = Ud[0];
 
-    E[1] = 0.5 * (Ud[1] + Ud[2]);
+    E[1] = T(0.5) * (Ud[1] + Ud[2]);
     E[2] = Ud[3];
   } else {
     E[0] = Ud[0];
 
-    E[1] = 0.5 * (Ud[1] + Ud[3]);
+    E[1] = T(0.5) * (Ud[1] + Ud[3]);
     E[2] = Ud[4];
 
-    E[3] = 0.5 * (Ud[2] + Ud[6]);
-    E[4] = 0.5 * (Ud[5] + Ud[7]);
+    E[3] = T(0.5) * (Ud[2] + Ud[6]);
+    E[4] = T(0.5) * (Ud[5] + Ud[7]);
     E[5] = Ud[8];
   }
 }
@@ -86,24 +86,24 @@ A2D_FUNCTION void NonlinearGreenStrainForwardCore(const T Ux[], const T Ud[],
   if constexpr (N == 2) {
     E[0] = Ud[0] + Ux[0] * Ud[0] + Ux[2] * Ud[2];
 
-    E[1] = 0.5 * (Ud[1] + Ud[2] + Ux[0] * Ud[1] + Ux[2] * Ud[3] +
-                  Ud[0] * Ux[1] + Ud[2] * Ux[3]);
-    E[2] = Ud[2] + Ux[1] * Ud[1] + Ux[3] * Ud[3];
+    E[1] = T(0.5) * (Ud[1] + Ud[2] + Ux[0] * Ud[1] + Ux[2] * Ud[3] +
+                     Ud[0] * Ux[1] + Ud[2] * Ux[3]);
+    E[2] = Ud[3] + Ux[1] * Ud[1] + Ux[3] * Ud[3];
 
   } else {
     E[0] = Ud[0] + Ux[0] * Ud[0] + Ux[3] * Ud[3] + Ux[6] * Ud[6];
 
-    E[1] =
-        0.5 * (Ud[1] + Ud[3] + Ux[0] * Ud[1] + Ux[3] * Ud[4] + Ux[6] * Ud[7] +
-               Ud[0] * Ux[1] + Ud[3] * Ux[4] + Ud[6] * Ux[7]);
+    E[1] = T(0.5) * (Ud[1] + Ud[3] + Ux[0] * Ud[1] + Ux[3] * Ud[4] +
+                     Ux[6] * Ud[7] + Ud[0] * Ux[1] + Ud[3] * Ux[4] +
+                     Ud[6] * Ux[7]);
     E[2] = Ud[4] + Ux[1] * Ud[1] + Ux[4] * Ud[4] + Ux[7] * Ud[7];
 
-    E[3] =
-        0.5 * (Ud[2] + Ud[6] + Ux[0] * Ud[2] + Ux[3] * Ud[5] + Ux[6] * Ud[8] +
-               Ud[0] * Ux[2] + Ud[3] * Ux[5] + Ud[6] * Ux[8]);
-    E[4] =
-        0.5 * (Ud[5] + Ud[7] + Ux[1] * Ud[2] + Ux[4] * Ud[5] + Ux[7] * Ud[8] +
-               Ud[1] * Ux[2] + Ud[4] * Ux[5] + Ud[7] * Ux[8]);
+    E[3] = T(0.5) * (Ud[2] + Ud[6] + Ux[0] * Ud[2] + Ux[3] * Ud[5] +
+                     Ux[6] * Ud[8] + Ud[0] * Ux[2] + Ud[3] * Ux[5] +
+                     Ud[6] * Ux[8]);
+    E[4] = T(0.5) * (Ud[5] + Ud[7] + Ux[1] * Ud[2] + Ux[4] * Ud[5] +
+                     Ux[7] * Ud[8] + Ud[1] * Ux[2] + Ud[4] * Ux[5] +
+                     Ud[7] * Ux[8]);
     E[5] = Ud[8] + Ux[2] * Ud[2] + Ux[5] * Ud[5] + Ux[8] * Ud[8];
   }
 }
@@ -116,22 +116,22 @@ A2D_FUNCTION void LinearGreenStrainReverseCore(const T Eb[], T Ub[]) {
   // E = 0.5 * (Ux + Ux^{T})
   if constexpr (N == 2) {
     Ub[0] += Eb[0];
-    Ub[1] += 0.5 * Eb[1];
+    Ub[1] += T(0.5) * Eb[1];
 
-    Ub[2] += 0.5 * Eb[1];
+    Ub[2] += T(0.5) * Eb[1];
     Ub[3] += Eb[2];
   } else {
     // Uxb = Eb
     Ub[0] += Eb[0];
-    Ub[1] += 0.5 * Eb[1];
-    Ub[2] += 0.5 * Eb[3];
+    Ub[1] += T(0.5) * Eb[1];
+    Ub[2] += T(0.5) * Eb[3];
 
-    Ub[3] += 0.5 * Eb[1];
+    Ub[3] += T(0.5) * Eb[1];
     Ub[4] += Eb[2];
-    Ub[5] += 0.5 * Eb[4];
+    Ub[5] += T(0.5) * Eb[4];
 
-    Ub[6] += 0.5 * Eb[3];
-    Ub[7] += 0.5 * Eb[4];
+    Ub[6] += T(0.5) * Eb[3];
+    Ub[7] += T(0.5) * Eb[4];
     Ub[8] += Eb[5];
   }
 }
@@ -145,23 +145,32 @@ A2D_FUNCTION void NonlinearGreenStrainReverseCore(const T Ux[], const T Eb[],
   // Uxb = (I + Ux) * Eb
   if constexpr (N == 2) {
     // Uxb = (I + Ux) * Eb
-    Ub[0] += (Ux[0] + 1.0) * Eb[0] + 0.5 * Ux[1] * Eb[1];
-    Ub[1] += 0.5 * (Ux[0] + 1.0) * Eb[1] + Ux[1] * Eb[2];
+    Ub[0] += (Ux[0] + T(1.0)) * Eb[0] + T(0.5) * Ux[1] * Eb[1];
+    Ub[1] += T(0.5) * (Ux[0] + T(1.0)) * Eb[1] + Ux[1] * Eb[2];
 
-    Ub[2] += Ux[2] * Eb[0] + 0.5 * (Ux[3] + 1.0) * Eb[1];
-    Ub[3] += 0.5 * Ux[2] * Eb[1] + (Ux[3] + 1.0) * Eb[2];
+    Ub[2] += Ux[2] * Eb[0] + T(0.5) * (Ux[3] + T(1.0)) * Eb[1];
+    Ub[3] += T(0.5) * Ux[2] * Eb[1] + (Ux[3] + T(1.0)) * Eb[2];
   } else {
-    Ub[0] += (Ux[0] + 1.0) * Eb[0] + 0.5 * Ux[1] * Eb[1] + 0.5 * Ux[2] * Eb[3];
-    Ub[1] += 0.5 * (Ux[0] + 1.0) * Eb[1] + Ux[1] * Eb[2] + 0.5 * Ux[2] * Eb[4];
-    Ub[2] += 0.5 * (Ux[0] + 1.0) * Eb[3] + 0.5 * Ux[1] * Eb[4] + Ux[2] * Eb[5];
-
-    Ub[3] += Ux[3] * Eb[0] + 0.5 * (Ux[4] + 1.0) * Eb[1] + 0.5 * Ux[5] * Eb[3];
-    Ub[4] += 0.5 * Ux[3] * Eb[1] + (Ux[4] + 1.0) * Eb[2] + 0.5 * Ux[5] * Eb[4];
-    Ub[5] += 0.5 * Ux[3] * Eb[3] + 0.5 * (Ux[4] + 1.0) * Eb[4] + Ux[5] * Eb[5];
-
-    Ub[6] += Ux[6] * Eb[0] + 0.5 * Ux[7] * Eb[1] + 0.5 * (Ux[8] + 1.0) * Eb[3];
-    Ub[7] += 0.5 * Ux[6] * Eb[1] + Ux[7] * Eb[2] + 0.5 * (Ux[8] + 1.0) * Eb[4];
-    Ub[8] += 0.5 * Ux[6] * Eb[3] + 0.5 * Ux[7] * Eb[4] + (Ux[8] + 1.0) * Eb[5];
+    Ub[0] += (Ux[0] + T(1.0)) * Eb[0] + T(0.5) * Ux[1] * Eb[1] +
+             T(0.5) * Ux[2] * Eb[3];
+    Ub[1] += T(0.5) * (Ux[0] + T(1.0)) * Eb[1] + Ux[1] * Eb[2] +
+             T(0.5) * Ux[2] * Eb[4];
+    Ub[2] += T(0.5) * (Ux[0] + T(1.0)) * Eb[3] + T(0.5) * Ux[1] * Eb[4] +
+             Ux[2] * Eb[5];
+
+    Ub[3] += Ux[3] * Eb[0] + T(0.5) * (Ux[4] + T(1.0)) * Eb[1] +
+             T(0.5) * Ux[5] * Eb[3];
+    Ub[4] += T(0.5) * Ux[3] * Eb[1] + (Ux[4] + T(1.0)) * Eb[2] +
+             T(0.5) * Ux[5] * Eb[4];
+    Ub[5] += T(0.5) * Ux[3] * Eb[3] + T(0.5) * (Ux[4] + T(1.0)) * Eb[4] +
+             Ux[5] * Eb[5];
+
+    Ub[6] += Ux[6] * Eb[0] + T(0.5) * Ux[7] * Eb[1] +
+             T(0.5) * (Ux[8] + T(1.0)) * Eb[3];
+    Ub[7] += T(0.5) * Ux[6] * Eb[1] + Ux[7] * Eb[2] +
+             T(0.5) * (Ux[8] + T(1.0)) * Eb[4];
+    Ub[8] += T(0.5) * Ux[6] * Eb[3] + T(0.5) * Ux[7] * Eb[4] +
+             (Ux[8] + T(1.0)) * Eb[5];
   }
 }
 
@@ -172,21 +181,21 @@ A2D_FUNCTION void LinearGreenStrainHReverseCore(const T Eh[], T Uh[]) {
 
   if constexpr (N == 2) {
     Uh[0] += Eh[0];
-    Uh[1] += 0.5 * Eh[1];
+    Uh[1] += T(0.5) * Eh[1];
 
-    Uh[2] += 0.5 * Eh[1];
+    Uh[2] += T(0.5) * Eh[1];
     Uh[3] += Eh[2];
   } else {
     Uh[0] += Eh[0];
-    Uh[1] += 0.5 * Eh[1];
-    Uh[2] += 0.5 * Eh[3];
+    Uh[1] += T(0.5) * Eh[1];
+    Uh[2] += T(0.5) * Eh[3];
 
-    Uh[3] += 0.5 * Eh[1];
+    Uh[3] += T(0.5) * Eh[1];
     Uh[4] += Eh[2];
-    Uh[5] += 0.5 * Eh[4];
+    Uh[5] += T(0.5) * Eh[4];
 
-    Uh[6] += 0.5 * Eh[3];
-    Uh[7] += 0.5 * Eh[4];
+    Uh[6] += T(0.5) * Eh[3];
+    Uh[7] += T(0.5) * Eh[4];
     Uh[8] += Eh[5];
   }
 }
@@ -199,39 +208,48 @@ A2D_FUNCTION void NonlinearGreenStrainHReverseCore(const T Ux[], const T Up[],
                 "NonlinearGreenStrainHReverseCore must use N == 2 or N == 3");
 
   if constexpr (N == 2) {
-    Uh[0] += Up[0] * Eb[0] + 0.5 * Up[1] * Eb[1];
-    Uh[1] += 0.5 * Up[0] * Eb[1] + Up[1] * Eb[2];
-    Uh[2] += Up[2] * Eb[0] + 0.5 * Up[3] * Eb[1];
-    Uh[3] += 0.5 * Up[2] * Eb[1] + Up[3] * Eb[2];
-
-    Uh[0] += (Ux[0] + 1.0) * Eh[0] + 0.5 * Ux[1] * Eh[1];
-    Uh[1] += 0.5 * (Ux[0] + 1.0) * Eh[1] + Ux[1] * Eh[2];
-    Uh[2] += Ux[2] * Eh[0] + 0.5 * (Ux[3] + 1.0) * Eh[1];
-    Uh[3] += 0.5 * Ux[2] * Eh[1] + (Ux[3] + 1.0) * Eh[2];
+    Uh[0] += Up[0] * Eb[0] + T(0.5) * Up[1] * Eb[1];
+    Uh[1] += T(0.5) * Up[0] * Eb[1] + Up[1] * Eb[2];
+    Uh[2] += Up[2] * Eb[0] + T(0.5) * Up[3] * Eb[1];
+    Uh[3] += T(0.5) * Up[2] * Eb[1] + Up[3] * Eb[2];
+
+    Uh[0] += (Ux[0] + T(1.0)) * Eh[0] + T(0.5) * Ux[1] * Eh[1];
+    Uh[1] += T(0.5) * (Ux[0] + T(1.0)) * Eh[1] + Ux[1] * Eh[2];
+    Uh[2] += Ux[2] * Eh[0] + T(0.5) * (Ux[3] + T(1.0)) * Eh[1];
+    Uh[3] += T(0.5) * Ux[2] * Eh[1] + (Ux[3] + T(1.0)) * Eh[2];
   } else {
-    Uh[0] += Up[0] * Eb[0] + 0.5 * Up[1] * Eb[1] + 0.5 * Up[2] * Eb[3];
-    Uh[1] += 0.5 * Up[0] * Eb[1] + Up[1] * Eb[2] + 0.5 * Up[2] * Eb[4];
-    Uh[2] += 0.5 * Up[0] * Eb[3] + 0.5 * Up[1] * Eb[4] + Up[2] * Eb[5];
-
-    Uh[3] += Up[3] * Eb[0] + 0.5 * Up[4] * Eb[1] + 0.5 * Up[5] * Eb[3];
-    Uh[4] += 0.5 * Up[3] * Eb[1] + Up[4] * Eb[2] + 0.5 * Up[5] * Eb[4];
-    Uh[5] += 0.5 * Up[3] * Eb[3] + 0.5 * Up[4] * Eb[4] + Up[5] * Eb[5];
-
-    Uh[6] += Up[6] * Eb[0] + 0.5 * Up[7] * Eb[1] + 0.5 * Up[8] * Eb[3];
-    Uh[7] += 0.5 * Up[6] * Eb[1] + Up[7] * Eb[2] + 0.5 * Up[8] * Eb[4];
-    Uh[8] += 0.5 * Up[6] * Eb[3] + 0.5 * Up[7] * Eb[4] + Up[8] * Eb[5];
-
-    Uh[0] += (Ux[0] + 1.0) * Eh[0] + 0.5 * Ux[1] * Eh[1] + 0.5 * Ux[2] * Eh[3];
-    Uh[1] += 0.5 * (Ux[0] + 1.0) * Eh[1] + Ux[1] * Eh[2] + 0.5 * Ux[2] * Eh[4];
-    Uh[2] += 0.5 * (Ux[0] + 1.0) * Eh[3] + 0.5 * Ux[1] * Eh[4] + Ux[2] * Eh[5];
-
-    Uh[3] += Ux[3] * Eh[0] + 0.5 * (Ux[4] + 1.0) * Eh[1] + 0.5 * Ux[5] * Eh[3];
-    Uh[4] += 0.5 * Ux[3] * Eh[1] + (Ux[4] + 1.0) * Eh[2] + 0.5 * Ux[5] * Eh[4];
-    Uh[5] += 0.5 * Ux[3] * Eh[3] + 0.5 * (Ux[4] + 1.0) * Eh[4] + Ux[5] * Eh[5];
-
-    Uh[6] += Ux[6] * Eh[0] + 0.5 * Ux[7] * Eh[1] + 0.5 * (Ux[8] + 1.0) * Eh[3];
-    Uh[7] += 0.5 * Ux[6] * Eh[1] + Ux[7] * Eh[2] + 0.5 * (Ux[8] + 1.0) * Eh[4];
-    Uh[8] += 0.5 * Ux[6] * Eh[3] + 0.5 * Ux[7] * Eh[4] + (Ux[8] + 1.0) * Eh[5];
+    Uh[0] += Up[0] * Eb[0] + T(0.5) * Up[1] * Eb[1] + T(0.5) * Up[2] * Eb[3];
+    Uh[1] += T(0.5) * Up[0] * Eb[1] + Up[1] * Eb[2] + T(0.5) * Up[2] * Eb[4];
+    Uh[2] += T(0.5) * Up[0] * Eb[3] + T(0.5) * Up[1] * Eb[4] + Up[2] * Eb[5];
+
+    Uh[3] += Up[3] * Eb[0] + T(0.5) * Up[4] * Eb[1] + T(0.5) * Up[5] * Eb[3];
+    Uh[4] += T(0.5) * Up[3] * Eb[1] + Up[4] * Eb[2] + T(0.5) * Up[5] * Eb[4];
+    Uh[5] += T(0.5) * Up[3] * Eb[3] + T(0.5) * Up[4] * Eb[4] + Up[5] * Eb[5];
+
+    Uh[6] += Up[6] * Eb[0] + T(0.5) * Up[7] * Eb[1] + T(0.5) * Up[8] * Eb[3];
+    Uh[7] += T(0.5) * Up[6] * Eb[1] + Up[7] * Eb[2] + T(0.5) * Up[8] * Eb[4];
+    Uh[8] += T(0.5) * Up[6] * Eb[3] + T(0.5) * Up[7] * Eb[4] + Up[8] * Eb[5];
+
+    Uh[0] += (Ux[0] + T(1.0)) * Eh[0] + T(0.5) * Ux[1] * Eh[1] +
+             T(0.5) * Ux[2] * Eh[3];
+    Uh[1] += T(0.5) * (Ux[0] + T(1.0)) * Eh[1] + Ux[1] * Eh[2] +
+             T(0.5) * Ux[2] * Eh[4];
+    Uh[2] += T(0.5) * (Ux[0] + T(1.0)) * Eh[3] + T(0.5) * Ux[1] * Eh[4] +
+             Ux[2] * Eh[5];
+
+    Uh[3] += Ux[3] * Eh[0] + T(0.5) * (Ux[4] + T(1.0)) * Eh[1] +
+             T(0.5) * Ux[5] * Eh[3];
+    Uh[4] += T(0.5) * Ux[3] * Eh[1] + (Ux[4] + T(1.0)) * Eh[2] +
+             T(0.5) * Ux[5] * Eh[4];
+    Uh[5] += T(0.5) * Ux[3] * Eh[3] + T(0.5) * (Ux[4] + T(1.0)) * Eh[4] +
+             Ux[5] * Eh[5];
+
+    Uh[6] += Ux[6] * Eh[0] + T(0.5) * Ux[7] * Eh[1] +
+             T(0.5) * (Ux[8] + T(1.0)) * Eh[3];
+    Uh[7] += T(0.5) * Ux[6] * Eh[1] + Ux[7] * Eh[2] +
+             T(0.5) * (Ux[8] + T(1.0)) * Eh[4];
+    Uh[8] += T(0.5) * Ux[6] * Eh[3] + T(0.5) * Ux[7] * Eh[4] +
+             (Ux[8] + T(1.0)) * Eh[5];
   }
 }
 
@@ -13,7 +13,7 @@ A2D_FUNCTION void MatInvCore(const T A[], T Ainv[]) {
     Ainv[0] = 1.0 / A[0];
   } else if constexpr (N == 2) {
     T det = A[0] * A[3] - A[1] * A[2];
-    T detinv = 1.0 / det;
+    T detinv = T(1.0) / det;
 
     Ainv[0] = A[3] * detinv;
     Ainv[1] = -A[1] * detinv;
@@ -23,18 +23,18 @@ A2D_FUNCTION void MatInvCore(const T A[], T Ainv[]) {
     T det = (A[8] * (A[0] * A[4] - A[3] * A[1]) -
              A[7] * (A[0] * A[5] - A[3] * A[2]) +
              A[6] * (A[1] * A[5] - A[2] * A[4]));
-    T detinv = 1.0 / det;
+    T detinv = T(1.0) / det;
 
     Ainv[0] = (A[4] * A[8] - A[5] * A[7]) * detinv;
-    Ainv[1] = -1.0 * (A[1] * A[8] - A[2] * A[7]) * detinv;
+    Ainv[1] = -T(1.0) * (A[1] * A[8] - A[2] * A[7]) * detinv;
     Ainv[2] = (A[1] * A[5] - A[2] * A[4]) * detinv;
 
-    Ainv[3] = -1.0 * (A[3] * A[8] - A[5] * A[6]) * detinv;
+    Ainv[3] = -T(1.0) * (A[3] * A[8] - A[5] * A[6]) * detinv;
     Ainv[4] = (A[0] * A[8] - A[2] * A[6]) * detinv;
-    Ainv[5] = -1.0 * (A[0] * A[5] - A[2] * A[3]) * detinv;
+    Ainv[5] = -T(1.0) * (A[0] * A[5] - A[2] * A[3]) * detinv;
 
     Ainv[6] = (A[3] * A[7] - A[4] * A[6]) * detinv;
-    Ainv[7] = -1.0 * (A[0] * A[7] - A[1] * A[6]) * detinv;
+    Ainv[7] = -T(1.0) * (A[0] * A[7] - A[1] * A[6]) * detinv;
     Ainv[8] = (A[0] * A[4] - A[1] * A[3]) * detinv;
   }
 }
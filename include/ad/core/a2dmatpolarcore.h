@@ -0,0 +1,313 @@
+#ifndef A2D_MAT_POLAR_CORE_H
+#define A2D_MAT_POLAR_CORE_H
+
+#include <limits>
+
+#include "../../a2ddefs.h"
+#include "a2dgemmcore.h"
+#include "a2dmatdetcore.h"
+#include "a2dmatinvcore.h"
+
+namespace A2D {
+
+/*
+  Solve the Sylvester equation
+
+  U * Omega + Omega * U = S
+
+  for the skew-symmetric matrix Omega, given the symmetric positive definite
+  matrix U (stored as a full matrix) and the skew-symmetric right-hand-side S.
+
+  For N = 2, Omega = S / tr(U).
+
+  For N = 3, write S = [s]x and Omega = [w]x, then the equation is equivalent to
+
+  (tr(U) * I - U) * w = s
+
+  so no eigenvectors of U are required.
+*/
+template <typename T, int N>
+A2D_FUNCTION void MatPolarSylvesterCore(const T U[], const T S[], T Omega[]) {
+  static_assert((N == 2 || N == 3),
+                "MatPolarSylvesterCore only implemented for N = 2, 3");
+
+  if constexpr (N == 2) {
+    T inv = T(1.0) / (U[0] + U[3]);
+    Omega[0] = 0.0;
+    Omega[1] = inv * S[1];
+    Omega[2] = inv * S[2];
+    Omega[3] = 0.0;
+  } else {  // N == 3
+    // Extract s from S = [s]x
+    T s0 = S[7], s1 = S[2], s2 = S[3];
+
+    // G = tr(U) * I - U is symmetric
+    T tr = U[0] + U[4] + U[8];
+    T G[9];
+    for (int i = 0; i < 9; i++) {
+      G[i] = -U[i];
+    }
+    G[0] += tr;
+    G[4] += tr;
+    G[8] += tr;
+
+    T Ginv[9];
+    MatInvCore<T, 3>(G, Ginv);
+
+    T w0 = Ginv[0] * s0 + Ginv[1] * s1 + Ginv[2] * s2;
+    T w1 = Ginv[3] * s0 + Ginv[4] * s1 + Ginv[5] * s2;
+    T w2 = Ginv[6] * s0 + Ginv[7] * s1 + Ginv[8] * s2;
+
+    Omega[0] = 0.0;
+    Omega[1] = -w2;
+    Omega[2] = w1;
+    Omega[3] = w2;
+    Omega[4] = 0.0;
+    Omega[5] = -w0;
+    Omega[6] = -w1;
+    Omega[7] = w0;
+    Omega[8] = 0.0;
+  }
+}
+
+// Convert a packed symmetric matrix to a full matrix
+template <typename T, int N>
+A2D_FUNCTION void MatPolarSymToFull(const T S[], T A[]) {
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j <= i; j++) {
+      A[N * i + j] = A[N * j + i] = S[j + i * (i + 1) / 2];
+    }
+  }
+}
+
+// Convert the derivative of a packed symmetric matrix to a full matrix
+template <typename T, int N>
+A2D_FUNCTION void MatPolarSymSeedToFull(const T Sb[], T Ab[]) {
+  for (int i = 0; i < N; i++) {
+    Ab[(N + 1) * i] = Sb[i + i * (i + 1) / 2];
+    for (int j = 0; j < i; j++) {
+      Ab[N * i + j] = Ab[N * j + i] = T(0.5) * Sb[j + i * (i + 1) / 2];
+    }
+  }
+}
+
+// Store the symmetric part of a full matrix in packed format
+template <typename T, int N>
+A2D_FUNCTION void MatPolarFullToSym(const T A[], T S[]) {
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j <= i; j++) {
+      S[j + i * (i + 1) / 2] = T(0.5) * (A[N * i + j] + A[N * j + i]);
+    }
+  }
+}
+
+// Compute Omega = L(A - A^{T}) where L is the Sylvester solution operator
+template <typename T, int N>
+A2D_FUNCTION void MatPolarSkewSolveCore(const T U[], const T A[], T Omega[]) {
+  T S[N * N];
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      S[N * i + j] = A[N * i + j] - A[N * j + i];
+    }
+  }
+  MatPolarSylvesterCore<T, N>(U, S, Omega);
+}
+
+/*
+  Compute the polar decomposition F = R * U
+
+  For N = 2 the rotation is computed in closed form. For N = 3, the rotation is
+  computed using the scaled Newton iteration
+
+  X <- 1/2 * (zeta * X + 1/zeta * X^{-T}), zeta = det(X)^{-1/3}
+
+  which converges quadratically. The iteration stops once the change in R is
+  a small multiple of the machine epsilon of the real type of T. The
+  decomposition requires det(F) > 0.
+
+  Returns false if the iteration did not converge within max_iters
+*/
+template <typename T, int N>
+A2D_FUNCTION bool MatPolarCore(const T F[], T R[], T U[]) {
+  static_assert((N == 2 || N == 3),
+                "MatPolarCore only implemented for N = 2, 3");
+
+  bool converged = true;
+  if constexpr (N == 2) {
+    T a = F[0] + F[3];
+    T b = F[2] - F[1];
+    T inv = T(1.0) / sqrt(a * a + b * b);
+    R[0] = inv * a;
+    R[1] = -inv * b;
+    R[2] = inv * b;
+    R[3] = inv * a;
+  } else {  // N == 3
+    using Real = decltype(absfunc(F[0]));
+    const int max_iters = 30;
+    constexpr Real tol = Real(100.0) * std::numeric_limits<Real>::epsilon();
+
+    for (int i = 0; i < 9; i++) {
+      R[i] = F[i];
+    }
+
+    // Perform one additional iteration after convergence so that complex-step
+    // perturbations are also converged
+    converged = false;
+    for (int iter = 0; iter < max_iters; iter++) {
+      T Rinv[9];
+      MatInvCore<T, 3>(R, Rinv);
+      T zeta = pow(MatDetCore<T, 3>(R), -T(1.0) / T(3.0));
+      T zinv = T(1.0) / zeta;
+
+      Real diff = 0.0;
+      for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+          T Rnew = T(0.5) * (zeta * R[3 * i + j] + zinv * Rinv[3 * j + i]);
+          diff += absfunc(Rnew - R[3 * i + j]);
+          R[3 * i + j] = Rnew;
+        }
+      }
+
+      if (converged) {
+        break;
+      }
+      converged = (diff < tol);
+    }
+  }
+
+  // U = sym(R^{T} * F)
+  T M[N * N];
+  MatMatMultCore<T, N, N, N, N, N, N, MatOp::TRANSPOSE, MatOp::NORMAL>(R, F,
+                                                                       M);
+  MatPolarFullToSym<T, N>(M, U);
+
+  return converged;
+}
+
+/*
+  The forward derivative is computed from
+
+  R^{T} * dot{F} = Omega * U + dot{U}
+
+  where Omega = R^{T} * dot{R} is skew-symmetric. With M = R^{T} * dot{F}
+
+  U * Omega + Omega * U = M - M^{T}
+  dot{R} = R * Omega
+  dot{U} = M - Omega * U
+*/
+template <typename T, int N>
+A2D_FUNCTION void MatPolarForwardCore(const T R[], const T U[], const T Fd[],
+                                      T Rd[], T Ud[]) {
+  T Uf[N * N], M[N * N], Omega[N * N];
+  MatPolarSymToFull<T, N>(U, Uf);
+
+  MatMatMultCore<T, N, N, N, N, N, N, MatOp::TRANSPOSE, MatOp::NORMAL>(R, Fd,
+                                                                       M);
+  MatPolarSkewSolveCore<T, N>(Uf, M, Omega);
+
+  MatMatMultCore<T, N, N, N, N, N, N>(R, Omega, Rd);
+
+  // M = M - Omega * U
+  MatMatMultScaleCore<T, N, N, N, N, N, N, MatOp::NORMAL, MatOp::NORMAL, true>(
+      T(-1.0), Omega, Uf, M);
+  MatPolarFullToSym<T, N>(M, Ud);
+}
+
+/*
+  The reverse derivative is
+
+  bar{F} = R * (bar{U} + Omega_b)
+
+  where Z = R^{T} * bar{R} - bar{U} * U and
+
+  U * Omega_b + Omega_b * U = Z - Z^{T}
+*/
+template <typename T, int N>
+A2D_FUNCTION void MatPolarReverseCore(const T R[], const T U[], const T Rb[],
+                                      const T Ub[], T Fb[]) {
+  T Uf[N * N], Ubf[N * N], Z[N * N], Y[N * N];
+  MatPolarSymToFull<T, N>(U, Uf);
+  MatPolarSymSeedToFull<T, N>(Ub, Ubf);
+
+  MatMatMultCore<T, N, N, N, N, N, N, MatOp::TRANSPOSE, MatOp::NORMAL>(R, Rb,
+                                                                       Z);
+  MatMatMultScaleCore<T, N, N, N, N, N, N, MatOp::NORMAL, MatOp::NORMAL, true>(
+      T(-1.0), Ubf, Uf, Z);
+  MatPolarSkewSolveCore<T, N>(Uf, Z, Y);
+
+  for (int i = 0; i < N * N; i++) {
+    Y[i] += Ubf[i];
+  }
+
+  MatMatMultCore<T, N, N, N, N, N, N, MatOp::NORMAL, MatOp::NORMAL, true>(R, Y,
+                                                                        Fb);
+}
+
+/*
+  The second-order contribution to the reverse mode is obtained by
+  differentiating the reverse mode in the direction p{F}. With Omega_p, p{U}
+  from the forward mode and Omega_b, Y = bar{U} + Omega_b from the reverse mode
+
+  p{Z} = - Omega_p * R^{T} * bar{R} - bar{U} * p{U}
+  U * p{Omega_b} + p{Omega_b} * U
+    = p{Z} - p{Z}^{T} - (p{U} * Omega_b + Omega_b * p{U})
+
+  h{F} += R * (Omega_p * Y + p{Omega_b})
+*/
+template <typename T, int N>
+A2D_FUNCTION void MatPolarHReverseCore(const T R[], const T U[], const T Rb[],
+                                       const T Ub[], const T Fp[], T Fh[]) {
+  constexpr MatOp NORMAL = MatOp::NORMAL;
+  constexpr MatOp TRANSPOSE = MatOp::TRANSPOSE;
+
+  T Uf[N * N], Ubf[N * N];
+  MatPolarSymToFull<T, N>(U, Uf);
+  MatPolarSymSeedToFull<T, N>(Ub, Ubf);
+
+  // Forward mode: Omega_p and p{U}
+  T Op[N * N], Up[N * N];
+  MatMatMultCore<T, N, N, N, N, N, N, TRANSPOSE, NORMAL>(R, Fp, Up);
+  MatPolarSkewSolveCore<T, N>(Uf, Up, Op);
+  MatMatMultScaleCore<T, N, N, N, N, N, N, NORMAL, NORMAL, true>(T(-1.0), Op,
+                                                                Uf, Up);
+
+  // Reverse mode: Omega_b and Y = bar{U} + Omega_b
+  T RtRb[N * N], Z[N * N], Ob[N * N], Y[N * N];
+  MatMatMultCore<T, N, N, N, N, N, N, TRANSPOSE, NORMAL>(R, Rb, RtRb);
+  for (int i = 0; i < N * N; i++) {
+    Z[i] = RtRb[i];
+  }
+  MatMatMultScaleCore<T, N, N, N, N, N, N, NORMAL, NORMAL, true>(T(-1.0), Ubf,
+                                                                Uf, Z);
+  MatPolarSkewSolveCore<T, N>(Uf, Z, Ob);
+  for (int i = 0; i < N * N; i++) {
+    Y[i] = Ubf[i] + Ob[i];
+  }
+
+  // p{Z} = - Omega_p * R^{T} * bar{R} - bar{U} * p{U}
+  T Zp[N * N];
+  MatMatMultScaleCore<T, N, N, N, N, N, N, NORMAL, NORMAL>(T(-1.0), Op, RtRb,
+                                                          Zp);
+  MatMatMultScaleCore<T, N, N, N, N, N, N, NORMAL, NORMAL, true>(T(-1.0), Ubf,
+                                                                Up, Zp);
+
+  // V = p{Z} - p{Z}^{T} - (p{U} * Omega_b + Omega_b * p{U})
+  T W[N * N], V[N * N];
+  MatMatMultCore<T, N, N, N, N, N, N>(Up, Ob, W);
+  MatMatMultCore<T, N, N, N, N, N, N, NORMAL, NORMAL, true>(Ob, Up, W);
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      V[N * i + j] = Zp[N * i + j] - Zp[N * j + i] - W[N * i + j];
+    }
+  }
+  T Obp[N * N];
+  MatPolarSylvesterCore<T, N>(Uf, V, Obp);
+
+  // h{F} += R * (Omega_p * Y + p{Omega_b})
+  MatMatMultCore<T, N, N, N, N, N, N, NORMAL, NORMAL, true>(Op, Y, Obp);
+  MatMatMultCore<T, N, N, N, N, N, N, NORMAL, NORMAL, true>(R, Obp, Fh);
+}
+
+}  // namespace A2D
+
+#endif  // A2D_MAT_POLAR_CORE_H
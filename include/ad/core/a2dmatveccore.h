@@ -16,43 +16,54 @@ namespace A2D {
 template <typename T, int M, int N, MatOp opA = MatOp::NORMAL,
           bool additive = false>
 A2D_FUNCTION void MatVecCore(const T A[], const T x[], T y[]) noexcept {
-  if constexpr (additive) {
-    if constexpr (opA == MatOp::NORMAL) {
-      for (int i = 0; i < M; i++) {
-        T value = 0.0;
-        for (int j = 0; j < N; j++, A++) {
-          value += A[0] * x[j];
-        }
-        y[i] += value;
+  using R = typename accumulate_type<T>::type;
+
+  if constexpr (opA == MatOp::NORMAL) {
+    for (int i = 0; i < M; i++) {
+      R value = R(0.0);
+      for (int j = 0; j < N; j++, A++) {
+        value += R(A[0]) * R(x[j]);
       }
-    } else {
-      for (int i = 0; i < M; i++) {
-        const T value = x[i];
-        for (int j = 0; j < N; j++, A++) {
-          y[j] += A[0] * value;
-        }
+
+      if constexpr (additive) {
+        y[i] += T(value);
+      } else {
+        y[i] = T(value);
       }
     }
-  } else {
-    if constexpr (opA == MatOp::NORMAL) {
-      for (int i = 0; i < M; i++) {
-        T value = 0.0;
-        for (int j = 0; j < N; j++, A++) {
-          value += A[0] * x[j];
-        }
-        y[i] = value;
-      }
-    } else {
+  } else if constexpr (std::is_same<R, T>::value) {
+    // Accumulate the rows of A scaled by x directly into y
+    if constexpr (!additive) {
       for (int j = 0; j < N; j++) {
         y[j] = T(0.0);
       }
+    }
 
-      for (int i = 0; i < M; i++) {
-        const T value = x[i];
+    for (int i = 0; i < M; i++) {
+      const T value = x[i];
+      for (int j = 0; j < N; j++, A++) {
+        y[j] += A[0] * value;
+      }
+    }
+  } else {
+    // Accumulate the rows of A scaled by x in the wider type
+    R values[N];
+    for (int j = 0; j < N; j++) {
+      values[j] = R(0.0);
+    }
 
-        for (int j = 0; j < N; j++, A++) {
-          y[j] += A[0] * value;
-        }
+    for (int i = 0; i < M; i++) {
+      const R value = x[i];
+      for (int j = 0; j < N; j++, A++) {
+        values[j] += R(A[0]) * value;
+      }
+    }
+
+    for (int j = 0; j < N; j++) {
+      if constexpr (additive) {
+        y[j] += T(values[j]);
+      } else {
+        y[j] = T(values[j]);
       }
     }
   }
@@ -62,45 +73,153 @@ template <typename T, int M, int N, MatOp opA = MatOp::NORMAL,
           bool additive = false>
 A2D_FUNCTION void MatVecCoreScale(const T alpha, const T A[], const T x[],
                                   T y[]) noexcept {
-  if constexpr (additive) {
-    if constexpr (opA == MatOp::NORMAL) {
-      for (int i = 0; i < M; i++) {
-        T value = 0.0;
-        for (int j = 0; j < N; j++, A++) {
-          value += A[0] * x[j];
-        }
+  using R = typename accumulate_type<T>::type;
+
+  if constexpr (opA == MatOp::NORMAL) {
+    for (int i = 0; i < M; i++) {
+      R value = R(0.0);
+      for (int j = 0; j < N; j++, A++) {
+        value += R(A[0]) * R(x[j]);
+      }
+
+      if constexpr (additive) {
+        y[i] += alpha * T(value);
+      } else {
+        y[i] = alpha * T(value);
+      }
+    }
+  } else if constexpr (std::is_same<R, T>::value) {
+    // Accumulate the rows of A scaled by alpha * x directly into y
+    if constexpr (!additive) {
+      for (int j = 0; j < N; j++) {
+        y[j] = T(0.0);
+      }
+    }
+
+    for (int i = 0; i < M; i++) {
+      const T value = alpha * x[i];
+      for (int j = 0; j < N; j++, A++) {
+        y[j] += A[0] * value;
+      }
+    }
+  } else {
+    // Accumulate the rows of A scaled by alpha * x in the wider type
+    R values[N];
+    for (int j = 0; j < N; j++) {
+      values[j] = R(0.0);
+    }
+
+    for (int i = 0; i < M; i++) {
+      const R value = alpha * x[i];
+      for (int j = 0; j < N; j++, A++) {
+        values[j] += R(A[0]) * value;
+      }
+    }
+
+    for (int j = 0; j < N; j++) {
+      if constexpr (additive) {
+        y[j] += T(values[j]);
+      } else {
+        y[j] = T(values[j]);
+      }
+    }
+  }
+}
 
-        y[i] += alpha * value;
+/*
+  Compute the matrix-vector products for K vectors stored contiguously
+
+  y_k = op(A) * x_k,   k = 0, ..., K-1
+
+  Each row of A is loaded once and applied to all K vectors
+*/
+template <typename T, int M, int N, int K, MatOp opA = MatOp::NORMAL,
+          bool additive = false>
+A2D_FUNCTION void MatMultiVecCore(const T A[], const T X[], T Y[]) noexcept {
+  using R = typename accumulate_type<T>::type;
+
+  if constexpr (opA == MatOp::NORMAL) {
+    R a[N];
+    for (int i = 0; i < M; i++) {
+      for (int j = 0; j < N; j++, A++) {
+        a[j] = R(A[0]);
       }
-    } else {
-      for (int i = 0; i < M; i++) {
-        const T value = alpha * x[i];
-        for (int j = 0; j < N; j++, A++) {
-          y[j] += A[0] * value;
+
+      for (int k = 0; k < K; k++) {
+        const T* x = &X[N * k];
+        R value = R(0.0);
+        for (int j = 0; j < N; j++) {
+          value += a[j] * R(x[j]);
+        }
+
+        if constexpr (additive) {
+          Y[M * k + i] += T(value);
+        } else {
+          Y[M * k + i] = T(value);
         }
       }
     }
   } else {
-    if constexpr (opA == MatOp::NORMAL) {
-      for (int i = 0; i < M; i++) {
-        T value = 0.0;
-        for (int j = 0; j < N; j++, A++) {
-          value += A[0] * x[j];
+    // Accumulate the rows of A scaled by each x_k
+    R values[K * N];
+    for (int j = 0; j < K * N; j++) {
+      values[j] = R(0.0);
+    }
+
+    R a[N];
+    for (int i = 0; i < M; i++) {
+      for (int j = 0; j < N; j++, A++) {
+        a[j] = R(A[0]);
+      }
+
+      for (int k = 0; k < K; k++) {
+        const R value = X[M * k + i];
+        for (int j = 0; j < N; j++) {
+          values[N * k + j] += a[j] * value;
         }
+      }
+    }
 
-        y[i] = alpha * value;
+    for (int j = 0; j < K * N; j++) {
+      if constexpr (additive) {
+        Y[j] += T(values[j]);
+      } else {
+        Y[j] = T(values[j]);
       }
-    } else {
+    }
+  }
+}
+
+/*
+  Compute the sum of the outer products of K pairs of vectors
+
+  A = sum_{k} x_k * y_k^{T}
+
+  where x_k and y_k are stored contiguously in X and Y
+*/
+template <typename T, int M, int N, int K, bool additive = false>
+A2D_FUNCTION void MultiVecOuterCore(const T X[], const T Y[], T A[]) noexcept {
+  using R = typename accumulate_type<T>::type;
+
+  R values[N];
+  for (int i = 0; i < M; i++) {
+    for (int j = 0; j < N; j++) {
+      values[j] = R(0.0);
+    }
+
+    for (int k = 0; k < K; k++) {
+      const R value = X[M * k + i];
+      const T* y = &Y[N * k];
       for (int j = 0; j < N; j++) {
-        y[j] = T(0.0);
+        values[j] += value * R(y[j]);
       }
+    }
 
-      for (int i = 0; i < M; i++) {
-        const T value = alpha * x[i];
-
-        for (int j = 0; j < N; j++, A++) {
-          y[j] += A[0] * value;
-        }
+    for (int j = 0; j < N; j++, A++) {
+      if constexpr (additive) {
+        A[0] += T(values[j]);
+      } else {
+        A[0] = T(values[j]);
       }
     }
   }
@@ -108,14 +227,16 @@ A2D_FUNCTION void MatVecCoreScale(const T alpha, const T A[], const T x[],
 
 template <typename T, int M, int N>
 A2D_FUNCTION T MatInnerCore(const T A[], const T x[], const T y[]) noexcept {
-  T value = 0.0;
+  using R = typename accumulate_type<T>::type;
+
+  R value = R(0.0);
   for (int i = 0; i < M; i++) {
-    for (int j = 0; j < N; j++) {
-      value += x[i] * A[0] * y[j];
+    for (int j = 0; j < N; j++, A++) {
+      value += R(x[i]) * R(A[0]) * R(y[j]);
     }
   }
 
-  return value;
+  return T(value);
 }
 
 template <typename T, int M, int N>
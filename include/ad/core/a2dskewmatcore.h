@@ -0,0 +1,129 @@
+#ifndef A2D_SKEWMAT_CORE_H
+#define A2D_SKEWMAT_CORE_H
+
+#include "../../a2ddefs.h"
+
+namespace A2D {
+
+/*
+  The skew-symmetric matrix S = [s]^{x} is stored as its axial vector s so
+  that the products with S reduce to cross products. Since S^{T} = -S, the
+  transpose only changes the sign of the result.
+
+  Compute C = op(S) * B where B, C are 3 x M matrices. Each column of C is the
+  cross product s x b_l which takes 6 multiplications instead of the 9 for the
+  dense matrix-vector product. The transpose negates the result and costs no
+  extra multiplications.
+*/
+template <typename T, int M, MatOp op = MatOp::NORMAL, bool additive = false>
+A2D_FUNCTION void SkewMatMatMultCore(const T s[], const T B[], T C[]) {
+  const T* b0 = &B[0];
+  const T* b1 = &B[M];
+  const T* b2 = &B[2 * M];
+  T* c0 = &C[0];
+  T* c1 = &C[M];
+  T* c2 = &C[2 * M];
+
+  for (int l = 0; l < M; l++) {
+    T v0 = s[1] * b2[l] - s[2] * b1[l];
+    T v1 = s[2] * b0[l] - s[0] * b2[l];
+    T v2 = s[0] * b1[l] - s[1] * b0[l];
+
+    if constexpr (op == MatOp::TRANSPOSE) {
+      v0 = -v0;
+      v1 = -v1;
+      v2 = -v2;
+    }
+
+    if constexpr (additive) {
+      c0[l] += v0;
+      c1[l] += v1;
+      c2[l] += v2;
+    } else {
+      c0[l] = v0;
+      c1[l] = v1;
+      c2[l] = v2;
+    }
+  }
+}
+
+/*
+  Compute C = A * op(S) where A, C are M x 3 matrices. Each row of C is
+  a_i^{T} * S = (S^{T} * a_i)^{T} = (a_i x s)^{T}.
+*/
+template <typename T, int M, MatOp op = MatOp::NORMAL, bool additive = false>
+A2D_FUNCTION void MatSkewMatMultCore(const T A[], const T s[], T C[]) {
+  for (int i = 0; i < M; i++, A += 3, C += 3) {
+    T v0 = A[1] * s[2] - A[2] * s[1];
+    T v1 = A[2] * s[0] - A[0] * s[2];
+    T v2 = A[0] * s[1] - A[1] * s[0];
+
+    if constexpr (op == MatOp::TRANSPOSE) {
+      v0 = -v0;
+      v1 = -v1;
+      v2 = -v2;
+    }
+
+    if constexpr (additive) {
+      C[0] += v0;
+      C[1] += v1;
+      C[2] += v2;
+    } else {
+      C[0] = v0;
+      C[1] = v1;
+      C[2] = v2;
+    }
+  }
+}
+
+/*
+  Compute s += sum_{l} a_l x b_l over the columns of the 3 x M matrices A and
+  B. This is the axial vector of A * B^{T} - B * A^{T} and gives the
+  derivative with respect to s of SkewMatMatMultCore. For op = TRANSPOSE the
+  sign is flipped, s -= sum_{l} a_l x b_l.
+*/
+template <typename T, int M, MatOp op = MatOp::NORMAL>
+A2D_FUNCTION void SkewMatColCrossCore(const T A[], const T B[], T s[]) {
+  const T* a0 = &A[0];
+  const T* a1 = &A[M];
+  const T* a2 = &A[2 * M];
+  const T* b0 = &B[0];
+  const T* b1 = &B[M];
+  const T* b2 = &B[2 * M];
+
+  for (int l = 0; l < M; l++) {
+    if constexpr (op == MatOp::NORMAL) {
+      s[0] += a1[l] * b2[l] - a2[l] * b1[l];
+      s[1] += a2[l] * b0[l] - a0[l] * b2[l];
+      s[2] += a0[l] * b1[l] - a1[l] * b0[l];
+    } else {
+      s[0] += a2[l] * b1[l] - a1[l] * b2[l];
+      s[1] += a0[l] * b2[l] - a2[l] * b0[l];
+      s[2] += a1[l] * b0[l] - a0[l] * b1[l];
+    }
+  }
+}
+
+/*
+  Compute s += sum_{i} a_i x b_i over the rows of the M x 3 matrices A and B.
+  This gives the derivative with respect to s of MatSkewMatMultCore. For
+  op = TRANSPOSE the sign is flipped.
+*/
+template <typename T, int M, MatOp op = MatOp::NORMAL>
+A2D_FUNCTION void SkewMatRowCrossCore(const T A[], const T B[], T s[]) {
+  for (int i = 0; i < M; i++, A += 3, B += 3) {
+    if constexpr (op == MatOp::NORMAL) {
+      s[0] += A[1] * B[2] - A[2] * B[1];
+      s[1] += A[2] * B[0] - A[0] * B[2];
+      s[2] += A[0] * B[1] - A[1] * B[0];
+    } else {
+      s[0] += A[2] * B[1] - A[1] * B[2];
+      s[1] += A[0] * B[2] - A[2] * B[0];
+      s[2] += A[1] * B[0] - A[0] * B[1];
+    }
+  }
+}
+
+}  // namespace A2D
+
+#endif  // A2D_SKEWMAT_CORE_H
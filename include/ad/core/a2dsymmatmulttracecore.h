@@ -10,20 +10,22 @@ A2D_FUNCTION T SymMatMultTraceCore(const T S[], const T E[]) {
   if constexpr (N == 1) {
     return S[0] * E[0];
   } else if constexpr (N == 2) {
-    return S[0] * E[0] + S[2] * E[2] + 2.0 * S[1] * E[1];
+    return S[0] * E[0] + S[2] * E[2] + T(2.0) * S[1] * E[1];
   } else if constexpr (N == 3) {
     return S[0] * E[0] + S[2] * E[2] + S[5] * E[5] +
-           2.0 * (S[1] * E[1] + S[3] * E[3] + S[4] * E[4]);
+           T(2.0) * (S[1] * E[1] + S[3] * E[3] + S[4] * E[4]);
   } else {
-    T trace = 0.0;
+    using R = typename accumulate_type<T>::type;
+
+    R trace = R(0.0);
     for (int i = 0; i < N; i++) {
       for (int j = 0; j < i; j++, S++, E++) {
-        trace += 2.0 * S[0] * E[0];
+        trace += R(2.0) * R(S[0]) * R(E[0]);
       }
-      trace += S[0] * E[0];
+      trace += R(S[0]) * R(E[0]);
       S++, E++;
     }
-    return trace;
+    return T(trace);
   }
 }
 
@@ -34,19 +36,19 @@ A2D_FUNCTION void SymMatMultTraceReverseCore(const T scale, const T S[],
     E[0] += scale * S[0];
   } else if constexpr (N == 2) {
     E[0] += scale * S[0];
-    E[1] += 2.0 * scale * S[1];
+    E[1] += T(2.0) * scale * S[1];
     E[2] += scale * S[2];
   } else if constexpr (N == 3) {
     E[0] += scale * S[0];
-    E[1] += 2.0 * scale * S[1];
+    E[1] += T(2.0) * scale * S[1];
     E[2] += scale * S[2];
-    E[3] += 2.0 * scale * S[3];
-    E[4] += 2.0 * scale * S[4];
+    E[3] += T(2.0) * scale * S[3];
+    E[4] += T(2.0) * scale * S[4];
     E[5] += scale * S[5];
   } else {
     for (int i = 0; i < N; i++) {
       for (int j = 0; j < i; j++, S++, E++) {
-        E[0] += 2.0 * scale * S[0];
+        E[0] += T(2.0) * scale * S[0];
       }
       E[0] += scale * S[0];
       S++, E++;
@@ -47,23 +47,19 @@ A2D_FUNCTION void SymMatVecCoreScale3x3(const T& scale, const T A[],
 */
 template <typename T, int M, bool additive = false>
 A2D_FUNCTION void SymMatVecCore(const T S[], const T x[], T y[]) noexcept {
-  if constexpr (additive) {
-    for (int i = 0; i < M; i++) {
-      T value = 0.0;
-      for (int j = 0; j < M; j++) {
-        int index = i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2;
-        value += S[index] * x[j];  // value += S[i, j] * y[j]
-      }
-      y[i] += value;
+  using R = typename accumulate_type<T>::type;
+
+  for (int i = 0; i < M; i++) {
+    R value = R(0.0);
+    for (int j = 0; j < M; j++) {
+      int index = i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2;
+      value += R(S[index]) * R(x[j]);  // value += S[i, j] * y[j]
     }
-  } else {
-    for (int i = 0; i < M; i++) {
-      T value = 0.0;
-      for (int j = 0; j < M; j++) {
-        int index = i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2;
-        value += S[index] * x[j];  // value += S[i, j] * y[j]
-      }
-      y[i] = value;
+
+    if constexpr (additive) {
+      y[i] += T(value);
+    } else {
+      y[i] = T(value);
     }
   }
 }
@@ -2,6 +2,7 @@
 #define A2D_SYMMAT_RK_CORE_H
 
 #include "../../a2ddefs.h"
+#include "../../a2ddispatch.h"
 
 namespace A2D {
 
@@ -14,21 +15,23 @@ namespace A2D {
 template <typename T, int N, int K, MatOp op = MatOp::NORMAL,
           bool additive = false>
 A2D_FUNCTION void SymMatRKCore(const T A[], T S[]) {
+  using R = typename accumulate_type<T>::type;
+
   if constexpr (op == MatOp::NORMAL) {
     for (int i = 0; i < N; i++) {
       for (int j = 0; j <= i; j++) {
         const T* a = &A[K * i];
         const T* b = &A[K * j];
 
-        T val = 0.0;
+        R val = R(0.0);
         for (int k = 0; k < K; k++) {
-          val += a[0] * b[0];
+          val += R(a[0]) * R(b[0]);
           a++, b++;
         }
         if constexpr (additive) {
-          S[0] += val;
+          S[0] += T(val);
         } else {
-          S[0] = val;
+          S[0] = T(val);
         }
         S++;
       }
@@ -39,15 +42,15 @@ A2D_FUNCTION void SymMatRKCore(const T A[], T S[]) {
         const T* a = &A[i];
         const T* b = &A[j];
 
-        T val = 0.0;
+        R val = R(0.0);
         for (int k = 0; k < N; k++) {
-          val += a[0] * b[0];
+          val += R(a[0]) * R(b[0]);
           a += K, b += K;
         }
         if constexpr (additive) {
-          S[0] += val;
+          S[0] += T(val);
         } else {
-          S[0] = val;
+          S[0] = T(val);
         }
         S++;
       }
@@ -55,6 +58,20 @@ A2D_FUNCTION void SymMatRKCore(const T A[], T S[]) {
   }
 }
 
+/*
+  SymMatRKCore that calls the dispatched core for square A of the sizes where
+  it is faster, see a2ddispatch.h
+*/
+template <typename T, int N, int K, MatOp op = MatOp::NORMAL,
+          bool additive = false>
+A2D_FUNCTION void SymMatRKDispatchCore(const T A[], T S[]) {
+  if constexpr (N == K && use_dispatch_sym_mat_rk<T, N>::value) {
+    DispatchSymMatRKCore<T, N, op, additive>(A, S);
+  } else {
+    SymMatRKCore<T, N, K, op, additive>(A, S);
+  }
+}
+
 /*
   Compute the following:
 
@@ -64,21 +81,23 @@ A2D_FUNCTION void SymMatRKCore(const T A[], T S[]) {
 template <typename T, int N, int K, MatOp op = MatOp::NORMAL,
           bool additive = false>
 A2D_FUNCTION void SymMatRKCoreScale(const T alpha, const T A[], T S[]) {
+  using R = typename accumulate_type<T>::type;
+
   if constexpr (op == MatOp::NORMAL) {
     for (int i = 0; i < N; i++) {
       for (int j = 0; j <= i; j++) {
         const T* a = &A[K * i];
         const T* b = &A[K * j];
 
-        T val = 0.0;
+        R val = R(0.0);
         for (int k = 0; k < K; k++) {
-          val += a[0] * b[0];
+          val += R(a[0]) * R(b[0]);
           a++, b++;
         }
         if constexpr (additive) {
-          S[0] += alpha * val;
+          S[0] += alpha * T(val);
         } else {
-          S[0] = alpha * val;
+          S[0] = alpha * T(val);
         }
         S++;
       }
@@ -89,15 +108,15 @@ A2D_FUNCTION void SymMatRKCoreScale(const T alpha, const T A[], T S[]) {
         const T* a = &A[i];
         const T* b = &A[j];
 
-        T val = 0.0;
+        R val = R(0.0);
         for (int k = 0; k < N; k++) {
-          val += a[0] * b[0];
+          val += R(a[0]) * R(b[0]);
           a += K, b += K;
         }
         if constexpr (additive) {
-          S[0] += alpha * val;
+          S[0] += alpha * T(val);
         } else {
-          S[0] = alpha * val;
+          S[0] = alpha * T(val);
         }
         S++;
       }
@@ -114,29 +133,31 @@ A2D_FUNCTION void SymMatRKCoreScale(const T alpha, const T A[], T S[]) {
 template <typename T, int N, int K, MatOp op = MatOp::NORMAL,
           bool additive = false>
 A2D_FUNCTION void SymMatR2KCore(const T A[], const T B[], T S[]) {
+  using R = typename accumulate_type<T>::type;
+
   if constexpr (op == MatOp::NORMAL) {
     for (int i = 0; i < N; i++) {
       for (int j = 0; j <= i; j++) {
-        T val = 0.0;
+        R val = R(0.0);
 
         const T* a = &A[K * i];
         const T* b = &B[K * j];
         for (int k = 0; k < K; k++) {
-          val += a[0] * b[0];
+          val += R(a[0]) * R(b[0]);
           a++, b++;
         }
 
         a = &A[K * j];
         b = &B[K * i];
         for (int k = 0; k < K; k++) {
-          val += a[0] * b[0];
+          val += R(a[0]) * R(b[0]);
           a++, b++;
         }
 
         if constexpr (additive) {
-          S[0] += val;
+          S[0] += T(val);
         } else {
-          S[0] = val;
+          S[0] = T(val);
         }
         S++;
       }
@@ -144,26 +165,26 @@ A2D_FUNCTION void SymMatR2KCore(const T A[], const T B[], T S[]) {
   } else {
     for (int i = 0; i < K; i++) {
       for (int j = 0; j <= i; j++) {
-        T val = 0.0;
+        R val = R(0.0);
 
         const T* a = &A[i];
         const T* b = &B[j];
         for (int k = 0; k < N; k++) {
-          val += a[0] * b[0];
+          val += R(a[0]) * R(b[0]);
           a += K, b += K;
         }
 
         a = &A[j];
         b = &B[i];
         for (int k = 0; k < N; k++) {
-          val += a[0] * b[0];
+          val += R(a[0]) * R(b[0]);
           a += K, b += K;
         }
 
         if constexpr (additive) {
-          S[0] += val;
+          S[0] += T(val);
         } else {
-          S[0] = val;
+          S[0] = T(val);
         }
         S++;
       }
@@ -181,29 +202,31 @@ template <typename T, int N, int K, MatOp op = MatOp::NORMAL,
           bool additive = false>
 A2D_FUNCTION void SymMatR2KCoreScale(const T alpha, const T A[], const T B[],
                                      T S[]) {
+  using R = typename accumulate_type<T>::type;
+
   if constexpr (op == MatOp::NORMAL) {
     for (int i = 0; i < N; i++) {
       for (int j = 0; j <= i; j++) {
-        T val = 0.0;
+        R val = R(0.0);
 
         const T* a = &A[K * i];
         const T* b = &B[K * j];
         for (int k = 0; k < K; k++) {
-          val += a[0] * b[0];
+          val += R(a[0]) * R(b[0]);
           a++, b++;
         }
 
         a = &A[K * j];
         b = &B[K * i];
         for (int k = 0; k < K; k++) {
-          val += a[0] * b[0];
+          val += R(a[0]) * R(b[0]);
           a++, b++;
         }
 
         if constexpr (additive) {
-          S[0] += alpha * val;
+          S[0] += alpha * T(val);
         } else {
-          S[0] = alpha * val;
+          S[0] = alpha * T(val);
         }
         S++;
       }
@@ -211,26 +234,26 @@ A2D_FUNCTION void SymMatR2KCoreScale(const T alpha, const T A[], const T B[],
   } else {
     for (int i = 0; i < K; i++) {
       for (int j = 0; j <= i; j++) {
-        T val = 0.0;
+        R val = R(0.0);
 
         const T* a = &A[i];
         const T* b = &B[j];
         for (int k = 0; k < N; k++) {
-          val += a[0] * b[0];
+          val += R(a[0]) * R(b[0]);
           a += K, b += K;
         }
 
         a = &A[j];
         b = &B[i];
         for (int k = 0; k < N; k++) {
-          val += a[0] * b[0];
+          val += R(a[0]) * R(b[0]);
           a += K, b += K;
         }
 
         if constexpr (additive) {
-          S[0] += alpha * val;
+          S[0] += alpha * T(val);
         } else {
-          S[0] = alpha * val;
+          S[0] = alpha * T(val);
         }
         S++;
       }
@@ -240,6 +263,8 @@ A2D_FUNCTION void SymMatR2KCoreScale(const T alpha, const T A[], const T B[],
 
 template <typename T, int N, int K, MatOp op = MatOp::NORMAL>
 A2D_FUNCTION void SymMatRKCoreReverse(const T A[], const T Sb[], T Ab[]) {
+  using R = typename accumulate_type<T>::type;
+
   if constexpr (op == MatOp::NORMAL) {
     // Ab = Sb * A
     for (int i = 0; i < N; i++) {
@@ -248,20 +273,20 @@ A2D_FUNCTION void SymMatRKCoreReverse(const T A[], const T Sb[], T Ab[]) {
         const T* s = &Sb[i * (i + 1) / 2];
         const T* a = &A[j];
 
-        T val = 0.0;
+        R val = R(0.0);
         for (; k < i; k++) {
-          val += s[0] * a[0];
+          val += R(s[0]) * R(a[0]);
           a += K, s++;
         }
 
         for (; k < N; k++) {
-          val += s[0] * a[0];
+          val += R(s[0]) * R(a[0]);
           a += K, s += k + 1;
         }
 
-        val += A[K * i + j] * Sb[i + i * (i + 1) / 2];
+        val += R(A[K * i + j]) * R(Sb[i + i * (i + 1) / 2]);
 
-        Ab[0] += val;
+        Ab[0] += T(val);
         Ab++;
       }
     }
@@ -272,20 +297,20 @@ A2D_FUNCTION void SymMatRKCoreReverse(const T A[], const T Sb[], T Ab[]) {
         const T* a = &A[K * i];
         const T* s = &Sb[j * (j + 1) / 2];
 
-        T val = 0.0;
+        R val = R(0.0);
         for (; k < j; k++) {
-          val += s[0] * a[0];
+          val += R(s[0]) * R(a[0]);
           a++, s++;
         }
 
         for (; k < K; k++) {
-          val += s[0] * a[0];
+          val += R(s[0]) * R(a[0]);
           a++, s += k + 1;
         }
 
-        val += A[K * i + j] * Sb[j + j * (j + 1) / 2];
+        val += R(A[K * i + j]) * R(Sb[j + j * (j + 1) / 2]);
 
-        Ab[0] += val;
+        Ab[0] += T(val);
         Ab++;
       }
     }
@@ -295,6 +320,8 @@ A2D_FUNCTION void SymMatRKCoreReverse(const T A[], const T Sb[], T Ab[]) {
 template <typename T, int N, int K, MatOp op = MatOp::NORMAL>
 A2D_FUNCTION void SymMatRKCoreReverseScale(const T alpha, const T A[],
                                            const T Sb[], T Ab[]) {
+  using R = typename accumulate_type<T>::type;
+
   if constexpr (op == MatOp::NORMAL) {
     // Ab = Sb * A
     for (int i = 0; i < N; i++) {
@@ -303,20 +330,20 @@ A2D_FUNCTION void SymMatRKCoreReverseScale(const T alpha, const T A[],
         const T* s = &Sb[i * (i + 1) / 2];
         const T* a = &A[j];
 
-        T val = 0.0;
+        R val = R(0.0);
         for (; k < i; k++) {
-          val += s[0] * a[0];
+          val += R(s[0]) * R(a[0]);
           a += K, s++;
         }
 
         for (; k < N; k++) {
-          val += s[0] * a[0];
+          val += R(s[0]) * R(a[0]);
           a += K, s += k + 1;
         }
 
-        val += A[K * i + j] * Sb[i + i * (i + 1) / 2];
+        val += R(A[K * i + j]) * R(Sb[i + i * (i + 1) / 2]);
 
-        Ab[0] += alpha * val;
+        Ab[0] += alpha * T(val);
         Ab++;
       }
     }
@@ -327,20 +354,20 @@ A2D_FUNCTION void SymMatRKCoreReverseScale(const T alpha, const T A[],
         const T* a = &A[K * i];
         const T* s = &Sb[j * (j + 1) / 2];
 
-        T val = 0.0;
+        R val = R(0.0);
         for (; k < j; k++) {
-          val += s[0] * a[0];
+          val += R(s[0]) * R(a[0]);
           a++, s++;
         }
 
         for (; k < K; k++) {
-          val += s[0] * a[0];
+          val += R(s[0]) * R(a[0]);
           a++, s += k + 1;
         }
 
-        val += A[K * i + j] * Sb[j + j * (j + 1) / 2];
+        val += R(A[K * i + j]) * R(Sb[j + j * (j + 1) / 2]);
 
-        Ab[0] += alpha * val;
+        Ab[0] += alpha * T(val);
         Ab++;
       }
     }
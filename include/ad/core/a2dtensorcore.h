@@ -0,0 +1,173 @@
+#ifndef A2D_TENSOR_CORE_H
+#define A2D_TENSOR_CORE_H
+
+#include "../../a2ddefs.h"
+
+namespace A2D {
+
+/*
+  Compute the number of dimensions d such that n^{d} == size, or 0 if size is
+  not a power of n with d = 1, 2 or 3
+*/
+A2D_FUNCTION constexpr int TensorDim(int n, int size) {
+  return (size == n ? 1 : (size == n * n ? 2 : (size == n * n * n ? 3 : 0)));
+}
+
+// The number of entries n^{dim} of a tensor with n entries per index
+A2D_FUNCTION constexpr int TensorSize(int n, int dim) {
+  return (dim == 1 ? n : (dim == 2 ? n * n : n * n * n));
+}
+
+// The flops of the sum-factorized product with a q x n matrix per index
+A2D_FUNCTION constexpr index_t TensorFlops(int n, int q, int dim) {
+  index_t flops = 0, size = TensorSize(n, dim);
+  for (int d = 0; d < dim; d++) {
+    flops += 2 * q * size;
+    size = (size / n) * q;
+  }
+  return flops;
+}
+
+/*
+  Apply B along the middle index of a tensor
+
+  out[l, a, r] = sum_{i} op(B)[a, i] * in[l, i, r]
+
+  where in is L x m x R and out is L x p x R. B is p x m when op == NORMAL and
+  m x p when op == TRANSPOSE. The entries of in and out are separated by sin
+  and sout so that a strided vector can be read or written directly.
+*/
+template <typename T, int L, int m, int p, int R, MatOp op, int sin = 1,
+          int sout = 1, bool additive = false>
+A2D_FUNCTION void TensorContractCore(const T B[], const T in[],
+                                     T out[]) noexcept {
+  using Racc = typename accumulate_type<T>::type;
+
+  for (int l = 0; l < L; l++) {
+    const T* x = &in[sin * m * R * l];
+    T* y = &out[sout * p * R * l];
+
+    for (int a = 0; a < p; a++) {
+      // Row a of op(B)
+      Racc b[m];
+      for (int i = 0; i < m; i++) {
+        b[i] = (op == MatOp::NORMAL ? B[m * a + i] : B[p * i + a]);
+      }
+
+      for (int r = 0; r < R; r++) {
+        Racc value = Racc(0.0);
+        for (int i = 0; i < m; i++) {
+          value += b[i] * Racc(x[sin * (R * i + r)]);
+        }
+
+        if constexpr (additive) {
+          y[sout * (R * a + r)] += T(value);
+        } else {
+          y[sout * (R * a + r)] = T(value);
+        }
+      }
+    }
+  }
+}
+
+/*
+  Apply the tensor product of the q x n 1D matrices B0, B1 and B2 to the
+  nodal values u with sum factorization
+
+  uq = (B2 x B1 x B0) u      (op == NORMAL)
+  u = (B2 x B1 x B0)^{T} uq  (op == TRANSPOSE)
+
+  The first index is the fastest so u[n * (n * k + j) + i] is node (i, j, k).
+  Only B0, ..., B(dim - 1) are used. Each direction costs O(n^{dim + 1}) for
+  n ~ q, rather than O(n^{2 dim}) for the assembled tensor product. The
+  output is written with stride sout (op == NORMAL) or the input is read with
+  stride sin (op == TRANSPOSE).
+*/
+template <typename T, int dim, int n, int q, MatOp op = MatOp::NORMAL,
+          int sin = 1, int sout = 1, bool additive = false>
+A2D_FUNCTION void TensorApplyCore(const T B0[], const T B1[], const T B2[],
+                                  const T in[], T out[]) noexcept {
+  static_assert(dim >= 1 && dim <= 3, "Tensor dimension must be 1, 2 or 3");
+
+  // Size of the input and output along each index
+  constexpr int m = (op == MatOp::NORMAL ? n : q);
+  constexpr int p = (op == MatOp::NORMAL ? q : n);
+
+  if constexpr (dim == 1) {
+    TensorContractCore<T, 1, m, p, 1, op, sin, sout, additive>(B0, in, out);
+  } else if constexpr (dim == 2) {
+    T t[m * p];
+    TensorContractCore<T, m, m, p, 1, op, sin>(B0, in, t);
+    TensorContractCore<T, 1, m, p, p, op, 1, sout, additive>(B1, t, out);
+  } else {
+    T t1[m * m * p], t2[m * p * p];
+    TensorContractCore<T, m * m, m, p, 1, op, sin>(B0, in, t1);
+    TensorContractCore<T, m, m, p, p, op>(B1, t1, t2);
+    TensorContractCore<T, 1, m, p, p * p, op, 1, sout, additive>(B2, t2, out);
+  }
+}
+
+/*
+  Apply the tensor product with the derivative matrix D along direction d
+  and the interpolation matrix N along the other directions
+*/
+template <typename T, int dim, int d, int n, int q, MatOp op = MatOp::NORMAL,
+          int sin = 1, int sout = 1, bool additive = false>
+A2D_FUNCTION void TensorApplyDerivCore(const T N[], const T D[], const T in[],
+                                       T out[]) noexcept {
+  TensorApplyCore<T, dim, n, q, op, sin, sout, additive>(
+      (d == 0 ? D : N), (d == 1 ? D : N), (d == 2 ? D : N), in, out);
+}
+
+/*
+  Apply the tensor products for all dim derivatives. The derivative along
+  direction d at point k is stored at out[ox * d + sx * k] (op == NORMAL) or
+  read from in[ox * d + sx * k] (op == TRANSPOSE).
+*/
+template <typename T, int dim, int n, int q, MatOp op = MatOp::NORMAL,
+          int sx = 1, int ox = 1, bool additive = false, int d = 0>
+A2D_FUNCTION void TensorApplyGradCore(const T N[], const T D[], const T in[],
+                                      T out[]) noexcept {
+  if constexpr (op == MatOp::NORMAL) {
+    TensorApplyDerivCore<T, dim, d, n, q, op, 1, sx, additive>(N, D, in,
+                                                               &out[ox * d]);
+  } else {
+    // The contributions from each direction are summed into out
+    TensorApplyDerivCore<T, dim, d, n, q, op, sx, 1, (additive || d > 0)>(
+        N, D, &in[ox * d], out);
+  }
+  if constexpr (d + 1 < dim) {
+    TensorApplyGradCore<T, dim, n, q, op, sx, ox, additive, d + 1>(N, D, in,
+                                                                   out);
+  }
+}
+
+/*
+  Evaluate the 1D Lagrange basis through the nodes x at the points xi
+
+  N[a, i] = prod_{j != i} (xi[a] - x[j]) / (x[i] - x[j])
+
+  and its derivative Nx[a, i] = dN[a, i] / dxi
+*/
+template <typename T, int n, int q>
+A2D_FUNCTION void LagrangeBasisCore(const T x[], const T xi[], T N[],
+                                    T Nx[]) noexcept {
+  for (int a = 0; a < q; a++) {
+    for (int i = 0; i < n; i++, N++, Nx++) {
+      T value = T(1.0), deriv = T(0.0);
+      for (int j = 0; j < n; j++) {
+        if (j != i) {
+          const T inv = T(1.0) / (x[i] - x[j]);
+          deriv = deriv * (xi[a] - x[j]) * inv + value * inv;
+          value *= (xi[a] - x[j]) * inv;
+        }
+      }
+      N[0] = value;
+      Nx[0] = deriv;
+    }
+  }
+}
+
+}  // namespace A2D
+
+#endif  // A2D_TENSOR_CORE_H
@@ -0,0 +1,284 @@
+#ifndef A2D_VEC_AGGREGATE_CORE_H
+#define A2D_VEC_AGGREGATE_CORE_H
+
+#include "../../a2ddefs.h"
+
+namespace A2D {
+
+/*
+  Streaming Kreisselmeier-Steinhauser (KS) aggregation
+
+  ks = m + log(sum_i exp(rho * (x_i - m))) / rho
+
+  where m = max_i x_i. The values are added one at a time or in blocks, and
+  the sum is rescaled whenever the running maximum increases, so the values
+  are never stored and the exponentials never overflow.
+
+  The derivative of the aggregate with respect to x_i is the weight
+
+  w_i = exp(rho * (x_i - ks))
+
+  so that a gradient can be accumulated in a second pass over the values
+  without forming the sum again. The aggregate is computed once and cached
+  for the calls to weight() until another value is added.
+*/
+template <typename T>
+class KSAggregator {
+ public:
+  A2D_FUNCTION KSAggregator(const T rho)
+      : rho(rho), m(0.0), s(0.0), empty(true), val(0.0), cached(false) {}
+
+  A2D_FUNCTION void add(const T x) {
+    cached = false;
+    if (empty) {
+      m = x;
+      s = 1.0;
+      empty = false;
+    } else if (RealPart(x) > RealPart(m)) {
+      s = s * exp(rho * (m - x)) + T(1.0);
+      m = x;
+    } else {
+      s += exp(rho * (x - m));
+    }
+  }
+
+  A2D_FUNCTION void add(const int n, const T x[]) {
+    for (int i = 0; i < n; i++) {
+      add(x[i]);
+    }
+  }
+
+  // Combine with the partial aggregate from another set of values
+  A2D_FUNCTION void add(const KSAggregator<T>& agg) {
+    cached = false;
+    if (agg.empty) {
+      return;
+    } else if (empty) {
+      m = agg.m;
+      s = agg.s;
+      empty = false;
+    } else if (RealPart(agg.m) > RealPart(m)) {
+      s = s * exp(rho * (m - agg.m)) + agg.s;
+      m = agg.m;
+    } else {
+      s += agg.s * exp(rho * (agg.m - m));
+    }
+  }
+
+  A2D_FUNCTION T value() const {
+    if (!cached) {
+      val = m + log(s) / rho;
+      cached = true;
+    }
+    return val;
+  }
+
+  A2D_FUNCTION T weight(const T x) const { return exp(rho * (x - value())); }
+
+ private:
+  T rho, m, s;
+  bool empty;
+
+  // Cached aggregate
+  mutable T val;
+  mutable bool cached;
+};
+
+/*
+  Streaming p-norm aggregation
+
+  alpha = (sum_i |x_i|^p)^(1/p) = m * (sum_i (|x_i| / m)^p)^(1/p)
+
+  where m = max_i |x_i| is used to scale the sum. The derivative with respect
+  to x_i is the weight
+
+  g_i = sign(x_i) * (|x_i| / alpha)^(p - 1)
+
+  The aggregate is cached for the calls to weight() as in KSAggregator.
+*/
+template <typename T>
+class PNormAggregator {
+ public:
+  A2D_FUNCTION PNormAggregator(const T p)
+      : p(p), m(0.0), s(0.0), val(0.0), cached(false) {}
+
+  A2D_FUNCTION void add(const T x) {
+    cached = false;
+    T a = (RealPart(x) < 0.0 ? -x : x);
+    if (RealPart(a) > RealPart(m)) {
+      if (RealPart(m) > 0.0) {
+        s = s * pow(m / a, p) + T(1.0);
+      } else {
+        s = 1.0;
+      }
+      m = a;
+    } else if (RealPart(a) > 0.0) {
+      s += pow(a / m, p);
+    }
+  }
+
+  A2D_FUNCTION void add(const int n, const T x[]) {
+    for (int i = 0; i < n; i++) {
+      add(x[i]);
+    }
+  }
+
+  // Combine with the partial aggregate from another set of values
+  A2D_FUNCTION void add(const PNormAggregator<T>& agg) {
+    cached = false;
+    if (RealPart(agg.m) > RealPart(m)) {
+      if (RealPart(m) > 0.0) {
+        s = s * pow(m / agg.m, p) + agg.s;
+      } else {
+        s = agg.s;
+      }
+      m = agg.m;
+    } else if (RealPart(agg.m) > 0.0) {
+      s += agg.s * pow(agg.m / m, p);
+    }
+  }
+
+  A2D_FUNCTION T value() const {
+    if (!cached) {
+      if (RealPart(m) == 0.0) {
+        val = T(0.0);
+      } else {
+        val = m * pow(s, T(1.0) / p);
+      }
+      cached = true;
+    }
+    return val;
+  }
+
+  A2D_FUNCTION T weight(const T x) const {
+    T alpha = value();
+    if (RealPart(alpha) == 0.0) {
+      return T(0.0);
+    }
+    if (RealPart(x) < 0.0) {
+      return -pow(-x / alpha, p - 1.0);
+    }
+    return pow(x / alpha, p - 1.0);
+  }
+
+ private:
+  T p, m, s;
+
+  // Cached aggregate
+  mutable T val;
+  mutable bool cached;
+};
+
+/*
+  Compute the KS aggregate of the N entries of x in a single pass
+*/
+template <typename T, int N>
+A2D_FUNCTION T VecKSCore(const T rho, const T x[]) {
+  KSAggregator<T> agg(rho);
+  agg.add(N, x);
+  return agg.value();
+}
+
+/*
+  Compute the KS weights w_i = exp(rho * (x_i - ks))
+*/
+template <typename T, int N>
+A2D_FUNCTION void VecKSWeightsCore(const T rho, const T ks, const T x[],
+                                   T w[]) {
+  for (int i = 0; i < N; i++) {
+    w[i] = exp(rho * (x[i] - ks));
+  }
+}
+
+/*
+  Compute the Hessian-vector product contribution of the KS aggregate
+
+  xh += ksh * w + ksb * rho * (w .* xp - w * (w^{T} xp))
+
+  where the weights w are computed from ks. The weights are computed once and
+  used for both the product and the update.
+*/
+template <typename T, int N>
+A2D_FUNCTION void VecKSHReverseCore(const T rho, const T ks, const T x[],
+                                    const T xp[], const T ksb, const T ksh,
+                                    T xh[]) {
+  T w[N];
+  VecKSWeightsCore<T, N>(rho, ks, x, w);
+
+  T wp = 0.0;
+  for (int i = 0; i < N; i++) {
+    wp += w[i] * xp[i];
+  }
+
+  for (int i = 0; i < N; i++) {
+    xh[i] += w[i] * (ksh + rho * ksb * (xp[i] - wp));
+  }
+}
+
+/*
+  Compute the p-norm aggregate of the N entries of x in a single pass
+*/
+template <typename T, int N>
+A2D_FUNCTION T VecPNormCore(const T p, const T x[]) {
+  PNormAggregator<T> agg(p);
+  agg.add(N, x);
+  return agg.value();
+}
+
+/*
+  Compute the p-norm weights g_i = sign(x_i) * (|x_i| / alpha)^(p - 1)
+
+  The weights are zero when x is zero, as in PNormAggregator::weight()
+*/
+template <typename T, int N>
+A2D_FUNCTION void VecPNormWeightsCore(const T p, const T alpha, const T x[],
+                                      T g[]) {
+  if (RealPart(alpha) == 0.0) {
+    for (int i = 0; i < N; i++) {
+      g[i] = T(0.0);
+    }
+    return;
+  }
+  for (int i = 0; i < N; i++) {
+    if (RealPart(x[i]) < 0.0) {
+      g[i] = -pow(-x[i] / alpha, p - T(1.0));
+    } else {
+      g[i] = pow(x[i] / alpha, p - T(1.0));
+    }
+  }
+}
+
+/*
+  Compute the Hessian-vector product contribution of the p-norm aggregate
+
+  xh += alphah * g + alphab * (p - 1) / alpha * (q .* xp - g * (g^{T} xp))
+
+  where q_i = (|x_i| / alpha)^(p - 2) = g_i * alpha / x_i. Nothing is added
+  when x is zero, where the weights are zero.
+*/
+template <typename T, int N>
+A2D_FUNCTION void VecPNormHReverseCore(const T p, const T alpha, const T x[],
+                                       const T xp[], const T alphab,
+                                       const T alphah, T xh[]) {
+  if (RealPart(alpha) == 0.0) {
+    return;
+  }
+
+  T g[N];
+  VecPNormWeightsCore<T, N>(p, alpha, x, g);
+
+  T gp = 0.0;
+  for (int i = 0; i < N; i++) {
+    gp += g[i] * xp[i];
+  }
+
+  T scale = alphab * (p - T(1.0)) / alpha;
+  for (int i = 0; i < N; i++) {
+    T q = (RealPart(x[i]) == 0.0 ? T(0.0) : g[i] * alpha / x[i]);
+    xh[i] += alphah * g[i] + scale * (q * xp[i] - g[i] * gp);
+  }
+}
+
+}  // namespace A2D
+
+#endif  // A2D_VEC_AGGREGATE_CORE_H
@@ -61,12 +61,14 @@ A2D_FUNCTION void VecAddCore(const T alpha, const T A[], T C[]) {
 
 template <typename T, int size>
 A2D_FUNCTION T VecDotCore(const T A[], const T B[]) {
-  T dot = 0.0;
+  using R = typename accumulate_type<T>::type;
+
+  R dot = R(0.0);
   for (int i = 0; i < size; i++) {
-    dot += A[0] * B[0];
+    dot += R(A[0]) * R(B[0]);
     A++, B++;
   }
-  return dot;
+  return T(dot);
 }
 
 template <typename T, int size>
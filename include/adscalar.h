@@ -33,55 +33,182 @@ template <typename... Types>
 using get_non_scalar_type_t = typename get_non_scalar_type<Types...>::type;
 
 template <class T, int N>
-class ADScalar {
+class ADScalar;
+
+/*
+  Base class for the lazily evaluated ADScalar expressions.
+
+  The arithmetic operators and functions on ADScalar objects return
+  lightweight expression nodes instead of new ADScalar objects. Each node
+  computes its value and the local derivative coefficients when it is
+  constructed, but the derivative array is only computed when the expression
+  is assigned to an ADScalar. At that point a single loop over the
+  derivative entries evaluates the whole expression with no intermediate
+  derivative arrays.
+
+  ADScalar operands are held by reference within the nodes, so the operands
+  must outlive any expression stored with auto.
+*/
+template <class Expr, class T, int N>
+class ADScalarExpr {
+ public:
+  A2D_FUNCTION Expr& self() { return static_cast<Expr&>(*this); }
+  A2D_FUNCTION const Expr& self() const {
+    return static_cast<const Expr&>(*this);
+  }
+};
+
+// Hold ADScalar operands by reference and expression nodes by value
+template <class A>
+struct adscalar_operand {
+  using type = const A;
+};
+
+template <class T, int N>
+struct adscalar_operand<ADScalar<T, N>> {
+  using type = const ADScalar<T, N>&;
+};
+
+/*
+  Check if R is a passive scalar with respect to expressions with numeric
+  type T and N derivatives. For the nested type ADScalar<ADScalar<T, N>, N>,
+  the inner ADScalar is a passive scalar for the outer expressions.
+*/
+template <class R, class T, int N>
+struct is_adscalar_passive {
+  static constexpr bool value =
+      (is_scalar_type<R>::value || std::is_same<R, T>::value) &&
+      !std::is_base_of<ADScalarExpr<R, T, N>, R>::value;
+};
+
+/*
+  Alignment in bytes of the derivative array in ADScalar. This should match
+  the vector register width of the target (32 for AVX2, 64 for AVX-512).
+  Setting it to sizeof(T) removes the padding.
+*/
+#ifndef A2D_ADSCALAR_ALIGN
+#define A2D_ADSCALAR_ALIGN 32
+#endif
+
+/*
+  Forward-mode AD scalar with N directional derivatives.
+
+  The derivative array is aligned to A2D_ADSCALAR_ALIGN bytes and padded to
+  NPAD >= N entries so that it fills whole vector registers. The padded
+  entries are always zero. All of the arithmetic loops run over the full
+  padded length so that they compile to aligned vector operations without a
+  remainder loop.
+*/
+template <class T, int N>
+class ADScalar : public ADScalarExpr<ADScalar<T, N>, T, N> {
  public:
   using type = T;
 
-  A2D_FUNCTION ADScalar() {}
-  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  // Length of the padded derivative array
+  static constexpr int NPAD =
+      (A2D_ADSCALAR_ALIGN % sizeof(T) == 0)
+          ? ((N * sizeof(T) + A2D_ADSCALAR_ALIGN - 1) / A2D_ADSCALAR_ALIGN) *
+                (A2D_ADSCALAR_ALIGN / sizeof(T))
+          : N;
 
-  A2D_FUNCTION ADScalar(const R value) : value(value), deriv{0.0} {}
+  A2D_FUNCTION ADScalar() {
+    for (int i = N; i < NPAD; i++) {
+      deriv[i] = 0.0;
+    }
+  }
+  template <typename R,
+            typename = std::enable_if_t<is_adscalar_passive<R, T, N>::value>>
+  A2D_FUNCTION ADScalar(const R value) : value(value) {
+    for (int i = 0; i < NPAD; i++) {
+      deriv[i] = 0.0;
+    }
+  }
 
-  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  template <typename R,
+            typename = std::enable_if_t<is_adscalar_passive<R, T, N>::value>>
   A2D_FUNCTION ADScalar(const R value, const T d[]) : value(value) {
     for (int i = 0; i < N; i++) {
       deriv[i] = d[i];
     }
+    for (int i = N; i < NPAD; i++) {
+      deriv[i] = 0.0;
+    }
   }
 
   A2D_FUNCTION ADScalar(const ADScalar<T, N> &r) : value(r.value) {
-    for (int i = 0; i < N; i++) {
+    for (int i = 0; i < NPAD; i++) {
+      deriv[i] = r.deriv[i];
+    }
+  }
+
+  // Evaluate an expression in a single loop over the derivative entries
+  template <class Expr>
+  A2D_FUNCTION ADScalar(const ADScalarExpr<Expr, T, N> &expr)
+      : value(expr.self().get_value()) {
+    const Expr &e = expr.self();
+    for (int i = 0; i < NPAD; i++) {
+      deriv[i] = e.get_deriv(i);
+    }
+  }
+
+  A2D_FUNCTION inline ADScalar<T, N> &operator=(const ADScalar<T, N> &r) {
+    value = r.value;
+    for (int i = 0; i < NPAD; i++) {
       deriv[i] = r.deriv[i];
     }
+    return *this;
   }
 
-  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  // The expression may reference this object, so only the entry i is read
+  // before deriv[i] is overwritten and the value is set last
+  template <class Expr>
+  A2D_FUNCTION inline ADScalar<T, N> &operator=(
+      const ADScalarExpr<Expr, T, N> &expr) {
+    const Expr &e = expr.self();
+    T v = e.get_value();
+    for (int i = 0; i < NPAD; i++) {
+      deriv[i] = e.get_deriv(i);
+    }
+    value = v;
+    return *this;
+  }
+
+  template <typename R,
+            typename = std::enable_if_t<is_adscalar_passive<R, T, N>::value>>
   A2D_FUNCTION inline ADScalar<T, N> &operator=(const R &r) {
     value = r;
-    for (int i = 0; i < N; i++) {
+    for (int i = 0; i < NPAD; i++) {
       deriv[i] = 0.0;
     }
     return *this;
   }
 
+  A2D_FUNCTION T get_value() const { return value; }
+  A2D_FUNCTION T get_deriv(const int i) const { return deriv[i]; }
+
   // Comparison operators
-  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  template <typename R,
+            typename = std::enable_if_t<is_adscalar_passive<R, T, N>::value>>
   A2D_FUNCTION inline bool operator<(const R &rhs) const {
     return value < rhs;
   }
-  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  template <typename R,
+            typename = std::enable_if_t<is_adscalar_passive<R, T, N>::value>>
   A2D_FUNCTION inline bool operator<=(const R &rhs) const {
     return value <= rhs;
   }
-  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  template <typename R,
+            typename = std::enable_if_t<is_adscalar_passive<R, T, N>::value>>
   A2D_FUNCTION inline bool operator>(const R &rhs) const {
     return value > rhs;
   }
-  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  template <typename R,
+            typename = std::enable_if_t<is_adscalar_passive<R, T, N>::value>>
   A2D_FUNCTION inline bool operator>=(const R &rhs) const {
     return value >= rhs;
   }
-  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  template <typename R,
+            typename = std::enable_if_t<is_adscalar_passive<R, T, N>::value>>
   A2D_FUNCTION inline bool operator!=(const R &rhs) const {
     return value != rhs;
   }
@@ -106,39 +233,75 @@ class ADScalar {
   // Operator +=, -=, *=, /=
   A2D_FUNCTION inline ADScalar<T, N> &operator+=(const ADScalar<T, N> &r) {
     value += r.value;
-    for (int i = 0; i < N; i++) {
+    for (int i = 0; i < NPAD; i++) {
       deriv[i] += r.deriv[i];
     }
     return *this;
   }
-  template <class R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  template <class Expr>
+  A2D_FUNCTION inline ADScalar<T, N> &operator+=(
+      const ADScalarExpr<Expr, T, N> &expr) {
+    const Expr &e = expr.self();
+    T v = e.get_value();
+    for (int i = 0; i < NPAD; i++) {
+      deriv[i] += e.get_deriv(i);
+    }
+    value += v;
+    return *this;
+  }
+  template <class R,
+            typename = std::enable_if_t<is_adscalar_passive<R, T, N>::value>>
   A2D_FUNCTION inline ADScalar<T, N> &operator+=(const R &r) {
     value += r;
     return *this;
   }
   A2D_FUNCTION inline ADScalar<T, N> &operator-=(const ADScalar<T, N> &r) {
     value -= r.value;
-    for (int i = 0; i < N; i++) {
+    for (int i = 0; i < NPAD; i++) {
       deriv[i] -= r.deriv[i];
     }
     return *this;
   }
-  template <class R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  template <class Expr>
+  A2D_FUNCTION inline ADScalar<T, N> &operator-=(
+      const ADScalarExpr<Expr, T, N> &expr) {
+    const Expr &e = expr.self();
+    T v = e.get_value();
+    for (int i = 0; i < NPAD; i++) {
+      deriv[i] -= e.get_deriv(i);
+    }
+    value -= v;
+    return *this;
+  }
+  template <class R,
+            typename = std::enable_if_t<is_adscalar_passive<R, T, N>::value>>
   A2D_FUNCTION inline ADScalar<T, N> &operator-=(const R &r) {
     value -= r;
     return *this;
   }
   A2D_FUNCTION inline ADScalar<T, N> &operator*=(const ADScalar<T, N> &r) {
-    for (int i = 0; i < N; i++) {
+    for (int i = 0; i < NPAD; i++) {
       deriv[i] = r.value * deriv[i] + value * r.deriv[i];
     }
     value *= r.value;
     return *this;
   }
-  template <class R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  template <class Expr>
+  A2D_FUNCTION inline ADScalar<T, N> &operator*=(
+      const ADScalarExpr<Expr, T, N> &expr) {
+    const Expr &e = expr.self();
+    T v = e.get_value();
+    for (int i = 0; i < NPAD; i++) {
+      deriv[i] = v * deriv[i] + value * e.get_deriv(i);
+    }
+    value *= v;
+    return *this;
+  }
+  template <class R,
+            typename = std::enable_if_t<is_adscalar_passive<R, T, N>::value>>
   A2D_FUNCTION inline ADScalar<T, N> &operator*=(const R &r) {
     value *= r;
-    for (int i = 0; i < N; i++) {
+    for (int i = 0; i < NPAD; i++) {
       deriv[i] = r * deriv[i];
     }
     return *this;
@@ -148,227 +311,370 @@ class ADScalar {
     T inv = 1.0 / r.value;
     T inv2 = value * inv * inv;
     value *= inv;
-    for (int i = 0; i < N; i++) {
+    for (int i = 0; i < NPAD; i++) {
       deriv[i] = inv * deriv[i] - inv2 * r.deriv[i];
     }
     return *this;
   }
-  template <class R, typename = std::enable_if_t<is_scalar_type<R>::value>>
-  A2D_FUNCTION inline ADScalar<T, N> operator/=(const R &r) {
+  template <class Expr>
+  A2D_FUNCTION inline ADScalar<T, N> &operator/=(
+      const ADScalarExpr<Expr, T, N> &expr) {
+    const Expr &e = expr.self();
+    T inv = 1.0 / e.get_value();
+    T inv2 = value * inv * inv;
+    for (int i = 0; i < NPAD; i++) {
+      deriv[i] = inv * deriv[i] - inv2 * e.get_deriv(i);
+    }
+    value *= inv;
+    return *this;
+  }
+  template <class R,
+            typename = std::enable_if_t<is_adscalar_passive<R, T, N>::value>>
+  A2D_FUNCTION inline ADScalar<T, N> &operator/=(const R &r) {
     T inv = 1.0 / r;
     value *= inv;
-    for (int i = 0; i < N; i++) {
+    for (int i = 0; i < NPAD; i++) {
       deriv[i] = inv * deriv[i];
     }
     return *this;
   }
 
-  A2D_FUNCTION inline ADScalar<T, N> operator-() const {
-    T negderivs[N];
-    for (int i = 0; i < N; i++) {
-      negderivs[i] = -deriv[i];
+  //  private:
+  T value;
+  alignas(A2D_ADSCALAR_ALIGN) T deriv[NPAD];
+};
+
+/*
+  Expression with the derivative of the operand, used for shifts a + s
+*/
+template <class A, class T, int N>
+class ADScalarShiftExpr
+    : public ADScalarExpr<ADScalarShiftExpr<A, T, N>, T, N> {
+ public:
+  A2D_FUNCTION ADScalarShiftExpr(const ADScalarExpr<A, T, N> &a0,
+                                 const T value)
+      : a(a0.self()), value(value) {}
+
+  A2D_FUNCTION T get_value() const { return value; }
+  A2D_FUNCTION T get_deriv(const int i) const { return a.get_deriv(i); }
+
+ private:
+  typename adscalar_operand<A>::type a;
+  const T value;
+};
+
+/*
+  Expression with the derivative d * da, used for the scalar multiples and
+  the elementary functions f(a) with d = f'(a)
+*/
+template <class A, class T, int N>
+class ADScalarUnaryExpr
+    : public ADScalarExpr<ADScalarUnaryExpr<A, T, N>, T, N> {
+ public:
+  A2D_FUNCTION ADScalarUnaryExpr(const ADScalarExpr<A, T, N> &a0,
+                                 const T value, const T d)
+      : a(a0.self()), value(value), d(d) {}
+
+  A2D_FUNCTION T get_value() const { return value; }
+  A2D_FUNCTION T get_deriv(const int i) const { return d * a.get_deriv(i); }
+
+ private:
+  typename adscalar_operand<A>::type a;
+  const T value, d;
+};
+
+/*
+  Expression for the sum a + b or the difference a - b
+*/
+template <class A, class B, class T, int N, bool subtract>
+class ADScalarSumExpr
+    : public ADScalarExpr<ADScalarSumExpr<A, B, T, N, subtract>, T, N> {
+ public:
+  A2D_FUNCTION ADScalarSumExpr(const ADScalarExpr<A, T, N> &a0,
+                               const ADScalarExpr<B, T, N> &b0)
+      : a(a0.self()), b(b0.self()) {
+    if constexpr (subtract) {
+      value = a.get_value() - b.get_value();
+    } else {
+      value = a.get_value() + b.get_value();
     }
-    return ADScalar<T, N>(-value,
-                          negderivs);  // Return by value, not by reference
   }
 
-  //  private:
+  A2D_FUNCTION T get_value() const { return value; }
+  A2D_FUNCTION T get_deriv(const int i) const {
+    if constexpr (subtract) {
+      return a.get_deriv(i) - b.get_deriv(i);
+    } else {
+      return a.get_deriv(i) + b.get_deriv(i);
+    }
+  }
+
+ private:
+  typename adscalar_operand<A>::type a;
+  typename adscalar_operand<B>::type b;
   T value;
-  T deriv[N];
 };
 
-// Addition
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> operator+(const ADScalar<X, M> &l,
-                                             const ADScalar<X, M> &r) {
-  ADScalar<X, M> out(l.value + r.value);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = l.deriv[i] + r.deriv[i];
+/*
+  Expression with the derivative ca * da + cb * db, used for the product and
+  the quotient
+*/
+template <class A, class B, class T, int N>
+class ADScalarBinaryExpr
+    : public ADScalarExpr<ADScalarBinaryExpr<A, B, T, N>, T, N> {
+ public:
+  A2D_FUNCTION ADScalarBinaryExpr(const ADScalarExpr<A, T, N> &a0,
+                                  const ADScalarExpr<B, T, N> &b0,
+                                  const T value, const T ca, const T cb)
+      : a(a0.self()), b(b0.self()), value(value), ca(ca), cb(cb) {}
+
+  A2D_FUNCTION T get_value() const { return value; }
+  A2D_FUNCTION T get_deriv(const int i) const {
+    return ca * a.get_deriv(i) + cb * b.get_deriv(i);
   }
-  return out;
+
+ private:
+  typename adscalar_operand<A>::type a;
+  typename adscalar_operand<B>::type b;
+  const T value, ca, cb;
+};
+
+// Negation
+template <class A, class T, int N>
+A2D_FUNCTION inline auto operator-(const ADScalarExpr<A, T, N> &a) {
+  return ADScalarUnaryExpr<A, T, N>(a, -a.self().get_value(), T(-1.0));
 }
-template <class X, int M, class L,
-          typename = std::enable_if_t<is_scalar_type<L>::value>>
-A2D_FUNCTION inline ADScalar<X, M> operator+(const L &l,
-                                             const ADScalar<X, M> &r) {
-  return ADScalar<X, M>(r.value + l, r.deriv);
+
+// Addition
+template <class A, class B, class T, int N>
+A2D_FUNCTION inline auto operator+(const ADScalarExpr<A, T, N> &a,
+                                   const ADScalarExpr<B, T, N> &b) {
+  return ADScalarSumExpr<A, B, T, N, false>(a, b);
+}
+template <class R, class A, class T, int N,
+          std::enable_if_t<is_adscalar_passive<R, T, N>::value, bool> = true>
+A2D_FUNCTION inline auto operator+(const R &r,
+                                   const ADScalarExpr<A, T, N> &a) {
+  return ADScalarShiftExpr<A, T, N>(a, r + a.self().get_value());
 }
-template <class X, int M, class R,
-          typename = std::enable_if_t<is_scalar_type<R>::value>>
-A2D_FUNCTION inline ADScalar<X, M> operator+(const ADScalar<X, M> &l,
-                                             const R &r) {
-  return ADScalar<X, M>(l.value + r, l.deriv);
+template <class A, class R, class T, int N,
+          std::enable_if_t<is_adscalar_passive<R, T, N>::value, bool> = true>
+A2D_FUNCTION inline auto operator+(const ADScalarExpr<A, T, N> &a,
+                                   const R &r) {
+  return ADScalarShiftExpr<A, T, N>(a, a.self().get_value() + r);
 }
 
 // Subtraction
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> operator-(const ADScalar<X, M> &l,
-                                             const ADScalar<X, M> &r) {
-  ADScalar<X, M> out(l.value - r.value);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = l.deriv[i] - r.deriv[i];
-  }
-  return out;
+template <class A, class B, class T, int N>
+A2D_FUNCTION inline auto operator-(const ADScalarExpr<A, T, N> &a,
+                                   const ADScalarExpr<B, T, N> &b) {
+  return ADScalarSumExpr<A, B, T, N, true>(a, b);
 }
-template <class X, int M, class L,
-          typename = std::enable_if_t<is_scalar_type<L>::value>>
-A2D_FUNCTION inline ADScalar<X, M> operator-(const L &l,
-                                             const ADScalar<X, M> &r) {
-  ADScalar<X, M> out(l - r.value);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = -r.deriv[i];
-  }
-  return out;
+template <class R, class A, class T, int N,
+          std::enable_if_t<is_adscalar_passive<R, T, N>::value, bool> = true>
+A2D_FUNCTION inline auto operator-(const R &r,
+                                   const ADScalarExpr<A, T, N> &a) {
+  return ADScalarUnaryExpr<A, T, N>(a, r - a.self().get_value(), T(-1.0));
 }
-template <class X, int M, class R,
-          typename = std::enable_if_t<is_scalar_type<R>::value>>
-A2D_FUNCTION inline ADScalar<X, M> operator-(const ADScalar<X, M> &l,
-                                             const R &r) {
-  return ADScalar<X, M>(l.value - r, l.deriv);
+template <class A, class R, class T, int N,
+          std::enable_if_t<is_adscalar_passive<R, T, N>::value, bool> = true>
+A2D_FUNCTION inline auto operator-(const ADScalarExpr<A, T, N> &a,
+                                   const R &r) {
+  return ADScalarShiftExpr<A, T, N>(a, a.self().get_value() - r);
 }
 
 // Multiplication
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> operator*(const ADScalar<X, M> &l,
-                                             const ADScalar<X, M> &r) {
-  ADScalar<X, M> out(l.value * r.value);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = r.value * l.deriv[i] + r.deriv[i] * l.value;
-  }
-  return out;
+template <class A, class B, class T, int N>
+A2D_FUNCTION inline auto operator*(const ADScalarExpr<A, T, N> &a,
+                                   const ADScalarExpr<B, T, N> &b) {
+  T av = a.self().get_value();
+  T bv = b.self().get_value();
+  return ADScalarBinaryExpr<A, B, T, N>(a, b, av * bv, bv, av);
 }
-template <class X, int M, class L,
-          typename = std::enable_if_t<is_scalar_type<L>::value>>
-A2D_FUNCTION inline ADScalar<X, M> operator*(const L &l,
-                                             const ADScalar<X, M> &r) {
-  ADScalar<X, M> out(l * r.value);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = r.deriv[i] * l;
-  }
-  return out;
+template <class R, class A, class T, int N,
+          std::enable_if_t<is_adscalar_passive<R, T, N>::value, bool> = true>
+A2D_FUNCTION inline auto operator*(const R &r,
+                                   const ADScalarExpr<A, T, N> &a) {
+  return ADScalarUnaryExpr<A, T, N>(a, r * a.self().get_value(), T(r));
 }
-template <class X, int M, class R,
-          typename = std::enable_if_t<is_scalar_type<R>::value>>
-A2D_FUNCTION inline ADScalar<X, M> operator*(const ADScalar<X, M> &l,
-                                             const R &r) {
-  ADScalar<X, M> out(l.value * r);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = l.deriv[i] * r;
-  }
-  return out;
+template <class A, class R, class T, int N,
+          std::enable_if_t<is_adscalar_passive<R, T, N>::value, bool> = true>
+A2D_FUNCTION inline auto operator*(const ADScalarExpr<A, T, N> &a,
+                                   const R &r) {
+  return ADScalarUnaryExpr<A, T, N>(a, a.self().get_value() * r, T(r));
 }
 
 // Division
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> operator/(const ADScalar<X, M> &l,
-                                             const ADScalar<X, M> &r) {
-  X inv = 1.0 / r.value;
-  X inv2 = l.value * inv * inv;
-  ADScalar<X, M> out(inv * l.value);
+template <class A, class B, class T, int N>
+A2D_FUNCTION inline auto operator/(const ADScalarExpr<A, T, N> &a,
+                                   const ADScalarExpr<B, T, N> &b) {
+  T inv = 1.0 / b.self().get_value();
+  T value = inv * a.self().get_value();
+  return ADScalarBinaryExpr<A, B, T, N>(a, b, value, inv, -value * inv);
+}
+template <class R, class A, class T, int N,
+          std::enable_if_t<is_adscalar_passive<R, T, N>::value, bool> = true>
+A2D_FUNCTION inline auto operator/(const R &r,
+                                   const ADScalarExpr<A, T, N> &a) {
+  T inv = 1.0 / a.self().get_value();
+  T value = inv * r;
+  return ADScalarUnaryExpr<A, T, N>(a, value, -value * inv);
+}
+template <class A, class R, class T, int N,
+          std::enable_if_t<is_adscalar_passive<R, T, N>::value, bool> = true>
+A2D_FUNCTION inline auto operator/(const ADScalarExpr<A, T, N> &a,
+                                   const R &r) {
+  T inv = 1.0 / r;
+  return ADScalarUnaryExpr<A, T, N>(a, inv * a.self().get_value(), inv);
+}
+
+/*
+  The math functions of the value are called unqualified. For double and
+  complex values they resolve to the scalar functions in a2ddefs.h, which are
+  device compatible, and for the nested type ADScalar<ADScalar<T, N>, N> they
+  resolve to the ADScalar overloads.
+*/
 
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = inv * l.deriv[i] - inv2 * r.deriv[i];
+// fabs, sqrt
+template <class A, class T, int N>
+A2D_FUNCTION inline auto fabs(const ADScalarExpr<A, T, N> &a) {
+  T value = a.self().get_value();
+  T scalar = 1.0;
+  if (value < 0.0) {
+    scalar = -1.0;
   }
-  return out;
+  return ADScalarUnaryExpr<A, T, N>(a, fabs(value), scalar);
 }
-template <class X, int M, class L,
-          typename = std::enable_if_t<is_scalar_type<L>::value>>
-A2D_FUNCTION inline ADScalar<X, M> operator/(const L &l,
-                                             const ADScalar<X, M> &r) {
-  X inv = 1.0 / r.value;
-  X inv2 = l * inv * inv;
-  ADScalar<X, M> out(inv * l);
 
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = -inv2 * r.deriv[i];
-  }
-  return out;
+template <class A, class T, int N>
+A2D_FUNCTION inline auto sqrt(const ADScalarExpr<A, T, N> &a) {
+  T value = sqrt(a.self().get_value());
+  return ADScalarUnaryExpr<A, T, N>(a, value, 0.5 / value);
 }
-template <class X, int M, class R,
-          typename = std::enable_if_t<is_scalar_type<R>::value>>
-A2D_FUNCTION inline ADScalar<X, M> operator/(const ADScalar<X, M> &l,
-                                             const R &r) {
-  X inv = 1.0 / r;
-  ADScalar<X, M> out(inv * l.value);
 
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = inv * l.deriv[i];
-  }
-  return out;
+template <class A, class T, int N, class R,
+          std::enable_if_t<is_adscalar_passive<R, T, N>::value, bool> = true>
+A2D_FUNCTION inline auto pow(const ADScalarExpr<A, T, N> &a,
+                             const R &exponent) {
+  T base = a.self().get_value();
+  T value = pow(base, exponent);
+  return ADScalarUnaryExpr<A, T, N>(a, value, exponent * value / base);
 }
 
-// fabs, sqrt
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> fabs(const ADScalar<X, M> &r) {
-  X scalar = 1.0;
-  if (r.value < 0.0) {
-    scalar = -1.0;
-  }
-  // device compatible fabs
-  ADScalar<X, M> out(::fabs(r.value));
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = scalar * r.deriv[i];
-  }
-  return out;
+template <class A, class T, int N>
+A2D_FUNCTION inline auto exp(const ADScalarExpr<A, T, N> &a) {
+  T value = exp(a.self().get_value());
+  return ADScalarUnaryExpr<A, T, N>(a, value, value);
 }
 
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> sqrt(const ADScalar<X, M> &r) {
-  // device compatible sqrt
-  X value = ::sqrt(r.value);
-  ADScalar<X, M> out(value);
-  X inv = 0.5 / value;
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = inv * r.deriv[i];
-  }
-  return out;
+template <class A, class T, int N>
+A2D_FUNCTION inline auto sin(const ADScalarExpr<A, T, N> &a) {
+  T value = a.self().get_value();
+  return ADScalarUnaryExpr<A, T, N>(a, sin(value), cos(value));
 }
 
-template <class X, int M, class R,
-          typename = std::enable_if_t<is_scalar_type<R>::value>>
-A2D_FUNCTION inline ADScalar<X, M> pow(const ADScalar<X, M> &r,
-                                       const R &exponent) {
-  // device compatible pow
-  X value = ::pow(r.value, exponent);
-  ADScalar<X, M> out(value);
-  X inv = exponent * value / r.value;
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = inv * r.deriv[i];
-  }
-  return out;
+template <class A, class T, int N>
+A2D_FUNCTION inline auto cos(const ADScalarExpr<A, T, N> &a) {
+  T value = a.self().get_value();
+  return ADScalarUnaryExpr<A, T, N>(a, cos(value), -sin(value));
 }
 
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> exp(const ADScalar<X, M> &r) {
-  // device compatible exp
-  X value = ::exp(r.value);
-  ADScalar<X, M> out(value);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = value * r.deriv[i];
-  }
-  return out;
+template <class A, class T, int N>
+A2D_FUNCTION inline auto log(const ADScalarExpr<A, T, N> &a) {
+  T value = a.self().get_value();
+  T inv = 1.0 / value;
+  return ADScalarUnaryExpr<A, T, N>(a, log(value), inv);
 }
 
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> sin(const ADScalar<X, M> &r) {
-  // device compatible sin, cos
-  ADScalar<X, M> out(::sin(r.value));
-  X d = ::cos(r.value);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = d * r.deriv[i];
-  }
-  return out;
+template <class A, class T, int N>
+A2D_FUNCTION inline auto asin(const ADScalarExpr<A, T, N> &a) {
+  T value = a.self().get_value();
+  T scalar = 1.0 / sqrt(1.0 - value * value);
+  return ADScalarUnaryExpr<A, T, N>(a, asin(value), scalar);
 }
 
-template <class X, int M>
-A2D_FUNCTION inline ADScalar<X, M> cos(const ADScalar<X, M> &r) {
-  // device compatible sin, cos
-  ADScalar<X, M> out(::cos(r.value));
-  X d = -::sin(r.value);
-  for (int i = 0; i < M; i++) {
-    out.deriv[i] = d * r.deriv[i];
-  }
-  return out;
+template <class A, class T, int N>
+A2D_FUNCTION inline auto acos(const ADScalarExpr<A, T, N> &a) {
+  T value = a.self().get_value();
+  T scalar = -1.0 / sqrt(1.0 - value * value);
+  return ADScalarUnaryExpr<A, T, N>(a, acos(value), scalar);
+}
+
+template <class A, class T, int N>
+A2D_FUNCTION inline auto tanh(const ADScalarExpr<A, T, N> &a) {
+  T value = tanh(a.self().get_value());
+  T scalar = 1.0 - value * value;
+  return ADScalarUnaryExpr<A, T, N>(a, value, scalar);
+}
+
+/*
+  Exact overloads for ADScalar operands. These are preferred over the scalar
+  functions in a2ddefs.h when ADScalar is registered as a numeric type.
+*/
+template <class T, int N>
+A2D_FUNCTION inline auto fabs(const ADScalar<T, N> &a) {
+  return fabs<ADScalar<T, N>, T, N>(a);
+}
+
+template <class T, int N>
+A2D_FUNCTION inline auto sqrt(const ADScalar<T, N> &a) {
+  return sqrt<ADScalar<T, N>, T, N>(a);
+}
+
+template <class T, int N, class R,
+          std::enable_if_t<is_adscalar_passive<R, T, N>::value, bool> = true>
+A2D_FUNCTION inline auto pow(const ADScalar<T, N> &a, const R &exponent) {
+  return pow<ADScalar<T, N>, T, N, R>(a, exponent);
+}
+
+template <class T, int N>
+A2D_FUNCTION inline auto exp(const ADScalar<T, N> &a) {
+  return exp<ADScalar<T, N>, T, N>(a);
+}
+
+template <class T, int N>
+A2D_FUNCTION inline auto sin(const ADScalar<T, N> &a) {
+  return sin<ADScalar<T, N>, T, N>(a);
+}
+
+template <class T, int N>
+A2D_FUNCTION inline auto cos(const ADScalar<T, N> &a) {
+  return cos<ADScalar<T, N>, T, N>(a);
+}
+
+template <class T, int N>
+A2D_FUNCTION inline auto log(const ADScalar<T, N> &a) {
+  return log<ADScalar<T, N>, T, N>(a);
+}
+
+template <class T, int N>
+A2D_FUNCTION inline auto asin(const ADScalar<T, N> &a) {
+  return asin<ADScalar<T, N>, T, N>(a);
+}
+
+template <class T, int N>
+A2D_FUNCTION inline auto acos(const ADScalar<T, N> &a) {
+  return acos<ADScalar<T, N>, T, N>(a);
+}
+
+template <class T, int N>
+A2D_FUNCTION inline auto tanh(const ADScalar<T, N> &a) {
+  return tanh<ADScalar<T, N>, T, N>(a);
+}
+
+/*
+  The real part and absolute value of the value, used for the branches and
+  convergence checks in the cores such as SymEigs. These recurse through the
+  nested type.
+*/
+template <class T, int N>
+A2D_FUNCTION inline auto RealPart(const ADScalar<T, N> &a) {
+  return RealPart(a.value);
+}
+
+template <class T, int N>
+A2D_FUNCTION inline auto absfunc(const ADScalar<T, N> &a) {
+  return absfunc(a.value);
 }
 
 // for A2D Objects
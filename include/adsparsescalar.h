@@ -0,0 +1,458 @@
+#ifndef A2D_ADSPARSE_SCALAR_H
+#define A2D_ADSPARSE_SCALAR_H
+
+#include <type_traits>
+#include <utility>
+
+#include "a2ddefs.h"
+
+namespace A2D {
+
+/*
+  A compile-time set of derivative indices. The indices must be sorted in
+  increasing order without duplicates.
+*/
+template <int... I>
+struct ADIndexSet {
+  static constexpr int size = sizeof...(I);
+
+  // Get the k-th index in the set
+  static constexpr int index(const int k) {
+    constexpr int idx[] = {I..., -1};
+    return idx[k];
+  }
+
+  // Get the position of the index within the set or -1 if it is not present
+  static constexpr int position(const int index) {
+    constexpr int idx[] = {I..., -1};
+    for (int k = 0; k < size; k++) {
+      if (idx[k] == index) {
+        return k;
+      }
+    }
+    return -1;
+  }
+
+  static constexpr bool is_sorted() {
+    constexpr int idx[] = {I..., -1};
+    for (int k = 1; k < size; k++) {
+      if (idx[k - 1] >= idx[k]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Check if all of the indices of the set S are contained in this set
+  template <class S>
+  static constexpr bool contains() {
+    for (int k = 0; k < S::size; k++) {
+      if (position(S::index(k)) < 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+/*
+  Compute the union of two index sets at compile time
+*/
+template <class A, class B>
+struct adindex_union {
+  struct Indices {
+    int size;
+    int idx[A::size + B::size + 1];
+  };
+
+  // Merge the two sorted index sets
+  static constexpr Indices merge() {
+    Indices u{0, {0}};
+    int i = 0, j = 0;
+    while (i < A::size || j < B::size) {
+      if (j >= B::size || (i < A::size && A::index(i) < B::index(j))) {
+        u.idx[u.size] = A::index(i);
+        i++;
+      } else if (i >= A::size || B::index(j) < A::index(i)) {
+        u.idx[u.size] = B::index(j);
+        j++;
+      } else {
+        u.idx[u.size] = A::index(i);
+        i++;
+        j++;
+      }
+      u.size++;
+    }
+    return u;
+  }
+
+  static constexpr Indices indices = merge();
+
+  template <std::size_t... K>
+  static ADIndexSet<indices.idx[K]...> make(std::index_sequence<K...>);
+
+  using type = decltype(make(std::make_index_sequence<indices.size>()));
+};
+
+template <class A, class B>
+using adindex_union_t = typename adindex_union<A, B>::type;
+
+/*
+  Forward-mode AD scalar that stores only the derivatives with respect to the
+  inputs in the compile-time index set Set.
+
+  The result of a binary operation stores the derivatives for the union of
+  the operand index sets. The positions of each operand's entries in the
+  result are resolved at compile time, so an entry that only one operand
+  depends on is a single scaled copy. Intermediate quantities that depend
+  on few of the inputs then cost only as many operations as they have
+  nonzero derivatives.
+*/
+template <class T, class Set>
+class ADSparseScalar {
+ public:
+  using type = T;
+  using index_set = Set;
+
+  // Number of stored derivatives
+  static constexpr int NNZ = Set::size;
+
+  static_assert(Set::is_sorted(), "Indices must be sorted and unique");
+
+  A2D_FUNCTION ADSparseScalar() {}
+
+  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  A2D_FUNCTION ADSparseScalar(const R value) : value(value) {
+    for (int i = 0; i < NNZ; i++) {
+      deriv[i] = 0.0;
+    }
+  }
+
+  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  A2D_FUNCTION ADSparseScalar(const R value, const T d[]) : value(value) {
+    for (int i = 0; i < NNZ; i++) {
+      deriv[i] = d[i];
+    }
+  }
+
+  // Convert from a scalar with fewer nonzero derivatives
+  template <class S,
+            typename = std::enable_if_t<!std::is_same<S, Set>::value>>
+  A2D_FUNCTION ADSparseScalar(const ADSparseScalar<T, S> &r) : value(r.value) {
+    static_assert(Set::template contains<S>(),
+                  "Index set must contain the input index set");
+    for (int i = 0; i < NNZ; i++) {
+      deriv[i] = 0.0;
+    }
+    for (int k = 0; k < S::size; k++) {
+      deriv[Set::position(S::index(k))] = r.deriv[k];
+    }
+  }
+
+  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  A2D_FUNCTION inline ADSparseScalar<T, Set> &operator=(const R &r) {
+    value = r;
+    for (int i = 0; i < NNZ; i++) {
+      deriv[i] = 0.0;
+    }
+    return *this;
+  }
+
+  // Get the derivative with respect to the input index
+  A2D_FUNCTION T get_deriv(const int index) const {
+    int k = Set::position(index);
+    if (k >= 0) {
+      return deriv[k];
+    }
+    return T(0.0);
+  }
+
+  // Comparison operators
+  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  A2D_FUNCTION inline bool operator<(const R &rhs) const {
+    return value < rhs;
+  }
+  template <typename R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  A2D_FUNCTION inline bool operator>(const R &rhs) const {
+    return value > rhs;
+  }
+
+  // Operator +=, -= for operands with the same or fewer indices
+  template <class S>
+  A2D_FUNCTION inline ADSparseScalar<T, Set> &operator+=(
+      const ADSparseScalar<T, S> &r) {
+    static_assert(Set::template contains<S>(),
+                  "Index set must contain the input index set");
+    value += r.value;
+    for (int k = 0; k < S::size; k++) {
+      deriv[Set::position(S::index(k))] += r.deriv[k];
+    }
+    return *this;
+  }
+  template <class S>
+  A2D_FUNCTION inline ADSparseScalar<T, Set> &operator-=(
+      const ADSparseScalar<T, S> &r) {
+    static_assert(Set::template contains<S>(),
+                  "Index set must contain the input index set");
+    value -= r.value;
+    for (int k = 0; k < S::size; k++) {
+      deriv[Set::position(S::index(k))] -= r.deriv[k];
+    }
+    return *this;
+  }
+  template <class R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  A2D_FUNCTION inline ADSparseScalar<T, Set> &operator+=(const R &r) {
+    value += r;
+    return *this;
+  }
+  template <class R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  A2D_FUNCTION inline ADSparseScalar<T, Set> &operator-=(const R &r) {
+    value -= r;
+    return *this;
+  }
+  template <class R, typename = std::enable_if_t<is_scalar_type<R>::value>>
+  A2D_FUNCTION inline ADSparseScalar<T, Set> &operator*=(const R &r) {
+    value *= r;
+    for (int i = 0; i < NNZ; i++) {
+      deriv[i] = r * deriv[i];
+    }
+    return *this;
+  }
+
+  //  private:
+  T value;
+  T deriv[NNZ > 0 ? NNZ : 1];
+};
+
+/*
+  Compute the entries of the result c = ca * a + cb * b over the union of the
+  index sets. The entries that depend on only one operand skip the other.
+*/
+template <std::size_t k, class T, class A, class B, class C>
+A2D_FUNCTION inline void ADSparseAxpbyEntry(const T ca,
+                                            const ADSparseScalar<T, A> &a,
+                                            const T cb,
+                                            const ADSparseScalar<T, B> &b,
+                                            ADSparseScalar<T, C> &c) {
+  constexpr int ia = A::position(C::index(k));
+  constexpr int ib = B::position(C::index(k));
+  if constexpr (ia >= 0 && ib >= 0) {
+    c.deriv[k] = ca * a.deriv[ia] + cb * b.deriv[ib];
+  } else if constexpr (ia >= 0) {
+    c.deriv[k] = ca * a.deriv[ia];
+  } else {
+    c.deriv[k] = cb * b.deriv[ib];
+  }
+}
+
+template <class T, class A, class B, class C, std::size_t... K>
+A2D_FUNCTION inline void ADSparseAxpbyCore(const T ca,
+                                           const ADSparseScalar<T, A> &a,
+                                           const T cb,
+                                           const ADSparseScalar<T, B> &b,
+                                           ADSparseScalar<T, C> &c,
+                                           std::index_sequence<K...>) {
+  (ADSparseAxpbyEntry<K>(ca, a, cb, b, c), ...);
+}
+
+/*
+  Compute the entries of the result c = a + b or c = a - b
+*/
+template <bool subtract, std::size_t k, class T, class A, class B, class C>
+A2D_FUNCTION inline void ADSparseSumEntry(const ADSparseScalar<T, A> &a,
+                                          const ADSparseScalar<T, B> &b,
+                                          ADSparseScalar<T, C> &c) {
+  constexpr int ia = A::position(C::index(k));
+  constexpr int ib = B::position(C::index(k));
+  if constexpr (ia >= 0 && ib >= 0) {
+    if constexpr (subtract) {
+      c.deriv[k] = a.deriv[ia] - b.deriv[ib];
+    } else {
+      c.deriv[k] = a.deriv[ia] + b.deriv[ib];
+    }
+  } else if constexpr (ia >= 0) {
+    c.deriv[k] = a.deriv[ia];
+  } else {
+    if constexpr (subtract) {
+      c.deriv[k] = -b.deriv[ib];
+    } else {
+      c.deriv[k] = b.deriv[ib];
+    }
+  }
+}
+
+template <bool subtract, class T, class A, class B, class C,
+          std::size_t... K>
+A2D_FUNCTION inline void ADSparseSumCore(const ADSparseScalar<T, A> &a,
+                                         const ADSparseScalar<T, B> &b,
+                                         ADSparseScalar<T, C> &c,
+                                         std::index_sequence<K...>) {
+  (ADSparseSumEntry<subtract, K>(a, b, c), ...);
+}
+
+// Compute c = d * a for the derivatives
+template <class T, class A>
+A2D_FUNCTION inline ADSparseScalar<T, A> ADSparseScale(
+    const T value, const T d, const ADSparseScalar<T, A> &a) {
+  ADSparseScalar<T, A> out;
+  out.value = value;
+  for (int i = 0; i < A::size; i++) {
+    out.deriv[i] = d * a.deriv[i];
+  }
+  return out;
+}
+
+// Negation
+template <class T, class A>
+A2D_FUNCTION inline ADSparseScalar<T, A> operator-(
+    const ADSparseScalar<T, A> &a) {
+  return ADSparseScale(-a.value, T(-1.0), a);
+}
+
+// Addition
+template <class T, class A, class B>
+A2D_FUNCTION inline auto operator+(const ADSparseScalar<T, A> &a,
+                                   const ADSparseScalar<T, B> &b) {
+  using C = adindex_union_t<A, B>;
+  ADSparseScalar<T, C> out;
+  out.value = a.value + b.value;
+  ADSparseSumCore<false>(a, b, out, std::make_index_sequence<C::size>());
+  return out;
+}
+template <class T, class A, class R,
+          typename = std::enable_if_t<is_scalar_type<R>::value>>
+A2D_FUNCTION inline ADSparseScalar<T, A> operator+(
+    const R &r, const ADSparseScalar<T, A> &a) {
+  ADSparseScalar<T, A> out(a);
+  out.value += r;
+  return out;
+}
+template <class T, class A, class R,
+          typename = std::enable_if_t<is_scalar_type<R>::value>>
+A2D_FUNCTION inline ADSparseScalar<T, A> operator+(
+    const ADSparseScalar<T, A> &a, const R &r) {
+  ADSparseScalar<T, A> out(a);
+  out.value += r;
+  return out;
+}
+
+// Subtraction
+template <class T, class A, class B>
+A2D_FUNCTION inline auto operator-(const ADSparseScalar<T, A> &a,
+                                   const ADSparseScalar<T, B> &b) {
+  using C = adindex_union_t<A, B>;
+  ADSparseScalar<T, C> out;
+  out.value = a.value - b.value;
+  ADSparseSumCore<true>(a, b, out, std::make_index_sequence<C::size>());
+  return out;
+}
+template <class T, class A, class R,
+          typename = std::enable_if_t<is_scalar_type<R>::value>>
+A2D_FUNCTION inline ADSparseScalar<T, A> operator-(
+    const R &r, const ADSparseScalar<T, A> &a) {
+  return ADSparseScale(r - a.value, T(-1.0), a);
+}
+template <class T, class A, class R,
+          typename = std::enable_if_t<is_scalar_type<R>::value>>
+A2D_FUNCTION inline ADSparseScalar<T, A> operator-(
+    const ADSparseScalar<T, A> &a, const R &r) {
+  ADSparseScalar<T, A> out(a);
+  out.value -= r;
+  return out;
+}
+
+// Multiplication
+template <class T, class A, class B>
+A2D_FUNCTION inline auto operator*(const ADSparseScalar<T, A> &a,
+                                   const ADSparseScalar<T, B> &b) {
+  using C = adindex_union_t<A, B>;
+  ADSparseScalar<T, C> out;
+  out.value = a.value * b.value;
+  ADSparseAxpbyCore(b.value, a, a.value, b, out,
+                    std::make_index_sequence<C::size>());
+  return out;
+}
+template <class T, class A, class R,
+          typename = std::enable_if_t<is_scalar_type<R>::value>>
+A2D_FUNCTION inline ADSparseScalar<T, A> operator*(
+    const R &r, const ADSparseScalar<T, A> &a) {
+  return ADSparseScale(r * a.value, T(r), a);
+}
+template <class T, class A, class R,
+          typename = std::enable_if_t<is_scalar_type<R>::value>>
+A2D_FUNCTION inline ADSparseScalar<T, A> operator*(
+    const ADSparseScalar<T, A> &a, const R &r) {
+  return ADSparseScale(a.value * r, T(r), a);
+}
+
+// Division
+template <class T, class A, class B>
+A2D_FUNCTION inline auto operator/(const ADSparseScalar<T, A> &a,
+                                   const ADSparseScalar<T, B> &b) {
+  using C = adindex_union_t<A, B>;
+  T inv = 1.0 / b.value;
+  ADSparseScalar<T, C> out;
+  out.value = inv * a.value;
+  ADSparseAxpbyCore(inv, a, -out.value * inv, b, out,
+                    std::make_index_sequence<C::size>());
+  return out;
+}
+template <class T, class A, class R,
+          typename = std::enable_if_t<is_scalar_type<R>::value>>
+A2D_FUNCTION inline ADSparseScalar<T, A> operator/(
+    const R &r, const ADSparseScalar<T, A> &a) {
+  T inv = 1.0 / a.value;
+  T value = inv * r;
+  return ADSparseScale(value, -value * inv, a);
+}
+template <class T, class A, class R,
+          typename = std::enable_if_t<is_scalar_type<R>::value>>
+A2D_FUNCTION inline ADSparseScalar<T, A> operator/(
+    const ADSparseScalar<T, A> &a, const R &r) {
+  T inv = 1.0 / r;
+  return ADSparseScale(inv * a.value, inv, a);
+}
+
+// fabs, sqrt
+template <class T, class A>
+A2D_FUNCTION inline ADSparseScalar<T, A> fabs(const ADSparseScalar<T, A> &a) {
+  T scalar = 1.0;
+  if (a.value < 0.0) {
+    scalar = -1.0;
+  }
+  return ADSparseScale(T(fabs(a.value)), scalar, a);
+}
+
+template <class T, class A>
+A2D_FUNCTION inline ADSparseScalar<T, A> sqrt(const ADSparseScalar<T, A> &a) {
+  T value = sqrt(a.value);
+  return ADSparseScale(value, T(0.5 / value), a);
+}
+
+template <class T, class A, class R,
+          typename = std::enable_if_t<is_scalar_type<R>::value>>
+A2D_FUNCTION inline ADSparseScalar<T, A> pow(const ADSparseScalar<T, A> &a,
+                                             const R &exponent) {
+  T value = pow(a.value, exponent);
+  return ADSparseScale(value, T(exponent * value / a.value), a);
+}
+
+template <class T, class A>
+A2D_FUNCTION inline ADSparseScalar<T, A> exp(const ADSparseScalar<T, A> &a) {
+  T value = exp(a.value);
+  return ADSparseScale(value, value, a);
+}
+
+template <class T, class A>
+A2D_FUNCTION inline ADSparseScalar<T, A> sin(const ADSparseScalar<T, A> &a) {
+  return ADSparseScale(T(sin(a.value)), T(cos(a.value)), a);
+}
+
+template <class T, class A>
+A2D_FUNCTION inline ADSparseScalar<T, A> cos(const ADSparseScalar<T, A> &a) {
+  return ADSparseScale(T(cos(a.value)), T(-sin(a.value)), a);
+}
+
+}  // namespace A2D
+
+#endif  // A2D_ADSPARSE_SCALAR_H
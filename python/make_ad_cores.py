@@ -0,0 +1,536 @@
+"""
+Generate the eval, forward, reverse and hreverse cores of fixed-size
+operations from a symbolic definition of the outputs.
+
+The expressions are stored in a hash-consed graph, so that identical
+subexpressions are the same node. The derivatives are formed symbolically on
+the graph, and any node that is used more than once by a core is computed
+once and stored in a temporary.
+
+Usage:
+
+python make_ad_cores.py [output]
+
+The default output is include/ad/core/a2dgencore.h
+"""
+
+import os
+import sys
+
+# All the nodes of the graph, keyed by their structure
+_nodes = {}
+
+
+class Node:
+    """
+    A node in the expression graph. The kind is one of:
+
+    'c': a constant with the value in data
+    'v': the entry data = (name, index) of an input array
+    '+': the sum of the nodes in args
+    '*': data times the product of the nodes in args
+    """
+
+    def __init__(self, kind, data, args, key):
+        self.kind = kind
+        self.data = data
+        self.args = args
+        self.key = key
+        self.id = len(_nodes)
+
+    def __add__(self, other):
+        return add([self, wrap(other)])
+
+    def __radd__(self, other):
+        return add([wrap(other), self])
+
+    def __sub__(self, other):
+        return add([self, mul([const(-1.0), wrap(other)])])
+
+    def __rsub__(self, other):
+        return add([wrap(other), mul([const(-1.0), self])])
+
+    def __mul__(self, other):
+        return mul([self, wrap(other)])
+
+    def __rmul__(self, other):
+        return mul([wrap(other), self])
+
+    def __neg__(self):
+        return mul([const(-1.0), self])
+
+
+def _make(kind, data, args):
+    key = (kind, data, tuple(a.id for a in args))
+    if key not in _nodes:
+        _nodes[key] = Node(kind, data, args, key)
+    return _nodes[key]
+
+
+def const(value):
+    return _make('c', float(value), ())
+
+
+def var(name, index):
+    return _make('v', (name, index), ())
+
+
+def wrap(x):
+    if isinstance(x, Node):
+        return x
+    return const(x)
+
+
+def _split(node):
+    """Split a node into a constant coefficient and the remaining term"""
+    if node.kind == 'c':
+        return node.data, None
+    elif node.kind == '*':
+        if len(node.args) == 1:
+            return node.data, node.args[0]
+        return node.data, _make('*', 1.0, node.args)
+    return 1.0, node
+
+
+def add(terms):
+    # Flatten the sums and collect the coefficients of like terms
+    coeffs = {}
+    order = []
+    value = 0.0
+    stack = list(reversed(terms))
+    while stack:
+        t = stack.pop()
+        if t.kind == '+':
+            stack.extend(reversed(t.args))
+            continue
+        c, base = _split(t)
+        if base is None:
+            value += c
+        else:
+            if base.id not in coeffs:
+                coeffs[base.id] = [0.0, base]
+                order.append(base.id)
+            coeffs[base.id][0] += c
+
+    args = []
+    for i in order:
+        c, base = coeffs[i]
+        if c != 0.0:
+            args.append(mul([const(c), base]))
+    if value != 0.0:
+        args.append(const(value))
+
+    if len(args) == 0:
+        return const(0.0)
+    elif len(args) == 1:
+        return args[0]
+    args.sort(key=lambda a: a.id)
+    return _make('+', None, tuple(args))
+
+
+def mul(factors):
+    # Flatten the products and fold the constants
+    c = 1.0
+    args = []
+    stack = list(reversed(factors))
+    while stack:
+        f = stack.pop()
+        if f.kind == 'c':
+            c *= f.data
+        elif f.kind == '*':
+            c *= f.data
+            stack.extend(reversed(f.args))
+        elif f.kind == '+':
+            # Take a coefficient shared by all the terms out of the sum so
+            # that 2 * x + 2 and x + 1 are the same factor
+            g = abs(_split(f.args[0])[0])
+            if g != 1.0 and all(abs(_split(a)[0]) == g for a in f.args):
+                c *= g
+                f = add([mul([const(1.0 / g), a]) for a in f.args])
+            args.append(f)
+        else:
+            args.append(f)
+
+    if c == 0.0:
+        return const(0.0)
+    elif len(args) == 0:
+        return const(c)
+    elif c == 1.0 and len(args) == 1:
+        return args[0]
+    args.sort(key=lambda a: a.id)
+    return _make('*', c, tuple(args))
+
+
+def diff(node, x, memo=None):
+    """
+    Differentiate the node with respect to the input entry x. The memo
+    stores the derivatives of the subexpressions and is specific to x.
+    """
+    if memo is None:
+        memo = {}
+    if node.id in memo:
+        return memo[node.id]
+
+    if node.kind == 'c':
+        d = const(0.0)
+    elif node.kind == 'v':
+        d = const(1.0 if node is x else 0.0)
+    elif node.kind == '+':
+        d = add([diff(a, x, memo) for a in node.args])
+    else:
+        terms = []
+        for i, a in enumerate(node.args):
+            da = diff(a, x, memo)
+            if da.kind == 'c' and da.data == 0.0:
+                continue
+            others = node.args[:i] + node.args[i + 1:]
+            terms.append(mul([const(node.data), da] + list(others)))
+        d = add(terms)
+
+    memo[node.id] = d
+    return d
+
+
+def dot(a, b):
+    return add([mul([x, y]) for x, y in zip(a, b)])
+
+
+def _fmt_const(value):
+    # Cast the constants to T so that float cores are not promoted to double
+    if value == int(value):
+        return 'T(%.1f)' % value
+    return 'T(%r)' % value
+
+
+class Printer:
+    """
+    Print the statements of a core, storing any node that is used more than
+    once in a temporary
+    """
+
+    def __init__(self, roots):
+        self.counts = {}
+        self.names = {}
+        self.order = []
+        visited = set()
+        for r in roots:
+            self._count(r, visited)
+        for r in roots:
+            self.counts[r.id] = self.counts.get(r.id, 0) + 1
+
+    def _count(self, node, visited):
+        if node.id in visited:
+            return
+        visited.add(node.id)
+        for a in node.args:
+            self.counts[a.id] = self.counts.get(a.id, 0) + 1
+            self._count(a, visited)
+        self.order.append(node)
+
+    def temporaries(self, roots):
+        lines = []
+        for node in self.order:
+            if (node.kind in '+*' and self.counts.get(node.id, 0) > 1 and
+                    node not in roots):
+                expr = self.expr(node)
+                name = 't%d' % len(self.names)
+                self.names[node.id] = name
+                lines.append('T %s = %s;' % (name, expr))
+        return lines
+
+    def expr(self, node, parens=False):
+        if node.id in self.names:
+            return self.names[node.id]
+        if node.kind == 'c':
+            return _fmt_const(node.data)
+        elif node.kind == 'v':
+            return '%s[%d]' % node.data
+        elif node.kind == '+':
+            s = ''
+            for i, a in enumerate(node.args):
+                c, base = _split(a)
+                if i > 0 and c < 0.0 and base is None:
+                    s += ' - ' + _fmt_const(-c)
+                elif i > 0 and c < 0.0 and a.id not in self.names:
+                    s += ' - ' + self.expr(mul([const(-c), base]))
+                elif i > 0:
+                    s += ' + ' + self.expr(a)
+                else:
+                    s += self.expr(a)
+            return '(%s)' % s if parens else s
+        else:
+            factors = [self.expr(a, parens=True) for a in node.args]
+            if node.data == -1.0:
+                factors[0] = '-' + factors[0]
+            elif node.data != 1.0:
+                factors.insert(0, _fmt_const(node.data))
+            return ' * '.join(factors)
+
+
+def _find_break(line, width, ops, depth_zero):
+    """Find the last operator in ops before width, or -1"""
+    cut = -1
+    depth = 0
+    for k, ch in enumerate(line[:width]):
+        if ch == '(':
+            depth += 1
+        elif ch == ')':
+            depth -= 1
+        elif (depth == 0 or not depth_zero) and line[k:k + 3] in ops:
+            if k + 2 <= width:
+                cut = k + 2
+    return cut
+
+
+def wrap_line(line, indent):
+    """
+    Wrap a statement after the operators to fit in 80 columns, preferring
+    the sums outside of any parentheses
+    """
+    lines = []
+    width = 80 - len(indent)
+    cont = '    '
+    while len(line) > width:
+        cut = -1
+        for ops, depth_zero in [((' + ', ' - '), True), ((' * ',), True),
+                                ((' + ', ' - '), False), ((' * ',), False)]:
+            cut = _find_break(line, width, ops, depth_zero)
+            if cut > 0:
+                break
+        if cut <= 0:
+            break
+        lines.append(line[:cut].rstrip())
+        line = line[cut:].lstrip()
+        width = 80 - len(indent) - len(cont)
+    lines.append(line)
+    return [indent + lines[0]] + [indent + cont + l for l in lines[1:]]
+
+
+def wrap_signature(func, args):
+    """Wrap the arguments of a function and align them after the paren"""
+    start = 'A2D_FUNCTION void %s(' % func
+    line = start + ', '.join(args) + ') {'
+    if len(line) <= 80:
+        return [line]
+    lines = []
+    current = start
+    for i, a in enumerate(args):
+        a += ') {' if i == len(args) - 1 else ','
+        if len(current) + len(a) + 1 > 80 and current.strip():
+            lines.append(current.rstrip())
+            current = ' ' * len(start)
+        elif current != start:
+            current += ' '
+        current += a
+    lines.append(current)
+    return lines
+
+
+def emit_body(stmts, indent):
+    """
+    Emit the statements (lhs, op, node), storing the shared subexpressions
+    in temporaries first
+    """
+    roots = [node for lhs, op, node in stmts]
+    printer = Printer(roots)
+    lines = []
+    for line in printer.temporaries(roots):
+        lines.extend(wrap_line(line, indent))
+    if lines:
+        lines.append('')
+    for lhs, op, node in stmts:
+        if op == '+=' and node.kind == 'c' and node.data == 0.0:
+            continue
+        line = '%s %s %s;' % (lhs, op, printer.expr(node))
+        lines.extend(wrap_line(line, indent))
+    return lines
+
+
+class Operation:
+    """
+    An operation with a single input array x and output array f, where the
+    outputs are given as functions of the input entries
+    """
+
+    def __init__(self, xname, nx, fname, outputs):
+        self.xname = xname
+        self.fname = fname
+        self.x = [var(xname, i) for i in range(nx)]
+        self.f = outputs(self.x)
+
+    def eval(self):
+        return [('%s[%d]' % (self.fname, k), '=', fk)
+                for k, fk in enumerate(self.f)]
+
+    def forward(self):
+        xd = [var(self.xname + 'd', i) for i in range(len(self.x))]
+        stmts = []
+        for k, fk in enumerate(self.f):
+            df = [diff(fk, xi) for xi in self.x]
+            stmts.append(('%sd[%d]' % (self.fname, k), '=', dot(df, xd)))
+        return stmts
+
+    def reverse(self):
+        fb = [var(self.fname + 'b', k) for k in range(len(self.f))]
+        L = dot(fb, self.f)
+        return [('%sb[%d]' % (self.xname, i), '+=', diff(L, xi))
+                for i, xi in enumerate(self.x)]
+
+    def hreverse(self):
+        # xh = J^{T} fh + (d/dx (fb^{T} J xp))^{T}
+        xp = [var(self.xname + 'p', i) for i in range(len(self.x))]
+        fb = [var(self.fname + 'b', k) for k in range(len(self.f))]
+        fh = [var(self.fname + 'h', k) for k in range(len(self.f))]
+        L = dot(fb, self.f)
+        Lp = dot([diff(L, xi) for xi in self.x], xp)
+        H = dot(fh, self.f)
+        return [('%sh[%d]' % (self.xname, i), '+=',
+                 add([diff(H, xi), diff(Lp, xi)]))
+                for i, xi in enumerate(self.x)]
+
+
+def mat_det(N):
+    def det(A, rows, cols):
+        if len(rows) == 1:
+            return A[N * rows[0] + cols[0]]
+        terms = []
+        for j, c in enumerate(cols):
+            sub = det(A, rows[1:], cols[:j] + cols[j + 1:])
+            sign = 1.0 if j % 2 == 0 else -1.0
+            terms.append(mul([const(sign), A[N * rows[0] + c], sub]))
+        return add(terms)
+
+    return Operation('A', N * N, 'det',
+                     lambda A: [det(A, list(range(N)), list(range(N)))])
+
+
+def nonlinear_green_strain(N):
+    # E = 0.5 * (Ux + Ux^{T} + Ux^{T} * Ux), stored in lower triangular order
+    def strain(U):
+        E = []
+        for i in range(N):
+            for j in range(i + 1):
+                terms = [U[N * i + j], U[N * j + i]]
+                terms += [mul([U[N * k + i], U[N * k + j]]) for k in range(N)]
+                E.append(mul([const(0.5), add(terms)]))
+        return E
+
+    return Operation('Ux', N * N, 'E', strain)
+
+
+def quaternion_matrix():
+    def rotation(q):
+        return [
+            1.0 - 2.0 * (q[2] * q[2] + q[3] * q[3]),
+            2.0 * (q[1] * q[2] + q[3] * q[0]),
+            2.0 * (q[1] * q[3] - q[2] * q[0]),
+            2.0 * (q[2] * q[1] - q[3] * q[0]),
+            1.0 - 2.0 * (q[1] * q[1] + q[3] * q[3]),
+            2.0 * (q[2] * q[3] + q[1] * q[0]),
+            2.0 * (q[3] * q[1] + q[2] * q[0]),
+            2.0 * (q[3] * q[2] - q[1] * q[0]),
+            1.0 - 2.0 * (q[1] * q[1] + q[2] * q[2])]
+
+    return Operation('q', 4, 'C', rotation)
+
+
+def get_core(name, sizes, make_op, kind):
+    """Emit one core for each of the sizes, selected by if constexpr"""
+    op = make_op(sizes[0]) if sizes else make_op()
+    x, f = op.xname, op.fname
+
+    if kind == 'eval':
+        suffix, args = '', ['const T %s[]' % x, 'T %s[]' % f]
+    elif kind == 'forward':
+        suffix = 'Forward'
+        args = ['const T %s[]' % x, 'const T %sd[]' % x, 'T %sd[]' % f]
+    elif kind == 'reverse':
+        suffix = 'Reverse'
+        args = ['const T %s[]' % x, 'const T %sb[]' % f, 'T %sb[]' % x]
+    else:
+        suffix = 'HReverse'
+        args = ['const T %s[]' % x, 'const T %sp[]' % x, 'const T %sb[]' % f,
+                'const T %sh[]' % f, 'T %sh[]' % x]
+
+    func = 'Gen%s%sCore' % (name, suffix)
+    lines = []
+    if sizes:
+        lines.append('template <typename T, int N>')
+    else:
+        lines.append('template <typename T>')
+    lines.extend(wrap_signature(func, args))
+
+    def body(op, indent):
+        return emit_body(getattr(op, kind)(), indent)
+
+    if sizes:
+        cond = ' || '.join('N == %d' % n for n in sizes)
+        lines.append('  static_assert(%s,' % cond)
+        lines.append('                "Generated core not available for N");')
+        lines.append('')
+        for i, n in enumerate(sizes):
+            if i == 0:
+                lines.append('  if constexpr (N == %d) {' % n)
+            elif i < len(sizes) - 1:
+                lines.append('  } else if constexpr (N == %d) {' % n)
+            else:
+                lines.append('  } else {  // N == %d' % n)
+            lines.extend(body(make_op(n), '    '))
+        lines.append('  }')
+    else:
+        lines.extend(body(op, '  '))
+    lines.append('}')
+    return '\n'.join(l.rstrip() for l in lines) + '\n'
+
+
+operations = [
+    ('MatDet', [2, 3], mat_det),
+    ('NonlinearGreenStrain', [2, 3], nonlinear_green_strain),
+    ('QuaternionMatrix', [], quaternion_matrix)]
+
+header = '''#ifndef A2D_GEN_CORE_H
+#define A2D_GEN_CORE_H
+
+#include "../../a2ddefs.h"
+
+/*
+  This file is generated by python/make_ad_cores.py. Do not edit it by hand.
+
+  Each operation Op has the cores
+
+  GenOpCore(x, y)
+  GenOpForwardCore(x, xd, yd)
+  GenOpReverseCore(x, yb, xb)
+  GenOpHReverseCore(x, xp, yb, yh, xh)
+
+  where every argument is an array, so that a scalar output such as the
+  determinant is an array of length one. The reverse and hreverse cores add
+  to their outputs. The arguments do not follow the hand-written cores, for
+  instance MatDetCore(A) returns the determinant and MatDetReverseCore(bdet,
+  A, Ab) takes the seed first. Subexpressions that are shared by the outputs
+  of a core are computed once.
+*/
+
+namespace A2D {
+'''
+
+footer = '''
+}  // namespace A2D
+
+#endif  // A2D_GEN_CORE_H
+'''
+
+if __name__ == '__main__':
+    path = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..',
+                        'include', 'ad', 'core', 'a2dgencore.h')
+    if len(sys.argv) > 1:
+        path = sys.argv[1]
+
+    s = header
+    for name, sizes, make_op in operations:
+        for kind in ['eval', 'forward', 'reverse', 'hreverse']:
+            s += '\n' + get_core(name, sizes, make_op, kind)
+    s += footer
+
+    with open(path, 'w') as fp:
+        fp.write(s)
@@ -0,0 +1,192 @@
+/*
+  Run-time selection of the instruction set for the dispatched cores
+
+  Each core is wrapped in one function per instruction set. The wrappers
+  for AVX2 and AVX-512 are compiled with the target attribute and flatten,
+  so the core is inlined and compiled for that instruction set, while the
+  out-of-line instantiations of the core keep the baseline instruction set.
+  The arguments of the wrappers are restrict, as the cores already assume,
+  which lets the compiler vectorize the inlined loops.
+*/
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#include "a2ddispatch.h"
+#include "ad/core/a2dgemmcore.h"
+#include "ad/core/a2dsymmatveccore.h"
+#include "ad/core/a2dsymrkcore.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define A2D_TARGET_SCALAR __attribute__((flatten))
+#else
+#define A2D_TARGET_SCALAR
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define A2D_DISPATCH_X86
+#define A2D_TARGET_AVX2 __attribute__((target("avx2,fma"), flatten))
+#define A2D_TARGET_AVX512 \
+  __attribute__((target("avx512f,avx512dq,avx2,fma,prefer-vector-width=512"), \
+                 flatten))
+#endif
+
+namespace A2D {
+
+KernelISA DetectKernelISA() {
+#ifdef A2D_DISPATCH_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+    return KernelISA::AVX512;
+  } else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return KernelISA::AVX2;
+  }
+#endif
+  return KernelISA::SCALAR;
+}
+
+const char* KernelISAName(KernelISA isa) {
+  if (isa == KernelISA::AVX512) {
+    return "avx512";
+  } else if (isa == KernelISA::AVX2) {
+    return "avx2";
+  }
+  return "scalar";
+}
+
+namespace {
+
+KernelISA LimitKernelISA(KernelISA isa) {
+  KernelISA detected = DetectKernelISA();
+  return (isa > detected ? detected : isa);
+}
+
+// Select the widest instruction set unless A2D_KERNEL_ISA says otherwise
+KernelISA InitKernelISA() {
+  KernelISA isa = DetectKernelISA();
+  const char* name = std::getenv("A2D_KERNEL_ISA");
+  if (name) {
+    for (KernelISA i :
+         {KernelISA::SCALAR, KernelISA::AVX2, KernelISA::AVX512}) {
+      if (std::strcmp(name, KernelISAName(i)) == 0) {
+        isa = LimitKernelISA(i);
+      }
+    }
+  }
+  return isa;
+}
+
+// Zero-initialized to SCALAR, so calls made during static initialization
+// before this is set are still safe. The dispatched cores may be called
+// from several threads while another sets the instruction set, so the
+// selection is atomic. Any of the variants gives the same result, so relaxed
+// ordering is enough.
+std::atomic<KernelISA> selected_isa(InitKernelISA());
+
+}  // namespace
+
+KernelISA GetKernelISA() {
+  return selected_isa.load(std::memory_order_relaxed);
+}
+
+KernelISA SetKernelISA(KernelISA isa) {
+  KernelISA used = LimitKernelISA(isa);
+  selected_isa.store(used, std::memory_order_relaxed);
+  return used;
+}
+
+// Define the dispatched function and its variants for each instruction set.
+// The variants are named by appending the instruction set to the function.
+#ifdef A2D_DISPATCH_X86
+#define A2D_DISPATCH_VARIANTS(TPARAMS, FUNC, PARAMS, BODY) \
+  template <TPARAMS>                                        \
+  A2D_TARGET_SCALAR void FUNC##Scalar PARAMS { BODY; }      \
+  template <TPARAMS>                                        \
+  A2D_TARGET_AVX2 void FUNC##AVX2 PARAMS { BODY; }          \
+  template <TPARAMS>                                        \
+  A2D_TARGET_AVX512 void FUNC##AVX512 PARAMS { BODY; }
+#define A2D_DISPATCH_SELECT(FUNC, TARGS, ARGS)                   \
+  KernelISA isa = selected_isa.load(std::memory_order_relaxed); \
+  if (isa == KernelISA::AVX512) {                               \
+    FUNC##AVX512<TARGS> ARGS;                                   \
+  } else if (isa == KernelISA::AVX2) {                          \
+    FUNC##AVX2<TARGS> ARGS;                                     \
+  } else {                                                      \
+    FUNC##Scalar<TARGS> ARGS;                                   \
+  }
+#else
+#define A2D_DISPATCH_VARIANTS(TPARAMS, FUNC, PARAMS, BODY) \
+  template <TPARAMS>                                        \
+  A2D_TARGET_SCALAR void FUNC##Scalar PARAMS { BODY; }
+#define A2D_DISPATCH_SELECT(FUNC, TARGS, ARGS) FUNC##Scalar<TARGS> ARGS;
+#endif
+
+// The template parameter lists contain commas, so pass them through a
+// macro argument as a single token sequence
+#define A2D_ARGS(...) __VA_ARGS__
+
+A2D_DISPATCH_VARIANTS(
+    A2D_ARGS(typename T, int N, MatOp opA, MatOp opB, bool additive),
+    MatMatMult, (const T* __restrict__ A, const T* __restrict__ B,
+                 T* __restrict__ C),
+    A2D_ARGS(MatMatMultCore<T, N, N, N, N, N, N, opA, opB, additive>(A, B, C)))
+
+A2D_DISPATCH_VARIANTS(A2D_ARGS(typename T, int N, MatOp op, bool additive),
+                      SymMatRK, (const T* __restrict__ A, T* __restrict__ S),
+                      A2D_ARGS(SymMatRKCore<T, N, N, op, additive>(A, S)))
+
+A2D_DISPATCH_VARIANTS(A2D_ARGS(typename T, int M, bool additive), SymMatVec,
+                      (const T* __restrict__ S, const T* __restrict__ x,
+                       T* __restrict__ y),
+                      A2D_ARGS(SymMatVecCore<T, M, additive>(S, x, y)))
+
+template <typename T, int N, MatOp opA, MatOp opB, bool additive>
+void DispatchMatMatMultCore(const T A[], const T B[], T C[]) {
+  A2D_DISPATCH_SELECT(MatMatMult, A2D_ARGS(T, N, opA, opB, additive),
+                      (A, B, C))
+}
+
+template <typename T, int N, MatOp op, bool additive>
+void DispatchSymMatRKCore(const T A[], T S[]) {
+  A2D_DISPATCH_SELECT(SymMatRK, A2D_ARGS(T, N, op, additive), (A, S))
+}
+
+template <typename T, int M, bool additive>
+void DispatchSymMatVecCore(const T S[], const T x[], T y[]) {
+  A2D_DISPATCH_SELECT(SymMatVec, A2D_ARGS(T, M, additive), (S, x, y))
+}
+
+// Instantiate the dispatched cores for double and the sizes 1 to 6
+#define A2D_DISPATCH_MATMATMULT(N, opA, opB)                                 \
+  template void DispatchMatMatMultCore<double, N, opA, opB, false>(          \
+      const double[], const double[], double[]);                             \
+  template void DispatchMatMatMultCore<double, N, opA, opB, true>(           \
+      const double[], const double[], double[]);
+
+#define A2D_DISPATCH_SIZE(N)                                                 \
+  A2D_DISPATCH_MATMATMULT(N, MatOp::NORMAL, MatOp::NORMAL)                   \
+  A2D_DISPATCH_MATMATMULT(N, MatOp::NORMAL, MatOp::TRANSPOSE)                \
+  A2D_DISPATCH_MATMATMULT(N, MatOp::TRANSPOSE, MatOp::NORMAL)                \
+  A2D_DISPATCH_MATMATMULT(N, MatOp::TRANSPOSE, MatOp::TRANSPOSE)             \
+  template void DispatchSymMatRKCore<double, N, MatOp::NORMAL, false>(       \
+      const double[], double[]);                                             \
+  template void DispatchSymMatRKCore<double, N, MatOp::NORMAL, true>(        \
+      const double[], double[]);                                             \
+  template void DispatchSymMatRKCore<double, N, MatOp::TRANSPOSE, false>(    \
+      const double[], double[]);                                             \
+  template void DispatchSymMatRKCore<double, N, MatOp::TRANSPOSE, true>(     \
+      const double[], double[]);                                             \
+  template void DispatchSymMatVecCore<double, N, false>(                     \
+      const double[], const double[], double[]);                             \
+  template void DispatchSymMatVecCore<double, N, true>(                      \
+      const double[], const double[], double[]);
+
+A2D_DISPATCH_SIZE(1)
+A2D_DISPATCH_SIZE(2)
+A2D_DISPATCH_SIZE(3)
+A2D_DISPATCH_SIZE(4)
+A2D_DISPATCH_SIZE(5)
+A2D_DISPATCH_SIZE(6)
+
+}  // namespace A2D
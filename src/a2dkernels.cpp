@@ -0,0 +1,7 @@
+/*
+  Compile the explicit instantiations declared in a2dkernels.h into the
+  A2D::kernels library
+*/
+
+#define A2D_KERNELS_INSTANTIATE
+#include "a2dkernels.h"
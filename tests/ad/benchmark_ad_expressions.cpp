@@ -0,0 +1,281 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "a2dcore.h"
+#include "ad/core/a2dgencore.h"
+#include "ad/core/a2dgreenstraincore.h"
+#include "ad/core/a2dmatdetcore.h"
+#include "adscalar.h"
+
+using namespace A2D;
+using namespace A2D::Test;
+
+/*
+  Time the hand-written and generated hreverse cores in ns/call
+*/
+template <class Func, typename T>
+double TimeCore(int num_reps, Func&& func, T out[]) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_reps; i++) {
+    func();
+    // Keep the results live between the calls
+    out[0] *= 0.5;
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / num_reps;
+}
+
+void WriteCoreTime(const char* name, double hand, double gen) {
+  std::cout << std::left << std::setw(36) << name << std::right << std::fixed
+            << std::setprecision(2) << std::setw(12) << hand << std::setw(12)
+            << gen << std::endl;
+}
+
+void BenchmarkGenCores(int num_reps) {
+  using T = double;
+  T A[9], Ap[9], Ah[9], Eb[6], Eh[6], q[4], qp[4], qh[4], Cb[9], Ch[9];
+  for (int i = 0; i < 9; i++) {
+    A[i] = 0.1 * (i + 1) + (i % 2 == 0 ? 1.0 : -0.5);
+    Ap[i] = -0.3 + 0.07 * i;
+    Cb[i] = 0.2 - 0.05 * i;
+    Ch[i] = -0.4 + 0.09 * i;
+    Ah[i] = 0.0;
+  }
+  for (int i = 0; i < 6; i++) {
+    Eb[i] = 0.5 - 0.1 * i;
+    Eh[i] = -0.2 + 0.15 * i;
+  }
+  for (int i = 0; i < 4; i++) {
+    q[i] = 0.5 - 0.2 * i;
+    qp[i] = 0.1 + 0.3 * i;
+    qh[i] = 0.0;
+  }
+  T bdet[1] = {1.2345}, hdet[1] = {-5.6678};
+
+  std::cout << std::left << std::setw(36) << "hreverse core (ns/call)"
+            << std::right << std::setw(12) << "hand" << std::setw(12)
+            << "generated" << std::endl;
+
+  WriteCoreTime(
+      "MatDet<3>",
+      TimeCore(
+          num_reps,
+          [&]() { MatDetHReverseCore<T, 3>(bdet[0], hdet[0], A, Ap, Ah); },
+          Ah),
+      TimeCore(
+          num_reps,
+          [&]() { GenMatDetHReverseCore<T, 3>(A, Ap, bdet, hdet, Ah); }, Ah));
+  WriteCoreTime(
+      "NonlinearGreenStrain<3>",
+      TimeCore(
+          num_reps,
+          [&]() { NonlinearGreenStrainHReverseCore<T, 3>(A, Ap, Eb, Eh, Ah); },
+          Ah),
+      TimeCore(
+          num_reps,
+          [&]() {
+            GenNonlinearGreenStrainHReverseCore<T, 3>(A, Ap, Eb, Eh, Ah);
+          },
+          Ah));
+  WriteCoreTime("QuaternionMatrix",
+                TimeCore(
+                    num_reps,
+                    [&]() {
+                      QuaternionMatrixReverseCore<T>(q, Ch, qh);
+                      QuaternionMatrixReverseCore<T>(qp, Cb, qh);
+                    },
+                    qh),
+                TimeCore(
+                    num_reps,
+                    [&]() {
+                      GenQuaternionMatrixHReverseCore<T>(q, qp, Cb, Ch, qh);
+                    },
+                    qh));
+}
+
+// Force the compiler to assume the array is read and written
+template <typename T>
+void KeepLive(T x[]) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r"(x) : "memory");
+#endif
+}
+
+/*
+  Time a forward-mode expression on ADScalar<T, N> in ns/call. NPAD is the
+  padded length of the derivative array. Define A2D_ADSCALAR_ALIGN as 8 to
+  time the unpadded layout for comparison.
+*/
+template <int N>
+void BenchmarkADScalarSize(int num_reps) {
+  using T = double;
+  T dx[N], dy[N], dz[N];
+  for (int i = 0; i < N; i++) {
+    dx[i] = 1.0 - 0.1 * i;
+    dy[i] = 0.2 + 0.05 * i;
+    dz[i] = -0.3 + 0.02 * i;
+  }
+  ADScalar<T, N> x(0.7, dx), y(1.3, dy), z(0.2, dz), f;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_reps; i++) {
+    KeepLive(&x);
+    KeepLive(&y);
+    KeepLive(&z);
+    f = sqrt(x * x + y * y) * exp(-z) + x / y;
+    KeepLive(&f);
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  std::stringstream label;
+  label << "ADScalar<" << N << ">";
+  std::cout << std::left << std::setw(24) << label.str() << std::right
+            << std::setw(12) << ADScalar<T, N>::NPAD << std::fixed
+            << std::setprecision(2) << std::setw(12)
+            << elapsed.count() / num_reps << std::endl;
+}
+
+void BenchmarkADScalar(int num_reps) {
+  std::cout << std::left << std::setw(24) << "forward (ns/call)" << std::right
+            << std::setw(12) << "NPAD" << std::setw(12) << "time"
+            << std::endl;
+  BenchmarkADScalarSize<3>(num_reps);
+  BenchmarkADScalarSize<5>(num_reps);
+  BenchmarkADScalarSize<8>(num_reps);
+}
+
+#ifdef A2D_USE_EXTERN_KERNELS
+
+/*
+  Time the inlined cores against the dispatched cores for each instruction
+  set supported by the CPU, in ns/call. The expressions call the dispatched
+  cores only at the sizes where they are faster, see a2ddispatch.h.
+*/
+template <int N>
+void BenchmarkDispatchSize(int num_reps) {
+  using T = double;
+  constexpr int S = N * (N + 1) / 2;
+  T A[N * N], B[N * N], C[N * N], Sm[S], x[N], y[N];
+  for (int i = 0; i < N * N; i++) {
+    A[i] = 0.5 + 0.1 * i;
+    B[i] = 1.0 - 0.05 * i;
+  }
+  for (int i = 0; i < S; i++) {
+    Sm[i] = 0.3 - 0.02 * i;
+  }
+  for (int i = 0; i < N; i++) {
+    x[i] = 1.0 - 0.3 * i;
+  }
+
+  auto time_call = [num_reps](auto&& func, T out[]) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_reps; i++) {
+      func();
+      KeepLive(out);
+    }
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / num_reps;
+  };
+
+  auto line = [&](const char* name, auto&& inlined, auto&& dispatched,
+                  T out[]) {
+    std::stringstream label;
+    label << name << "<" << N << ">";
+    std::cout << std::left << std::setw(24) << label.str() << std::right
+              << std::fixed << std::setprecision(2) << std::setw(12)
+              << time_call(inlined, out);
+    KernelISA selected = GetKernelISA();
+    for (KernelISA isa :
+         {KernelISA::SCALAR, KernelISA::AVX2, KernelISA::AVX512}) {
+      if (SetKernelISA(isa) == isa) {
+        std::cout << std::setw(12) << time_call(dispatched, out);
+      } else {
+        std::cout << std::setw(12) << "-";
+      }
+    }
+    SetKernelISA(selected);
+    std::cout << std::endl;
+  };
+
+  constexpr MatOp NORMAL = MatOp::NORMAL;
+  line("MatMatMult",
+       [&]() { MatMatMultCore<T, N, N, N, N, N, N, NORMAL, NORMAL>(A, B, C); },
+       [&]() { DispatchMatMatMultCore<T, N>(A, B, C); }, C);
+  line("SymMatRK", [&]() { SymMatRKCore<T, N, N>(A, Sm); },
+       [&]() { DispatchSymMatRKCore<T, N>(A, Sm); }, Sm);
+  line("SymMatVec", [&]() { SymMatVecCore<T, N>(Sm, x, y); },
+       [&]() { DispatchSymMatVecCore<T, N>(Sm, x, y); }, y);
+}
+
+void BenchmarkDispatch(int num_reps) {
+  std::cout << std::left << std::setw(24) << "dispatch (ns/call)"
+            << std::right << std::setw(12) << "inline" << std::setw(12)
+            << "scalar" << std::setw(12) << "avx2" << std::setw(12)
+            << "avx512" << std::endl;
+  BenchmarkDispatchSize<2>(num_reps);
+  BenchmarkDispatchSize<3>(num_reps);
+  BenchmarkDispatchSize<4>(num_reps);
+  BenchmarkDispatchSize<5>(num_reps);
+  BenchmarkDispatchSize<6>(num_reps);
+}
+#endif  // A2D_USE_EXTERN_KERNELS
+
+int main(int argc, char *argv[]) {
+  int num_reps = 10000;
+
+  // Check for the number of repetitions
+  for (int i = 0; i < argc; i++) {
+    std::string str(argv[i]);
+    if (str.compare("--reps") == 0 && i + 1 < argc) {
+      num_reps = std::atoi(argv[i + 1]);
+    }
+  }
+
+  using T = double;
+  const MatOp NORMAL = MatOp::NORMAL;
+  const MatOp TRANSPOSE = MatOp::TRANSPOSE;
+  const int num_warmup = num_reps / 10;
+
+  WriteBenchmarkHeader(std::cout);
+
+  MatMatMultTest<NORMAL, NORMAL, T, 3, 3, 3, 3, 3, 3> test1;
+  Benchmark(test1, num_reps, num_warmup);
+  MatMatMultTest<NORMAL, NORMAL, T, 6, 6, 6, 6, 6, 6> test2;
+  Benchmark(test2, num_reps, num_warmup);
+  MatInvTest<T, 3> test3;
+  Benchmark(test3, num_reps, num_warmup);
+  MatDetTest<T, 3> test4;
+  Benchmark(test4, num_reps, num_warmup);
+  SymMatRKTest<TRANSPOSE, T, 3, 3, 3> test5;
+  Benchmark(test5, num_reps, num_warmup);
+  VecNormTest<T, 3> test6;
+  Benchmark(test6, num_reps, num_warmup);
+  VecKSAggregateTest<T, 50> test7(50.0);
+  Benchmark(test7, num_reps, num_warmup);
+  SymIsotropicTest<T, 3> test8;
+  Benchmark(test8, num_reps, num_warmup);
+  MatGreenStrainTest<GreenStrainType::NONLINEAR, T, 3> test9;
+  Benchmark(test9, num_reps, num_warmup);
+  SymEigsTest<T, 3> test10;
+  Benchmark(test10, num_reps, num_warmup);
+
+  std::cout << std::endl;
+  BenchmarkGenCores(num_reps);
+
+  std::cout << std::endl;
+  BenchmarkADScalar(num_reps);
+
+#ifdef A2D_USE_EXTERN_KERNELS
+  std::cout << std::endl;
+  BenchmarkDispatch(num_reps);
+#endif
+
+  return 0;
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include "ad/a2dquaternion.h"
+#include "ad/core/a2dgencore.h"
+#include "ad/core/a2dgreenstraincore.h"
+#include "ad/core/a2dmatdetcore.h"
+#include "test_commons.h"
+
+using namespace A2D;
+
+/*
+  Compare the cores generated by python/make_ad_cores.py with the
+  hand-written cores
+*/
+
+template <int n>
+void fill_rand(T x[]) {
+  for (int i = 0; i < n; i++) {
+    x[i] = -1.0 + 2.0 * static_cast<T>(rand()) / RAND_MAX;
+  }
+}
+
+template <int n>
+void zero(T x[]) {
+  for (int i = 0; i < n; i++) {
+    x[i] = 0.0;
+  }
+}
+
+template <int n>
+void expect_arrays_near(const T a[], const T b[]) {
+  for (int i = 0; i < n; i++) {
+    EXPECT_NEAR(a[i], b[i], 1e-14);
+  }
+}
+
+template <int N>
+void test_mat_det_gen_core() {
+  constexpr int size = N * N;
+  T A[size], Ad[size], Ap[size];
+  fill_rand<size>(A);
+  fill_rand<size>(Ad);
+  fill_rand<size>(Ap);
+  T bdet = 1.2345, hdet = -5.6678;
+
+  T det[1], detd[1];
+  GenMatDetCore<T, N>(A, det);
+  GenMatDetForwardCore<T, N>(A, Ad, detd);
+  EXPECT_NEAR(det[0], (MatDetCore<T, N>(A)), 1e-14);
+  EXPECT_NEAR(detd[0], (MatDetForwardCore<T, N>(A, Ad)), 1e-14);
+
+  T Ab[size], Abg[size];
+  zero<size>(Ab);
+  zero<size>(Abg);
+  T detb[1] = {bdet};
+  MatDetReverseCore<T, N>(bdet, A, Ab);
+  GenMatDetReverseCore<T, N>(A, detb, Abg);
+  expect_arrays_near<size>(Ab, Abg);
+
+  T Ah[size], Ahg[size];
+  zero<size>(Ah);
+  zero<size>(Ahg);
+  T deth[1] = {hdet};
+  MatDetHReverseCore<T, N>(bdet, hdet, A, Ap, Ah);
+  GenMatDetHReverseCore<T, N>(A, Ap, detb, deth, Ahg);
+  expect_arrays_near<size>(Ah, Ahg);
+}
+
+template <int N>
+void test_green_strain_gen_core() {
+  constexpr int size = N * N;
+  constexpr int ssize = N * (N + 1) / 2;
+  T Ux[size], Ud[size], Up[size], Eb[ssize], Eh[ssize];
+  fill_rand<size>(Ux);
+  fill_rand<size>(Ud);
+  fill_rand<size>(Up);
+  fill_rand<ssize>(Eb);
+  fill_rand<ssize>(Eh);
+
+  T E[ssize], Eg[ssize];
+  NonlinearGreenStrainCore<T, N>(Ux, E);
+  GenNonlinearGreenStrainCore<T, N>(Ux, Eg);
+  expect_arrays_near<ssize>(E, Eg);
+
+  NonlinearGreenStrainForwardCore<T, N>(Ux, Ud, E);
+  GenNonlinearGreenStrainForwardCore<T, N>(Ux, Ud, Eg);
+  expect_arrays_near<ssize>(E, Eg);
+
+  T Ub[size], Ubg[size];
+  zero<size>(Ub);
+  zero<size>(Ubg);
+  NonlinearGreenStrainReverseCore<T, N>(Ux, Eb, Ub);
+  GenNonlinearGreenStrainReverseCore<T, N>(Ux, Eb, Ubg);
+  expect_arrays_near<size>(Ub, Ubg);
+
+  T Uh[size], Uhg[size];
+  zero<size>(Uh);
+  zero<size>(Uhg);
+  NonlinearGreenStrainHReverseCore<T, N>(Ux, Up, Eb, Eh, Uh);
+  GenNonlinearGreenStrainHReverseCore<T, N>(Ux, Up, Eb, Eh, Uhg);
+  expect_arrays_near<size>(Uh, Uhg);
+}
+
+void test_quaternion_matrix_gen_core() {
+  T q[4], qd[4], qp[4], Cb[9], Ch[9];
+  fill_rand<4>(q);
+  fill_rand<4>(qd);
+  fill_rand<4>(qp);
+  fill_rand<9>(Cb);
+  fill_rand<9>(Ch);
+
+  T C[9], Cg[9];
+  QuaternionMatrixCore<T>(q, C);
+  GenQuaternionMatrixCore<T>(q, Cg);
+  expect_arrays_near<9>(C, Cg);
+
+  QuaternionMatrixForwardCore<T>(q, qd, C);
+  GenQuaternionMatrixForwardCore<T>(q, qd, Cg);
+  expect_arrays_near<9>(C, Cg);
+
+  T qb[4], qbg[4];
+  zero<4>(qb);
+  zero<4>(qbg);
+  QuaternionMatrixReverseCore<T>(q, Cb, qb);
+  GenQuaternionMatrixReverseCore<T>(q, Cb, qbg);
+  expect_arrays_near<4>(qb, qbg);
+
+  // The hand-written hreverse is formed from two reverse calls
+  T qh[4], qhg[4];
+  zero<4>(qh);
+  zero<4>(qhg);
+  QuaternionMatrixReverseCore<T>(q, Ch, qh);
+  QuaternionMatrixReverseCore<T>(qp, Cb, qh);
+  GenQuaternionMatrixHReverseCore<T>(q, qp, Cb, Ch, qhg);
+  expect_arrays_near<4>(qh, qhg);
+}
+
+TEST(test_a2dgencore, MatDetGenCore) {
+  test_mat_det_gen_core<2>();
+  test_mat_det_gen_core<3>();
+}
+
+TEST(test_a2dgencore, NonlinearGreenStrainGenCore) {
+  test_green_strain_gen_core<2>();
+  test_green_strain_gen_core<3>();
+}
+
+TEST(test_a2dgencore, QuaternionMatrixGenCore) {
+  test_quaternion_matrix_gen_core();
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+#include "ad/core/a2dmatpolarcore.h"
+#include "test_commons.h"
+
+using namespace A2D;
+
+// The rotation converges to the precision of the numeric type
+template <typename T>
+void test_mat_polar_converged() {
+  const T F[9] = {1.2, 0.3, -0.1, -0.2, 0.9, 0.4, 0.1, -0.3, 1.1};
+  T R[9], U[6];
+  EXPECT_TRUE((MatPolarCore<T, 3>(F, R, U)));
+
+  // R^{T} * R = I
+  const T tol = T(100.0) * std::numeric_limits<T>::epsilon();
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      T value = 0.0;
+      for (int k = 0; k < 3; k++) {
+        value += R[3 * k + i] * R[3 * k + j];
+      }
+      EXPECT_NEAR(value, (i == j ? T(1.0) : T(0.0)), tol);
+    }
+  }
+}
+
+TEST(test_a2dmatpolarcore, converged) {
+  test_mat_polar_converged<double>();
+  test_mat_polar_converged<float>();
+}
+
+// The iteration does not converge when det(F) < 0
+TEST(test_a2dmatpolarcore, not_converged) {
+  using T = double;
+  const T F[9] = {-1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+  T R[9], U[6];
+  EXPECT_FALSE((MatPolarCore<T, 3>(F, R, U)));
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include "ad/core/a2dtensorcore.h"
+#include "test_commons.h"
+
+using namespace A2D;
+
+// Polynomial of degree n - 1 and its derivative
+template <int n>
+double poly(const double c[], double x) {
+  double value = 0.0;
+  for (int k = n - 1; k >= 0; k--) {
+    value = value * x + c[k];
+  }
+  return value;
+}
+
+template <int n>
+double poly_deriv(const double c[], double x) {
+  double value = 0.0;
+  for (int k = n - 1; k >= 1; k--) {
+    value = value * x + k * c[k];
+  }
+  return value;
+}
+
+// The basis through n nodes interpolates a polynomial of degree n - 1 and
+// its derivative exactly at the points
+template <int n, int q>
+void test_lagrange_basis() {
+  using T = double;
+  T x[n], xi[q], N[q * n], D[q * n];
+  for (int i = 0; i < n; i++) {
+    x[i] = -1.0 + 2.0 * i / (n - 1);
+  }
+  for (int a = 0; a < q; a++) {
+    xi[a] = -0.9 + 1.8 * (a + 0.25) / q;
+  }
+  LagrangeBasisCore<T, n, q>(x, xi, N, D);
+
+  const T c[] = {0.7, -1.3, 0.4, 2.1, -0.6};
+  static_assert(n <= 5, "Coefficients are given up to degree 4");
+
+  T u[n], uq[q], uxi[q];
+  for (int i = 0; i < n; i++) {
+    u[i] = poly<n>(c, x[i]);
+  }
+  TensorApplyCore<T, 1, n, q>(N, N, N, u, uq);
+  TensorApplyCore<T, 1, n, q>(D, D, D, u, uxi);
+
+  for (int a = 0; a < q; a++) {
+    EXPECT_NEAR(uq[a], poly<n>(c, xi[a]), 1e-13);
+    EXPECT_NEAR(uxi[a], poly_deriv<n>(c, xi[a]), 1e-12);
+  }
+}
+
+// The tensor product reproduces f(x, y, z) = p0(x) p1(y) p2(z) and its
+// gradient, stored column-major so that direction d is at uxi[nq * d + k]
+template <int n, int q>
+void test_tensor_grad() {
+  using T = double;
+  constexpr int dim = 3;
+  constexpr int nu = n * n * n;
+  constexpr int nq = q * q * q;
+
+  T x[n], xi[q], N[q * n], D[q * n];
+  for (int i = 0; i < n; i++) {
+    x[i] = -1.0 + 2.0 * i / (n - 1);
+  }
+  for (int a = 0; a < q; a++) {
+    xi[a] = -0.9 + 1.8 * (a + 0.25) / q;
+  }
+  LagrangeBasisCore<T, n, q>(x, xi, N, D);
+
+  const T c[dim][5] = {{0.7, -1.3, 0.4, 2.1, -0.6},
+                       {-0.2, 0.5, 1.1, -0.8, 0.3},
+                       {1.4, 0.9, -0.7, 0.2, 0.6}};
+
+  T u[nu];
+  for (int k = 0; k < n; k++) {
+    for (int j = 0; j < n; j++) {
+      for (int i = 0; i < n; i++) {
+        u[n * (n * k + j) + i] =
+            poly<n>(c[0], x[i]) * poly<n>(c[1], x[j]) * poly<n>(c[2], x[k]);
+      }
+    }
+  }
+
+  T uq[nq], uxi[dim * nq];
+  TensorApplyCore<T, dim, n, q>(N, N, N, u, uq);
+  TensorApplyGradCore<T, dim, n, q, MatOp::NORMAL, 1, nq>(N, D, u, uxi);
+
+  for (int c2 = 0; c2 < q; c2++) {
+    for (int b = 0; b < q; b++) {
+      for (int a = 0; a < q; a++) {
+        const int pt = q * (q * c2 + b) + a;
+        const T p[dim] = {poly<n>(c[0], xi[a]), poly<n>(c[1], xi[b]),
+                          poly<n>(c[2], xi[c2])};
+        const T dp[dim] = {poly_deriv<n>(c[0], xi[a]),
+                           poly_deriv<n>(c[1], xi[b]),
+                           poly_deriv<n>(c[2], xi[c2])};
+
+        EXPECT_NEAR(uq[pt], p[0] * p[1] * p[2], 1e-12);
+        EXPECT_NEAR(uxi[pt], dp[0] * p[1] * p[2], 1e-11);
+        EXPECT_NEAR(uxi[nq + pt], p[0] * dp[1] * p[2], 1e-11);
+        EXPECT_NEAR(uxi[2 * nq + pt], p[0] * p[1] * dp[2], 1e-11);
+      }
+    }
+  }
+}
+
+TEST(test_a2dtensorcore, LagrangeBasis) {
+  test_lagrange_basis<2, 3>();
+  test_lagrange_basis<3, 4>();
+  test_lagrange_basis<4, 5>();
+  test_lagrange_basis<5, 3>();
+}
+
+TEST(test_a2dtensorcore, TensorGrad) {
+  test_tensor_grad<3, 2>();
+  test_tensor_grad<4, 4>();
+}
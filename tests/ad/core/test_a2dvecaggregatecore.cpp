@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include "ad/a2dvecaggregate.h"
+#include "ad/core/a2dvecaggregatecore.h"
+#include "test_commons.h"
+
+using namespace A2D;
+
+// Values with the maximum in the second half so that merging the halves in
+// either order takes both the larger and smaller maximum branches
+constexpr int N = 12;
+constexpr int N1 = 5;
+const double x[N] = {0.3,  -1.2, 0.8, 1.1, -0.4, 2.5,
+                     -2.9, 0.6,  1.9, 0.1, -0.7, 1.4};
+
+template <class Aggregator>
+void expect_weights_near(const Aggregator& agg, const double w[]) {
+  for (int i = 0; i < N; i++) {
+    EXPECT_NEAR(agg.weight(x[i]), w[i], 1e-14);
+  }
+}
+
+TEST(test_a2dvecaggregatecore, KSAggregator) {
+  using T = double;
+  const T rho = 10.0;
+
+  T ks = VecKSCore<T, N>(rho, x);
+  T w[N];
+  VecKSWeightsCore<T, N>(rho, ks, x, w);
+
+  // Block add of the first values and single adds of the rest
+  KSAggregator<T> agg1(rho), agg2(rho), empty(rho);
+  agg1.add(N1, x);
+  for (int i = N1; i < N; i++) {
+    agg2.add(x[i]);
+  }
+
+  // Merge into an empty aggregate, then one with a larger maximum
+  KSAggregator<T> merged12(rho);
+  merged12.add(agg1);
+  merged12.add(empty);
+  merged12.add(agg2);
+  EXPECT_NEAR(merged12.value(), ks, 1e-14);
+  expect_weights_near(merged12, w);
+
+  // Merge one with a smaller maximum
+  KSAggregator<T> merged21(rho);
+  merged21.add(agg2);
+  merged21.add(agg1);
+  merged21.add(empty);
+  EXPECT_NEAR(merged21.value(), ks, 1e-14);
+  expect_weights_near(merged21, w);
+
+  // Adding a value after the weights updates the cached aggregate
+  T y[N + 1];
+  for (int i = 0; i < N; i++) {
+    y[i] = x[i];
+  }
+  y[N] = 3.2;
+  agg1.add(N - N1, &x[N1]);
+  EXPECT_NEAR(agg1.value(), ks, 1e-14);
+  agg1.add(y[N]);
+  EXPECT_NEAR(agg1.value(), (VecKSCore<T, N + 1>(rho, y)), 1e-14);
+}
+
+TEST(test_a2dvecaggregatecore, PNormAggregator) {
+  using T = double;
+  const T p = 6.0;
+
+  T alpha = VecPNormCore<T, N>(p, x);
+  T g[N];
+  VecPNormWeightsCore<T, N>(p, alpha, x, g);
+
+  // Block add of the first values and single adds of the rest
+  PNormAggregator<T> agg1(p), agg2(p), empty(p);
+  agg1.add(N1, x);
+  for (int i = N1; i < N; i++) {
+    agg2.add(x[i]);
+  }
+  EXPECT_EQ(empty.value(), 0.0);
+  EXPECT_EQ(empty.weight(x[0]), 0.0);
+
+  // Merge into an empty aggregate, then one with a larger maximum
+  PNormAggregator<T> merged12(p);
+  merged12.add(agg1);
+  merged12.add(empty);
+  merged12.add(agg2);
+  EXPECT_NEAR(merged12.value(), alpha, 1e-14);
+  expect_weights_near(merged12, g);
+
+  // Merge one with a smaller maximum
+  PNormAggregator<T> merged21(p);
+  merged21.add(agg2);
+  merged21.add(agg1);
+  merged21.add(empty);
+  EXPECT_NEAR(merged21.value(), alpha, 1e-14);
+  expect_weights_near(merged21, g);
+
+  // Adding a value after the weights updates the cached aggregate
+  T y[N + 1];
+  for (int i = 0; i < N; i++) {
+    y[i] = x[i];
+  }
+  y[N] = -3.2;
+  agg1.add(N - N1, &x[N1]);
+  EXPECT_NEAR(agg1.value(), alpha, 1e-14);
+  agg1.add(y[N]);
+  EXPECT_NEAR(agg1.value(), (VecPNormCore<T, N + 1>(p, y)), 1e-14);
+}
+
+TEST(test_a2dvecaggregatecore, PNormZeroVector) {
+  using T = double;
+  const T p = 6.0;
+  const T z[3] = {0.0, 0.0, 0.0}, zp[3] = {0.5, -1.0, 2.0};
+
+  T alpha = VecPNormCore<T, 3>(p, z);
+  EXPECT_EQ(alpha, 0.0);
+
+  // The weights are zero, as from the streaming aggregate
+  T g[3], zh[3] = {0.0, 0.0, 0.0};
+  VecPNormWeightsCore<T, 3>(p, alpha, z, g);
+  VecPNormHReverseCore<T, 3>(p, alpha, z, zp, 1.0, 1.0, zh);
+  PNormAggregator<T> agg(p);
+  agg.add(3, z);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(g[i], 0.0);
+    EXPECT_EQ(zh[i], 0.0);
+    EXPECT_EQ(agg.weight(z[i]), 0.0);
+  }
+
+  ADObj<Vec<T, 3>> x;
+  ADObj<T> a;
+  auto stack = MakeStack(VecPNormAggregate(p, x, a));
+  a.bvalue() = 1.0;
+  stack.reverse();
+  EXPECT_EQ(a.value(), 0.0);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(x.bvalue()[i], 0.0);
+  }
+}
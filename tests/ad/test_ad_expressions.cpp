@@ -1,3 +1,4 @@
+#include <cstdlib>
 #include <functional>
 #include <vector>
 
@@ -102,7 +103,7 @@ class MooneyRivlin
   std::string name() { return std::string("MooneyRivlin"); }
 
   void get_point(Input &x) {
-    x.set_rand();
+    x.set_rand(this->get_rng("point"));
     for (int i = 0; i < 9; i++) {
       x[i] *= 0.05;
     }
@@ -128,18 +129,18 @@ class MooneyRivlin
 
     const T C1(0.1), C2(0.23);
 
-    MatInv(J, Jinv);                // Jinv = J^{-1}
-    MatMatMult(Uxi, Jinv, Ux);      // Ux = Uxi * Jinv
-    MatSum(Id, Ux, F);              // F = I + Ux
-    MatDet(F, detF);                // detF = det(F)
-    SymMatRK(F, B);                 // B = F * F^{T}
-    MatTrace(B, trB);               // trB = tr(B)
-    SymMatMultTrace(B, B, trB2);    // trB2 = tr(B * B)
-    inv = pow(detF, -2.0 / 3.0);    // inv = detF^{-2/3}
-    I2 = 0.5 * (trB * trB - trB2);  // I2 = 0.5 * (trB * trB - tr(B * B))
-    I1bar = inv * trB;              // I1bar = inv * I1 = inv * tr(B)
-    I2bar = inv * inv * I2;         // I2bar = inv^2 * I2
-    W = C1 * (I1bar - 3.0) + C2 * (I2bar - 3.0);
+    MatInv(J, Jinv);                   // Jinv = J^{-1}
+    MatMatMult(Uxi, Jinv, Ux);         // Ux = Uxi * Jinv
+    MatSum(Id, Ux, F);                 // F = I + Ux
+    MatDet(F, detF);                   // detF = det(F)
+    SymMatRK(F, B);                    // B = F * F^{T}
+    MatTrace(B, trB);                  // trB = tr(B)
+    SymMatMultTrace(B, B, trB2);       // trB2 = tr(B * B)
+    inv = pow(detF, -2.0 / 3.0);       // inv = detF^{-2/3}
+    I2 = T(0.5) * (trB * trB - trB2);  // I2 = 0.5 * (trB * trB - tr(B * B))
+    I1bar = inv * trB;                 // I1bar = inv * I1 = inv * tr(B)
+    I2bar = inv * inv * I2;            // I2bar = inv^2 * I2
+    W = C1 * (I1bar - T(3.0)) + C2 * (I2bar - T(3.0));
 
     return MakeVarTuple<T>(W);
   }
@@ -450,8 +451,8 @@ class VonMisesPenaltyTest : public A2D::Test::A2DTest<T, T, T, Mat<T, 3, 3>> {
   // Evaluate the function
   Output eval(const Input &x) {
     // Set constants
-    double q = 5.0;
-    double design_stress = 135.0;
+    T q = 5.0;
+    T design_stress = 135.0;
     T mu = 3.374, lambda = 9.173;
 
     // Get the variables
@@ -470,8 +471,8 @@ class VonMisesPenaltyTest : public A2D::Test::A2DTest<T, T, T, Mat<T, 3, 3>> {
     // Compute the von Mises stress = sqrt(1.5 * tr(S * S) - 0.5 * tr(S)**2)
     MatTrace(S, trS);
     SymMatMultTrace(S, S, trSS);
-    T vm = sqrt(1.5 * trSS - 0.5 * trS * trS);
-    T relaxed_stress = (vm * ((q + 1.0) / (q * rho + 1.0)));
+    T vm = sqrt(T(1.5) * trSS - T(0.5) * trS * trS);
+    T relaxed_stress = (vm * ((q + T(1.0)) / (q * rho + T(1.0))));
     T failure_index = relaxed_stress / design_stress;
 
     return MakeVarTuple<T>(failure_index);
@@ -617,27 +618,125 @@ class DiamondGraphTest : public A2D::Test::A2DTest<T, T, Mat<T, N, N>> {
   }
 };
 
+/*
+  Test the checkpointed stack on the strain energy computation. The symmetric
+  matrix W holds E1 in the second segment and S in the third segment.
+*/
+template <typename T, int N>
+class CheckpointStrainTest
+    : public A2D::Test::A2DTest<T, T, Mat<T, N, N>, Mat<T, N, N>> {
+ public:
+  using Input = VarTuple<T, Mat<T, N, N>, Mat<T, N, N>>;
+  using Output = VarTuple<T, T>;
+
+  // Assemble a string to describe the test
+  std::string name() {
+    std::stringstream s;
+    s << "CheckpointStrainTest<" << N << ">";
+    return s.str();
+  }
+
+  // Evaluate the function
+  Output eval(const Input &x) {
+    Mat<T, N, N> Uxi, J;
+    x.get_values(Uxi, J);
+    T output;
+
+    // Set the intermediary values
+    Mat<T, N, N> Jinv, Ux;
+    SymMat<T, N> E2, E, W;
+
+    MatInv(J, Jinv);                       // Jinv = J^{-1}
+    MatMatMult(Uxi, Jinv, Ux);             // Ux = Uxi * Jinv
+    SymMatSum(T(0.5), Ux, W);              // W = 0.5 * (Ux + Ux^{T})
+    SymMatRK<MatOp::TRANSPOSE>(Ux, E2);    // E2 = Ux^{T} * Ux
+    MatSum(T(1.0), W, T(0.5), E2, E);      // E = W + 0.5 * E2
+    SymIsotropic(T(0.35), T(0.51), E, W);  // W = 2 * mu * E + lam * tr(E) * I
+    SymMatMultTrace(E, W, output);         // output = tr(E * W)
+
+    return MakeVarTuple<T>(output);
+  }
+
+  // Compute the derivative
+  void deriv(const Output &seed, const Input &x, Input &g) {
+    // The AD objects
+    ADObj<T> output;
+    ADObj<Mat<T, N, N>> Uxi, J, Jinv, Ux;
+    ADObj<SymMat<T, N>> E2, E, W;
+
+    x.get_values(Uxi.value(), J.value());
+
+    auto stack = MakeCheckpointStack(
+        MakeSegment(MatInv(J, Jinv),             // Jinv = J^{-1}
+                    MatMatMult(Uxi, Jinv, Ux)),  // Ux = Uxi * Jinv
+        MakeSegment(SymMatSum(T(0.5), Ux, W),    // W = 0.5 * (Ux + Ux^{T})
+                    SymMatRK<MatOp::TRANSPOSE>(Ux, E2),  // E2 = Ux^{T} * Ux
+                    MatSum(T(1.0), W, T(0.5), E2, E)),   // E = W + 0.5 * E2
+        MakeSegment(SymIsotropic(T(0.35), T(0.51), E, W),  // W = S(E)
+                    SymMatMultTrace(E, W, output)));
+
+    seed.get_values(output.bvalue());
+    stack.reverse();
+    g.set_values(Uxi.bvalue(), J.bvalue());
+  }
+
+  // Compute the second-derivative
+  void hprod(const Output &seed, const Output &hval, const Input &x,
+             const Input &p, Input &h) {
+    // The AD objects
+    A2DObj<Mat<T, N, N>> Uxi, J;
+    A2DObj<T> output;
+    A2DObj<Mat<T, N, N>> Jinv, Ux;
+    A2DObj<SymMat<T, N>> E1, E2, E, S;
+
+    x.get_values(Uxi.value(), J.value());
+    p.get_values(Uxi.pvalue(), J.pvalue());
+
+    auto stack =
+        MakeStack(MatInv(J, Jinv),            // Jinv = J^{-1}
+                  MatMatMult(Uxi, Jinv, Ux),  // Ux = Uxi * Jinv
+                  SymMatSum(T(0.5), Ux, E1),  // E1 = 0.5 * (Ux + Ux^{T})
+                  SymMatRK<MatOp::TRANSPOSE>(Ux, E2),    // E2 = Ux^{T} * Ux
+                  MatSum(T(1.0), E1, T(0.5), E2, E),     // E = E1 + 0.5 * E2
+                  SymIsotropic(T(0.35), T(0.51), E, S),  // S = S(E)
+                  SymMatMultTrace(E, S, output));
+
+    seed.get_values(output.bvalue());
+    hval.get_values(output.hvalue());
+    stack.hproduct();
+    h.set_values(Uxi.hvalue(), J.hvalue());
+  }
+};
+
+/*
+  Run the integration tests in the precision T. The complex-step step size
+  and tolerances of the tests are set for T.
+*/
+template <typename T>
 bool MatIntegrationTests(bool component, bool write_output) {
   bool passed = true;
 
-  StrainTest<A2D_complex_t<double>, 3> test1;
+  StrainTest<A2D_complex_t<T>, 3> test1;
   passed = passed && A2D::Test::Run(test1, component, write_output);
 
-  DefGradTest<A2D_complex_t<double>, 3> test2;
+  DefGradTest<A2D_complex_t<T>, 3> test2;
   passed = passed && A2D::Test::Run(test2, component, write_output);
 
-  MooneyRivlin<A2D_complex_t<double>> test3;
+  MooneyRivlin<A2D_complex_t<T>> test3;
   passed = passed && A2D::Test::Run(test3, component, write_output);
 
-  HExtractTest<A2D_complex_t<double>, 3> test4;
+  HExtractTest<A2D_complex_t<T>, 3> test4;
   passed = passed && A2D::Test::Run(test4, component, write_output);
 
-  VonMisesPenaltyTest<A2D_complex_t<double>> test5;
+  VonMisesPenaltyTest<A2D_complex_t<T>> test5;
   passed = passed && A2D::Test::Run(test5, component, write_output);
 
-  DiamondGraphTest<A2D_complex_t<double>, 3> test6;
+  DiamondGraphTest<A2D_complex_t<T>, 3> test6;
   passed = passed && A2D::Test::Run(test6, component, write_output);
 
+  CheckpointStrainTest<A2D_complex_t<T>, 3> test7;
+  passed = passed && A2D::Test::Run(test7, component, write_output);
+
   return passed;
 }
 
@@ -654,17 +753,29 @@ int main(int argc, char *argv[]) {
     if (str.compare("--component") == 0) {
       component = true;
     }
+    // Passed to Run through the environment, see DefaultNumThreads()
+    if (str.compare("--threads") == 0 && i + 1 < argc) {
+      setenv("A2D_TEST_THREADS", argv[i + 1], 1);
+    }
   }
 
   typedef std::function<bool(bool, bool)> TestFunc;
   std::vector<TestFunc> tests;
 
-  tests.push_back(MatIntegrationTests);
+  tests.push_back(MatIntegrationTests<double>);
+  tests.push_back(MatIntegrationTests<float>);
   tests.push_back(A2D::Test::MatMatMultTestAll);
   tests.push_back(A2D::Test::MatVecMultTestAll);
+  tests.push_back(A2D::Test::MatMultiVecTestAll);
   tests.push_back(A2D::Test::SymMatVecMultTestAll);
+  tests.push_back(A2D::Test::SkewMatMatMultTestAll);
+  tests.push_back(A2D::Test::SkewMatVecMultTestAll);
+  tests.push_back(A2D::Test::DiagMatMatMultTestAll);
+  tests.push_back(A2D::Test::DiagMatVecMultTestAll);
+  tests.push_back(A2D::Test::MatDiagSumTestAll);
   tests.push_back(A2D::Test::MatDetTestAll);
   tests.push_back(A2D::Test::MatInvTestAll);
+  tests.push_back(A2D::Test::MatPolarDecompTestAll);
   tests.push_back(A2D::Test::MatTraceTestAll);
   tests.push_back(A2D::Test::MatGreenStrainTestAll);
   tests.push_back(A2D::Test::SymMatMultTraceTestAll);
@@ -679,11 +790,19 @@ int main(int argc, char *argv[]) {
   tests.push_back(A2D::Test::VecNormalizeTestAll);
   tests.push_back(A2D::Test::VecSumTestAll);
   tests.push_back(A2D::Test::VecOuterTestAll);
+  tests.push_back(A2D::Test::VecAggregateTestAll);
   tests.push_back(A2D::Test::ScalarTestAll);
+  tests.push_back(A2D::Test::ScalarShareTestAll);
+  tests.push_back(A2D::Test::ScalarNaryTestAll);
+  tests.push_back(A2D::Test::ScalarMathTestAll);
   tests.push_back(A2D::Test::SymEigsTestAll);
   tests.push_back(A2D::Test::QuaternionMatrixTestAll);
   tests.push_back(A2D::Test::QuaternionAngularVelocityTestAll);
+  tests.push_back(A2D::Test::QuaternionProductTestAll);
+  tests.push_back(A2D::Test::QuaternionRotateVecTestAll);
+  tests.push_back(A2D::Test::RotationVecToMatTestAll);
   tests.push_back(A2D::Test::VecHadamardTestAll);
+  tests.push_back(A2D::Test::TensorInterpTestAll);
 
   bool passed = true;
   for (int i = 0; i < tests.size(); i++) {
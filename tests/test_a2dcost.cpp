@@ -0,0 +1,127 @@
+#include <sstream>
+#include <string>
+
+#include "a2dcore.h"
+#include "test_commons.h"
+
+using namespace A2D;
+
+TEST(test_a2dcost, gemm_counts) {
+  using T = double;
+  ADObj<Mat<T, 3, 4>> A;
+  ADObj<Mat<T, 4, 2>> B;
+  ADObj<Mat<T, 3, 2>> C;
+
+  auto stack = MakeStack(MatMatMult(A, B, C));
+  constexpr ADCost cost = decltype(stack)::cost();
+
+  // C = A * B takes 2 * 3 * 2 * 4 flops
+  static_assert(cost.eval.flops == 48);
+  static_assert(cost.forward.flops == 2 * 48);
+  static_assert(cost.reverse.flops == 2 * 48);
+  static_assert(cost.hreverse.flops == 4 * 48);
+  EXPECT_EQ(cost.eval.bytes, (12 + 8 + 6) * sizeof(T));
+}
+
+TEST(test_a2dcost, passive_input) {
+  using T = double;
+  Mat<T, 3, 3> A;
+  ADObj<Mat<T, 3, 3>> B, C;
+
+  auto stack = MakeStack(MatMatMult(A, B, C));
+  constexpr ADCost cost = decltype(stack)::cost();
+
+  // Only the derivative with respect to B is computed
+  static_assert(cost.forward.flops == 54);
+  static_assert(cost.reverse.flops == 54);
+  static_assert(cost.hreverse.flops == 54);
+}
+
+TEST(test_a2dcost, stack_sum) {
+  using T = double;
+  A2DObj<Mat<T, 3, 3>> J, Jinv, Uxi, Ux;
+  A2DObj<SymMat<T, 3>> E;
+  A2DObj<T> ks;
+
+  auto stack =
+      MakeStack(MatInv(J, Jinv), MatMatMult(Uxi, Jinv, Ux),
+                SymMatRK<MatOp::TRANSPOSE>(Ux, E), MatDet(Ux, ks));
+  using Stack = decltype(stack);
+
+  constexpr ADCost total = Stack::cost();
+  constexpr ADCost inv = Stack::cost<0>();
+  constexpr ADCost mult = Stack::cost<1>();
+  constexpr ADCost rk = Stack::cost<2>();
+  constexpr ADCost det = Stack::cost<3>();
+
+  static_assert(total.eval.flops == inv.eval.flops + mult.eval.flops +
+                                        rk.eval.flops + det.eval.flops);
+  static_assert(total.hproduct().flops ==
+                total.reverse.flops + total.hforward.flops +
+                    total.hreverse.flops);
+  EXPECT_EQ(std::string(mult.name), "MatMatMult");
+
+  std::stringstream s;
+  stack.write_cost(s);
+  std::string table = s.str();
+  EXPECT_NE(table.find("0: MatInv"), std::string::npos);
+  EXPECT_NE(table.find("3: MatDet"), std::string::npos);
+  EXPECT_NE(table.find("hproduct"), std::string::npos);
+}
+
+TEST(test_a2dcost, unknown_operation) {
+  using T = double;
+  ADObj<Vec<T, 3>> x, y, z;
+
+  auto stack = MakeStack(VecCross(x, y, z));
+  constexpr ADCost cost = decltype(stack)::cost<0>();
+
+  static_assert(!has_ad_cost<decltype(VecCross(x, y, z))>::value);
+  static_assert(cost.unknown == 1 && !cost.complete());
+  EXPECT_EQ(std::string(cost.name), "unknown");
+  EXPECT_EQ(cost.eval.flops, 0u);
+}
+
+TEST(test_a2dcost, unknown_count) {
+  using T = double;
+  ADObj<Vec<T, 3>> x, y, z, w;
+  ADObj<Mat<T, 3, 3>> A;
+  ADObj<T> det;
+
+  auto stack = MakeStack(VecCross(x, y, z), VecCross(x, z, w), MatDet(A, det));
+  using Stack = decltype(stack);
+
+  // The totals hold only the counts of MatDet
+  constexpr ADCost total = Stack::cost();
+  static_assert(total.unknown == 2 && !total.complete());
+  static_assert(total.eval.flops == Stack::cost<2>().eval.flops);
+
+  auto known = MakeStack(MatDet(A, det));
+  static_assert(decltype(known)::cost().complete());
+
+  std::stringstream s;
+  stack.write_cost(s);
+  EXPECT_NE(s.str().find("2 ops unknown"), std::string::npos);
+
+  std::stringstream t;
+  known.write_cost(t);
+  EXPECT_EQ(t.str().find("unknown"), std::string::npos);
+}
+
+TEST(test_a2dcost, checkpoint_recompute) {
+  using T = double;
+  ADObj<Mat<T, 3, 3>> J, Jinv, Uxi, Ux;
+  ADObj<T> det;
+
+  auto stack =
+      MakeCheckpointStack(MakeSegment(MatInv(J, Jinv)),
+                          MakeSegment(MatMatMult(Uxi, Jinv, Ux)),
+                          MakeSegment(MatDet(Ux, det)));
+  using Stack = decltype(stack);
+
+  // The last segment is not evaluated again in the reverse sweep
+  constexpr ADPhaseCost recompute = Stack::recompute_cost();
+  constexpr ADCost total = Stack::cost();
+  static_assert(recompute.flops == 51 + 54);
+  static_assert(total.eval.flops == 51 + 54 + 14);
+}
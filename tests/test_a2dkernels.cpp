@@ -0,0 +1,278 @@
+#include "a2dcore.h"
+#include "test_commons.h"
+
+#ifndef A2D_USE_EXTERN_KERNELS
+#error "test_a2dkernels must link to A2D::kernels"
+#endif
+
+using namespace A2D;
+
+/*
+  These calls use the cores compiled into A2D::kernels, so the test fails to
+  link if an instantiation declared in a2dkernels.h is missing from the
+  library
+*/
+
+TEST(test_a2dkernels, mat_mat_mult) {
+  using T = double;
+  Mat<T, 4, 4> A, B, C;
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      A(i, j) = 1.0 + i - 0.5 * j;
+      B(i, j) = 0.25 * i * j - 1.0;
+    }
+  }
+
+  MatMatMult<MatOp::NORMAL, MatOp::TRANSPOSE>(A, B, C);
+
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      T value = 0.0;
+      for (int k = 0; k < 4; k++) {
+        value += A(i, k) * B(j, k);
+      }
+      EXPECT_DOUBLE_EQ(C(i, j), value);
+    }
+  }
+}
+
+TEST(test_a2dkernels, mat_vec_mult_complex) {
+  using T = A2D_complex_t<double>;
+  T A[25], x[5], y[5];
+  for (int i = 0; i < 25; i++) {
+    A[i] = T(0.1 * i, -0.2 * i);
+  }
+  for (int i = 0; i < 5; i++) {
+    x[i] = T(1.0 - i, 0.5);
+  }
+
+  MatVecCore<T, 5, 5, MatOp::TRANSPOSE>(A, x, y);
+
+  for (int i = 0; i < 5; i++) {
+    T value = 0.0;
+    for (int k = 0; k < 5; k++) {
+      value += A[5 * k + i] * x[k];
+    }
+    EXPECT_DOUBLE_EQ(y[i].real(), value.real());
+    EXPECT_DOUBLE_EQ(y[i].imag(), value.imag());
+  }
+}
+
+TEST(test_a2dkernels, det_and_inverse) {
+  using T = double;
+  T A[9] = {2.0, 1.0, 0.0, 1.0, 3.0, 1.0, 0.0, 1.0, 4.0};
+  T Ainv[9];
+
+  MatInvCore<T, 3>(A, Ainv);
+  EXPECT_DOUBLE_EQ((MatDetCore<T, 3>(A)), 18.0);
+
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      T value = 0.0;
+      for (int k = 0; k < 3; k++) {
+        value += A[3 * i + k] * Ainv[3 * k + j];
+      }
+      EXPECT_NEAR(value, i == j ? 1.0 : 0.0, 1e-14);
+    }
+  }
+}
+
+TEST(test_a2dkernels, sym_eigs) {
+  using T = double;
+  constexpr int N = 4;
+  SymMat<T, N> S;
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j <= i; j++) {
+      S(i, j) = (i == j ? 4.0 + i : 1.0 / (1.0 + i + j));
+    }
+  }
+
+  T eigs[N], Q[N * N];
+  SymEigsGeneral<T, N>(get_data(S), eigs, Q);
+
+  // Check that S = Q * diag(eigs) * Q^{T}
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      T value = 0.0;
+      for (int k = 0; k < N; k++) {
+        value += Q[N * i + k] * eigs[k] * Q[N * j + k];
+      }
+      EXPECT_NEAR(value, S(i, j), 1e-12);
+    }
+  }
+}
+
+TEST(test_a2dkernels, stack_reverse) {
+  using T = double;
+  ADObj<Mat<T, 3, 3>> A;
+  ADObj<T> det;
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      A.value()(i, j) = (i == j ? 2.0 : 0.5);
+    }
+  }
+
+  auto stack = MakeStack(MatDet(A, det));
+  det.bvalue() = 1.0;
+  stack.reverse();
+
+  // The derivative of det(A) is det(A) * A^{-T}
+  Mat<T, 3, 3> Ainv;
+  MatInv(A.value(), Ainv);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      EXPECT_NEAR(A.bvalue()(i, j), det.value() * Ainv(j, i), 1e-14);
+    }
+  }
+}
+
+/*
+  Check each variant of the dispatched cores that the CPU supports against
+  the cores compiled for the baseline instruction set
+*/
+template <int N, MatOp opA, MatOp opB>
+void check_dispatch_mat_mat_mult() {
+  using T = double;
+  T A[N * N], B[N * N], C[N * N], D[N * N];
+  for (int i = 0; i < N * N; i++) {
+    A[i] = 0.5 + 0.1 * i;
+    B[i] = 1.0 - 0.05 * i * i;
+    C[i] = D[i] = 0.25 * i;
+  }
+
+  DispatchMatMatMultCore<T, N, opA, opB, true>(A, B, C);
+  MatMatMultCore<T, N, N, N, N, N, N, opA, opB, true>(A, B, D);
+  for (int i = 0; i < N * N; i++) {
+    EXPECT_NEAR(C[i], D[i], 1e-13 * (1.0 + std::fabs(D[i])));
+  }
+}
+
+template <int N>
+void check_dispatch_size() {
+  using T = double;
+  check_dispatch_mat_mat_mult<N, MatOp::NORMAL, MatOp::NORMAL>();
+  check_dispatch_mat_mat_mult<N, MatOp::NORMAL, MatOp::TRANSPOSE>();
+  check_dispatch_mat_mat_mult<N, MatOp::TRANSPOSE, MatOp::NORMAL>();
+  check_dispatch_mat_mat_mult<N, MatOp::TRANSPOSE, MatOp::TRANSPOSE>();
+
+  constexpr int S = N * (N + 1) / 2;
+  T A[N * N], Sd[S], Sc[S], x[N], y[N], z[N];
+  for (int i = 0; i < N * N; i++) {
+    A[i] = 1.0 / (1.0 + i);
+  }
+  for (int i = 0; i < N; i++) {
+    x[i] = 1.0 - 0.3 * i;
+  }
+
+  DispatchSymMatRKCore<T, N, MatOp::TRANSPOSE>(A, Sd);
+  SymMatRKCore<T, N, N, MatOp::TRANSPOSE>(A, Sc);
+  for (int i = 0; i < S; i++) {
+    EXPECT_NEAR(Sd[i], Sc[i], 1e-13);
+  }
+
+  DispatchSymMatVecCore<T, N>(Sd, x, y);
+  SymMatVecCore<T, N>(Sc, x, z);
+  for (int i = 0; i < N; i++) {
+    EXPECT_NEAR(y[i], z[i], 1e-13);
+  }
+}
+
+/*
+  The dispatched cores are compiled for double and sizes 1 to 6, and the
+  expressions call them only at the sizes where they are faster
+*/
+static_assert(use_dispatch_core<double, 6>::value,
+              "The dispatched cores are compiled for double");
+static_assert(!use_dispatch_core<double, 7>::value &&
+                  !use_dispatch_core<A2D_complex_t<double>, 3>::value,
+              "The dispatched cores are only compiled for double and N <= 6");
+static_assert(!use_dispatch_mat_mat_mult<double, 3>::value &&
+                  use_dispatch_mat_mat_mult<double, 4>::value,
+              "Small products are inlined");
+static_assert(!use_dispatch_sym_mat_rk<double, 4>::value &&
+                  use_dispatch_sym_mat_rk<double, 5>::value,
+              "Small rank-k products are inlined");
+
+template <int N>
+void check_dispatch_expressions() {
+  using T = double;
+  constexpr int S = N * (N + 1) / 2;
+  Mat<T, N, N> A, B, C;
+  SymMat<T, N> Sd;
+  Vec<T, N> x, y;
+  T D[N * N], Sc[S], z[N];
+  for (int i = 0; i < N * N; i++) {
+    A[i] = 0.5 + 0.1 * i;
+    B[i] = 1.0 - 0.05 * i * i;
+  }
+  for (int i = 0; i < N; i++) {
+    x[i] = 1.0 - 0.3 * i;
+  }
+
+  MatMatMult<MatOp::TRANSPOSE, MatOp::NORMAL>(A, B, C);
+  MatMatMultCore<T, N, N, N, N, N, N, MatOp::TRANSPOSE, MatOp::NORMAL>(
+      get_data(A), get_data(B), D);
+  for (int i = 0; i < N * N; i++) {
+    EXPECT_NEAR(C[i], D[i], 1e-13 * (1.0 + std::fabs(D[i])));
+  }
+
+  SymMatRK(A, Sd);
+  SymMatRKCore<T, N, N>(get_data(A), Sc);
+  for (int i = 0; i < S; i++) {
+    EXPECT_NEAR(Sd[i], Sc[i], 1e-13 * (1.0 + std::fabs(Sc[i])));
+  }
+
+  // The reverse sweep accumulates into the seed of x
+  ADObj<SymMat<T, N>> Sobj(Sd);
+  ADObj<Vec<T, N>> xobj(x), yobj;
+  auto stack = MakeStack(MatVecMult(Sobj, xobj, yobj));
+  for (int i = 0; i < N; i++) {
+    yobj.bvalue()[i] = 1.0 + 0.5 * i;
+  }
+  stack.reverse();
+
+  SymMatVecCore<T, N>(Sc, get_data(x), z);
+  for (int i = 0; i < N; i++) {
+    EXPECT_NEAR(yobj.value()[i], z[i], 1e-13 * (1.0 + std::fabs(z[i])));
+  }
+  SymMatVecCore<T, N>(Sc, get_data(yobj.bvalue()), z);
+  for (int i = 0; i < N; i++) {
+    EXPECT_NEAR(xobj.bvalue()[i], z[i], 1e-13 * (1.0 + std::fabs(z[i])));
+  }
+}
+
+TEST(test_a2dkernels, dispatch_expressions) {
+  KernelISA selected = GetKernelISA();
+  for (KernelISA isa :
+       {KernelISA::SCALAR, KernelISA::AVX2, KernelISA::AVX512}) {
+    SetKernelISA(isa);
+    check_dispatch_expressions<1>();
+    check_dispatch_expressions<3>();
+    check_dispatch_expressions<4>();
+    check_dispatch_expressions<5>();
+    check_dispatch_expressions<6>();
+  }
+  SetKernelISA(selected);
+}
+
+TEST(test_a2dkernels, dispatch) {
+  KernelISA selected = GetKernelISA();
+  KernelISA detected = DetectKernelISA();
+  EXPECT_LE(selected, detected);
+
+  for (KernelISA isa :
+       {KernelISA::SCALAR, KernelISA::AVX2, KernelISA::AVX512}) {
+    KernelISA used = SetKernelISA(isa);
+    EXPECT_EQ(used, (isa > detected ? detected : isa));
+    EXPECT_EQ(GetKernelISA(), used);
+
+    check_dispatch_size<1>();
+    check_dispatch_size<2>();
+    check_dispatch_size<3>();
+    check_dispatch_size<4>();
+    check_dispatch_size<5>();
+    check_dispatch_size<6>();
+  }
+
+  SetKernelISA(selected);
+}
@@ -0,0 +1,191 @@
+#include "a2dcore.h"
+#include "test_commons.h"
+
+#ifndef A2D_MIXED_PRECISION
+#error "test_a2dmixed must be compiled with A2D_MIXED_PRECISION"
+#endif
+
+using namespace A2D;
+
+/*
+  The float data below are chosen so that the products are exact in double
+  but not in float, and the sums of the products are exact in double. The
+  mixed-precision reductions must then return the correctly rounded result.
+*/
+static float entry_a(int i) { return 4096.0f + 0.015625f * (i % 7); }
+static float entry_b(int i) { return 0.03125f * (i % 5) - 4096.0f; }
+
+static_assert(std::is_same<accumulate_type<float>::type, double>::value,
+              "float must be accumulated in double");
+static_assert(std::is_same<accumulate_type<double>::type, double>::value,
+              "double must be accumulated in double");
+
+template <MatOp opA, MatOp opB>
+void check_mat_mat_mult() {
+  constexpr int N = 5, M = 6, K = 4;
+  float A[N * M], B[M * K], C[N * K];
+  for (int i = 0; i < N * M; i++) {
+    A[i] = entry_a(i);
+  }
+  for (int i = 0; i < M * K; i++) {
+    B[i] = entry_b(i);
+  }
+
+  // op(A) is N x M and op(B) is M x K
+  constexpr int Anrows = (opA == MatOp::NORMAL ? N : M);
+  constexpr int Ancols = (opA == MatOp::NORMAL ? M : N);
+  constexpr int Bnrows = (opB == MatOp::NORMAL ? M : K);
+  constexpr int Bncols = (opB == MatOp::NORMAL ? K : M);
+  MatMatMultCore<float, Anrows, Ancols, Bnrows, Bncols, N, K, opA, opB>(A, B,
+                                                                        C);
+
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < K; j++) {
+      double value = 0.0;
+      for (int k = 0; k < M; k++) {
+        double a = (opA == MatOp::NORMAL ? A[M * i + k] : A[N * k + i]);
+        double b = (opB == MatOp::NORMAL ? B[K * k + j] : B[M * j + k]);
+        value += a * b;
+      }
+      EXPECT_EQ(C[K * i + j], static_cast<float>(value));
+    }
+  }
+}
+
+TEST(test_a2dmixed, mat_mat_mult) {
+  check_mat_mat_mult<MatOp::NORMAL, MatOp::NORMAL>();
+  check_mat_mat_mult<MatOp::NORMAL, MatOp::TRANSPOSE>();
+  check_mat_mat_mult<MatOp::TRANSPOSE, MatOp::NORMAL>();
+  check_mat_mat_mult<MatOp::TRANSPOSE, MatOp::TRANSPOSE>();
+}
+
+TEST(test_a2dmixed, mat_vec_mult) {
+  constexpr int M = 4, N = 6;
+  float A[M * N], x[N], y[N], z[M];
+  for (int i = 0; i < M * N; i++) {
+    A[i] = entry_a(i);
+  }
+  for (int i = 0; i < N; i++) {
+    x[i] = entry_b(i);
+  }
+
+  MatVecCore<float, M, N>(A, x, z);
+  for (int i = 0; i < M; i++) {
+    double value = 0.0;
+    for (int j = 0; j < N; j++) {
+      value += double(A[N * i + j]) * double(x[j]);
+    }
+    EXPECT_EQ(z[i], static_cast<float>(value));
+  }
+
+  MatVecCore<float, M, N, MatOp::TRANSPOSE>(A, x, y);
+  for (int j = 0; j < N; j++) {
+    double value = 0.0;
+    for (int i = 0; i < M; i++) {
+      value += double(A[N * i + j]) * double(x[i]);
+    }
+    EXPECT_EQ(y[j], static_cast<float>(value));
+  }
+}
+
+TEST(test_a2dmixed, sym_reductions) {
+  constexpr int N = 4, K = 6;
+  float A[N * K], S[N * (N + 1) / 2], x[N], y[N];
+  for (int i = 0; i < N * K; i++) {
+    A[i] = entry_a(i);
+  }
+  for (int i = 0; i < N; i++) {
+    x[i] = entry_b(i);
+  }
+
+  // S = A * A^{T}
+  SymMatRKCore<float, N, K>(A, S);
+  for (int i = 0, index = 0; i < N; i++) {
+    for (int j = 0; j <= i; j++, index++) {
+      double value = 0.0;
+      for (int k = 0; k < K; k++) {
+        value += double(A[K * i + k]) * double(A[K * j + k]);
+      }
+      EXPECT_EQ(S[index], static_cast<float>(value));
+    }
+  }
+
+  // y = S * x
+  SymMatVecCore<float, N>(S, x, y);
+  for (int i = 0; i < N; i++) {
+    double value = 0.0;
+    for (int j = 0; j < N; j++) {
+      int index = i >= j ? j + i * (i + 1) / 2 : i + j * (j + 1) / 2;
+      value += double(S[index]) * double(x[j]);
+    }
+    EXPECT_EQ(y[i], static_cast<float>(value));
+  }
+
+  // The dot product of the first two rows of A
+  double value = 0.0;
+  for (int k = 0; k < K; k++) {
+    value += double(A[k]) * double(A[K + k]);
+  }
+  EXPECT_EQ((VecDotCore<float, K>(A, &A[K])), static_cast<float>(value));
+}
+
+TEST(test_a2dmixed, diag_mat_dots) {
+  constexpr int M = 4, N = 6;
+  float A[M * N], B[M * N], r[M], c[N];
+  for (int i = 0; i < M * N; i++) {
+    A[i] = entry_a(i);
+    B[i] = entry_b(i + 3);
+  }
+  for (int i = 0; i < M; i++) {
+    r[i] = 0.0f;
+  }
+  for (int j = 0; j < N; j++) {
+    c[j] = 0.0f;
+  }
+
+  // The derivatives of D * A and A * D with respect to the diagonal
+  DiagMatRowDotCore<float, M, N>(A, B, r);
+  DiagMatColDotCore<float, M, N>(A, B, c);
+  for (int i = 0; i < M; i++) {
+    double value = 0.0;
+    for (int j = 0; j < N; j++) {
+      value += double(A[N * i + j]) * double(B[N * i + j]);
+    }
+    EXPECT_EQ(r[i], static_cast<float>(value));
+  }
+  for (int j = 0; j < N; j++) {
+    double value = 0.0;
+    for (int i = 0; i < M; i++) {
+      value += double(A[N * i + j]) * double(B[N * i + j]);
+    }
+    EXPECT_EQ(c[j], static_cast<float>(value));
+  }
+}
+
+/*
+  The AD objects use the same cores, so the reverse mode of a float stack is
+  accumulated in double as well
+*/
+TEST(test_a2dmixed, stack_reverse) {
+  constexpr int N = 4;
+  ADObj<Mat<float, N, N>> A, B, C;
+  for (int i = 0; i < N * N; i++) {
+    A.value()[i] = entry_a(i);
+    B.value()[i] = entry_b(i);
+    C.bvalue()[i] = entry_b(i + 2);
+  }
+
+  auto stack = MakeStack(MatMatMult(A, B, C));
+  stack.reverse();
+
+  // Ab = Cb * B^{T}
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      double value = 0.0;
+      for (int k = 0; k < N; k++) {
+        value += double(C.bvalue()(i, k)) * double(B.value()(j, k));
+      }
+      EXPECT_EQ(A.bvalue()(i, j), static_cast<float>(value));
+    }
+  }
+}
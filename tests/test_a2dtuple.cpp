@@ -50,3 +50,25 @@ TEST(test_a2dtuple, TieTuple) {
   auto g = A2D::MakeTieTuple<T, A2D::ADseed::b>(Uxb);
   g.zero();
 }
+
+TEST(test_a2dtuple, set_rand_counter_based) {
+  using T = double;
+  A2D::A2DRandom rng("VarTuple"), other("VarTuple", 1);
+
+  A2D::VarTuple<T, T, A2D::Mat<T, 3, 3>> x, y, z;
+  x.set_rand(rng);
+  y.set_rand(rng);
+  z.set_rand(other, 2.0, 3.0);
+
+  // The same key gives the same values, regardless of call order
+  for (A2D::index_t i = 0; i < x.get_num_components(); i++) {
+    EXPECT_DOUBLE_EQ(x[i], y[i]);
+    EXPECT_DOUBLE_EQ(x[i], -1.0 + 2.0 * rng.uniform(i));
+    EXPECT_GE(z[i], 2.0);
+    EXPECT_LT(z[i], 3.0);
+  }
+
+  // A different stream gives different values
+  EXPECT_NE(rng.uniform(0), other.uniform(0));
+  EXPECT_NE(rng.uniform(0), rng.split(0).uniform(0));
+}
@@ -0,0 +1,369 @@
+#include <cstdint>
+
+#include "a2dcore.h"
+#include "adscalar.h"
+#include "adsparsescalar.h"
+#include "test_commons.h"
+
+using namespace A2D;
+
+// Set up x with derivatives dx = [1, 2, ..., N] and y with dy = [N, ..., 1]
+template <int N>
+void set_inputs(ADScalar<T, N>& x, ADScalar<T, N>& y) {
+  x = 1.3;
+  y = -0.7;
+  for (int i = 0; i < N; i++) {
+    x.deriv[i] = i + 1.0;
+    y.deriv[i] = N - i;
+  }
+}
+
+TEST(test_adscalar, padded_storage) {
+  using Scalar = ADScalar<T, 13>;
+  EXPECT_GE(Scalar::NPAD, 13);
+  EXPECT_EQ((Scalar::NPAD * sizeof(T)) % A2D_ADSCALAR_ALIGN, 0u);
+
+  Scalar x, y;
+  set_inputs(x, y);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(x.deriv) % A2D_ADSCALAR_ALIGN,
+            0u);
+
+  // The padded entries must remain zero through the arithmetic
+  Scalar z = -(x * y + 2.0 * x) / y - sqrt(x * x) + exp(sin(y));
+  for (int i = 13; i < Scalar::NPAD; i++) {
+    EXPECT_EQ(z.deriv[i], 0.0);
+  }
+}
+
+TEST(test_adscalar, arithmetic) {
+  constexpr int N = 13;
+  ADScalar<T, N> x, y;
+  set_inputs(x, y);
+
+  ADScalar<T, N> f = x * y - x / y + 3.0 * x - y / 2.0 + 1.0;
+  ADScalar<T, N> g = -x;
+  g += y;
+  g *= x;
+  g /= y;
+
+  T xv = x.value, yv = y.value;
+  _EXPECT_VAL_NEAR(f.value, xv * yv - xv / yv + 3.0 * xv - yv / 2.0 + 1.0);
+  _EXPECT_VAL_NEAR(g.value, (yv - xv) * xv / yv);
+  for (int i = 0; i < N; i++) {
+    T dx = x.deriv[i], dy = y.deriv[i];
+    T df = dx * yv + xv * dy - dx / yv + xv * dy / (yv * yv) + 3.0 * dx -
+           0.5 * dy;
+    T dg = ((dy - dx) * xv + (yv - xv) * dx) / yv -
+           (yv - xv) * xv * dy / (yv * yv);
+    _EXPECT_VAL_NEAR_TOL(f.deriv[i], df, 1e-13);
+    _EXPECT_VAL_NEAR_TOL(g.deriv[i], dg, 1e-13);
+  }
+}
+
+TEST(test_adscalar, functions) {
+  constexpr int N = 5;
+  ADScalar<T, N> x, y;
+  set_inputs(x, y);
+
+  ADScalar<T, N> f = sqrt(x) + exp(y) + sin(x) * cos(y) + pow(x, 2.5) +
+                     fabs(y);
+
+  T xv = x.value, yv = y.value;
+  _EXPECT_VAL_NEAR_TOL(f.value,
+                       std::sqrt(xv) + std::exp(yv) +
+                           std::sin(xv) * std::cos(yv) + std::pow(xv, 2.5) -
+                           yv,
+                       1e-14);
+  for (int i = 0; i < N; i++) {
+    T dx = x.deriv[i], dy = y.deriv[i];
+    T df = 0.5 * dx / std::sqrt(xv) + std::exp(yv) * dy +
+           std::cos(xv) * std::cos(yv) * dx -
+           std::sin(xv) * std::sin(yv) * dy +
+           2.5 * std::pow(xv, 1.5) * dx - dy;
+    _EXPECT_VAL_NEAR_TOL(f.deriv[i], df, 1e-13);
+  }
+}
+
+TEST(test_adscalar, aliased_assignment) {
+  constexpr int N = 6;
+  ADScalar<T, N> x, y, z;
+  set_inputs(x, y);
+  z = x;
+
+  // The right-hand side references the left-hand side
+  z = z * y + z / y - z;
+  x += x * y;
+  y *= y - 1.0;
+
+  T xv = 1.3, yv = -0.7;
+  _EXPECT_VAL_NEAR(z.value, xv * yv + xv / yv - xv);
+  _EXPECT_VAL_NEAR(x.value, xv + xv * yv);
+  _EXPECT_VAL_NEAR(y.value, yv * (yv - 1.0));
+  for (int i = 0; i < N; i++) {
+    T dx = i + 1.0, dy = N - i;
+    T dz = dx * yv + xv * dy + dx / yv - xv * dy / (yv * yv) - dx;
+    _EXPECT_VAL_NEAR_TOL(z.deriv[i], dz, 1e-13);
+    _EXPECT_VAL_NEAR_TOL(x.deriv[i], dx + dx * yv + xv * dy, 1e-13);
+    _EXPECT_VAL_NEAR_TOL(y.deriv[i], dy * (2.0 * yv - 1.0), 1e-13);
+  }
+}
+
+TEST(test_adscalar, lazy_expression) {
+  constexpr int N = 4;
+  ADScalar<T, N> x, y;
+  set_inputs(x, y);
+
+  // The expression is not evaluated until it is assigned
+  auto expr = exp(x * y) - 2.0 / x;
+  ADScalar<T, N> f = expr;
+  ADScalar<T, N> g = exp(x * y);
+  g -= 2.0 / x;
+
+  _EXPECT_VAL_NEAR(f.value, g.value);
+  for (int i = 0; i < ADScalar<T, N>::NPAD; i++) {
+    _EXPECT_VAL_NEAR(f.deriv[i], g.deriv[i]);
+  }
+}
+
+TEST(test_adscalar, matrix_cores) {
+  constexpr int N = 3;
+  using Scalar = ADScalar<T, N>;
+
+  // Seed the derivatives of x with respect to each of its components
+  Mat<Scalar, N, N> A;
+  Vec<Scalar, N> x, y;
+  for (int i = 0; i < N; i++) {
+    x(i) = 0.5 + i;
+    x(i).deriv[i] = 1.0;
+    for (int j = 0; j < N; j++) {
+      A(i, j) = 1.0 / (i + j + 1.0);
+    }
+  }
+
+  // ||A * x||_2 has the derivative A^{T} * A * x / ||A * x||_2
+  Scalar norm;
+  MatVecMult(A, x, y);
+  VecNorm(y, norm);
+
+  for (int k = 0; k < N; k++) {
+    T value = 0.0;
+    for (int i = 0; i < N; i++) {
+      value += A(i, k).value * y(i).value;
+    }
+    _EXPECT_VAL_NEAR_TOL(norm.deriv[k], value / norm.value, 1e-14);
+  }
+}
+
+// Seed the nested scalar for forward-over-forward second derivatives
+template <int N>
+void seed_hessian(const T xvals[], ADScalar<ADScalar<T, N>, N> x[]) {
+  for (int i = 0; i < N; i++) {
+    x[i] = ADScalar<T, N>(xvals[i]);
+    x[i].value.deriv[i] = 1.0;
+    x[i].deriv[i].value = 1.0;
+  }
+}
+
+TEST(test_adscalar, nested_hessian) {
+  constexpr int N = 3;
+  using Scalar = ADScalar<ADScalar<T, N>, N>;
+  const T xvals[] = {0.7, -1.2, 0.4};
+  Scalar x[N];
+  seed_hessian<N>(xvals, x);
+
+  // f = x0 * x1 * exp(x2) + sqrt(x0) / x1 - 3 * sin(x2)
+  Scalar f = x[0] * x[1] * exp(x[2]) + sqrt(x[0]) / x[1] - 3.0 * sin(x[2]);
+
+  T x0 = xvals[0], x1 = xvals[1], x2 = xvals[2];
+  T e = std::exp(x2), r = std::sqrt(x0);
+  T grad[] = {x1 * e + 0.5 / (r * x1), x0 * e - r / (x1 * x1),
+              x0 * x1 * e - 3.0 * std::cos(x2)};
+  T hess[] = {-0.25 / (r * x0 * x1),
+              e - 0.5 / (r * x1 * x1),
+              x1 * e,
+              e - 0.5 / (r * x1 * x1),
+              2.0 * r / (x1 * x1 * x1),
+              x0 * e,
+              x1 * e,
+              x0 * e,
+              x0 * x1 * e + 3.0 * std::sin(x2)};
+
+  _EXPECT_VAL_NEAR_TOL(f.value.value,
+                       x0 * x1 * e + r / x1 - 3.0 * std::sin(x2), 1e-14);
+  for (int i = 0; i < N; i++) {
+    _EXPECT_VAL_NEAR_TOL(f.value.deriv[i], grad[i], 1e-13);
+    _EXPECT_VAL_NEAR_TOL(f.deriv[i].value, grad[i], 1e-13);
+    for (int j = 0; j < N; j++) {
+      _EXPECT_VAL_NEAR_TOL(f.deriv[i].deriv[j], hess[N * i + j], 1e-13);
+    }
+  }
+}
+
+TEST(test_adscalar, nested_functions) {
+  constexpr int N = 3;
+  using Scalar = ADScalar<ADScalar<T, N>, N>;
+  const T xvals[] = {0.7, -1.2, 0.4};
+  Scalar x[N];
+  seed_hessian<N>(xvals, x);
+
+  // f = log(x0) * tanh(x1) + x0 * asin(x2) + x1 * acos(x2)
+  Scalar f = log(x[0]) * tanh(x[1]) + x[0] * asin(x[2]) + x[1] * acos(x[2]);
+
+  T x0 = xvals[0], x1 = xvals[1], x2 = xvals[2];
+  T t = std::tanh(x1), dt = 1.0 - t * t, s = std::sqrt(1.0 - x2 * x2);
+  T grad[] = {t / x0 + std::asin(x2), std::log(x0) * dt + std::acos(x2),
+              (x0 - x1) / s};
+  T hess[] = {-t / (x0 * x0),
+              dt / x0,
+              1.0 / s,
+              dt / x0,
+              -2.0 * t * dt * std::log(x0),
+              -1.0 / s,
+              1.0 / s,
+              -1.0 / s,
+              (x0 - x1) * x2 / (s * s * s)};
+
+  _EXPECT_VAL_NEAR_TOL(f.value.value,
+                       std::log(x0) * t + x0 * std::asin(x2) +
+                           x1 * std::acos(x2),
+                       1e-14);
+  for (int i = 0; i < N; i++) {
+    _EXPECT_VAL_NEAR_TOL(f.value.deriv[i], grad[i], 1e-13);
+    _EXPECT_VAL_NEAR_TOL(f.deriv[i].value, grad[i], 1e-13);
+    for (int j = 0; j < N; j++) {
+      _EXPECT_VAL_NEAR_TOL(f.deriv[i].deriv[j], hess[N * i + j], 1e-13);
+    }
+  }
+
+  // The real part and absolute value recurse to the innermost value
+  _EXPECT_VAL_NEAR(RealPart(x[1]), x1);
+  _EXPECT_VAL_NEAR(absfunc(x[1]), -x1);
+}
+
+// The Hessian of sum_i eigs_i^2 = ||S||_F^2 with S(0, 0) = x0, S(1, 0) = x1
+// and S(M - 1, M - 1) = x2 is diag(2, 4, 2)
+template <int M>
+void check_nested_sym_eigs() {
+  constexpr int N = 3;
+  using Scalar = ADScalar<ADScalar<T, N>, N>;
+  const T xvals[] = {0.7, -1.2, 0.4};
+  Scalar x[N];
+  seed_hessian<N>(xvals, x);
+
+  SymMat<Scalar, M> S;
+  for (int i = 0; i < M; i++) {
+    for (int j = 0; j <= i; j++) {
+      S(i, j) = (i == j ? 2.0 + i : 0.5 / (1.0 + i + j));
+    }
+  }
+  S(0, 0) = x[0];
+  S(1, 0) = x[1];
+  S(M - 1, M - 1) = x[2];
+
+  Vec<Scalar, M> eigs;
+  SymEigs(S, eigs);
+
+  Scalar f = 0.0;
+  for (int i = 0; i < M; i++) {
+    f += eigs(i) * eigs(i);
+  }
+
+  T hess[] = {2.0, 0.0, 0.0, 0.0, 4.0, 0.0, 0.0, 0.0, 2.0};
+  T grad[] = {2.0 * xvals[0], 4.0 * xvals[1], 2.0 * xvals[2]};
+  for (int i = 0; i < N; i++) {
+    _EXPECT_VAL_NEAR_TOL(f.value.deriv[i], grad[i], 1e-12);
+    _EXPECT_VAL_NEAR_TOL(f.deriv[i].value, grad[i], 1e-12);
+    for (int j = 0; j < N; j++) {
+      _EXPECT_VAL_NEAR_TOL(f.deriv[i].deriv[j], hess[N * i + j], 1e-12);
+    }
+  }
+}
+
+TEST(test_adscalar, nested_sym_eigs) {
+  check_nested_sym_eigs<2>();
+  check_nested_sym_eigs<3>();
+}
+
+TEST(test_adscalar, nested_matrix_cores) {
+  constexpr int N = 3;
+  using Scalar = ADScalar<ADScalar<T, N>, N>;
+  const T xvals[] = {0.5, 1.5, 2.5};
+
+  // The Hessian of ||A * x||_2 is (A^{T} A - g g^{T}) / ||A * x||_2 where
+  // g = A^{T} A x / ||A * x||_2 is the gradient
+  Mat<Scalar, N, N> A;
+  Vec<Scalar, N> x, y;
+  seed_hessian<N>(xvals, x.get_data());
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      A(i, j) = 1.0 / (i + j + 1.0);
+    }
+  }
+
+  Scalar norm;
+  MatVecMult(A, x, y);
+  VecNorm(y, norm);
+
+  T nrm = norm.value.value;
+  T grad[N];
+  for (int k = 0; k < N; k++) {
+    grad[k] = 0.0;
+    for (int i = 0; i < N; i++) {
+      grad[k] += A(i, k).value.value * y(i).value.value / nrm;
+    }
+    _EXPECT_VAL_NEAR_TOL(norm.value.deriv[k], grad[k], 1e-14);
+  }
+
+  for (int k = 0; k < N; k++) {
+    for (int l = 0; l < N; l++) {
+      T ata = 0.0;
+      for (int i = 0; i < N; i++) {
+        ata += A(i, k).value.value * A(i, l).value.value;
+      }
+      _EXPECT_VAL_NEAR_TOL(norm.deriv[k].deriv[l],
+                           (ata - grad[k] * grad[l]) / nrm, 1e-14);
+    }
+  }
+}
+
+TEST(test_adscalar, sparse_index_union) {
+  using U = adindex_union_t<ADIndexSet<0, 3, 5>, ADIndexSet<1, 3, 7>>;
+  EXPECT_TRUE((std::is_same<U, ADIndexSet<0, 1, 3, 5, 7>>::value));
+  EXPECT_EQ(U::position(5), 3);
+  EXPECT_EQ(U::position(2), -1);
+}
+
+TEST(test_adscalar, sparse_matches_dense) {
+  constexpr int N = 8;
+  const T xvals[] = {0.3, -1.1, 0.8, 1.7, -0.4, 0.6, 2.1, -0.9};
+
+  // Dense scalars with all N derivatives
+  ADScalar<T, N> xd[N];
+  for (int i = 0; i < N; i++) {
+    xd[i] = xvals[i];
+    xd[i].deriv[i] = 1.0;
+  }
+
+  // Sparse scalars that depend only on their own input
+  const T one = 1.0;
+  ADSparseScalar<T, ADIndexSet<0>> x0(xvals[0], &one);
+  ADSparseScalar<T, ADIndexSet<1>> x1(xvals[1], &one);
+  ADSparseScalar<T, ADIndexSet<2>> x2(xvals[2], &one);
+  ADSparseScalar<T, ADIndexSet<5>> x5(xvals[5], &one);
+  ADSparseScalar<T, ADIndexSet<7>> x7(xvals[7], &one);
+
+  auto a = x0 * x1 - 2.0 * sin(x2);
+  auto b = exp(x5) / (1.0 + x7 * x7);
+  auto f = sqrt(a * a + b) - b / x0;
+  EXPECT_TRUE((std::is_same<decltype(f)::index_set,
+                            ADIndexSet<0, 1, 2, 5, 7>>::value));
+
+  ADScalar<T, N> ad = xd[0] * xd[1] - 2.0 * sin(xd[2]);
+  ADScalar<T, N> bd = exp(xd[5]) / (1.0 + xd[7] * xd[7]);
+  ADScalar<T, N> fd = sqrt(ad * ad + bd) - bd / xd[0];
+
+  _EXPECT_VAL_NEAR(f.value, fd.value);
+  for (int i = 0; i < N; i++) {
+    _EXPECT_VAL_NEAR_TOL(f.get_deriv(i), fd.deriv[i], 1e-14);
+  }
+}